@@ -18,6 +18,36 @@
 
 namespace blink {
 
+namespace {
+
+// An entry that is stored uncompressed in a mapped archive. Pages of the entry
+// are only read from storage when they are used and the memory is shared with
+// the page cache instead of being a private copy.
+class ArchiveEntryMapping final : public fml::Mapping {
+ public:
+  ArchiveEntryMapping(std::shared_ptr<fml::FileMapping> archive,
+                      size_t offset,
+                      size_t size)
+      : archive_(std::move(archive)), offset_(offset), size_(size) {}
+
+  ~ArchiveEntryMapping() override = default;
+
+  size_t GetSize() const override { return size_; }
+
+  const uint8_t* GetMapping() const override {
+    return archive_->GetMapping() + offset_;
+  }
+
+ private:
+  std::shared_ptr<fml::FileMapping> archive_;
+  const size_t offset_;
+  const size_t size_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ArchiveEntryMapping);
+};
+
+}  // namespace
+
 void UniqueUnzipperTraits::Free(void* file) {
   unzClose(file);
 }
@@ -25,6 +55,11 @@ void UniqueUnzipperTraits::Free(void* file) {
 ZipAssetStore::ZipAssetStore(std::string file_path)
     : file_path_(std::move(file_path)) {
   BuildStatCache();
+
+  archive_mapping_ = std::make_shared<fml::FileMapping>(file_path_);
+  if (archive_mapping_->GetMapping() == nullptr) {
+    archive_mapping_ = nullptr;
+  }
 }
 
 ZipAssetStore::~ZipAssetStore() = default;
@@ -68,6 +103,18 @@ std::unique_ptr<fml::Mapping> ZipAssetStore::GetAsMapping(
     return nullptr;
   }
 
+  if (found->second.stored && archive_mapping_) {
+    // The data of the entry follows its local header, the size of which is
+    // only known once the entry has been opened.
+    const ZPOS64_T offset = unzGetCurrentFileZStreamPos64(unzipper.get());
+    const size_t size = found->second.uncompressed_size;
+    if (offset != 0 && offset <= archive_mapping_->GetSize() &&
+        size <= archive_mapping_->GetSize() - offset) {
+      return std::make_unique<ArchiveEntryMapping>(archive_mapping_, offset,
+                                                   size);
+    }
+  }
+
   std::vector<uint8_t> data(found->second.uncompressed_size);
   int total_read = 0;
   while (total_read < static_cast<int>(data.size())) {
@@ -118,8 +165,12 @@ void ZipAssetStore::BuildStatCache() {
       continue;
     }
 
+    // Bit 0 of the flags marks encrypted entries.
+    const bool stored =
+        file_info.compression_method == 0 && (file_info.flag & 1) == 0;
+
     std::string file_name_key(file_name, file_info.size_filename);
-    CacheEntry entry(file_pos, file_info.uncompressed_size);
+    CacheEntry entry(file_pos, file_info.uncompressed_size, stored);
     stat_cache_.emplace(std::move(file_name_key), std::move(entry));
 
   } while (unzGoToNextFile(unzipper.get()) == UNZ_OK);
@@ -6,9 +6,11 @@
 #define FLUTTER_ASSETS_ZIP_ASSET_STORE_H_
 
 #include <map>
+#include <memory>
 
 #include "flutter/assets/asset_resolver.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
 #include "third_party/zlib/contrib/minizip/unzip.h"
 
 namespace blink {
@@ -31,12 +33,21 @@ class ZipAssetStore final : public AssetResolver {
   struct CacheEntry {
     unz_file_pos file_pos;
     size_t uncompressed_size;
-    CacheEntry(unz_file_pos p_file_pos, size_t p_uncompressed_size)
-        : file_pos(p_file_pos), uncompressed_size(p_uncompressed_size) {}
+    // Whether the entry is stored without compression or encryption, in which
+    // case its data can be used in place.
+    bool stored;
+    CacheEntry(unz_file_pos p_file_pos,
+               size_t p_uncompressed_size,
+               bool p_stored)
+        : file_pos(p_file_pos),
+          uncompressed_size(p_uncompressed_size),
+          stored(p_stored) {}
   };
 
   std::string file_path_;
   mutable std::map<std::string, CacheEntry> stat_cache_;
+  // The whole archive mapped into memory. Null if it could not be mapped.
+  std::shared_ptr<fml::FileMapping> archive_mapping_;
 
   // |blink::AssetResolver|
   bool IsValid() const override;
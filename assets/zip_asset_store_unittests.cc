@@ -0,0 +1,101 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <string>
+
+#include "flutter/assets/zip_asset_store.h"
+#include "gtest/gtest.h"
+#include "lib/fxl/files/scoped_temp_dir.h"
+#include "third_party/zlib/contrib/minizip/zip.h"
+
+namespace blink {
+namespace {
+
+constexpr int kStored = 0;
+
+// Adds |contents| to |archive| as |name|, compressed with |method|. The local
+// header of the entry gets an extra field of |extra_field_size| bytes.
+void AddEntry(zipFile archive,
+              const std::string& name,
+              const std::string& contents,
+              int method,
+              size_t extra_field_size = 0) {
+  const std::string extra_field(extra_field_size, 'x');
+  zip_fileinfo info = {};
+  ASSERT_EQ(zipOpenNewFileInZip(archive, name.c_str(), &info,
+                                extra_field.data(), extra_field.size(),
+                                nullptr, 0, nullptr, method,
+                                method == kStored ? 0 : Z_DEFAULT_COMPRESSION),
+            ZIP_OK);
+  ASSERT_EQ(zipWriteInFileInZip(archive, contents.data(), contents.size()),
+            ZIP_OK);
+  ASSERT_EQ(zipCloseFileInZip(archive), ZIP_OK);
+}
+
+std::string ToString(const fml::Mapping& mapping) {
+  return std::string(reinterpret_cast<const char*>(mapping.GetMapping()),
+                     mapping.GetSize());
+}
+
+class ZipAssetStoreTest : public ::testing::Test {
+ protected:
+  const std::string stored_contents_ = std::string(10000, 's');
+  const std::string compressed_contents_ = std::string(10000, 'c');
+  std::unique_ptr<AssetResolver> store_;
+
+  void SetUp() override {
+    const std::string path = temp_dir_.path() + "/assets.zip";
+    zipFile archive = zipOpen(path.c_str(), APPEND_STATUS_CREATE);
+    ASSERT_NE(archive, nullptr);
+    AddEntry(archive, "compressed.txt", compressed_contents_, Z_DEFLATED);
+    AddEntry(archive, "stored.ttf", stored_contents_, kStored);
+    AddEntry(archive, "stored_with_extra_field.ttf", stored_contents_, kStored,
+             17);
+    ASSERT_EQ(zipClose(archive, nullptr), ZIP_OK);
+
+    store_ = std::make_unique<ZipAssetStore>(path);
+    ASSERT_TRUE(store_->IsValid());
+  }
+
+ private:
+  files::ScopedTempDir temp_dir_;
+};
+
+}  // namespace
+
+TEST_F(ZipAssetStoreTest, StoredEntriesAreMappedInPlace) {
+  for (const char* name : {"stored.ttf", "stored_with_extra_field.ttf"}) {
+    auto mapping1 = store_->GetAsMapping(name);
+    auto mapping2 = store_->GetAsMapping(name);
+    ASSERT_TRUE(mapping1);
+    ASSERT_TRUE(mapping2);
+    ASSERT_EQ(ToString(*mapping1), stored_contents_);
+    // Both are views of the mapped archive rather than copies.
+    ASSERT_EQ(mapping1->GetMapping(), mapping2->GetMapping());
+  }
+}
+
+TEST_F(ZipAssetStoreTest, CompressedEntriesAreInflated) {
+  auto mapping1 = store_->GetAsMapping("compressed.txt");
+  auto mapping2 = store_->GetAsMapping("compressed.txt");
+  ASSERT_TRUE(mapping1);
+  ASSERT_TRUE(mapping2);
+  ASSERT_EQ(ToString(*mapping1), compressed_contents_);
+  ASSERT_EQ(ToString(*mapping2), compressed_contents_);
+  ASSERT_NE(mapping1->GetMapping(), mapping2->GetMapping());
+}
+
+TEST_F(ZipAssetStoreTest, MissingEntriesAreNotFound) {
+  ASSERT_FALSE(store_->GetAsMapping("missing.ttf"));
+}
+
+TEST_F(ZipAssetStoreTest, MappingsOutliveTheStore) {
+  auto mapping = store_->GetAsMapping("stored.ttf");
+  ASSERT_TRUE(mapping);
+  store_.reset();
+  ASSERT_EQ(ToString(*mapping), stored_contents_);
+}
+
+}  // namespace blink
@@ -8,6 +8,14 @@
 
 namespace blink {
 
+static std::string ThreadConfigToString(const fml::Thread::Config& config) {
+  std::stringstream stream;
+  stream << "priority " << static_cast<int>(config.priority)
+         << ", cpu_affinity_mask 0x" << std::hex << config.cpu_affinity_mask
+         << std::dec << ", stack_size " << config.stack_size;
+  return stream.str();
+}
+
 std::string Settings::ToString() const {
   std::stringstream stream;
   stream << "Settings: " << std::endl;
@@ -39,8 +47,21 @@ std::string Settings::ToString() const {
   stream << "use_test_fonts: " << use_test_fonts << std::endl;
   stream << "enable_software_rendering: " << enable_software_rendering
          << std::endl;
+  stream << "enable_task_stats: " << enable_task_stats << std::endl;
+  stream << "shader_warmup_skp_path: " << shader_warmup_skp_path
+         << std::endl;
   stream << "log_tag: " << log_tag << std::endl;
   stream << "icu_data_path: " << icu_data_path << std::endl;
+  stream << "ui_thread_config: " << ThreadConfigToString(ui_thread_config)
+         << std::endl;
+  stream << "gpu_thread_config: " << ThreadConfigToString(gpu_thread_config)
+         << std::endl;
+  stream << "io_thread_config: " << ThreadConfigToString(io_thread_config)
+         << std::endl;
+  stream << "vulkan_prefer_low_latency_present_mode: "
+         << vulkan_prefer_low_latency_present_mode << std::endl;
+  stream << "vulkan_frames_in_flight: " << vulkan_frames_in_flight
+         << std::endl;
   stream << "assets_dir: " << assets_dir << std::endl;
   stream << "assets_path: " << assets_path << std::endl;
   return stream.str();
@@ -12,6 +12,7 @@
 #include <string>
 #include <vector>
 
+#include "flutter/fml/thread.h"
 #include "flutter/fml/unique_fd.h"
 #include "lib/fxl/functional/closure.h"
 
@@ -75,11 +76,36 @@ struct Settings {
   // call is made.
   fxl::Closure root_isolate_shutdown_callback;
   bool enable_software_rendering = false;
+  // Records how long the tasks of the threads of the shell wait and run, by
+  // the site they were posted from. Read with the _flutter.getTaskStats
+  // service protocol extension.
+  bool enable_task_stats = false;
+  // A picture captured with the screenshot SKP service extension. It is drawn
+  // offscreen once the GPU surface is set up so that the programs it needs
+  // are compiled (and stored in the GPU program cache) before the first
+  // frame.
+  std::string shader_warmup_skp_path;
   bool skia_deterministic_rendering_on_cpu = false;
   bool verbose_logging = false;
   std::string log_tag = "flutter";
   std::string icu_data_path;
 
+  // Thread settings
+  // Used for the threads the shell creates. Not used for task runners supplied
+  // by the embedder.
+  fml::Thread::Config ui_thread_config = {fml::Thread::Priority::kDisplay};
+  fml::Thread::Config gpu_thread_config = {fml::Thread::Priority::kRaster};
+  // Frames wait on the image decodes and uploads of the IO thread.
+  fml::Thread::Config io_thread_config = {fml::Thread::Priority::kNormal};
+
+  // Vulkan settings
+  // Present with mailbox or immediate presentation instead of FIFO if the
+  // surface supports it. Lowers latency at the cost of rendering frames that
+  // may never be shown.
+  bool vulkan_prefer_low_latency_present_mode = false;
+  // The number of frames the CPU may record ahead of the GPU.
+  size_t vulkan_frames_in_flight = 2;
+
   // Assets settings
   fml::UniqueFD::element_type assets_dir =
       fml::UniqueFD::traits_type::InvalidValue();
@@ -4,21 +4,179 @@
 
 #include "flutter/flow/layers/backdrop_filter_layer.h"
 
+#include <algorithm>
+
+#include "flutter/fml/hash.h"
 #include "third_party/skia/include/core/SkImageFilter.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/effects/SkBlurImageFilter.h"
 
 namespace flow {
 
+namespace {
+
+constexpr int kMaxDownsampleFactor = 8;
+
+// Below this sigma (in downsampled pixels) the downsampling becomes visible.
+constexpr SkScalar kMinDownsampledSigma = 2.0f;
+
+// Copying more of the surface than this costs more than the saveLayer the
+// downsampled blur replaces.
+constexpr float kMaxSnapshotSurfaceFraction = 0.5f;
+
+int DownsampleFactor(SkScalar sigma) {
+  int factor = 1;
+  while (factor < kMaxDownsampleFactor &&
+         sigma / (factor * 2) >= kMinDownsampledSigma) {
+    factor *= 2;
+  }
+  return factor;
+}
+
+// Blurs |src_rect| of |surface| at 1/|factor| of its resolution. Only
+// |src_rect| is copied out of |surface|.
+sk_sp<SkImage> BlurDownsampled(SkSurface* surface,
+                               const SkIRect& src_rect,
+                               const SkVector& sigma,
+                               int factor) {
+  TRACE_EVENT0("flutter", "BackdropFilterLayer::BlurDownsampled");
+  const SkImageInfo info = SkImageInfo::MakeN32Premul(
+      (src_rect.width() + factor - 1) / factor,
+      (src_rect.height() + factor - 1) / factor,
+      sk_ref_sp(surface->getCanvas()->imageInfo().colorSpace()));
+  sk_sp<SkSurface> downsampled = surface->makeSurface(info);
+  if (!downsampled) {
+    return nullptr;
+  }
+
+  SkCanvas* canvas = downsampled->getCanvas();
+  canvas->clear(SK_ColorTRANSPARENT);
+  SkPaint blur_paint;
+  blur_paint.setImageFilter(SkBlurImageFilter::Make(
+      sigma.x() / factor, sigma.y() / factor, nullptr, nullptr,
+      SkBlurImageFilter::kClamp_TileMode));
+  {
+    // The snapshot is released before anything else is drawn to |surface| so
+    // that the surface does not have to be copied on write.
+    sk_sp<SkImage> backdrop = surface->makeImageSnapshot(src_rect);
+    if (!backdrop) {
+      return nullptr;
+    }
+    canvas->saveLayer(nullptr, &blur_paint);
+    SkPaint paint;
+    paint.setFilterQuality(kLow_SkFilterQuality);
+    canvas->drawImageRect(backdrop, SkRect::Make(info.bounds()), &paint);
+    canvas->restore();
+  }
+  return downsampled->makeImageSnapshot();
+}
+
+}  // namespace
+
 BackdropFilterLayer::BackdropFilterLayer() = default;
 
 BackdropFilterLayer::~BackdropFilterLayer() = default;
 
+void BackdropFilterLayer::Preroll(PrerollContext* context,
+                                  const SkMatrix& matrix) {
+  // Everything prerolled so far is painted underneath this layer.
+  raster_cache_ = context->backdrop_signature ? context->raster_cache : nullptr;
+  backdrop_signature_ =
+      context->backdrop_signature ? *context->backdrop_signature : 0;
+  // Within a saveLayer the backdrop is not on the surface yet.
+  can_snapshot_backdrop_ = !context->in_save_layer;
+
+  AddToBackdropSignature(context, matrix);
+  AddToBackdropSignature(context, blur_sigma_);
+  if (blur_sigma_.isZero()) {
+    // Arbitrary filters cannot be compared across frames.
+    MarkBackdropVolatile(context);
+  }
+
+  ContainerLayer::Preroll(context, matrix);
+  set_reads_backdrop(true);
+}
+
 void BackdropFilterLayer::Paint(PaintContext& context) const {
   TRACE_EVENT0("flutter", "BackdropFilterLayer::Paint");
   FXL_DCHECK(needs_painting());
 
-  Layer::AutoSaveLayer(context, SkCanvas::SaveLayerRec{&paint_bounds(), nullptr,
-                                                       filter_.get(), 0});
-  PaintChildren(context);
+  if (PaintDownsampledBlur(context)) {
+    PaintChildren(context);
+    return;
+  }
+
+  Layer::AutoSaveLayer save(context, SkCanvas::SaveLayerRec{&paint_bounds(),
+                                                            nullptr,
+                                                            filter_.get(), 0});
+  // The backdrop of nested backdrop filters is in the layer, not on the
+  // surface.
+  PaintContext child_context = context;
+  child_context.in_save_layer = true;
+  PaintChildren(child_context);
+}
+
+bool BackdropFilterLayer::PaintDownsampledBlur(PaintContext& context) const {
+  SkCanvas& canvas = context.canvas;
+  SkSurface* surface = canvas.getSurface();
+  const SkMatrix& ctm = canvas.getTotalMatrix();
+  if (blur_sigma_.isZero() || !can_snapshot_backdrop_ ||
+      context.in_save_layer || !surface || !ctm.rectStaysRect()) {
+    return false;
+  }
+
+  // The sigma is specified in the local coordinate space.
+  SkVector device_sigma = blur_sigma_;
+  ctm.mapVectors(&device_sigma, 1);
+  device_sigma.set(SkScalarAbs(device_sigma.x()),
+                   SkScalarAbs(device_sigma.y()));
+  const int factor =
+      DownsampleFactor(std::min(device_sigma.x(), device_sigma.y()));
+  if (factor == 1) {
+    return false;
+  }
+
+  SkIRect device_rect = RasterCache::GetDeviceBounds(paint_bounds(), ctm);
+  // The blur samples up to three sigmas around the area it covers.
+  SkIRect src_rect = device_rect.makeOutset(
+      SkScalarCeilToInt(3 * device_sigma.x()),
+      SkScalarCeilToInt(3 * device_sigma.y()));
+  if (!device_rect.intersect(canvas.getDeviceClipBounds()) ||
+      !src_rect.intersect(SkIRect::MakeWH(surface->width(),
+                                          surface->height()))) {
+    return true;
+  }
+
+  // The blurred backdrop is reused for as long as nothing underneath it
+  // changes, e.g. while content scrolls on top of a frosted app bar.
+  uint64_t cache_key = 0;
+  sk_sp<SkImage> blurred;
+  if (raster_cache_) {
+    cache_key = fml::HashValue(backdrop_signature_, src_rect);
+    cache_key = fml::HashValue(cache_key, device_sigma);
+    blurred = raster_cache_->GetBackdropImage(cache_key);
+  }
+  if (!blurred) {
+    if (static_cast<float>(src_rect.width()) * src_rect.height() >
+        kMaxSnapshotSurfaceFraction * surface->width() * surface->height()) {
+      return false;
+    }
+    blurred = BlurDownsampled(surface, src_rect, device_sigma, factor);
+    if (!blurred) {
+      return false;
+    }
+    if (raster_cache_) {
+      raster_cache_->SetBackdropImage(cache_key, blurred);
+    }
+  }
+
+  SkAutoCanvasRestore save(&canvas, true);
+  canvas.resetMatrix();
+  canvas.clipRect(SkRect::Make(device_rect));
+  SkPaint paint;
+  paint.setFilterQuality(kLow_SkFilterQuality);
+  canvas.drawImageRect(blurred, SkRect::Make(src_rect), &paint);
+  return true;
 }
 
 }  // namespace flow
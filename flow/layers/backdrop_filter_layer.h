@@ -16,10 +16,25 @@ class BackdropFilterLayer : public ContainerLayer {
 
   void set_filter(sk_sp<SkImageFilter> filter) { filter_ = std::move(filter); }
 
+  // The sigma of |filter| if it is a plain Gaussian blur, zero otherwise.
+  // Large blurs are run on a downsampled copy of the backdrop.
+  void set_blur_sigma(const SkVector& blur_sigma) { blur_sigma_ = blur_sigma; }
+
+  void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
+
   void Paint(PaintContext& context) const override;
 
  private:
   sk_sp<SkImageFilter> filter_;
+  SkVector blur_sigma_ = SkVector::Make(0, 0);
+  // Whether the backdrop can be read back from the surface being painted to.
+  bool can_snapshot_backdrop_ = false;
+  // Used to reuse the blurred backdrop across frames. May be null.
+  RasterCache* raster_cache_ = nullptr;
+  uint64_t backdrop_signature_ = 0;
+
+  // Returns false if the backdrop must be filtered with a saveLayer instead.
+  bool PaintDownsampledBlur(PaintContext& context) const;
 
   FXL_DISALLOW_COPY_AND_ASSIGN(BackdropFilterLayer);
 };
@@ -0,0 +1,192 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/backdrop_filter_layer.h"
+#include "flutter/flow/layers/physical_shape_layer.h"
+#include "flutter/flow/raster_cache.h"
+#include "flutter/fml/hash.h"
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/effects/SkBlurImageFilter.h"
+
+namespace {
+
+const SkRect kScreen = SkRect::MakeWH(400, 400);
+const SkRect kBlurredRect = SkRect::MakeXYWH(150, 150, 100, 100);
+constexpr SkScalar kSigma = 16;
+
+// A layer that only reports paint bounds.
+class EmptyLayer : public flow::Layer {
+ public:
+  explicit EmptyLayer(const SkRect& bounds) : bounds_(bounds) {}
+
+  void Preroll(PrerollContext* context, const SkMatrix& matrix) override {
+    set_paint_bounds(bounds_);
+  }
+
+  void Paint(PaintContext& context) const override {}
+
+ private:
+  const SkRect bounds_;
+};
+
+std::unique_ptr<flow::BackdropFilterLayer> MakeBlur(SkScalar sigma) {
+  auto layer = std::make_unique<flow::BackdropFilterLayer>();
+  if (sigma > 0) {
+    layer->set_filter(SkBlurImageFilter::Make(sigma, sigma, nullptr));
+  }
+  layer->set_blur_sigma(SkVector::Make(sigma, sigma));
+  layer->Add(std::make_unique<EmptyLayer>(kBlurredRect));
+  return layer;
+}
+
+std::unique_ptr<flow::PhysicalShapeLayer> MakeShape(SkColor color) {
+  auto layer = std::make_unique<flow::PhysicalShapeLayer>(flow::Clip::none);
+  layer->set_path(SkPath().addRect(SkRect::MakeWH(100, 100)));
+  layer->set_elevation(0);
+  layer->set_color(color);
+  layer->set_shadow_color(SK_ColorBLACK);
+  layer->set_device_pixel_ratio(1.0f);
+  return layer;
+}
+
+uint64_t Preroll(flow::Layer* layer, flow::RasterCache* raster_cache) {
+  uint64_t signature = fml::kHashSeed;
+  flow::Layer::PrerollContext context = {
+      raster_cache,         // raster_cache
+      nullptr,              // gr_context
+      nullptr,              // dst_color_space
+      SkRect::MakeEmpty(),  // child_paint_bounds
+      kScreen,              // cull_rect
+      &signature,           // backdrop_signature
+      false,                // in_save_layer
+  };
+  layer->Preroll(&context, SkMatrix::I());
+  return signature;
+}
+
+void Paint(flow::Layer* layer, SkCanvas* canvas) {
+  const flow::Stopwatch unused_stopwatch;
+  flow::TextureRegistry unused_texture_registry;
+  flow::Layer::PaintContext paint_context = {
+      *canvas,                  // canvas
+      unused_stopwatch,         // frame time
+      unused_stopwatch,         // engine time
+      unused_texture_registry,  // texture registry
+      false,                    // checkerboard offscreen layers
+      false                     // in save layer
+  };
+  layer->Paint(paint_context);
+}
+
+// Red on the left half of the surface and blue on the right half.
+sk_sp<SkSurface> MakeBackdrop() {
+  sk_sp<SkSurface> surface = SkSurface::MakeRasterN32Premul(
+      kScreen.width(), kScreen.height());
+  SkPaint paint;
+  paint.setColor(SK_ColorRED);
+  surface->getCanvas()->drawRect(SkRect::MakeWH(200, 400), paint);
+  paint.setColor(SK_ColorBLUE);
+  surface->getCanvas()->drawRect(SkRect::MakeXYWH(200, 0, 200, 400), paint);
+  return surface;
+}
+
+SkColor GetPixel(SkSurface* surface, int x, int y) {
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(1, 1);
+  surface->readPixels(bitmap, x, y);
+  return bitmap.getColor(0, 0);
+}
+
+bool IsMixed(SkColor color) {
+  return SkColorGetR(color) > 0 && SkColorGetB(color) > 0;
+}
+
+}  // namespace
+
+TEST(BackdropFilterLayer, IdenticalTreesHaveTheSameSignature) {
+  flow::RasterCache raster_cache;
+  flow::ContainerLayer tree1;
+  tree1.Add(MakeShape(SK_ColorRED));
+  tree1.Add(MakeBlur(kSigma));
+  flow::ContainerLayer tree2;
+  tree2.Add(MakeShape(SK_ColorRED));
+  tree2.Add(MakeBlur(kSigma));
+  flow::ContainerLayer tree3;
+  tree3.Add(MakeShape(SK_ColorGREEN));
+  tree3.Add(MakeBlur(kSigma));
+
+  const uint64_t signature1 = Preroll(&tree1, &raster_cache);
+  ASSERT_EQ(Preroll(&tree1, &raster_cache), signature1);
+  ASSERT_EQ(Preroll(&tree2, &raster_cache), signature1);
+  ASSERT_NE(Preroll(&tree3, &raster_cache), signature1);
+}
+
+TEST(BackdropFilterLayer, ArbitraryFiltersMakeTheSignatureVolatile) {
+  flow::RasterCache raster_cache;
+  flow::ContainerLayer tree;
+  tree.Add(MakeBlur(0));
+  ASSERT_NE(Preroll(&tree, &raster_cache), Preroll(&tree, &raster_cache));
+
+  // Without a raster cache, signatures are not compared across frames.
+  ASSERT_EQ(Preroll(&tree, nullptr), Preroll(&tree, nullptr));
+}
+
+TEST(BackdropFilterLayer, DownsampledBlurBlursTheBackdrop) {
+  auto layer = MakeBlur(kSigma);
+  Preroll(layer.get(), nullptr);
+  sk_sp<SkSurface> surface = MakeBackdrop();
+  Paint(layer.get(), surface->getCanvas());
+
+  // The edge between the colors is blurred inside the layer only.
+  ASSERT_TRUE(IsMixed(GetPixel(surface.get(), 199, 200)));
+  ASSERT_TRUE(IsMixed(GetPixel(surface.get(), 200, 200)));
+  ASSERT_EQ(GetPixel(surface.get(), 199, 100), SK_ColorRED);
+  ASSERT_EQ(GetPixel(surface.get(), 200, 100), SK_ColorBLUE);
+}
+
+TEST(BackdropFilterLayer, BlurredBackdropIsReusedWhileTheSignatureHolds) {
+  flow::RasterCache raster_cache;
+  flow::ContainerLayer tree;
+  tree.Add(MakeBlur(kSigma));
+
+  Preroll(&tree, &raster_cache);
+  sk_sp<SkSurface> surface = MakeBackdrop();
+  Paint(&tree, surface->getCanvas());
+
+  // Nothing in the layer tree changed. So the cached blur is drawn even
+  // though the surface is now green underneath.
+  Preroll(&tree, &raster_cache);
+  surface->getCanvas()->clear(SK_ColorGREEN);
+  Paint(&tree, surface->getCanvas());
+  ASSERT_TRUE(IsMixed(GetPixel(surface.get(), 200, 200)));
+}
+
+TEST(BackdropFilterLayer, NestedBlurDoesNotReadTheSurfaceInASaveLayer) {
+  // The outer layer falls back to a saveLayer since it is not a plain blur.
+  // The backdrop of the inner layer is then the (empty) saveLayer, not the
+  // surface.
+  auto outer = std::make_unique<flow::BackdropFilterLayer>();
+  outer->Add(MakeBlur(kSigma));
+  Preroll(outer.get(), nullptr);
+  sk_sp<SkSurface> surface = MakeBackdrop();
+  Paint(outer.get(), surface->getCanvas());
+
+  ASSERT_EQ(GetPixel(surface.get(), 199, 200), SK_ColorRED);
+  ASSERT_EQ(GetPixel(surface.get(), 200, 200), SK_ColorBLUE);
+}
+
+TEST(BackdropFilterLayer, LargeBackdropsAreNotCopied) {
+  // The area the blur samples covers most of the surface. The saveLayer
+  // fallback still blurs it.
+  auto layer = std::make_unique<flow::BackdropFilterLayer>();
+  layer->set_filter(SkBlurImageFilter::Make(kSigma, kSigma, nullptr));
+  layer->set_blur_sigma(SkVector::Make(kSigma, kSigma));
+  layer->Add(std::make_unique<EmptyLayer>(kScreen));
+  Preroll(layer.get(), nullptr);
+  sk_sp<SkSurface> surface = MakeBackdrop();
+  Paint(layer.get(), surface->getCanvas());
+
+  ASSERT_TRUE(IsMixed(GetPixel(surface.get(), 200, 200)));
+}
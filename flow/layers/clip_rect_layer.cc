@@ -13,11 +13,29 @@ ClipRectLayer::~ClipRectLayer() = default;
 
 void ClipRectLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   SkRect child_paint_bounds = SkRect::MakeEmpty();
-  PrerollChildren(context, matrix, &child_paint_bounds);
+  SkRect child_opaque_bounds;
+  // The clip applies to everything the children paint.
+  AddToBackdropSignature(context, clip_rect_);
+  AddToBackdropSignature(context, matrix);
+  AddToBackdropSignature(context, clip_behavior_);
+
+  PrerollContext clipped_context =
+      ClipPrerollContext(*context, matrix, clip_rect_);
+  if (clip_behavior_ == Clip::antiAliasWithSaveLayer) {
+    clipped_context.in_save_layer = true;
+  }
+  PrerollChildren(&clipped_context, matrix, &child_paint_bounds,
+                  &child_opaque_bounds);
 
   if (child_paint_bounds.intersect(clip_rect_)) {
     set_paint_bounds(child_paint_bounds);
   }
+
+  if (!child_opaque_bounds.intersect(
+          GetOpaqueDeviceBounds(matrix, clip_rect_))) {
+    child_opaque_bounds.setEmpty();
+  }
+  set_opaque_device_bounds(child_opaque_bounds);
 }
 
 #if defined(OS_FUCHSIA)
@@ -13,7 +13,17 @@ ClipRRectLayer::~ClipRRectLayer() = default;
 
 void ClipRRectLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   SkRect child_paint_bounds = SkRect::MakeEmpty();
-  PrerollChildren(context, matrix, &child_paint_bounds);
+  // The clip applies to everything the children paint.
+  AddToBackdropSignature(context, clip_rrect_);
+  AddToBackdropSignature(context, matrix);
+  AddToBackdropSignature(context, clip_behavior_);
+
+  PrerollContext clipped_context =
+      ClipPrerollContext(*context, matrix, clip_rrect_.getBounds());
+  if (clip_behavior_ == Clip::antiAliasWithSaveLayer) {
+    clipped_context.in_save_layer = true;
+  }
+  PrerollChildren(&clipped_context, matrix, &child_paint_bounds);
 
   if (child_paint_bounds.intersect(clip_rrect_.getBounds())) {
     set_paint_bounds(child_paint_bounds);
@@ -10,6 +10,15 @@ ColorFilterLayer::ColorFilterLayer() = default;
 
 ColorFilterLayer::~ColorFilterLayer() = default;
 
+void ColorFilterLayer::Preroll(PrerollContext* context,
+                               const SkMatrix& matrix) {
+  AddToBackdropSignature(context, color_);
+  AddToBackdropSignature(context, blend_mode_);
+  PrerollContext child_context = *context;
+  child_context.in_save_layer = true;
+  ContainerLayer::Preroll(&child_context, matrix);
+}
+
 void ColorFilterLayer::Paint(PaintContext& context) const {
   TRACE_EVENT0("flutter", "ColorFilterLayer::Paint");
   FXL_DCHECK(needs_painting());
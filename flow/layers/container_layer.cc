@@ -15,6 +15,11 @@ void ContainerLayer::Add(std::unique_ptr<Layer> layer) {
   layers_.push_back(std::move(layer));
 }
 
+void ContainerLayer::set_arena(LayerArena* arena) {
+  FXL_DCHECK(layers_.empty());
+  layers_ = LayerList(LayerArenaAllocator<std::unique_ptr<Layer>>(arena));
+}
+
 void ContainerLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   TRACE_EVENT0("flutter", "ContainerLayer::Preroll");
 
@@ -25,16 +30,101 @@ void ContainerLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
 
 void ContainerLayer::PrerollChildren(PrerollContext* context,
                                      const SkMatrix& child_matrix,
-                                     SkRect* child_paint_bounds) {
+                                     SkRect* child_paint_bounds,
+                                     SkRect* child_opaque_bounds) {
+  if (child_opaque_bounds) {
+    child_opaque_bounds->setEmpty();
+  }
+
   for (auto& layer : layers_) {
+#if !defined(OS_FUCHSIA)
+    // Nothing is visible through an empty cull rect, e.g. within a clip that
+    // is entirely offscreen. On Fuchsia children may still have to be handed
+    // to the system compositor, which is only known once they are prerolled.
+    if (context->cull_rect.isEmpty()) {
+      layer->set_is_culled(true);
+      continue;
+    }
+#endif  // !defined(OS_FUCHSIA)
+
     PrerollContext child_context = *context;
     layer->Preroll(&child_context, child_matrix);
 
     if (layer->needs_system_composite()) {
       set_needs_system_composite(true);
     }
+    if (layer->reads_backdrop()) {
+      set_reads_backdrop(true);
+    }
     child_paint_bounds->join(layer->paint_bounds());
+
+    const SkRect device_bounds =
+        GetChildDeviceBounds(*context, child_matrix, *layer);
+    layer->set_is_culled(
+        !layer->needs_system_composite() &&
+        !SkRect::Intersects(device_bounds, context->cull_rect));
+  }
+
+  // Walk the children from front to back tracking the largest opaque rect
+  // painted so far. Only a single rect is tracked, which is enough to catch
+  // the common case of full screen routes stacked on top of each other.
+  SkRect occluder = SkRect::MakeEmpty();
+  bool after_backdrop_reader = false;
+  for (auto it = layers_.rbegin(); it != layers_.rend(); ++it) {
+    Layer* layer = it->get();
+    if (layer->is_culled()) {
+      continue;
+    }
+    const SkRect device_bounds =
+        GetChildDeviceBounds(*context, child_matrix, *layer);
+    layer->set_is_occluded(!layer->needs_system_composite() &&
+                           !occluder.isEmpty() &&
+                           occluder.contains(device_bounds));
+    if (layer->is_occluded()) {
+      continue;
+    }
+    if (layer->reads_backdrop()) {
+      // What this layer samples must be painted, and it may make the edges of
+      // earlier opaque content translucent.
+      occluder.setEmpty();
+      after_backdrop_reader = true;
+      continue;
+    }
+    const SkRect& opaque_bounds = layer->opaque_device_bounds();
+    if (opaque_bounds.width() * opaque_bounds.height() >
+        occluder.width() * occluder.height()) {
+      occluder = opaque_bounds;
+      if (!after_backdrop_reader && child_opaque_bounds) {
+        *child_opaque_bounds = occluder;
+      }
+    }
+  }
+}
+
+SkRect ContainerLayer::GetChildDeviceBounds(const PrerollContext& context,
+                                            const SkMatrix& child_matrix,
+                                            const Layer& layer) {
+  // What a backdrop reader paints is not limited to the bounds of its children
+  // but covers everything under it up to the nearest clip.
+  if (layer.reads_backdrop()) {
+    return context.cull_rect;
+  }
+  SkRect device_bounds;
+  child_matrix.mapRect(&device_bounds, layer.paint_bounds());
+  return device_bounds;
+}
+
+Layer::PrerollContext ContainerLayer::ClipPrerollContext(
+    const PrerollContext& context,
+    const SkMatrix& matrix,
+    const SkRect& clip_bounds) {
+  PrerollContext clipped_context = context;
+  SkRect device_clip_bounds;
+  matrix.mapRect(&device_clip_bounds, clip_bounds);
+  if (!clipped_context.cull_rect.intersect(device_clip_bounds)) {
+    clipped_context.cull_rect.setEmpty();
   }
+  return clipped_context;
 }
 
 void ContainerLayer::PaintChildren(PaintContext& context) const {
@@ -43,7 +133,13 @@ void ContainerLayer::PaintChildren(PaintContext& context) const {
   // Intentionally not tracing here as there should be no self-time
   // and the trace event on this common function has a small overhead.
   for (auto& layer : layers_) {
-    if (layer->needs_painting()) {
+    // The canvas tracks the accumulated clip in device space, so this skips
+    // layers that are offscreen or clipped out entirely. Backdrop readers are
+    // visible wherever the clip is, regardless of their paint bounds.
+    if (layer->needs_painting() && !layer->is_occluded() &&
+        !layer->is_culled() &&
+        (layer->reads_backdrop() ||
+         !context.canvas.quickReject(layer->paint_bounds()))) {
       layer->Paint(context);
     }
   }
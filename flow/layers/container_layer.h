@@ -15,28 +15,54 @@ class ContainerLayer : public Layer {
   ContainerLayer();
   ~ContainerLayer() override;
 
+  using LayerList = std::vector<std::unique_ptr<Layer>,
+                                LayerArenaAllocator<std::unique_ptr<Layer>>>;
+
   void Add(std::unique_ptr<Layer> layer);
 
+  // Allocates the list of child layers from |arena| instead of the heap. Must
+  // be called before any children are added.
+  void set_arena(LayerArena* arena);
+
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
 
 #if defined(OS_FUCHSIA)
   void UpdateScene(SceneUpdateContext& context) override;
 #endif  // defined(OS_FUCHSIA)
 
-  const std::vector<std::unique_ptr<Layer>>& layers() const { return layers_; }
+  const LayerList& layers() const { return layers_; }
 
  protected:
+  // Also marks the children that are occluded by opaque later siblings or
+  // outside the cull rect. Children are not prerolled at all if the cull rect
+  // is empty. If |child_opaque_bounds| is not null, it is set to the largest
+  // device space rect that the children are known to cover with opaque pixels.
   void PrerollChildren(PrerollContext* context,
                        const SkMatrix& child_matrix,
-                       SkRect* child_paint_bounds);
+                       SkRect* child_paint_bounds,
+                       SkRect* child_opaque_bounds = nullptr);
+  // Paints the children that are not occluded and intersect the clip of the
+  // canvas.
   void PaintChildren(PaintContext& context) const;
 
+  // The device space region a prerolled child may paint to. This is the cull
+  // rect for children that read the backdrop.
+  static SkRect GetChildDeviceBounds(const PrerollContext& context,
+                                     const SkMatrix& child_matrix,
+                                     const Layer& layer);
+
+  // Returns a copy of |context| with the cull rect further restricted to the
+  // device space bounds of a clip with the given local |clip_bounds|.
+  static PrerollContext ClipPrerollContext(const PrerollContext& context,
+                                           const SkMatrix& matrix,
+                                           const SkRect& clip_bounds);
+
 #if defined(OS_FUCHSIA)
   void UpdateSceneChildren(SceneUpdateContext& context);
 #endif  // defined(OS_FUCHSIA)
 
  private:
-  std::vector<std::unique_ptr<Layer>> layers_;
+  LayerList layers_;
 
   FXL_DISALLOW_COPY_AND_ASSIGN(ContainerLayer);
 };
@@ -0,0 +1,182 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/backdrop_filter_layer.h"
+#include "flutter/flow/layers/clip_rect_layer.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/physical_shape_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+
+namespace {
+
+const SkRect kScreen = SkRect::MakeWH(400, 800);
+
+std::unique_ptr<flow::PhysicalShapeLayer> MakeShape(const SkRect& rect,
+                                                    SkColor color) {
+  auto layer = std::make_unique<flow::PhysicalShapeLayer>(flow::Clip::none);
+  layer->set_path(SkPath().addRect(rect));
+  layer->set_elevation(0);
+  layer->set_color(color);
+  layer->set_shadow_color(SK_ColorBLACK);
+  layer->set_device_pixel_ratio(1.0f);
+  return layer;
+}
+
+class CountingLayer : public flow::Layer {
+ public:
+  CountingLayer(const SkRect& bounds, size_t& paint_count)
+      : bounds_(bounds), paint_count_(paint_count) {}
+
+  void Preroll(PrerollContext* context, const SkMatrix& matrix) override {
+    preroll_count_++;
+    set_paint_bounds(bounds_);
+  }
+
+  void Paint(PaintContext& context) const override { paint_count_++; }
+
+  size_t preroll_count() const { return preroll_count_; }
+
+ private:
+  const SkRect bounds_;
+  size_t& paint_count_;
+  size_t preroll_count_ = 0;
+};
+
+void Preroll(flow::Layer* layer) {
+  flow::Layer::PrerollContext context = {
+      nullptr,              // raster_cache
+      nullptr,              // gr_context
+      nullptr,              // dst_color_space
+      SkRect::MakeEmpty(),  // child_paint_bounds
+      kScreen,              // cull_rect
+      nullptr,              // backdrop_signature
+      false,                // in_save_layer
+  };
+  layer->Preroll(&context, SkMatrix::I());
+}
+
+}  // namespace
+
+TEST(ContainerLayer, OpaqueLaterSiblingOccludesEarlierOnes) {
+  flow::ContainerLayer root;
+  root.Add(MakeShape(SkRect::MakeXYWH(10, 10, 100, 100), SK_ColorRED));
+  root.Add(MakeShape(kScreen, SK_ColorBLUE));
+  Preroll(&root);
+
+  ASSERT_TRUE(root.layers()[0]->is_occluded());
+  ASSERT_FALSE(root.layers()[1]->is_occluded());
+  ASSERT_EQ(root.layers()[1]->opaque_device_bounds(), kScreen);
+}
+
+TEST(ContainerLayer, TranslucentSiblingsDoNotOcclude) {
+  flow::ContainerLayer root;
+  root.Add(MakeShape(SkRect::MakeXYWH(10, 10, 100, 100), SK_ColorRED));
+  root.Add(MakeShape(kScreen, SkColorSetA(SK_ColorBLUE, 0x80)));
+  Preroll(&root);
+
+  ASSERT_FALSE(root.layers()[0]->is_occluded());
+  ASSERT_TRUE(root.layers()[1]->opaque_device_bounds().isEmpty());
+}
+
+TEST(ContainerLayer, PartiallyCoveredSiblingsAreNotOccluded) {
+  flow::ContainerLayer root;
+  root.Add(MakeShape(SkRect::MakeXYWH(300, 10, 200, 100), SK_ColorRED));
+  root.Add(MakeShape(kScreen, SK_ColorBLUE));
+  Preroll(&root);
+
+  ASSERT_FALSE(root.layers()[0]->is_occluded());
+}
+
+TEST(ContainerLayer, BackdropReadersPreventOcclusion) {
+  flow::ContainerLayer root;
+  root.Add(MakeShape(SkRect::MakeXYWH(10, 10, 100, 100), SK_ColorRED));
+  auto backdrop = std::make_unique<flow::BackdropFilterLayer>();
+  backdrop->Add(MakeShape(SkRect::MakeXYWH(0, 0, 500, 900),
+                          SkColorSetA(SK_ColorGREEN, 0x80)));
+  root.Add(std::move(backdrop));
+  root.Add(MakeShape(kScreen, SK_ColorBLUE));
+  Preroll(&root);
+
+  ASSERT_FALSE(root.layers()[0]->is_occluded());
+  ASSERT_TRUE(root.layers()[1]->reads_backdrop());
+}
+
+TEST(ContainerLayer, LayersOutsideTheClipAreNotPainted) {
+  size_t paint_count = 0;
+  flow::TransformLayer root;
+  root.set_transform(SkMatrix::I());
+  root.Add(std::make_unique<CountingLayer>(SkRect::MakeXYWH(10, 10, 50, 50),
+                                           paint_count));
+  root.Add(std::make_unique<CountingLayer>(
+      SkRect::MakeXYWH(10, 2000, 50, 50), paint_count));
+  Preroll(&root);
+
+  SkPictureRecorder recorder;
+  SkCanvas* canvas = recorder.beginRecording(kScreen);
+  const flow::Stopwatch unused_stopwatch;
+  flow::TextureRegistry unused_texture_registry;
+  flow::Layer::PaintContext paint_context = {
+      *canvas,                  // canvas
+      unused_stopwatch,         // frame time
+      unused_stopwatch,         // engine time
+      unused_texture_registry,  // texture registry
+      false,                    // checkerboard offscreen layers
+      false                     // in save layer
+  };
+  root.Paint(paint_context);
+
+  ASSERT_EQ(paint_count, 1u);
+}
+
+TEST(ContainerLayer, LayersOutsideTheCullRectAreCulled) {
+  size_t paint_count = 0;
+  flow::ContainerLayer root;
+  root.Add(std::make_unique<CountingLayer>(SkRect::MakeXYWH(10, 10, 50, 50),
+                                           paint_count));
+  root.Add(std::make_unique<CountingLayer>(
+      SkRect::MakeXYWH(10, 2000, 50, 50), paint_count));
+  Preroll(&root);
+
+  ASSERT_FALSE(root.layers()[0]->is_culled());
+  ASSERT_TRUE(root.layers()[1]->is_culled());
+}
+
+TEST(ContainerLayer, LayersWithinOffscreenClipsAreNotPrerolled) {
+  size_t paint_count = 0;
+  auto clip = std::make_unique<flow::ClipRectLayer>(flow::Clip::hardEdge);
+  clip->set_clip_rect(SkRect::MakeXYWH(0, 1000, 400, 800));
+  auto child = std::make_unique<CountingLayer>(kScreen, paint_count);
+  CountingLayer* child_ptr = child.get();
+  clip->Add(std::move(child));
+
+  flow::ContainerLayer root;
+  root.Add(std::move(clip));
+  Preroll(&root);
+
+#if defined(OS_FUCHSIA)
+  ASSERT_EQ(child_ptr->preroll_count(), 1u);
+#else
+  ASSERT_EQ(child_ptr->preroll_count(), 0u);
+#endif  // defined(OS_FUCHSIA)
+  ASSERT_TRUE(child_ptr->is_culled());
+  ASSERT_TRUE(root.layers()[0]->is_culled());
+}
+
+TEST(ContainerLayer, BackdropReadersAreVisibleBeyondTheirChildren) {
+  size_t paint_count = 0;
+  flow::ContainerLayer root;
+  auto backdrop = std::make_unique<flow::BackdropFilterLayer>();
+  backdrop->Add(std::make_unique<CountingLayer>(
+      SkRect::MakeXYWH(10, 2000, 50, 50), paint_count));
+  root.Add(std::move(backdrop));
+  // Covers the children of the backdrop filter but not what it blurs.
+  root.Add(MakeShape(SkRect::MakeXYWH(0, 700, 400, 1400), SK_ColorBLUE));
+  Preroll(&root);
+
+  ASSERT_TRUE(root.layers()[0]->reads_backdrop());
+  ASSERT_FALSE(root.layers()[0]->is_culled());
+  ASSERT_FALSE(root.layers()[0]->is_occluded());
+}
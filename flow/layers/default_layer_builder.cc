@@ -28,7 +28,8 @@ namespace flow {
 
 static const SkRect kGiantRect = SkRect::MakeLTRB(-1E9F, -1E9F, 1E9F, 1E9F);
 
-DefaultLayerBuilder::DefaultLayerBuilder() {
+DefaultLayerBuilder::DefaultLayerBuilder()
+    : arena_(std::make_unique<flow::LayerArena>()) {
   cull_rects_.push(kGiantRect);
 }
 
@@ -44,7 +45,7 @@ void DefaultLayerBuilder::PushTransform(const SkMatrix& sk_matrix) {
   } else {
     cullRect = kGiantRect;
   }
-  auto layer = std::make_unique<flow::TransformLayer>();
+  auto layer = MakeLayer<flow::TransformLayer>();
   layer->set_transform(sk_matrix);
   PushLayer(std::move(layer), cullRect);
 }
@@ -55,7 +56,7 @@ void DefaultLayerBuilder::PushClipRect(const SkRect& clipRect,
   if (!cullRect.intersect(clipRect, cull_rects_.top())) {
     cullRect = SkRect::MakeEmpty();
   }
-  auto layer = std::make_unique<flow::ClipRectLayer>(clip_behavior);
+  auto layer = MakeLayer<flow::ClipRectLayer>(clip_behavior);
   layer->set_clip_rect(clipRect);
   PushLayer(std::move(layer), cullRect);
 }
@@ -66,7 +67,7 @@ void DefaultLayerBuilder::PushClipRoundedRect(const SkRRect& rrect,
   if (!cullRect.intersect(rrect.rect(), cull_rects_.top())) {
     cullRect = SkRect::MakeEmpty();
   }
-  auto layer = std::make_unique<flow::ClipRRectLayer>(clip_behavior);
+  auto layer = MakeLayer<flow::ClipRRectLayer>(clip_behavior);
   layer->set_clip_rrect(rrect);
   PushLayer(std::move(layer), cullRect);
 }
@@ -77,35 +78,37 @@ void DefaultLayerBuilder::PushClipPath(const SkPath& path, Clip clip_behavior) {
   if (!cullRect.intersect(path.getBounds(), cull_rects_.top())) {
     cullRect = SkRect::MakeEmpty();
   }
-  auto layer = std::make_unique<flow::ClipPathLayer>(clip_behavior);
+  auto layer = MakeLayer<flow::ClipPathLayer>(clip_behavior);
   layer->set_clip_path(path);
   PushLayer(std::move(layer), cullRect);
 }
 
 void DefaultLayerBuilder::PushOpacity(int alpha) {
-  auto layer = std::make_unique<flow::OpacityLayer>();
+  auto layer = MakeLayer<flow::OpacityLayer>();
   layer->set_alpha(alpha);
   PushLayer(std::move(layer), cull_rects_.top());
 }
 
 void DefaultLayerBuilder::PushColorFilter(SkColor color,
                                           SkBlendMode blend_mode) {
-  auto layer = std::make_unique<flow::ColorFilterLayer>();
+  auto layer = MakeLayer<flow::ColorFilterLayer>();
   layer->set_color(color);
   layer->set_blend_mode(blend_mode);
   PushLayer(std::move(layer), cull_rects_.top());
 }
 
-void DefaultLayerBuilder::PushBackdropFilter(sk_sp<SkImageFilter> filter) {
-  auto layer = std::make_unique<flow::BackdropFilterLayer>();
+void DefaultLayerBuilder::PushBackdropFilter(sk_sp<SkImageFilter> filter,
+                                             const SkVector& blur_sigma) {
+  auto layer = MakeLayer<flow::BackdropFilterLayer>();
   layer->set_filter(filter);
+  layer->set_blur_sigma(blur_sigma);
   PushLayer(std::move(layer), cull_rects_.top());
 }
 
 void DefaultLayerBuilder::PushShaderMask(sk_sp<SkShader> shader,
                                          const SkRect& rect,
                                          SkBlendMode blend_mode) {
-  auto layer = std::make_unique<flow::ShaderMaskLayer>();
+  auto layer = MakeLayer<flow::ShaderMaskLayer>();
   layer->set_shader(shader);
   layer->set_mask_rect(rect);
   layer->set_blend_mode(blend_mode);
@@ -122,7 +125,7 @@ void DefaultLayerBuilder::PushPhysicalShape(const SkPath& sk_path,
   if (!cullRect.intersect(sk_path.getBounds(), cull_rects_.top())) {
     cullRect = SkRect::MakeEmpty();
   }
-  auto layer = std::make_unique<flow::PhysicalShapeLayer>(clip_behavior);
+  auto layer = MakeLayer<flow::PhysicalShapeLayer>(clip_behavior);
   layer->set_path(sk_path);
   layer->set_elevation(elevation);
   layer->set_color(color);
@@ -136,15 +139,18 @@ void DefaultLayerBuilder::PushPerformanceOverlay(uint64_t enabled_options,
   if (!current_layer_) {
     return;
   }
-  auto layer = std::make_unique<flow::PerformanceOverlayLayer>(enabled_options);
+  auto layer = MakeLayer<flow::PerformanceOverlayLayer>(enabled_options);
   layer->set_paint_bounds(rect);
   current_layer_->Add(std::move(layer));
 }
 
-void DefaultLayerBuilder::PushPicture(const SkPoint& offset,
-                                      SkiaGPUObject<SkPicture> picture,
-                                      bool picture_is_complex,
-                                      bool picture_will_change) {
+void DefaultLayerBuilder::PushPicture(
+    const SkPoint& offset,
+    SkiaGPUObject<SkPicture> picture,
+    bool picture_is_complex,
+    bool picture_will_change,
+    bool picture_is_opaque,
+    std::shared_ptr<PictureContentHash> picture_content_hash) {
   if (!current_layer_) {
     return;
   }
@@ -153,11 +159,13 @@ void DefaultLayerBuilder::PushPicture(const SkPoint& offset,
   if (!SkRect::Intersects(pictureRect, cull_rects_.top())) {
     return;
   }
-  auto layer = std::make_unique<flow::PictureLayer>();
+  auto layer = MakeLayer<flow::PictureLayer>();
   layer->set_offset(offset);
   layer->set_picture(std::move(picture));
   layer->set_is_complex(picture_is_complex);
   layer->set_will_change(picture_will_change);
+  layer->set_is_opaque(picture_is_opaque);
+  layer->set_content_hash(std::move(picture_content_hash));
   current_layer_->Add(std::move(layer));
 }
 
@@ -167,7 +175,7 @@ void DefaultLayerBuilder::PushTexture(const SkPoint& offset,
   if (!current_layer_) {
     return;
   }
-  auto layer = std::make_unique<flow::TextureLayer>();
+  auto layer = MakeLayer<flow::TextureLayer>();
   layer->set_offset(offset);
   layer->set_size(size);
   layer->set_texture_id(texture_id);
@@ -188,7 +196,7 @@ void DefaultLayerBuilder::PushChildScene(
   if (!SkRect::Intersects(sceneRect, cull_rects_.top())) {
     return;
   }
-  auto layer = std::make_unique<flow::ChildSceneLayer>();
+  auto layer = MakeLayer<flow::ChildSceneLayer>();
   layer->set_offset(offset);
   layer->set_size(size);
   layer->set_export_node_holder(std::move(export_token_holder));
@@ -209,10 +217,15 @@ std::unique_ptr<flow::Layer> DefaultLayerBuilder::TakeLayer() {
   return std::move(root_layer_);
 }
 
+std::unique_ptr<flow::LayerArena> DefaultLayerBuilder::TakeArena() {
+  return std::move(arena_);
+}
+
 void DefaultLayerBuilder::PushLayer(std::unique_ptr<flow::ContainerLayer> layer,
                                     const SkRect& cullRect) {
   FXL_DCHECK(layer);
 
+  layer->set_arena(arena_.get());
   cull_rects_.push(cullRect);
 
   if (!root_layer_) {
@@ -6,8 +6,10 @@
 #define FLUTTER_FLOW_LAYERS_DEFAULT_LAYER_BUILDER_H_
 
 #include <stack>
+#include <utility>
 
 #include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/layer_arena.h"
 #include "flutter/flow/layers/layer_builder.h"
 #include "garnet/public/lib/fxl/macros.h"
 
@@ -42,7 +44,8 @@ class DefaultLayerBuilder final : public LayerBuilder {
   void PushColorFilter(SkColor color, SkBlendMode blend_mode) override;
 
   // |flow::LayerBuilder|
-  void PushBackdropFilter(sk_sp<SkImageFilter> filter) override;
+  void PushBackdropFilter(sk_sp<SkImageFilter> filter,
+                          const SkVector& blur_sigma) override;
 
   // |flow::LayerBuilder|
   void PushShaderMask(sk_sp<SkShader> shader,
@@ -62,10 +65,13 @@ class DefaultLayerBuilder final : public LayerBuilder {
                               const SkRect& rect) override;
 
   // |flow::LayerBuilder|
-  void PushPicture(const SkPoint& offset,
-                   SkiaGPUObject<SkPicture> picture,
-                   bool picture_is_complex,
-                   bool picture_will_change) override;
+  void PushPicture(
+      const SkPoint& offset,
+      SkiaGPUObject<SkPicture> picture,
+      bool picture_is_complex,
+      bool picture_will_change,
+      bool picture_is_opaque,
+      std::shared_ptr<PictureContentHash> picture_content_hash) override;
 
   // |flow::LayerBuilder|
   void PushTexture(const SkPoint& offset,
@@ -86,12 +92,24 @@ class DefaultLayerBuilder final : public LayerBuilder {
   // |flow::LayerBuilder|
   std::unique_ptr<flow::Layer> TakeLayer() override;
 
+  // |flow::LayerBuilder|
+  std::unique_ptr<flow::LayerArena> TakeArena() override;
+
  private:
+  // Must outlive (and hence be declared before) all the layers allocated from
+  // it.
+  std::unique_ptr<flow::LayerArena> arena_;
   std::unique_ptr<flow::ContainerLayer> root_layer_;
   flow::ContainerLayer* current_layer_ = nullptr;
 
   std::stack<SkRect> cull_rects_;
 
+  template <class LayerType, class... Args>
+  std::unique_ptr<LayerType> MakeLayer(Args&&... args) {
+    return std::unique_ptr<LayerType>(
+        new (arena_.get()) LayerType(std::forward<Args>(args)...));
+  }
+
   void PushLayer(std::unique_ptr<flow::ContainerLayer> layer,
                  const SkRect& cullRect);
 
@@ -4,6 +4,9 @@
 
 #include "flutter/flow/layers/layer.h"
 
+#include <cstddef>
+#include <new>
+
 #include "flutter/flow/paint_utils.h"
 #include "third_party/skia/include/core/SkColorFilter.h"
 
@@ -12,11 +15,101 @@ namespace flow {
 Layer::Layer()
     : parent_(nullptr),
       needs_system_composite_(false),
-      paint_bounds_(SkRect::MakeEmpty()) {}
+      is_occluded_(false),
+      is_culled_(false),
+      reads_backdrop_(false),
+      paint_bounds_(SkRect::MakeEmpty()),
+      opaque_device_bounds_(SkRect::MakeEmpty()) {}
 
 Layer::~Layer() = default;
 
-void Layer::Preroll(PrerollContext* context, const SkMatrix& matrix) {}
+SkRect Layer::GetOpaqueDeviceBounds(const SkMatrix& matrix,
+                                    const SkRect& local_rect) {
+  if (local_rect.isEmpty() || !matrix.rectStaysRect()) {
+    return SkRect::MakeEmpty();
+  }
+  SkRect device_rect;
+  matrix.mapRect(&device_rect, local_rect);
+  // Keep the rect within the range of integer pixel coordinates.
+  const SkScalar kLimit = 1 << 24;
+  if (!device_rect.intersect(
+          SkRect::MakeLTRB(-kLimit, -kLimit, kLimit, kLimit))) {
+    return SkRect::MakeEmpty();
+  }
+  SkIRect pixels;
+  device_rect.roundIn(&pixels);
+  return SkRect::Make(pixels);
+}
+
+namespace {
+
+// Every layer allocation is prefixed with a header that records the arena it
+// was carved out of (if any). This lets |operator delete| tell heap
+// allocations apart from arena allocations.
+struct alignas(std::max_align_t) LayerAllocationHeader {
+  LayerArena* arena;
+};
+
+}  // namespace
+
+void* Layer::operator new(size_t size) {
+  return Layer::operator new(size, nullptr);
+}
+
+void* Layer::operator new(size_t size, LayerArena* arena) {
+  const size_t allocation_size = sizeof(LayerAllocationHeader) + size;
+  void* allocation =
+      arena ? arena->Allocate(allocation_size, alignof(LayerAllocationHeader))
+            : ::operator new(allocation_size);
+  auto header = new (allocation) LayerAllocationHeader{arena};
+  return header + 1;
+}
+
+void Layer::operator delete(void* pointer) {
+  if (pointer == nullptr) {
+    return;
+  }
+  auto header = static_cast<LayerAllocationHeader*>(pointer) - 1;
+  if (header->arena == nullptr) {
+    ::operator delete(header);
+  }
+  // Arena allocations are reclaimed when the arena itself is collected.
+}
+
+void Layer::operator delete(void* pointer, LayerArena* arena) {
+  Layer::operator delete(pointer);
+}
+
+void Layer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
+  // Nothing is known about what the layer paints.
+  MarkBackdropVolatile(context);
+}
+
+void Layer::AddToBackdropSignature(PrerollContext* context,
+                                   const SkMatrix& matrix) {
+  SkScalar values[9];
+  matrix.get9(values);
+  AddToBackdropSignature(context, values);
+}
+
+void Layer::AddToBackdropSignature(PrerollContext* context,
+                                   const SkPath& path) {
+  if (!context->backdrop_signature) {
+    return;
+  }
+  std::vector<uint8_t> data(path.writeToMemory(nullptr));
+  path.writeToMemory(data.data());
+  *context->backdrop_signature = fml::HashBytes(
+      *context->backdrop_signature, data.data(), data.size());
+}
+
+void Layer::MarkBackdropVolatile(PrerollContext* context) {
+  // Signatures are only compared across frames by the raster cache.
+  if (context->raster_cache) {
+    AddToBackdropSignature(context,
+                           context->raster_cache->NextVolatileBackdropId());
+  }
+}
 
 #if defined(OS_FUCHSIA)
 void Layer::UpdateScene(SceneUpdateContext& context) {}
@@ -9,8 +9,10 @@
 #include <vector>
 
 #include "flutter/flow/instrumentation.h"
+#include "flutter/flow/layers/layer_arena.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/flow/texture.h"
+#include "flutter/fml/hash.h"
 #include "flutter/fml/trace_event.h"
 #include "lib/fxl/build_config.h"
 #include "lib/fxl/logging.h"
@@ -46,11 +48,29 @@ class Layer {
   Layer();
   virtual ~Layer();
 
+  // Layers may be allocated from the |LayerArena| of the tree they belong to
+  // using |new (arena) SomeLayer(...)|. Such layers are still owned and
+  // destroyed via |std::unique_ptr<Layer>| but their memory is only reclaimed
+  // when the arena is collected. A null arena allocates from the heap.
+  static void* operator new(size_t size);
+  static void* operator new(size_t size, LayerArena* arena);
+  static void operator delete(void* pointer);
+  static void operator delete(void* pointer, LayerArena* arena);
+
   struct PrerollContext {
     RasterCache* raster_cache;
     GrContext* gr_context;
     SkColorSpace* dst_color_space;
     SkRect child_paint_bounds;
+    // The accumulated clip in device space. Content outside it is not visible
+    // on screen.
+    SkRect cull_rect;
+    // A fingerprint of everything prerolled so far, in paint order. Layers
+    // that read the backdrop use it to tell whether the content underneath
+    // them changed since the last frame. May be null.
+    uint64_t* backdrop_signature;
+    // Whether painting happens within a saveLayer of an ancestor.
+    bool in_save_layer;
   };
 
   virtual void Preroll(PrerollContext* context, const SkMatrix& matrix);
@@ -61,6 +81,10 @@ class Layer {
     const Stopwatch& engine_time;
     TextureRegistry& texture_registry;
     const bool checkerboard_offscreen_layers;
+    // Whether painting happens within a saveLayer that was only decided on
+    // during Paint. See |PrerollContext::in_save_layer| for those decided on
+    // during Preroll.
+    bool in_save_layer;
   };
 
   // Calls SkCanvas::saveLayer and restores the layer upon destruction. Also
@@ -107,10 +131,65 @@ class Layer {
 
   bool needs_painting() const { return !paint_bounds_.isEmpty(); }
 
+  // The device space region this layer is guaranteed to cover with opaque
+  // pixels once painted, or empty. Computed during Preroll.
+  const SkRect& opaque_device_bounds() const { return opaque_device_bounds_; }
+  void set_opaque_device_bounds(const SkRect& bounds) {
+    opaque_device_bounds_ = bounds;
+  }
+
+  // Set by the parent during Preroll if this layer is entirely covered by an
+  // opaque later sibling. Occluded layers are not painted.
+  bool is_occluded() const { return is_occluded_; }
+  void set_is_occluded(bool value) { is_occluded_ = value; }
+
+  // Set by the parent during Preroll if this layer is entirely outside the
+  // cull rect. Culled layers are not painted.
+  bool is_culled() const { return is_culled_; }
+  void set_is_culled(bool value) { is_culled_ = value; }
+
+  // Whether painting this layer samples what was painted before it (e.g. a
+  // backdrop filter). Such layers prevent earlier siblings from being culled.
+  bool reads_backdrop() const { return reads_backdrop_; }
+  void set_reads_backdrop(bool value) { reads_backdrop_ = value; }
+
+ protected:
+  // Mixes |value| into the backdrop signature of |context|. See
+  // |PrerollContext::backdrop_signature|.
+  template <class T>
+  static void AddToBackdropSignature(PrerollContext* context, const T& value) {
+    if (context->backdrop_signature) {
+      *context->backdrop_signature =
+          fml::HashValue(*context->backdrop_signature, value);
+    }
+  }
+
+  // Matrices and paths are mixed in by value rather than by representation
+  // since their representations contain lazily computed state.
+  static void AddToBackdropSignature(PrerollContext* context,
+                                     const SkMatrix& matrix);
+  static void AddToBackdropSignature(PrerollContext* context,
+                                     const SkPath& path);
+
+  // For layers whose content may change without any of their properties
+  // changing (e.g. textures). Ensures that the backdrop signature differs from
+  // that of every other frame.
+  static void MarkBackdropVolatile(PrerollContext* context);
+
+  // Maps the opaque |local_rect| to device space. The result is rounded in to
+  // whole pixels since anti-aliased edges are not opaque. Returns an empty
+  // rect if |matrix| does not map rects to rects.
+  static SkRect GetOpaqueDeviceBounds(const SkMatrix& matrix,
+                                      const SkRect& local_rect);
+
  private:
   ContainerLayer* parent_;
   bool needs_system_composite_;
+  bool is_occluded_;
+  bool is_culled_;
+  bool reads_backdrop_;
   SkRect paint_bounds_;
+  SkRect opaque_device_bounds_;
 
   FXL_DISALLOW_COPY_AND_ASSIGN(Layer);
 };
@@ -0,0 +1,62 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/layer_arena.h"
+
+#include <algorithm>
+
+#include "lib/fxl/logging.h"
+
+namespace flow {
+
+static inline uintptr_t AlignUp(uintptr_t value, size_t alignment) {
+  return (value + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+}
+
+LayerArena::LayerArena(size_t block_size) : block_size_(block_size) {
+  FXL_DCHECK(block_size_ > 0);
+}
+
+LayerArena::~LayerArena() = default;
+
+void* LayerArena::AllocateFromBlock(Block& block,
+                                    size_t size,
+                                    size_t alignment) {
+  const uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+  const uintptr_t start = AlignUp(base + block.used, alignment);
+  if (start + size > base + block.size) {
+    return nullptr;
+  }
+  block.used = start + size - base;
+  bytes_allocated_ += size;
+  return reinterpret_cast<void*>(start);
+}
+
+void* LayerArena::Allocate(size_t size, size_t alignment) {
+  FXL_DCHECK(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+  if (size == 0) {
+    size = 1;
+  }
+
+  if (!blocks_.empty()) {
+    if (void* allocation = AllocateFromBlock(blocks_.back(), size, alignment)) {
+      return allocation;
+    }
+  }
+
+  // The current block is exhausted (or this is the first allocation). Objects
+  // larger than the block size get a dedicated block of their own.
+  Block block;
+  block.size = std::max(block_size_, size + alignment);
+  block.data.reset(new uint8_t[block.size]);
+  bytes_reserved_ += block.size;
+  blocks_.emplace_back(std::move(block));
+
+  void* allocation = AllocateFromBlock(blocks_.back(), size, alignment);
+  FXL_DCHECK(allocation != nullptr);
+  return allocation;
+}
+
+}  // namespace flow
@@ -0,0 +1,117 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_LAYERS_LAYER_ARENA_H_
+#define FLUTTER_FLOW_LAYERS_LAYER_ARENA_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "lib/fxl/macros.h"
+
+namespace flow {
+
+// A bump allocator for the layers of a single layer tree. Layers (and the
+// lists of children of container layers) are carved out of a small number of
+// contiguous blocks as the tree is built on the UI thread. Deallocation of
+// individual objects is a no-op. Instead, all blocks are released in one shot
+// when the arena is collected along with the |LayerTree| that owns it.
+//
+// The arena is not thread safe. It is only ever used by one thread at a time.
+class LayerArena {
+ public:
+  static constexpr size_t kDefaultBlockSize = 16 * 1024;
+
+  explicit LayerArena(size_t block_size = kDefaultBlockSize);
+
+  ~LayerArena();
+
+  // |alignment| must be a power of two.
+  void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+  size_t block_count() const { return blocks_.size(); }
+
+  // The total number of bytes handed out by |Allocate|.
+  size_t bytes_allocated() const { return bytes_allocated_; }
+
+  // The total number of bytes held by the blocks of this arena.
+  size_t bytes_reserved() const { return bytes_reserved_; }
+
+ private:
+  struct Block {
+    std::unique_ptr<uint8_t[]> data;
+    size_t size = 0;
+    size_t used = 0;
+  };
+
+  const size_t block_size_;
+  std::vector<Block> blocks_;
+  size_t bytes_allocated_ = 0;
+  size_t bytes_reserved_ = 0;
+
+  void* AllocateFromBlock(Block& block, size_t size, size_t alignment);
+
+  FXL_DISALLOW_COPY_AND_ASSIGN(LayerArena);
+};
+
+// A standard library compatible allocator that allocates from a layer arena.
+// A default constructed allocator (or one without an arena) falls back to the
+// heap so that containers using it work the same on layers that were not
+// allocated from an arena.
+template <class T>
+class LayerArenaAllocator {
+ public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  LayerArenaAllocator() = default;
+
+  explicit LayerArenaAllocator(LayerArena* arena) : arena_(arena) {}
+
+  template <class U>
+  LayerArenaAllocator(const LayerArenaAllocator<U>& other)
+      : arena_(other.arena()) {}
+
+  T* allocate(size_t count) {
+    if (arena_ == nullptr) {
+      return static_cast<T*>(::operator new(count * sizeof(T)));
+    }
+    return static_cast<T*>(arena_->Allocate(count * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* pointer, size_t count) {
+    if (arena_ == nullptr) {
+      ::operator delete(pointer);
+    }
+    // Arena allocations are reclaimed when the arena itself is collected.
+  }
+
+  LayerArena* arena() const { return arena_; }
+
+ private:
+  LayerArena* arena_ = nullptr;
+};
+
+template <class T, class U>
+bool operator==(const LayerArenaAllocator<T>& lhs,
+                const LayerArenaAllocator<U>& rhs) {
+  return lhs.arena() == rhs.arena();
+}
+
+template <class T, class U>
+bool operator!=(const LayerArenaAllocator<T>& lhs,
+                const LayerArenaAllocator<U>& rhs) {
+  return !(lhs == rhs);
+}
+
+}  // namespace flow
+
+#endif  // FLUTTER_FLOW_LAYERS_LAYER_ARENA_H_
@@ -0,0 +1,84 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/layer_arena.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/layer_tree.h"
+#include "flutter/flow/layers/opacity_layer.h"
+#include "gtest/gtest.h"
+
+TEST(LayerArena, AllocationsAreAligned) {
+  flow::LayerArena arena(64);
+  for (size_t alignment = 1; alignment <= 32; alignment <<= 1) {
+    void* allocation = arena.Allocate(3, alignment);
+    ASSERT_NE(allocation, nullptr);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(allocation) % alignment, 0u);
+  }
+}
+
+TEST(LayerArena, AllocationsShareBlocks) {
+  flow::LayerArena arena(1024);
+  for (size_t i = 0; i < 16; i++) {
+    arena.Allocate(32);
+  }
+  ASSERT_EQ(arena.block_count(), 1u);
+  ASSERT_EQ(arena.bytes_allocated(), 16u * 32u);
+}
+
+TEST(LayerArena, LargeAllocationsGetTheirOwnBlock) {
+  flow::LayerArena arena(128);
+  void* allocation = arena.Allocate(1024);
+  ASSERT_NE(allocation, nullptr);
+  ASSERT_EQ(arena.block_count(), 1u);
+  ASSERT_GE(arena.bytes_reserved(), 1024u);
+}
+
+namespace {
+
+class CountingLayer : public flow::ContainerLayer {
+ public:
+  explicit CountingLayer(size_t& live_count) : live_count_(live_count) {
+    live_count_++;
+  }
+
+  ~CountingLayer() override { live_count_--; }
+
+  void Paint(PaintContext& context) const override {}
+
+ private:
+  size_t& live_count_;
+};
+
+}  // namespace
+
+TEST(LayerArena, LayersAreDestroyedBeforeTheArena) {
+  size_t live_count = 0;
+  {
+    auto arena = std::make_unique<flow::LayerArena>();
+    flow::LayerArena* raw_arena = arena.get();
+
+    std::unique_ptr<CountingLayer> root(new (raw_arena)
+                                            CountingLayer(live_count));
+    root->set_arena(raw_arena);
+    for (size_t i = 0; i < 100; i++) {
+      root->Add(std::unique_ptr<flow::Layer>(
+          new (raw_arena) CountingLayer(live_count)));
+    }
+    ASSERT_EQ(live_count, 101u);
+    ASSERT_EQ(root->layers().size(), 100u);
+    ASSERT_EQ(root->layers().get_allocator().arena(), raw_arena);
+
+    flow::LayerTree tree;
+    tree.set_root_layer(std::move(root), std::move(arena));
+    ASSERT_EQ(tree.arena(), raw_arena);
+  }
+  ASSERT_EQ(live_count, 0u);
+}
+
+TEST(LayerArena, HeapLayersAreStillSupported) {
+  auto layer = std::make_unique<flow::OpacityLayer>();
+  layer->Add(std::make_unique<flow::OpacityLayer>());
+  ASSERT_EQ(layer->layers().size(), 1u);
+  ASSERT_EQ(layer->layers().get_allocator().arena(), nullptr);
+}
@@ -8,6 +8,8 @@
 #include <memory>
 
 #include "flutter/flow/layers/layer.h"
+#include "flutter/flow/layers/layer_arena.h"
+#include "flutter/flow/picture_content_hash.h"
 #include "flutter/flow/skia_gpu_object.h"
 #include "garnet/public/lib/fxl/macros.h"
 #include "third_party/skia/include/core/SkBlendMode.h"
@@ -45,7 +47,10 @@ class LayerBuilder {
 
   virtual void PushColorFilter(SkColor color, SkBlendMode blend_mode) = 0;
 
-  virtual void PushBackdropFilter(sk_sp<SkImageFilter> filter) = 0;
+  // |blur_sigma| is the sigma of |filter| if it is a plain Gaussian blur and
+  // zero otherwise.
+  virtual void PushBackdropFilter(sk_sp<SkImageFilter> filter,
+                                  const SkVector& blur_sigma) = 0;
 
   virtual void PushShaderMask(sk_sp<SkShader> shader,
                               const SkRect& rect,
@@ -61,10 +66,13 @@ class LayerBuilder {
   virtual void PushPerformanceOverlay(uint64_t enabled_options,
                                       const SkRect& rect) = 0;
 
-  virtual void PushPicture(const SkPoint& offset,
-                           SkiaGPUObject<SkPicture> picture,
-                           bool picture_is_complex,
-                           bool picture_will_change) = 0;
+  virtual void PushPicture(
+      const SkPoint& offset,
+      SkiaGPUObject<SkPicture> picture,
+      bool picture_is_complex,
+      bool picture_will_change,
+      bool picture_is_opaque,
+      std::shared_ptr<PictureContentHash> picture_content_hash) = 0;
 
   virtual void PushTexture(const SkPoint& offset,
                            const SkSize& size,
@@ -82,6 +90,10 @@ class LayerBuilder {
 
   virtual std::unique_ptr<flow::Layer> TakeLayer() = 0;
 
+  // The arena the layers returned by |TakeLayer| were allocated from (if
+  // any). It must outlive those layers.
+  virtual std::unique_ptr<flow::LayerArena> TakeArena() = 0;
+
   int GetRasterizerTracingThreshold() const;
 
   bool GetCheckerboardRasterCacheImages() const;
@@ -5,6 +5,7 @@
 #include "flutter/flow/layers/layer_tree.h"
 
 #include "flutter/flow/layers/layer.h"
+#include "flutter/fml/hash.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
 
@@ -25,11 +26,15 @@ void LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
       frame.canvas() ? frame.canvas()->imageInfo().colorSpace() : nullptr;
   frame.context().raster_cache().SetCheckboardCacheImages(
       checkerboard_raster_cache_images_);
+  uint64_t backdrop_signature = fml::kHashSeed;
   Layer::PrerollContext context = {
       ignore_raster_cache ? nullptr : &frame.context().raster_cache(),
       frame.gr_context(),
       color_space,
       SkRect::MakeEmpty(),
+      SkRect::Make(frame_size_),
+      &backdrop_signature,
+      false,
   };
 
   root_layer_->Preroll(&context, SkMatrix::I());
@@ -67,7 +72,8 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame) const {
       frame.context().frame_time(),        //
       frame.context().engine_time(),       //
       frame.context().texture_registry(),  //
-      checkerboard_offscreen_layers_       //
+      checkerboard_offscreen_layers_,      //
+      false                                //
   };
 
   if (root_layer_->needs_painting())
@@ -89,6 +95,9 @@ sk_sp<SkPicture> LayerTree::Flatten(const SkRect& bounds) {
       nullptr,              // gr_context  (used for the raster cache)
       nullptr,              // SkColorSpace* dst_color_space
       SkRect::MakeEmpty(),  // SkRect child_paint_bounds
+      bounds,               // SkRect cull_rect
+      nullptr,              // uint64_t* backdrop_signature
+      false,                // bool in_save_layer
   };
 
   const Stopwatch unused_stopwatch;
@@ -99,7 +108,8 @@ sk_sp<SkPicture> LayerTree::Flatten(const SkRect& bounds) {
       unused_stopwatch,         // frame time (dont care)
       unused_stopwatch,         // engine time (dont care)
       unused_texture_registry,  // texture registry (not supported)
-      false                     // checkerboard offscreen layers
+      false,                    // checkerboard offscreen layers
+      false                     // in save layer
   };
 
   // Even if we don't have a root layer, we still need to create an empty
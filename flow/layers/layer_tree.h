@@ -11,6 +11,7 @@
 
 #include "flutter/flow/compositor_context.h"
 #include "flutter/flow/layers/layer.h"
+#include "flutter/flow/layers/layer_arena.h"
 #include "lib/fxl/macros.h"
 #include "lib/fxl/time/time_delta.h"
 #include "third_party/skia/include/core/SkPicture.h"
@@ -38,10 +39,17 @@ class LayerTree {
 
   Layer* root_layer() const { return root_layer_.get(); }
 
-  void set_root_layer(std::unique_ptr<Layer> root_layer) {
+  // If the layers of |root_layer| were allocated from an arena, that arena
+  // must be passed along so that it is released with the layers.
+  void set_root_layer(std::unique_ptr<Layer> root_layer,
+                      std::unique_ptr<LayerArena> arena = nullptr) {
+    // Collect the previous layers before the arena they may live in.
     root_layer_ = std::move(root_layer);
+    arena_ = std::move(arena);
   }
 
+  const LayerArena* arena() const { return arena_.get(); }
+
   const SkISize& frame_size() const { return frame_size_; }
 
   void set_frame_size(const SkISize& frame_size) { frame_size_ = frame_size; }
@@ -73,6 +81,8 @@ class LayerTree {
 
  private:
   SkISize frame_size_;  // Physical pixels.
+  // Must be declared before the root layer so that it is destroyed after it.
+  std::unique_ptr<LayerArena> arena_;
   std::unique_ptr<Layer> root_layer_;
   fxl::TimeDelta construction_time_;
   uint32_t rasterizer_tracing_threshold_;
@@ -10,6 +10,13 @@ OpacityLayer::OpacityLayer() = default;
 
 OpacityLayer::~OpacityLayer() = default;
 
+void OpacityLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
+  AddToBackdropSignature(context, alpha_);
+  PrerollContext child_context = *context;
+  child_context.in_save_layer = true;
+  ContainerLayer::Preroll(&child_context, matrix);
+}
+
 void OpacityLayer::Paint(PaintContext& context) const {
   TRACE_EVENT0("flutter", "OpacityLayer::Paint");
   FXL_DCHECK(needs_painting());
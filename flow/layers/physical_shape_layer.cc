@@ -4,11 +4,46 @@
 
 #include "flutter/flow/layers/physical_shape_layer.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "flutter/flow/paint_utils.h"
+#include "flutter/fml/hash.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
 #include "third_party/skia/include/utils/SkShadowUtils.h"
 
 namespace flow {
 
+namespace {
+
+const SkScalar kAmbientAlpha = 0.039f;
+const SkScalar kSpotAlpha = 0.25f;
+const SkScalar kLightHeight = 600;
+const SkScalar kLightRadius = 800;
+
+// Constants used by SkShadowUtils to size the ambient shadow.
+const SkScalar kAmbientHeightFactor = 1.0f / 128.0f;
+const SkScalar kAmbientGeomFactor = 64.0f;
+const SkScalar kMaxAmbientRadius =
+    300 * kAmbientHeightFactor * kAmbientGeomFactor;
+
+// The largest step the light is snapped to when caching shadows.
+const SkScalar kMaxLightQuantum = 1024;
+
+// The light is positioned in device space, independent of the canvas matrix.
+SkPoint3 ShadowLightPosition(const SkRect& path_bounds, SkScalar dpr) {
+  return SkPoint3::Make((path_bounds.left() + path_bounds.right()) / 2,
+                        path_bounds.top() - 600.0f, dpr * kLightHeight);
+}
+
+// The spot shadow moves by this many device pixels for every device pixel the
+// light moves.
+SkScalar SpotShadowZRatio(SkScalar occluder_z, SkScalar light_z) {
+  return std::min(std::max(occluder_z / (light_z - occluder_z), 0.0f), 0.95f);
+}
+
+}  // namespace
+
 PhysicalShapeLayer::PhysicalShapeLayer(Clip clip_behavior)
     : isRect_(false), clip_behavior_(clip_behavior) {}
 
@@ -40,27 +75,122 @@ void PhysicalShapeLayer::set_path(const SkPath& path) {
 
 void PhysicalShapeLayer::Preroll(PrerollContext* context,
                                  const SkMatrix& matrix) {
-  SkRect child_paint_bounds;
-  PrerollChildren(context, matrix, &child_paint_bounds);
+  // The shadow and the shape are painted before the children.
+  AddToBackdropSignature(context, path_);
+  AddToBackdropSignature(context, matrix);
+  AddToBackdropSignature(context, elevation_);
+  AddToBackdropSignature(context, color_);
+  AddToBackdropSignature(context, shadow_color_);
+  AddToBackdropSignature(context, device_pixel_ratio_);
+  AddToBackdropSignature(context, clip_behavior_);
 
-  if (elevation_ == 0) {
-    set_paint_bounds(path_.getBounds());
+  SkRect child_paint_bounds;
+  if (clip_behavior_ == Clip::none) {
+    PrerollChildren(context, matrix, &child_paint_bounds);
   } else {
+    PrerollContext clipped_context =
+        ClipPrerollContext(*context, matrix, path_.getBounds());
+    if (clip_behavior_ == Clip::antiAliasWithSaveLayer) {
+      clipped_context.in_save_layer = true;
+    }
+    PrerollChildren(&clipped_context, matrix, &child_paint_bounds);
+  }
+
+  // Children are painted on top of the shape so it stays opaque.
+  SkRect opaque_rect = SkRect::MakeEmpty();
+  if (SkColorGetA(color_) == 0xff) {
+    if (isRect_) {
+      opaque_rect = frameRRect_.rect();
+    } else if (frameRRect_.isSimple() || frameRRect_.isNinePatch()) {
+      // Skip the rounded corners.
+      SkVector radii = SkVector::Make(0, 0);
+      for (int corner = 0; corner < 4; corner++) {
+        const SkVector& corner_radii =
+            frameRRect_.radii(static_cast<SkRRect::Corner>(corner));
+        radii.fX = std::max(radii.fX, corner_radii.fX);
+        radii.fY = std::max(radii.fY, corner_radii.fY);
+      }
+      opaque_rect = frameRRect_.rect().makeInset(radii.fX, radii.fY);
+    }
+  }
+  set_opaque_device_bounds(GetOpaqueDeviceBounds(matrix, opaque_rect));
+
+  shadow_cache_result_ = RasterCacheResult();
+  SkRect bounds = path_.getBounds();
+  if (elevation_ != 0) {
 #if defined(OS_FUCHSIA)
     // Let the system compositor draw all shadows for us.
     set_needs_system_composite(true);
 #else
-    // Add some margin to the paint bounds to leave space for the shadow.
-    // The margin is hardcoded to an arbitrary maximum for now because Skia
-    // doesn't provide a way to calculate it.  We fill this whole region
-    // and clip children to it so we don't need to join the child paint bounds.
-    SkRect bounds(path_.getBounds());
-    bounds.outset(20.0, 20.0);
-    set_paint_bounds(bounds);
+    bounds =
+        ComputeShadowBounds(path_, elevation_, device_pixel_ratio_, matrix);
+    PrerollShadow(context, matrix, bounds);
 #endif  // defined(OS_FUCHSIA)
   }
+  set_paint_bounds(bounds);
 }
 
+#if !defined(OS_FUCHSIA)
+
+void PhysicalShapeLayer::PrerollShadow(PrerollContext* context,
+                                       const SkMatrix& matrix,
+                                       const SkRect& shadow_bounds) {
+  RasterCache* cache = context->raster_cache;
+  SkRect device_bounds;
+  matrix.mapRect(&device_bounds, shadow_bounds);
+  if (!cache || !SkRect::Intersects(device_bounds, context->cull_rect)) {
+    return;
+  }
+
+  SkMatrix ctm = matrix;
+#ifndef SUPPORT_FRACTIONAL_TRANSLATION
+  ctm = RasterCache::GetIntegralTransCTM(ctm);
+#endif
+
+  // The light is positioned in device space, so the shadow depends on where
+  // the shape is on screen. Rasterize it with the light at a snapped position
+  // relative to the cached image so that shapes moved by a few pixels share
+  // the image.
+  const SkIRect cache_rect = RasterCache::GetDeviceBounds(shadow_bounds, ctm);
+  const SkPoint relative_light = SnapShadowLightPosition(
+      path_, elevation_, device_pixel_ratio_,
+      SkIPoint::Make(cache_rect.left(), cache_rect.top()));
+  const SkPoint3 light =
+      ShadowLightPosition(path_.getBounds(), device_pixel_ratio_);
+  const SkVector light_offset = SkVector::Make(relative_light.x() - light.fX,
+                                               relative_light.y() - light.fY);
+  const bool transparent_occluder = SkColorGetA(color_) != 0xff;
+
+  SkPictureRecorder recorder;
+  DrawShadowWithLightOffset(recorder.beginRecording(shadow_bounds), path_,
+                            shadow_color_, elevation_, transparent_occluder,
+                            device_pixel_ratio_, light_offset);
+  sk_sp<SkPicture> shadow = recorder.finishRecordingAsPicture();
+
+  // Shapes are re-created every frame so key the cache on the content of the
+  // shadow instead of the identity of the picture.
+  std::vector<uint8_t> path_data(path_.writeToMemory(nullptr));
+  path_.writeToMemory(path_data.data());
+  uint64_t hash = fml::kHashSeed;
+  hash = fml::HashBytes(hash, path_data.data(), path_data.size());
+  hash = fml::HashValue(hash, elevation_);
+  hash = fml::HashValue(hash, device_pixel_ratio_);
+  hash = fml::HashValue(hash, shadow_color_);
+  hash = fml::HashValue(hash, transparent_occluder);
+  hash = fml::HashValue(hash, relative_light);
+
+  // Shadows are always expensive enough to be worth caching, so the hash is
+  // always needed.
+  PictureContentHash content_hash([hash]() { return hash == 0 ? 1 : hash; });
+  shadow_cache_result_ = cache->GetPrerolledImage(
+      context->gr_context, shadow.get(), ctm, context->dst_color_space,
+      true,   // is complex
+      false,  // will change
+      &content_hash);
+}
+
+#endif  // !defined(OS_FUCHSIA)
+
 #if defined(OS_FUCHSIA)
 
 void PhysicalShapeLayer::UpdateScene(SceneUpdateContext& context) {
@@ -82,7 +212,14 @@ void PhysicalShapeLayer::Paint(PaintContext& context) const {
   TRACE_EVENT0("flutter", "PhysicalShapeLayer::Paint");
   FXL_DCHECK(needs_painting());
 
-  if (elevation_ != 0) {
+  if (shadow_cache_result_.is_valid()) {
+    SkAutoCanvasRestore save(&context.canvas, true);
+#ifndef SUPPORT_FRACTIONAL_TRANSLATION
+    context.canvas.setMatrix(
+        RasterCache::GetIntegralTransCTM(context.canvas.getTotalMatrix()));
+#endif
+    shadow_cache_result_.draw(context.canvas);
+  } else if (elevation_ != 0) {
     DrawShadow(&context.canvas, path_, shadow_color_, elevation_,
                SkColorGetA(color_) != 0xff, device_pixel_ratio_);
   }
@@ -118,26 +255,100 @@ void PhysicalShapeLayer::DrawShadow(SkCanvas* canvas,
                                     float elevation,
                                     bool transparentOccluder,
                                     SkScalar dpr) {
-  const SkScalar kAmbientAlpha = 0.039f;
-  const SkScalar kSpotAlpha = 0.25f;
-  const SkScalar kLightHeight = 600;
-  const SkScalar kLightRadius = 800;
+  DrawShadowWithLightOffset(canvas, path, color, elevation,
+                            transparentOccluder, dpr, SkVector::Make(0, 0));
+}
+
+SkRect PhysicalShapeLayer::ComputeShadowBounds(const SkPath& path,
+                                               float elevation,
+                                               SkScalar dpr,
+                                               const SkMatrix& ctm) {
+  // Mirrors the shadow geometry of SkShadowUtils::DrawShadow for the
+  // parameters used by |DrawShadowWithLightOffset|. All of it is computed in
+  // device space since that is where the light is positioned.
+  const SkRect& bounds = path.getBounds();
+  const SkScalar occluder_z = dpr * elevation;
+  const SkPoint3 light = ShadowLightPosition(bounds, dpr);
+  SkMatrix inverse;
+  if (!ctm.rectStaysRect() || !ctm.invert(&inverse) ||
+      light.fZ <= occluder_z) {
+    // Fall back to an arbitrary margin around the shape.
+    return bounds.makeOutset(20.0, 20.0);
+  }
 
+  SkRect device_bounds;
+  ctm.mapRect(&device_bounds, bounds);
+
+  // The ambient shadow is the shape blurred in place.
+  const SkScalar ambient_blur = std::min(occluder_z * kAmbientHeightFactor *
+                                             kAmbientGeomFactor,
+                                         kMaxAmbientRadius);
+  SkRect shadow_bounds = device_bounds.makeOutset(ambient_blur, ambient_blur);
+
+  // The spot shadow is the shape projected away from the light and blurred.
+  const SkScalar z_ratio = SpotShadowZRatio(occluder_z, light.fZ);
+  const SkScalar spot_blur = dpr * kLightRadius * z_ratio;
+  const SkScalar scale =
+      std::min(std::max(light.fZ / (light.fZ - occluder_z), 1.0f), 1.95f);
+  SkMatrix spot_matrix;
+  spot_matrix.setScaleTranslate(scale, scale, -z_ratio * light.fX,
+                                -z_ratio * light.fY);
+  SkRect spot_bounds;
+  spot_matrix.mapRect(&spot_bounds, device_bounds);
+  shadow_bounds.join(spot_bounds.makeOutset(spot_blur, spot_blur));
+
+  // Leave room for anti-aliasing.
+  shadow_bounds.outset(1, 1);
+
+  SkRect local_bounds;
+  inverse.mapRect(&local_bounds, shadow_bounds);
+  local_bounds.join(bounds);
+  return local_bounds;
+}
+
+SkPoint PhysicalShapeLayer::SnapShadowLightPosition(const SkPath& path,
+                                                    float elevation,
+                                                    SkScalar dpr,
+                                                    const SkIPoint& origin) {
+  const SkPoint3 light = ShadowLightPosition(path.getBounds(), dpr);
+  SkPoint relative_light =
+      SkPoint::Make(light.fX - origin.x(), light.fY - origin.y());
+
+  // Snap to the largest power of two that moves the spot shadow by at most
+  // half a pixel. The ambient shadow does not depend on the light.
+  const SkScalar z_ratio = SpotShadowZRatio(dpr * elevation, light.fZ);
+  SkScalar quantum = 1;
+  while (quantum * 2 <= kMaxLightQuantum && quantum * 2 * z_ratio <= 0.5f) {
+    quantum *= 2;
+  }
+  relative_light.set(SkScalarRoundToScalar(relative_light.x() / quantum),
+                     SkScalarRoundToScalar(relative_light.y() / quantum));
+  relative_light.scale(quantum);
+  return relative_light;
+}
+
+void PhysicalShapeLayer::DrawShadowWithLightOffset(
+    SkCanvas* canvas,
+    const SkPath& path,
+    SkColor color,
+    float elevation,
+    bool transparentOccluder,
+    SkScalar dpr,
+    const SkVector& light_offset) {
   SkShadowFlags flags = transparentOccluder
                             ? SkShadowFlags::kTransparentOccluder_ShadowFlag
                             : SkShadowFlags::kNone_ShadowFlag;
-  const SkRect& bounds = path.getBounds();
-  SkScalar shadow_x = (bounds.left() + bounds.right()) / 2;
-  SkScalar shadow_y = bounds.top() - 600.0f;
+  SkPoint3 light = ShadowLightPosition(path.getBounds(), dpr);
+  light.fX += light_offset.x();
+  light.fY += light_offset.y();
   SkColor inAmbient = SkColorSetA(color, kAmbientAlpha * SkColorGetA(color));
   SkColor inSpot = SkColorSetA(color, kSpotAlpha * SkColorGetA(color));
   SkColor ambientColor, spotColor;
   SkShadowUtils::ComputeTonalColors(inAmbient, inSpot, &ambientColor,
                                     &spotColor);
-  SkShadowUtils::DrawShadow(
-      canvas, path, SkPoint3::Make(0, 0, dpr * elevation),
-      SkPoint3::Make(shadow_x, shadow_y, dpr * kLightHeight),
-      dpr * kLightRadius, ambientColor, spotColor, flags);
+  SkShadowUtils::DrawShadow(canvas, path, SkPoint3::Make(0, 0, dpr * elevation),
+                            light, dpr * kLightRadius, ambientColor, spotColor,
+                            flags);
 }
 
 }  // namespace flow
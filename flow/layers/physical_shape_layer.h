@@ -28,6 +28,22 @@ class PhysicalShapeLayer : public ContainerLayer {
                          bool transparentOccluder,
                          SkScalar dpr);
 
+  // The local bounds of the shape and the shadow |DrawShadow| draws for it
+  // under the device transform |ctm|.
+  static SkRect ComputeShadowBounds(const SkPath& path,
+                                    float elevation,
+                                    SkScalar dpr,
+                                    const SkMatrix& ctm);
+
+  // The position of the light of the shadow |DrawShadow| draws for |path|,
+  // relative to |origin| in device space. The position is snapped to a grid
+  // that is as coarse as possible while moving the shadow by at most half a
+  // pixel, so that the shadows of shapes that moved a little can be cached.
+  static SkPoint SnapShadowLightPosition(const SkPath& path,
+                                         float elevation,
+                                         SkScalar dpr,
+                                         const SkIPoint& origin);
+
   void Preroll(PrerollContext* context, const SkMatrix& matrix) override;
 
   void Paint(PaintContext& context) const override;
@@ -37,6 +53,22 @@ class PhysicalShapeLayer : public ContainerLayer {
 #endif  // defined(OS_FUCHSIA)
 
  private:
+  // Same as |DrawShadow| but with the light moved by |light_offset| in device
+  // space.
+  static void DrawShadowWithLightOffset(SkCanvas* canvas,
+                                        const SkPath& path,
+                                        SkColor color,
+                                        float elevation,
+                                        bool transparentOccluder,
+                                        SkScalar dpr,
+                                        const SkVector& light_offset);
+
+#if !defined(OS_FUCHSIA)
+  void PrerollShadow(PrerollContext* context,
+                     const SkMatrix& matrix,
+                     const SkRect& shadow_bounds);
+#endif  // !defined(OS_FUCHSIA)
+
   float elevation_;
   SkColor color_;
   SkColor shadow_color_;
@@ -45,6 +77,7 @@ class PhysicalShapeLayer : public ContainerLayer {
   bool isRect_;
   SkRRect frameRRect_;
   Clip clip_behavior_;
+  RasterCacheResult shadow_cache_result_;
 };
 
 }  // namespace flow
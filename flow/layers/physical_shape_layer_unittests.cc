@@ -0,0 +1,106 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <utility>
+
+#include "flutter/flow/layers/physical_shape_layer.h"
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace {
+
+// Returns the bounds of the pixels that are not fully transparent.
+SkIRect GetDrawnBounds(SkSurface* surface) {
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(surface->width(), surface->height());
+  surface->readPixels(bitmap, 0, 0);
+  SkIRect drawn = SkIRect::MakeEmpty();
+  for (int y = 0; y < bitmap.height(); y++) {
+    for (int x = 0; x < bitmap.width(); x++) {
+      if (SkColorGetA(bitmap.getColor(x, y)) != 0) {
+        drawn.join(SkIRect::MakeXYWH(x, y, 1, 1));
+      }
+    }
+  }
+  return drawn;
+}
+
+void ExpectShadowWithinBounds(const SkMatrix& ctm) {
+  const SkPath path = SkPath().addRect(SkRect::MakeXYWH(100, 300, 200, 100));
+  const float elevation = 8;
+  const SkScalar dpr = ctm.getScaleX();
+
+  sk_sp<SkSurface> surface = SkSurface::MakeRasterN32Premul(1600, 1600);
+  SkCanvas* canvas = surface->getCanvas();
+  canvas->clear(SK_ColorTRANSPARENT);
+  canvas->concat(ctm);
+  flow::PhysicalShapeLayer::DrawShadow(canvas, path, SK_ColorBLACK, elevation,
+                                       false, dpr);
+
+  SkRect bounds = flow::PhysicalShapeLayer::ComputeShadowBounds(
+      path, elevation, dpr, ctm);
+  SkRect device_bounds;
+  ctm.mapRect(&device_bounds, bounds);
+  SkIRect pixel_bounds;
+  device_bounds.roundOut(&pixel_bounds);
+
+  const SkIRect drawn = GetDrawnBounds(surface.get());
+  ASSERT_FALSE(drawn.isEmpty());
+  ASSERT_TRUE(pixel_bounds.contains(drawn));
+  // The bounds should be much tighter than the whole surface.
+  ASSERT_LT(pixel_bounds.width(), surface->width());
+}
+
+}  // namespace
+
+TEST(PhysicalShapeLayer, ShadowBoundsContainTheShadow) {
+  ExpectShadowWithinBounds(SkMatrix::I());
+}
+
+TEST(PhysicalShapeLayer, ShadowBoundsContainTheScaledShadow) {
+  SkMatrix ctm = SkMatrix::MakeScale(3, 3);
+  ctm.postTranslate(50, 20);
+  ExpectShadowWithinBounds(ctm);
+}
+
+TEST(PhysicalShapeLayer, ShadowLightIsSnappedForSmallMoves) {
+  const SkPath path = SkPath().addRect(SkRect::MakeXYWH(100, 300, 200, 100));
+
+  // The light barely moves the shadow of a low shape, so shapes moved by a few
+  // pixels share a light position.
+  std::set<std::pair<SkScalar, SkScalar>> positions;
+  for (int offset = 0; offset < 10; offset++) {
+    const SkPoint light = flow::PhysicalShapeLayer::SnapShadowLightPosition(
+        path, 1, 1, SkIPoint::Make(offset, offset));
+    positions.insert({light.x(), light.y()});
+  }
+  ASSERT_LE(positions.size(), 2u);
+}
+
+TEST(PhysicalShapeLayer, SnappedShadowLightMovesTheShadowByHalfAPixel) {
+  const SkPath path = SkPath().addRect(SkRect::MakeXYWH(100, 300, 200, 100));
+  // The light is at the top center of the shape and 600 logical pixels up.
+  const SkPoint exact_light = SkPoint::Make(200, -300);
+
+  for (float elevation : {1.0f, 4.0f, 8.0f, 24.0f, 400.0f}) {
+    for (SkScalar dpr : {1.0f, 3.0f}) {
+      const SkScalar occluder_z = dpr * elevation;
+      const SkScalar light_z = dpr * 600;
+      const SkScalar z_ratio =
+          std::min(occluder_z / (light_z - occluder_z), 0.95f);
+      for (int origin : {-317, 0, 13, 1000}) {
+        const SkPoint light = flow::PhysicalShapeLayer::SnapShadowLightPosition(
+            path, elevation, dpr, SkIPoint::Make(origin, origin));
+        const SkPoint exact_relative_light =
+            exact_light - SkPoint::Make(origin, origin);
+        const SkVector error = light - exact_relative_light;
+        ASSERT_LE(std::abs(error.x()) * z_ratio, 0.5f);
+        ASSERT_LE(std::abs(error.y()) * z_ratio, 0.5f);
+      }
+    }
+  }
+}
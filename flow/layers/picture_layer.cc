@@ -15,21 +15,49 @@ PictureLayer::~PictureLayer() = default;
 void PictureLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   SkPicture* sk_picture = picture();
 
-  if (auto cache = context->raster_cache) {
-    SkMatrix ctm = matrix;
-    ctm.postTranslate(offset_.x(), offset_.y());
+  SkRect bounds = sk_picture->cullRect().makeOffset(offset_.x(), offset_.y());
+  set_paint_bounds(bounds);
+
+  SkRect device_bounds;
+  matrix.mapRect(&device_bounds, bounds);
+  // Pictures that are not visible are not worth caching.
+  const bool is_visible = SkRect::Intersects(device_bounds, context->cull_rect);
+
+  SkMatrix ctm = matrix;
+  ctm.postTranslate(offset_.x(), offset_.y());
 #ifndef SUPPORT_FRACTIONAL_TRANSLATION
-    ctm = RasterCache::GetIntegralTransCTM(ctm);
+  ctm = RasterCache::GetIntegralTransCTM(ctm);
 #endif
+
+  auto cache = context->raster_cache;
+  if (cache && is_visible) {
     raster_cache_result_ = cache->GetPrerolledImage(
         context->gr_context, sk_picture, ctm, context->dst_color_space,
-        is_complex_, will_change_);
+        is_complex_, will_change_, content_hash_.get());
   } else {
     raster_cache_result_ = RasterCacheResult();
   }
 
-  SkRect bounds = sk_picture->cullRect().makeOffset(offset_.x(), offset_.y());
-  set_paint_bounds(bounds);
+  // Content hashes identify pictures across frames. Picture IDs do not, but
+  // are still correct. Hashes are only computed for pictures the raster cache
+  // considered, so others are identified by their ID.
+  const uint64_t content_hash =
+      content_hash_ ? content_hash_->GetIfComputed() : 0;
+  AddToBackdropSignature(context, content_hash != 0
+                                      ? content_hash
+                                      : uint64_t{sk_picture->uniqueID()});
+  AddToBackdropSignature(context, offset_);
+  AddToBackdropSignature(context, matrix);
+
+  // A cached raster image of an opaque picture is just as opaque. Cached
+  // images found to be opaque cover exactly their device bounds when painted.
+  if (raster_cache_result_.is_opaque()) {
+    set_opaque_device_bounds(SkRect::Make(
+        RasterCache::GetDeviceBounds(sk_picture->cullRect(), ctm)));
+  } else {
+    set_opaque_device_bounds(is_opaque_ ? GetOpaqueDeviceBounds(matrix, bounds)
+                                        : SkRect::MakeEmpty());
+  }
 }
 
 void PictureLayer::Paint(PaintContext& context) const {
@@ -8,6 +8,7 @@
 #include <memory>
 
 #include "flutter/flow/layers/layer.h"
+#include "flutter/flow/picture_content_hash.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/flow/skia_gpu_object.h"
 
@@ -25,6 +26,12 @@ class PictureLayer : public Layer {
 
   void set_is_complex(bool value) { is_complex_ = value; }
   void set_will_change(bool value) { will_change_ = value; }
+  // Whether the picture covers its cull rect with opaque pixels.
+  void set_is_opaque(bool value) { is_opaque_ = value; }
+  // See |PictureContentHash|. Null if the picture has no content hash.
+  void set_content_hash(std::shared_ptr<PictureContentHash> content_hash) {
+    content_hash_ = std::move(content_hash);
+  }
 
   SkPicture* picture() const { return picture_.get().get(); }
 
@@ -39,6 +46,8 @@ class PictureLayer : public Layer {
   SkiaGPUObject<SkPicture> picture_;
   bool is_complex_ = false;
   bool will_change_ = false;
+  bool is_opaque_ = false;
+  std::shared_ptr<PictureContentHash> content_hash_;
   RasterCacheResult raster_cache_result_;
 
   FXL_DISALLOW_COPY_AND_ASSIGN(PictureLayer);
@@ -10,6 +10,15 @@ ShaderMaskLayer::ShaderMaskLayer() = default;
 
 ShaderMaskLayer::~ShaderMaskLayer() = default;
 
+void ShaderMaskLayer::Preroll(PrerollContext* context,
+                              const SkMatrix& matrix) {
+  PrerollContext child_context = *context;
+  child_context.in_save_layer = true;
+  ContainerLayer::Preroll(&child_context, matrix);
+  // Shaders cannot be compared across frames.
+  MarkBackdropVolatile(context);
+}
+
 void ShaderMaskLayer::Paint(PaintContext& context) const {
   TRACE_EVENT0("flutter", "ShaderMaskLayer::Paint");
   FXL_DCHECK(needs_painting());
@@ -13,6 +13,8 @@ TextureLayer::TextureLayer() = default;
 TextureLayer::~TextureLayer() = default;
 
 void TextureLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
+  // Textures are updated behind the back of the layer tree.
+  MarkBackdropVolatile(context);
   set_paint_bounds(SkRect::MakeXYWH(offset_.x(), offset_.y(), size_.width(),
                                     size_.height()));
 }
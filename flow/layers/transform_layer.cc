@@ -15,10 +15,13 @@ void TransformLayer::Preroll(PrerollContext* context, const SkMatrix& matrix) {
   child_matrix.setConcat(matrix, transform_);
 
   SkRect child_paint_bounds = SkRect::MakeEmpty();
-  PrerollChildren(context, child_matrix, &child_paint_bounds);
+  SkRect child_opaque_bounds;
+  PrerollChildren(context, child_matrix, &child_paint_bounds,
+                  &child_opaque_bounds);
 
   transform_.mapRect(&child_paint_bounds);
   set_paint_bounds(child_paint_bounds);
+  set_opaque_device_bounds(child_opaque_bounds);
 }
 
 #if defined(OS_FUCHSIA)
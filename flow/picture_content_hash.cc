@@ -0,0 +1,35 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/picture_content_hash.h"
+
+#include <utility>
+
+#include "flutter/fml/trace_event.h"
+
+namespace flow {
+
+PictureContentHash::PictureContentHash(std::function<uint64_t()> compute)
+    : compute_(std::move(compute)), computed_(false), hash_(0) {}
+
+PictureContentHash::~PictureContentHash() = default;
+
+uint64_t PictureContentHash::Get() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!computed_) {
+    TRACE_EVENT0("flutter", "PictureContentHash::Get");
+    hash_ = compute_ ? compute_() : 0;
+    computed_ = true;
+    // Whatever the computation referenced is no longer needed.
+    compute_ = nullptr;
+  }
+  return hash_;
+}
+
+uint64_t PictureContentHash::GetIfComputed() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return hash_;
+}
+
+}  // namespace flow
@@ -0,0 +1,49 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_PICTURE_CONTENT_HASH_H_
+#define FLUTTER_FLOW_PICTURE_CONTENT_HASH_H_
+
+#include <stdint.h>
+
+#include <functional>
+#include <mutex>
+
+#include "lib/fxl/macros.h"
+
+namespace flow {
+
+// A fingerprint of the content of a picture that is the same for pictures
+// that draw the same content, even if they were recorded separately. See
+// |RasterCacheKey|.
+//
+// Computing the fingerprint may be expensive, so it is only computed the first
+// time it is asked for, which is when the raster cache considers the picture.
+class PictureContentHash {
+ public:
+  // |compute| returns zero if the content cannot be fingerprinted. It may be
+  // called on any thread.
+  explicit PictureContentHash(std::function<uint64_t()> compute);
+
+  ~PictureContentHash();
+
+  // Returns the fingerprint, computing it if necessary, or zero if the content
+  // cannot be fingerprinted.
+  uint64_t Get();
+
+  // Returns the fingerprint if it has been computed already, or zero.
+  uint64_t GetIfComputed();
+
+ private:
+  std::mutex mutex_;
+  std::function<uint64_t()> compute_;
+  bool computed_;
+  uint64_t hash_;
+
+  FXL_DISALLOW_COPY_AND_ASSIGN(PictureContentHash);
+};
+
+}  // namespace flow
+
+#endif  // FLUTTER_FLOW_PICTURE_CONTENT_HASH_H_
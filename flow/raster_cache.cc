@@ -13,6 +13,7 @@
 #include "third_party/skia/include/core/SkColorSpaceXformCanvas.h"
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkPicture.h"
+#include "third_party/skia/include/core/SkPixmap.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
 namespace flow {
@@ -27,7 +28,10 @@ void RasterCacheResult::draw(SkCanvas& canvas) const {
 }
 
 RasterCache::RasterCache(size_t threshold)
-    : threshold_(threshold), checkerboard_images_(false), weak_factory_(this) {}
+    : threshold_(threshold),
+      volatile_backdrop_count_(0),
+      checkerboard_images_(false),
+      weak_factory_(this) {}
 
 RasterCache::~RasterCache() = default;
 
@@ -118,7 +122,16 @@ RasterCacheResult RasterizePicture(SkPicture* picture,
     DrawCheckerboard(canvas, logical_rect);
   }
 
-  return {surface->makeImageSnapshot(), logical_rect};
+  sk_sp<SkImage> image = surface->makeImageSnapshot();
+
+  // The pixels of raster images are checked once per entry, which costs no
+  // more than rasterizing them did. Pictures the framework flagged as opaque
+  // are reported by their layer without looking at the pixels.
+  SkPixmap pixmap;
+  const bool is_opaque = image && image->peekPixels(&pixmap) &&
+                         pixmap.computeIsOpaque();
+
+  return {std::move(image), logical_rect, is_opaque};
 }
 
 static inline size_t ClampSize(size_t value, size_t min, size_t max) {
@@ -139,7 +152,8 @@ RasterCacheResult RasterCache::GetPrerolledImage(
     const SkMatrix& transformation_matrix,
     SkColorSpace* dst_color_space,
     bool is_complex,
-    bool will_change) {
+    bool will_change,
+    PictureContentHash* content_hash) {
   if (!IsPictureWorthRasterizing(picture, will_change, is_complex)) {
     // We only deal with pictures that are worthy of rasterization.
     return {};
@@ -154,7 +168,8 @@ RasterCacheResult RasterCache::GetPrerolledImage(
     return {};
   }
 
-  RasterCacheKey cache_key(*picture, transformation_matrix);
+  RasterCacheKey cache_key(*picture, transformation_matrix,
+                           content_hash ? content_hash->Get() : 0);
 
   Entry& entry = cache_[cache_key];
   entry.access_count = ClampSize(entry.access_count + 1, 0, threshold_);
@@ -173,6 +188,21 @@ RasterCacheResult RasterCache::GetPrerolledImage(
   return entry.image;
 }
 
+sk_sp<SkImage> RasterCache::GetBackdropImage(uint64_t key) {
+  auto found = backdrop_cache_.find(key);
+  if (found == backdrop_cache_.end()) {
+    return nullptr;
+  }
+  found->second.used_this_frame = true;
+  return found->second.image;
+}
+
+void RasterCache::SetBackdropImage(uint64_t key, sk_sp<SkImage> image) {
+  BackdropEntry& entry = backdrop_cache_[key];
+  entry.used_this_frame = true;
+  entry.image = std::move(image);
+}
+
 void RasterCache::SweepAfterFrame() {
   std::vector<RasterCacheKey::Map<Entry>::iterator> dead;
 
@@ -187,10 +217,20 @@ void RasterCache::SweepAfterFrame() {
   for (auto it : dead) {
     cache_.erase(it);
   }
+
+  for (auto it = backdrop_cache_.begin(); it != backdrop_cache_.end();) {
+    if (it->second.used_this_frame) {
+      it->second.used_this_frame = false;
+      ++it;
+    } else {
+      it = backdrop_cache_.erase(it);
+    }
+  }
 }
 
 void RasterCache::Clear() {
   cache_.clear();
+  backdrop_cache_.clear();
 }
 
 void RasterCache::SetCheckboardCacheImages(bool checkerboard) {
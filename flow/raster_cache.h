@@ -9,6 +9,7 @@
 #include <unordered_map>
 
 #include "flutter/flow/instrumentation.h"
+#include "flutter/flow/picture_content_hash.h"
 #include "flutter/flow/raster_cache_key.h"
 #include "lib/fxl/macros.h"
 #include "lib/fxl/memory/weak_ptr.h"
@@ -21,18 +22,28 @@ class RasterCacheResult {
  public:
   RasterCacheResult() {}
 
-  RasterCacheResult(sk_sp<SkImage> image, const SkRect& logical_rect)
-      : image_(std::move(image)), logical_rect_(logical_rect) {}
+  RasterCacheResult(sk_sp<SkImage> image,
+                    const SkRect& logical_rect,
+                    bool is_opaque = false)
+      : image_(std::move(image)),
+        logical_rect_(logical_rect),
+        is_opaque_(is_opaque) {}
 
   operator bool() const { return static_cast<bool>(image_); }
 
   bool is_valid() const { return static_cast<bool>(image_); };
 
+  // Whether every pixel of the image is known to be opaque. Only images in
+  // CPU memory are checked since reading back a texture stalls the GPU, so
+  // this is false for GPU images regardless of their contents.
+  bool is_opaque() const { return is_opaque_; }
+
   void draw(SkCanvas& canvas) const;
 
  private:
   sk_sp<SkImage> image_;
   SkRect logical_rect_;
+  bool is_opaque_ = false;
 };
 
 class RasterCache {
@@ -56,12 +67,28 @@ class RasterCache {
     return result;
   }
 
-  RasterCacheResult GetPrerolledImage(GrContext* context,
-                                      SkPicture* picture,
-                                      const SkMatrix& transformation_matrix,
-                                      SkColorSpace* dst_color_space,
-                                      bool is_complex,
-                                      bool will_change);
+  // If |content_hash| is not null and the picture is worth caching, the hash
+  // is computed and used to look up the picture in place of its unique ID so
+  // that identical pictures recorded on different frames share the same cache
+  // entry.
+  RasterCacheResult GetPrerolledImage(
+      GrContext* context,
+      SkPicture* picture,
+      const SkMatrix& transformation_matrix,
+      SkColorSpace* dst_color_space,
+      bool is_complex,
+      bool will_change,
+      PictureContentHash* content_hash = nullptr);
+
+  // Filtered backdrops, keyed by a fingerprint of the content underneath the
+  // filter. See |BackdropFilterLayer|. Returns null on a miss.
+  sk_sp<SkImage> GetBackdropImage(uint64_t key);
+
+  void SetBackdropImage(uint64_t key, sk_sp<SkImage> image);
+
+  // Returns a value that differs on every call. Mixed into the backdrop
+  // signatures of content that changes without its layer properties changing.
+  uint64_t NextVolatileBackdropId() { return ++volatile_backdrop_count_; }
 
   void SweepAfterFrame();
 
@@ -76,8 +103,15 @@ class RasterCache {
     RasterCacheResult image;
   };
 
+  struct BackdropEntry {
+    bool used_this_frame = false;
+    sk_sp<SkImage> image;
+  };
+
   const size_t threshold_;
   RasterCacheKey::Map<Entry> cache_;
+  std::unordered_map<uint64_t, BackdropEntry> backdrop_cache_;
+  uint64_t volatile_backdrop_count_;
   bool checkerboard_images_;
   fxl::WeakPtrFactory<RasterCache> weak_factory_;
 
@@ -16,8 +16,15 @@ namespace flow {
 
 class RasterCacheKey {
  public:
-  RasterCacheKey(const SkPicture& picture, const SkMatrix& ctm)
-      : picture_id_(picture.uniqueID()), matrix_(ctm) {
+  // Pictures are identified by their unique ID unless a non-zero
+  // |content_hash| is supplied. Content hashes are computed when the picture
+  // is recorded and are the same for pictures that draw the same content.
+  RasterCacheKey(const SkPicture& picture,
+                 const SkMatrix& ctm,
+                 uint64_t content_hash = 0)
+      : picture_id_(content_hash != 0 ? content_hash : picture.uniqueID()),
+        is_content_hash_(content_hash != 0),
+        matrix_(ctm) {
     matrix_[SkMatrix::kMTransX] = SkScalarFraction(ctm.getTranslateX());
     matrix_[SkMatrix::kMTransY] = SkScalarFraction(ctm.getTranslateY());
 #ifndef SUPPORT_FRACTIONAL_TRANSLATION
@@ -25,19 +32,22 @@ class RasterCacheKey {
 #endif
   }
 
-  uint32_t picture_id() const { return picture_id_; }
+  uint64_t picture_id() const { return picture_id_; }
+  bool is_content_hash() const { return is_content_hash_; }
   const SkMatrix& matrix() const { return matrix_; }
 
   struct Hash {
     std::size_t operator()(RasterCacheKey const& key) const {
-      return key.picture_id_;
+      return static_cast<std::size_t>(key.picture_id_);
     }
   };
 
   struct Equal {
     constexpr bool operator()(const RasterCacheKey& lhs,
                               const RasterCacheKey& rhs) const {
-      return lhs.picture_id_ == rhs.picture_id_ && lhs.matrix_ == rhs.matrix_;
+      return lhs.picture_id_ == rhs.picture_id_ &&
+             lhs.is_content_hash_ == rhs.is_content_hash_ &&
+             lhs.matrix_ == rhs.matrix_;
     }
   };
 
@@ -45,7 +55,8 @@ class RasterCacheKey {
   using Map = std::unordered_map<RasterCacheKey, Value, Hash, Equal>;
 
  private:
-  uint32_t picture_id_;
+  uint64_t picture_id_;
+  bool is_content_hash_;
 
   // ctm where only fractional (0-1) translations are preserved:
   //   matrix_ = ctm;
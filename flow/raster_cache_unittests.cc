@@ -4,6 +4,8 @@
 
 #include "flutter/flow/raster_cache.h"
 #include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkPicture.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
 
@@ -93,3 +95,122 @@ TEST(RasterCache, SweepsRemoveUnusedFrames) {
   ASSERT_FALSE(cache.GetPrerolledImage(NULL, picture.get(), matrix, srgb.get(),
                                        true, false));  // 5
 }
+
+TEST(RasterCache, IdenticalContentHashesShareAnEntry) {
+  size_t threshold = 3;
+  flow::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+  flow::PictureContentHash content_hash([]() { return 0x1234; });
+
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  for (size_t frame = 1; frame < threshold; frame++) {
+    // Each frame re-records the same content into a new picture.
+    auto picture = GetSamplePicture();
+    ASSERT_FALSE(cache.GetPrerolledImage(NULL, picture.get(), matrix,
+                                         srgb.get(), true, false,
+                                         &content_hash));
+    cache.SweepAfterFrame();
+  }
+  auto picture = GetSamplePicture();
+  ASSERT_TRUE(cache.GetPrerolledImage(NULL, picture.get(), matrix, srgb.get(),
+                                      true, false, &content_hash));
+}
+
+TEST(RasterCache, ContentHashesAreOnlyComputedForPicturesWorthCaching) {
+  flow::RasterCache cache;
+  size_t compute_count = 0;
+  flow::PictureContentHash content_hash([&compute_count]() {
+    compute_count++;
+    return 0x1234;
+  });
+
+  SkMatrix matrix = SkMatrix::I();
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  auto picture = GetSamplePicture();
+
+  // Pictures that will change are never cached.
+  ASSERT_FALSE(cache.GetPrerolledImage(NULL, picture.get(), matrix, srgb.get(),
+                                       true, true, &content_hash));
+  ASSERT_EQ(compute_count, 0u);
+  ASSERT_EQ(content_hash.GetIfComputed(), 0u);
+
+  // The hash is computed once no matter how often it is asked for.
+  for (int frame = 0; frame < 2; frame++) {
+    ASSERT_FALSE(cache.GetPrerolledImage(NULL, picture.get(), matrix,
+                                         srgb.get(), true, false,
+                                         &content_hash));
+  }
+  ASSERT_EQ(compute_count, 1u);
+  ASSERT_EQ(content_hash.GetIfComputed(), 0x1234u);
+}
+
+TEST(RasterCache, PicturesWithoutContentHashesAreKeyedByID) {
+  size_t threshold = 3;
+  flow::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  for (size_t frame = 1; frame <= threshold; frame++) {
+    auto picture = GetSamplePicture();
+    ASSERT_FALSE(cache.GetPrerolledImage(NULL, picture.get(), matrix,
+                                         srgb.get(), true, false));
+    cache.SweepAfterFrame();
+  }
+}
+
+TEST(RasterCache, BackdropImagesAreEvictedWhenUnused) {
+  flow::RasterCache cache;
+  const uint64_t key = 0x5678;
+
+  sk_sp<SkImage> image =
+      SkImage::MakeRasterData(SkImageInfo::MakeN32Premul(1, 1),
+                              SkData::MakeUninitialized(4), 4);
+  ASSERT_FALSE(cache.GetBackdropImage(key));
+  cache.SetBackdropImage(key, image);
+  cache.SweepAfterFrame();
+
+  ASSERT_EQ(cache.GetBackdropImage(key), image);
+  cache.SweepAfterFrame();
+
+  cache.SweepAfterFrame();  // Extra frame without a backdrop access.
+  ASSERT_FALSE(cache.GetBackdropImage(key));
+}
+
+TEST(RasterCache, OpaqueRasterImagesAreReportedAsOpaque) {
+  flow::RasterCache cache(1);
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+  const SkMatrix matrix = SkMatrix::MakeScale(2, 2);
+
+  SkPictureRecorder recorder;
+  recorder.beginRecording(SkRect::MakeWH(150, 100));
+  recorder.getRecordingCanvas()->drawColor(SK_ColorBLUE);
+  auto opaque = recorder.finishRecordingAsPicture();
+
+  auto result = cache.GetPrerolledImage(NULL, opaque.get(), matrix,
+                                        srgb.get(), true, false);
+  ASSERT_TRUE(result);
+  ASSERT_TRUE(result.is_opaque());
+}
+
+TEST(RasterCache, PartiallyCoveredRasterImagesAreNotOpaque) {
+  flow::RasterCache cache(1);
+  sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+
+  // Only a part of the cull rect is painted.
+  auto picture = GetSamplePicture();
+  auto result = cache.GetPrerolledImage(NULL, picture.get(), SkMatrix::I(),
+                                        srgb.get(), true, false);
+  ASSERT_TRUE(result);
+  ASSERT_FALSE(result.is_opaque());
+
+  SkPictureRecorder recorder;
+  recorder.beginRecording(SkRect::MakeWH(150, 100));
+  recorder.getRecordingCanvas()->drawColor(SkColorSetA(SK_ColorBLUE, 0xfe));
+  auto translucent = recorder.finishRecordingAsPicture();
+  result = cache.GetPrerolledImage(NULL, translucent.get(), SkMatrix::I(),
+                                   srgb.get(), true, false);
+  ASSERT_TRUE(result);
+  ASSERT_FALSE(result.is_opaque());
+}
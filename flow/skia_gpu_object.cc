@@ -4,41 +4,180 @@
 
 #include "flutter/flow/skia_gpu_object.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "flutter/fml/message_loop.h"
+#include "flutter/fml/trace_event.h"
 
 namespace flow {
 
+// Unreffing a texture can take a while in the driver. Slices are kept short so
+// that tasks queued behind the drain (image decodes and uploads) still run
+// promptly.
+static constexpr fxl::TimeDelta kDrainSliceDuration =
+    fxl::TimeDelta::FromMilliseconds(2);
+
+// Objects are taken out of the queue in small batches to avoid holding the
+// lock while unreffing and to avoid checking the clock for every object.
+static constexpr size_t kDrainBatchSize = 8;
+
+constexpr size_t SkiaUnrefQueue::kBackpressureByteThreshold;
+
 SkiaUnrefQueue::SkiaUnrefQueue(fxl::RefPtr<fxl::TaskRunner> task_runner,
                                fxl::TimeDelta delay)
     : task_runner_(std::move(task_runner)),
       drain_delay_(delay),
-      drain_pending_(false) {}
+      queued_bytes_(0),
+      drain_pending_(false),
+      backpressure_drain_pending_(false),
+      idle_drain_pending_(false) {}
 
 SkiaUnrefQueue::~SkiaUnrefQueue() {
   Drain();
 }
 
-void SkiaUnrefQueue::Unref(SkRefCnt* object) {
+void SkiaUnrefQueue::Unref(SkRefCnt* object, size_t byte_size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  objects_.push_back({object, byte_size});
+  queued_bytes_ += byte_size;
+  TraceCountersLocked();
+
+  if (queued_bytes_ > kBackpressureByteThreshold) {
+    ScheduleBackpressureDrainLocked();
+    return;
+  }
+
+  ScheduleDrainLocked(drain_delay_);
+}
+
+void SkiaUnrefQueue::ScheduleBackpressureDrainLocked() {
+  if (queued_bytes_ <= kBackpressureByteThreshold ||
+      backpressure_drain_pending_) {
+    return;
+  }
+  backpressure_drain_pending_ = true;
+  task_runner_->PostTask([strong = fxl::Ref(this)]() {
+    {
+      std::lock_guard<std::mutex> lock(strong->mutex_);
+      strong->backpressure_drain_pending_ = false;
+    }
+    strong->DrainSlice();
+  });
+}
+
+void SkiaUnrefQueue::ScheduleDrainLocked(fxl::TimeDelta delay) {
+  if (drain_pending_) {
+    return;
+  }
+  drain_pending_ = true;
+  task_runner_->PostDelayedTask(
+      [strong = fxl::Ref(this)]() {
+        {
+          std::lock_guard<std::mutex> lock(strong->mutex_);
+          strong->drain_pending_ = false;
+        }
+        strong->DrainSlice();
+      },
+      delay);
+}
+
+void SkiaUnrefQueue::DrainSlice() {
+  if (!DrainUntil(fxl::TimePoint::Now() + kDrainSliceDuration)) {
+    return;
+  }
+  // Yield to the other tasks on the task runner before the next slice.
   std::lock_guard<std::mutex> lock(mutex_);
-  objects_.push_back(object);
-  if (!drain_pending_) {
-    drain_pending_ = true;
-    task_runner_->PostDelayedTask(
-        [strong = fxl::Ref(this)]() { strong->Drain(); }, drain_delay_);
+  if (queued_bytes_ > kBackpressureByteThreshold) {
+    ScheduleBackpressureDrainLocked();
+  } else {
+    ScheduleDrainLocked(fxl::TimeDelta::Zero());
+  }
+}
+
+bool SkiaUnrefQueue::DrainUntil(fxl::TimePoint deadline) {
+  TRACE_EVENT0("flutter", "SkiaUnrefQueue::DrainUntil");
+  std::vector<SkRefCnt*> batch;
+  batch.reserve(kDrainBatchSize);
+  while (true) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (objects_.empty()) {
+        return false;
+      }
+      if (fxl::TimePoint::Now() >= deadline) {
+        return true;
+      }
+      const size_t count = std::min(kDrainBatchSize, objects_.size());
+      for (size_t i = 0; i < count; i++) {
+        batch.push_back(objects_.front().object);
+        queued_bytes_ -= objects_.front().byte_size;
+        objects_.pop_front();
+      }
+      TraceCountersLocked();
+    }
+
+    for (SkRefCnt* skia_object : batch) {
+      skia_object->unref();
+    }
+    batch.clear();
   }
 }
 
 void SkiaUnrefQueue::Drain() {
-  std::deque<SkRefCnt*> skia_objects;
+  std::deque<Entry> skia_objects;
   {
     std::lock_guard<std::mutex> lock(mutex_);
     objects_.swap(skia_objects);
-    drain_pending_ = false;
+    queued_bytes_ = 0;
+    TraceCountersLocked();
+  }
+
+  for (const Entry& entry : skia_objects) {
+    entry.object->unref();
+  }
+}
+
+void SkiaUnrefQueue::NotifyIdle(fxl::TimePoint deadline) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (objects_.empty() || idle_drain_pending_) {
+      return;
+    }
+    idle_drain_pending_ = true;
   }
 
-  for (SkRefCnt* skia_object : skia_objects) {
-    skia_object->unref();
+  task_runner_->PostTask([strong = fxl::Ref(this), deadline]() {
+    {
+      std::lock_guard<std::mutex> lock(strong->mutex_);
+      strong->idle_drain_pending_ = false;
+    }
+    // The scheduled drain picks up whatever is left.
+    if (strong->DrainUntil(deadline)) {
+      std::lock_guard<std::mutex> lock(strong->mutex_);
+      strong->ScheduleBackpressureDrainLocked();
+    }
+  });
+}
+
+size_t SkiaUnrefQueue::GetQueuedObjectCount() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return objects_.size();
+}
+
+size_t SkiaUnrefQueue::GetQueuedByteSize() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return queued_bytes_;
+}
+
+void SkiaUnrefQueue::TraceCountersLocked() const {
+  if (!TRACE_EVENT_CATEGORY_ENABLED("flutter")) {
+    return;
   }
+  TRACE_COUNTER1("flutter", "SkiaUnrefQueue Objects", "count",
+                 static_cast<int64_t>(objects_.size()));
+  TRACE_COUNTER1("flutter", "SkiaUnrefQueue Bytes", "bytes",
+                 static_cast<int64_t>(queued_bytes_));
 }
 
 }  // namespace flow
@@ -11,15 +11,31 @@
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/task_runner.h"
 #include "lib/fxl/memory/ref_ptr.h"
+#include "lib/fxl/time/time_point.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkImageInfo.h"
+#include "third_party/skia/include/core/SkPicture.h"
+#include "third_party/skia/include/core/SkPixmap.h"
 #include "third_party/skia/include/core/SkRefCnt.h"
 
 namespace flow {
 
 // A queue that holds Skia objects that must be destructed on the the given task
 // runner.
+//
+// Objects are unreffed in bounded slices so that a large backlog does not stall
+// the task runner. Slices run after the drain delay and during idle periods
+// signalled by |NotifyIdle|. When the approximate size of the queued objects
+// exceeds a threshold, slices are posted back to back without waiting for the
+// drain delay till the backlog is under control again. Slices never overrun
+// their deadline so that other tasks can run in between.
 class SkiaUnrefQueue : public fxl::RefCountedThreadSafe<SkiaUnrefQueue> {
  public:
-  void Unref(SkRefCnt* object);
+  // The approximate number of bytes held by queued objects above which they
+  // are drained without waiting for the drain delay or an idle period.
+  static constexpr size_t kBackpressureByteThreshold = 64 << 20;
+
+  void Unref(SkRefCnt* object, size_t byte_size = 0);
 
   // Usually, the drain is called automatically. However, during IO manager
   // shutdown (when the platform side reference to the OpenGL context is about
@@ -28,23 +44,81 @@ class SkiaUnrefQueue : public fxl::RefCountedThreadSafe<SkiaUnrefQueue> {
   // after this call.
   void Drain();
 
+  // Drains queued objects on the task runner until the deadline. Called when
+  // the UI thread is idle since that is when the frame workload is least
+  // likely to be contending for the GPU.
+  void NotifyIdle(fxl::TimePoint deadline);
+
+  size_t GetQueuedObjectCount();
+
+  size_t GetQueuedByteSize();
+
  private:
+  struct Entry {
+    SkRefCnt* object;
+    size_t byte_size;
+  };
+
   const fxl::RefPtr<fxl::TaskRunner> task_runner_;
   const fxl::TimeDelta drain_delay_;
   std::mutex mutex_;
-  std::deque<SkRefCnt*> objects_;
+  std::deque<Entry> objects_;
+  size_t queued_bytes_;
   bool drain_pending_;
+  bool backpressure_drain_pending_;
+  bool idle_drain_pending_;
 
   SkiaUnrefQueue(fxl::RefPtr<fxl::TaskRunner> task_runner,
                  fxl::TimeDelta delay);
 
   ~SkiaUnrefQueue();
 
+  // Posts a drain after the given delay if one is not already pending. Must be
+  // called with the mutex held.
+  void ScheduleDrainLocked(fxl::TimeDelta delay);
+
+  void DrainSlice();
+
+  // Returns true if objects are still queued when the deadline is reached.
+  bool DrainUntil(fxl::TimePoint deadline);
+
+  // Posts a slice right away if the queued objects exceed the backpressure
+  // threshold and one is not already pending. Must be called with the mutex
+  // held.
+  void ScheduleBackpressureDrainLocked();
+
+  // Must be called with the mutex held.
+  void TraceCountersLocked() const;
+
   FRIEND_REF_COUNTED_THREAD_SAFE(SkiaUnrefQueue);
   FRIEND_MAKE_REF_COUNTED(SkiaUnrefQueue);
   FXL_DISALLOW_COPY_AND_ASSIGN(SkiaUnrefQueue);
 };
 
+// The approximate number of bytes that are released when the last reference to
+// the object is dropped. Used to apply backpressure on the unref queue.
+template <class T>
+size_t GetApproximateByteSize(const T& object) {
+  return 0;
+}
+
+inline size_t GetApproximateByteSize(const SkImage& image) {
+  SkPixmap pixmap;
+  if (image.peekPixels(&pixmap)) {
+    return pixmap.computeByteSize();
+  }
+  // Textures and lazily decoded images. Mipmaps are not accounted for. The
+  // color type of images that have not been decoded yet is unknown, they are
+  // assumed to decode to 32-bit pixels.
+  const int bytes_per_pixel = SkColorTypeBytesPerPixel(image.colorType());
+  return static_cast<size_t>(image.width()) * image.height() *
+         (bytes_per_pixel > 0 ? bytes_per_pixel : 4);
+}
+
+inline size_t GetApproximateByteSize(const SkPicture& picture) {
+  return picture.approximateBytesUsed();
+}
+
 /// An object whose deallocation needs to be performed on an specific unref
 /// queue. The template argument U need to have a call operator that returns
 /// that unref queue.
@@ -58,6 +132,7 @@ class SkiaGPUObject {
   SkiaGPUObject(sk_sp<SkiaObjectType> object, fxl::RefPtr<SkiaUnrefQueue> queue)
       : object_(std::move(object)), queue_(std::move(queue)) {
     FXL_DCHECK(queue_ && object_);
+    byte_size_ = GetApproximateByteSize(*object_);
   }
 
   SkiaGPUObject(SkiaGPUObject&&) = default;
@@ -70,7 +145,7 @@ class SkiaGPUObject {
 
   void reset() {
     if (object_) {
-      queue_->Unref(object_.release());
+      queue_->Unref(object_.release(), byte_size_);
     }
     queue_ = nullptr;
     FXL_DCHECK(object_ == nullptr);
@@ -79,6 +154,7 @@ class SkiaGPUObject {
  private:
   sk_sp<SkiaObjectType> object_;
   fxl::RefPtr<SkiaUnrefQueue> queue_;
+  size_t byte_size_ = 0;
 
   FXL_DISALLOW_COPY_AND_ASSIGN(SkiaGPUObject);
 };
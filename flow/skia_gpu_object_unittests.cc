@@ -0,0 +1,143 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "flutter/flow/skia_gpu_object.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkData.h"
+
+namespace {
+
+class TestObject : public SkRefCnt {
+ public:
+  TestObject(std::atomic<int>* destroyed, fml::AutoResetWaitableEvent* latch)
+      : destroyed_(destroyed), latch_(latch) {}
+
+  ~TestObject() override {
+    (*destroyed_)++;
+    latch_->Signal();
+  }
+
+ private:
+  std::atomic<int>* destroyed_;
+  fml::AutoResetWaitableEvent* latch_;
+};
+
+// Takes a while to unref, like a texture does in some drivers.
+class SlowObject : public SkRefCnt {
+ public:
+  explicit SlowObject(std::atomic<int>* destroyed) : destroyed_(destroyed) {}
+
+  ~SlowObject() override {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    (*destroyed_)++;
+  }
+
+ private:
+  std::atomic<int>* destroyed_;
+};
+
+// Long enough that the scheduled drain never runs during the test.
+const fxl::TimeDelta kNeverDrainDelay = fxl::TimeDelta::FromSeconds(3600);
+
+}  // namespace
+
+TEST(SkiaUnrefQueue, TracksQueuedObjectsAndBytes) {
+  fml::Thread thread;
+  auto queue = fxl::MakeRefCounted<flow::SkiaUnrefQueue>(
+      thread.GetTaskRunner(), kNeverDrainDelay);
+  std::atomic<int> destroyed(0);
+  fml::AutoResetWaitableEvent latch;
+
+  queue->Unref(new TestObject(&destroyed, &latch), 100);
+  queue->Unref(new TestObject(&destroyed, &latch), 200);
+  ASSERT_EQ(queue->GetQueuedObjectCount(), 2u);
+  ASSERT_EQ(queue->GetQueuedByteSize(), 300u);
+  ASSERT_EQ(destroyed, 0);
+
+  queue->Drain();
+  ASSERT_EQ(queue->GetQueuedObjectCount(), 0u);
+  ASSERT_EQ(queue->GetQueuedByteSize(), 0u);
+  ASSERT_EQ(destroyed, 2);
+}
+
+TEST(SkiaUnrefQueue, DrainsWhenIdle) {
+  fml::Thread thread;
+  auto queue = fxl::MakeRefCounted<flow::SkiaUnrefQueue>(
+      thread.GetTaskRunner(), kNeverDrainDelay);
+  std::atomic<int> destroyed(0);
+  fml::AutoResetWaitableEvent latch;
+
+  queue->Unref(new TestObject(&destroyed, &latch), 100);
+  queue->NotifyIdle(fxl::TimePoint::Now() + fxl::TimeDelta::FromSeconds(1));
+  latch.Wait();
+  ASSERT_EQ(destroyed, 1);
+  ASSERT_EQ(queue->GetQueuedByteSize(), 0u);
+}
+
+TEST(SkiaUnrefQueue, DrainsImmediatelyUnderBackpressure) {
+  fml::Thread thread;
+  auto queue = fxl::MakeRefCounted<flow::SkiaUnrefQueue>(
+      thread.GetTaskRunner(), kNeverDrainDelay);
+  std::atomic<int> destroyed(0);
+  fml::AutoResetWaitableEvent latch;
+
+  queue->Unref(new TestObject(&destroyed, &latch), 100);
+  queue->Unref(new TestObject(&destroyed, &latch),
+               flow::SkiaUnrefQueue::kBackpressureByteThreshold);
+  while (destroyed < 2) {
+    latch.Wait();
+  }
+  ASSERT_EQ(queue->GetQueuedObjectCount(), 0u);
+}
+
+TEST(SkiaUnrefQueue, SlicesYieldUnderBackpressure) {
+  fml::Thread thread;
+  auto queue = fxl::MakeRefCounted<flow::SkiaUnrefQueue>(
+      thread.GetTaskRunner(), kNeverDrainDelay);
+  std::atomic<int> destroyed(0);
+
+  constexpr int kObjectCount = 200;
+  for (int i = 0; i < kObjectCount; i++) {
+    queue->Unref(new SlowObject(&destroyed),
+                 flow::SkiaUnrefQueue::kBackpressureByteThreshold);
+  }
+
+  // Tasks posted while the queue is over the threshold run between slices
+  // instead of after the whole backlog.
+  fml::AutoResetWaitableEvent latch;
+  int destroyed_before_task = 0;
+  thread.GetTaskRunner()->PostTask([&]() {
+    destroyed_before_task = destroyed;
+    latch.Signal();
+  });
+  latch.Wait();
+  ASSERT_LT(destroyed_before_task, kObjectCount);
+
+  while (queue->GetQueuedObjectCount() > 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ASSERT_EQ(queue->GetQueuedByteSize(), 0u);
+}
+
+TEST(SkiaUnrefQueue, ImageByteSizeDependsOnColorType) {
+  const SkImageInfo n32_info = SkImageInfo::MakeN32Premul(100, 50);
+  sk_sp<SkImage> n32_image = SkImage::MakeRasterData(
+      n32_info, SkData::MakeUninitialized(n32_info.computeMinByteSize()),
+      n32_info.minRowBytes());
+  ASSERT_TRUE(n32_image);
+  ASSERT_EQ(flow::GetApproximateByteSize(*n32_image), 100u * 50u * 4u);
+
+  const SkImageInfo a8_info = SkImageInfo::MakeA8(100, 50);
+  sk_sp<SkImage> a8_image = SkImage::MakeRasterData(
+      a8_info, SkData::MakeUninitialized(a8_info.computeMinByteSize()),
+      a8_info.minRowBytes());
+  ASSERT_TRUE(a8_image);
+  ASSERT_EQ(flow::GetApproximateByteSize(*a8_image), 100u * 50u);
+}
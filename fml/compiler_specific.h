@@ -35,6 +35,17 @@
 #define FML_NOINLINE __declspec(noinline)
 #endif
 
+// The address the current function returns to. Identifies the call site of the
+// function as long as the function is not inlined.
+// Use like:
+//   FML_NOINLINE void DoStuff() { const void* caller = FML_RETURN_ADDRESS(); }
+#if defined(__GNUC__) || defined(__clang__)
+#define FML_RETURN_ADDRESS() __builtin_return_address(0)
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#define FML_RETURN_ADDRESS() _ReturnAddress()
+#endif
+
 // Specify memory alignment for structs, classes, etc.
 // Use like:
 //   class FML_ALIGNAS(16) MyClass { ... }
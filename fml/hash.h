@@ -0,0 +1,38 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_HASH_H_
+#define FLUTTER_FML_HASH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace fml {
+
+// 64-bit FNV-1a. Unlike |std::hash|, the result is the same in every process
+// and on every platform, so it may be persisted.
+
+// The hash of no bytes. Start with this value and mix in the data with
+// |HashBytes| and |HashValue|.
+constexpr uint64_t kHashSeed = 0xcbf29ce484222325ull;
+
+inline uint64_t HashBytes(uint64_t hash, const void* data, size_t length) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < length; i++) {
+    hash ^= bytes[i];
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
+
+// Mixes in the object representation of |value|. Only use this for types
+// without padding or lazily computed state.
+template <class T>
+inline uint64_t HashValue(uint64_t hash, const T& value) {
+  return HashBytes(hash, &value, sizeof(value));
+}
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_HASH_H_
@@ -0,0 +1,36 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string.h>
+
+#include "flutter/fml/hash.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace {
+
+uint64_t HashString(const char* string) {
+  return HashBytes(kHashSeed, string, strlen(string));
+}
+
+TEST(Hash, MatchesReferenceValues) {
+  ASSERT_EQ(HashString(""), 0xcbf29ce484222325ull);
+  ASSERT_EQ(HashString("a"), 0xaf63dc4c8601ec8cull);
+  ASSERT_EQ(HashString("foobar"), 0x85944171f73967e8ull);
+}
+
+TEST(Hash, CanBeComputedIncrementally) {
+  const uint64_t hash = HashBytes(HashString("foo"), "bar", 3);
+  ASSERT_EQ(hash, HashString("foobar"));
+}
+
+TEST(Hash, HashesTheRepresentationOfValues) {
+  const uint32_t value = 0x12345678;
+  ASSERT_EQ(HashValue(kHashSeed, value),
+            HashBytes(kHashSeed, &value, sizeof(value)));
+  ASSERT_NE(HashValue(kHashSeed, value), HashValue(kHashSeed, value + 1));
+}
+
+}  // namespace
+}  // namespace fml
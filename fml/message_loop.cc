@@ -71,6 +71,10 @@ void MessageLoop::RemoveTaskObserver(intptr_t key) {
   loop_->RemoveTaskObserver(key);
 }
 
+std::shared_ptr<TaskStats> MessageLoop::EnableTaskStats() {
+  return loop_->EnableTaskStats();
+}
+
 void MessageLoop::RunExpiredTasksNow() {
   loop_->RunExpiredTasksNow();
 }
@@ -5,7 +5,10 @@
 #ifndef FLUTTER_FML_MESSAGE_LOOP_H_
 #define FLUTTER_FML_MESSAGE_LOOP_H_
 
+#include <memory>
+
 #include "flutter/fml/macros.h"
+#include "flutter/fml/task_stats.h"
 #include "lib/fxl/tasks/task_runner.h"
 
 namespace fml {
@@ -28,6 +31,11 @@ class MessageLoop {
 
   void RemoveTaskObserver(intptr_t key);
 
+  // Starts recording how long the tasks of this loop wait to run and how long
+  // they run, by the site they were posted from. Returns the recorded stats.
+  // Recording stays enabled for the lifetime of the loop.
+  std::shared_ptr<TaskStats> EnableTaskStats();
+
   fxl::RefPtr<fml::TaskRunner> GetTaskRunner() const;
 
   // Exposed for the embedder shell which allows clients to poll for events
@@ -43,9 +43,11 @@ MessageLoopImpl::MessageLoopImpl() : order_(0), terminated_(false) {}
 
 MessageLoopImpl::~MessageLoopImpl() = default;
 
-void MessageLoopImpl::PostTask(fxl::Closure task, fxl::TimePoint target_time) {
+void MessageLoopImpl::PostTask(fxl::Closure task,
+                               fxl::TimePoint target_time,
+                               TaskStats::Site site) {
   FML_DCHECK(task != nullptr);
-  RegisterTask(task, target_time);
+  RegisterTask(task, target_time, site);
 }
 
 void MessageLoopImpl::RunExpiredTasksNow() {
@@ -67,6 +69,16 @@ void MessageLoopImpl::RemoveTaskObserver(intptr_t key) {
   task_observers_.erase(key);
 }
 
+std::shared_ptr<TaskStats> MessageLoopImpl::EnableTaskStats() {
+  FML_DCHECK(MessageLoop::GetCurrent().GetLoopImpl().get() == this)
+      << "Message loop task stats must be enabled on the same thread as the "
+         "loop.";
+  if (!task_stats_) {
+    task_stats_ = std::make_shared<TaskStats>();
+  }
+  return task_stats_;
+}
+
 void MessageLoopImpl::DoRun() {
   if (terminated_) {
     // Message loops may be run only once.
@@ -100,7 +112,8 @@ void MessageLoopImpl::DoTerminate() {
 }
 
 void MessageLoopImpl::RegisterTask(fxl::Closure task,
-                                   fxl::TimePoint target_time) {
+                                   fxl::TimePoint target_time,
+                                   TaskStats::Site site) {
   FML_DCHECK(task != nullptr);
   if (terminated_) {
     // If the message loop has already been terminated, PostTask should destruct
@@ -108,13 +121,13 @@ void MessageLoopImpl::RegisterTask(fxl::Closure task,
     return;
   }
   std::lock_guard<std::mutex> lock(delayed_tasks_mutex_);
-  delayed_tasks_.push({++order_, std::move(task), target_time});
+  delayed_tasks_.push({++order_, std::move(task), target_time, site});
   WakeUp(delayed_tasks_.top().target_time);
 }
 
 void MessageLoopImpl::RunExpiredTasks() {
   TRACE_EVENT0("fml", "MessageLoop::RunExpiredTasks");
-  std::vector<fxl::Closure> invocations;
+  std::vector<DelayedTask> invocations;
 
   {
     std::lock_guard<std::mutex> lock(delayed_tasks_mutex_);
@@ -129,7 +142,7 @@ void MessageLoopImpl::RunExpiredTasks() {
       if (top.target_time > now) {
         break;
       }
-      invocations.emplace_back(std::move(top.task));
+      invocations.emplace_back(std::move(top));
       delayed_tasks_.pop();
     }
 
@@ -138,7 +151,15 @@ void MessageLoopImpl::RunExpiredTasks() {
   }
 
   for (const auto& invocation : invocations) {
-    invocation();
+    if (task_stats_) {
+      const auto start = fxl::TimePoint::Now();
+      invocation.task();
+      const auto end = fxl::TimePoint::Now();
+      task_stats_->Record(invocation.site, start - invocation.target_time,
+                          end - start);
+    } else {
+      invocation.task();
+    }
     for (const auto& observer : task_observers_) {
       observer.second();
     }
@@ -8,12 +8,14 @@
 #include <atomic>
 #include <deque>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include <utility>
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/message_loop.h"
+#include "flutter/fml/task_stats.h"
 #include "lib/fxl/functional/closure.h"
 #include "lib/fxl/memory/ref_counted.h"
 #include "lib/fxl/time/time_point.h"
@@ -32,12 +34,16 @@ class MessageLoopImpl : public fxl::RefCountedThreadSafe<MessageLoopImpl> {
 
   virtual void WakeUp(fxl::TimePoint time_point) = 0;
 
-  void PostTask(fxl::Closure task, fxl::TimePoint target_time);
+  void PostTask(fxl::Closure task,
+                fxl::TimePoint target_time,
+                TaskStats::Site site);
 
   void AddTaskObserver(intptr_t key, fxl::Closure callback);
 
   void RemoveTaskObserver(intptr_t key);
 
+  std::shared_ptr<TaskStats> EnableTaskStats();
+
   void DoRun();
 
   void DoTerminate();
@@ -54,11 +60,16 @@ class MessageLoopImpl : public fxl::RefCountedThreadSafe<MessageLoopImpl> {
     size_t order;
     fxl::Closure task;
     fxl::TimePoint target_time;
+    TaskStats::Site site;
 
     DelayedTask(size_t p_order,
                 fxl::Closure p_task,
-                fxl::TimePoint p_target_time)
-        : order(p_order), task(std::move(p_task)), target_time(p_target_time) {}
+                fxl::TimePoint p_target_time,
+                TaskStats::Site p_site)
+        : order(p_order),
+          task(std::move(p_task)),
+          target_time(p_target_time),
+          site(p_site) {}
   };
 
   struct DelayedTaskCompare {
@@ -72,12 +83,16 @@ class MessageLoopImpl : public fxl::RefCountedThreadSafe<MessageLoopImpl> {
       priority_queue<DelayedTask, std::deque<DelayedTask>, DelayedTaskCompare>;
 
   std::map<intptr_t, fxl::Closure> task_observers_;
+  // Only accessed on the thread of the loop. Null unless enabled.
+  std::shared_ptr<TaskStats> task_stats_;
   std::mutex delayed_tasks_mutex_;
   DelayedTaskQueue delayed_tasks_;
   size_t order_;
   std::atomic_bool terminated_;
 
-  void RegisterTask(fxl::Closure task, fxl::TimePoint target_time);
+  void RegisterTask(fxl::Closure task,
+                    fxl::TimePoint target_time,
+                    TaskStats::Site site);
 
   void RunExpiredTasks();
 
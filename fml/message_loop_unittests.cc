@@ -278,3 +278,36 @@ TEST(MessageLoop, TaskObserverFire) {
   ASSERT_TRUE(started);
   ASSERT_TRUE(terminated);
 }
+
+TEST(MessageLoop, TaskStatsAreRecordedByPostingSite) {
+  bool done = false;
+  std::thread thread([&done]() {
+    fml::MessageLoop::EnsureInitializedForCurrentThread();
+    auto& loop = fml::MessageLoop::GetCurrent();
+    auto stats = loop.EnableTaskStats();
+    ASSERT_TRUE(stats);
+    ASSERT_EQ(loop.EnableTaskStats(), stats);
+    const size_t count = 3;
+    for (size_t i = 0; i < count; i++) {
+      loop.GetTaskRunner()->PostTask([]() {});
+    }
+    loop.GetTaskRunner()->PostTask(
+        []() { fml::MessageLoop::GetCurrent().Terminate(); });
+    loop.Run();
+    auto snapshot = stats->GetSnapshot();
+    // The tasks posted in the loop share a site. The terminating task was
+    // posted from another.
+    ASSERT_EQ(snapshot.size(), 2u);
+    size_t total = 0;
+    for (const auto& site : snapshot) {
+      ASSERT_NE(site.first, nullptr);
+      ASSERT_EQ(site.second.queueing_delay.count,
+                site.second.run_time.count);
+      total += site.second.run_time.count;
+    }
+    ASSERT_EQ(total, count + 1);
+    done = true;
+  });
+  thread.join();
+  ASSERT_TRUE(done);
+}
@@ -22,16 +22,18 @@ TaskRunner::TaskRunner(fxl::RefPtr<MessageLoopImpl> loop)
 TaskRunner::~TaskRunner() = default;
 
 void TaskRunner::PostTask(fxl::Closure task) {
-  loop_->PostTask(std::move(task), fxl::TimePoint::Now());
+  loop_->PostTask(std::move(task), fxl::TimePoint::Now(),
+                  FML_RETURN_ADDRESS());
 }
 
 void TaskRunner::PostTaskForTime(fxl::Closure task,
                                  fxl::TimePoint target_time) {
-  loop_->PostTask(std::move(task), target_time);
+  loop_->PostTask(std::move(task), target_time, FML_RETURN_ADDRESS());
 }
 
 void TaskRunner::PostDelayedTask(fxl::Closure task, fxl::TimeDelta delay) {
-  loop_->PostTask(std::move(task), fxl::TimePoint::Now() + delay);
+  loop_->PostTask(std::move(task), fxl::TimePoint::Now() + delay,
+                  FML_RETURN_ADDRESS());
 }
 
 bool TaskRunner::RunsTasksOnCurrentThread() {
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_FML_TASK_RUNNER_H_
 #define FLUTTER_FML_TASK_RUNNER_H_
 
+#include "flutter/fml/compiler_specific.h"
 #include "flutter/fml/macros.h"
 #include "lib/fxl/memory/ref_counted.h"
 #include "lib/fxl/tasks/task_runner.h"
@@ -15,11 +16,16 @@ class MessageLoopImpl;
 
 class TaskRunner final : public fxl::TaskRunner {
  public:
-  void PostTask(fxl::Closure task) override;
+  // The caller of each of these is recorded as the posting site of the task
+  // in the |TaskStats| of the loop. Tasks posted by |RunNowOrPostTask| are
+  // attributed to it.
+  FML_NOINLINE void PostTask(fxl::Closure task) override;
 
-  void PostTaskForTime(fxl::Closure task, fxl::TimePoint target_time) override;
+  FML_NOINLINE void PostTaskForTime(fxl::Closure task,
+                                    fxl::TimePoint target_time) override;
 
-  void PostDelayedTask(fxl::Closure task, fxl::TimeDelta delay) override;
+  FML_NOINLINE void PostDelayedTask(fxl::Closure task,
+                                    fxl::TimeDelta delay) override;
 
   bool RunsTasksOnCurrentThread() override;
 
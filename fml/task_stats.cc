@@ -0,0 +1,76 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/task_stats.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "flutter/fml/build_config.h"
+
+#if !defined(OS_WIN)
+#include <dlfcn.h>
+#endif
+
+namespace fml {
+
+constexpr size_t TaskStats::Histogram::kBucketCount;
+
+void TaskStats::Histogram::Add(fxl::TimeDelta duration) {
+  const int64_t micros = std::max<int64_t>(duration.ToMicroseconds(), 0);
+  size_t bucket = 0;
+  while (bucket + 1 < kBucketCount && (int64_t{1} << bucket) <= micros) {
+    bucket++;
+  }
+  count++;
+  total_micros += micros;
+  max_micros = std::max(max_micros, micros);
+  buckets[bucket]++;
+}
+
+TaskStats::TaskStats() = default;
+
+TaskStats::~TaskStats() = default;
+
+void TaskStats::Record(Site site,
+                       fxl::TimeDelta queueing_delay,
+                       fxl::TimeDelta run_time) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  SiteStats& stats = sites_[site];
+  stats.queueing_delay.Add(queueing_delay);
+  stats.run_time.Add(run_time);
+}
+
+std::map<TaskStats::Site, TaskStats::SiteStats> TaskStats::GetSnapshot()
+    const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return sites_;
+}
+
+void TaskStats::Reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  sites_.clear();
+}
+
+std::string TaskStats::GetSiteName(Site site) {
+  std::stringstream stream;
+#if !defined(OS_WIN)
+  Dl_info info = {};
+  if (dladdr(site, &info) != 0 && info.dli_fname != nullptr) {
+    std::string binary = info.dli_fname;
+    binary = binary.substr(binary.find_last_of('/') + 1);
+    stream << binary << "+0x" << std::hex
+           << (reinterpret_cast<uintptr_t>(site) -
+               reinterpret_cast<uintptr_t>(info.dli_fbase));
+    if (info.dli_sname != nullptr) {
+      stream << " (" << info.dli_sname << ")";
+    }
+    return stream.str();
+  }
+#endif
+  stream << site;
+  return stream.str();
+}
+
+}  // namespace fml
@@ -0,0 +1,76 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TASK_STATS_H_
+#define FLUTTER_FML_TASK_STATS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/synchronization/thread_annotations.h"
+#include "lib/fxl/time/time_delta.h"
+
+namespace fml {
+
+// Histograms of how long the tasks of a message loop waited to run after their
+// target time and of how long they ran, by the site they were posted from.
+// Recorded on the thread of the loop. May be read on any thread.
+class TaskStats {
+ public:
+  // Identifies the code that posted a task. This is the address the call to
+  // |TaskRunner::PostTask| (or one of its variants) returns to. See
+  // |GetSiteName| to map it back to source.
+  using Site = const void*;
+
+  struct Histogram {
+    // Bucket 0 counts durations under a microsecond and bucket i durations in
+    // [2^(i-1), 2^i) microseconds. The last bucket also counts all durations
+    // longer than that.
+    static constexpr size_t kBucketCount = 24;
+
+    uint64_t count = 0;
+    int64_t total_micros = 0;
+    int64_t max_micros = 0;
+    uint64_t buckets[kBucketCount] = {};
+
+    void Add(fxl::TimeDelta duration);
+  };
+
+  struct SiteStats {
+    Histogram queueing_delay;
+    Histogram run_time;
+  };
+
+  TaskStats();
+
+  ~TaskStats();
+
+  void Record(Site site,
+              fxl::TimeDelta queueing_delay,
+              fxl::TimeDelta run_time);
+
+  std::map<Site, SiteStats> GetSnapshot() const;
+
+  void Reset();
+
+  // A name for |site| that can be symbolized offline, even in stripped
+  // release builds: the binary the site is in and its offset in that binary.
+  // Followed by the name of the enclosing function if the binary exports it.
+  static std::string GetSiteName(Site site);
+
+ private:
+  mutable std::mutex mutex_;
+  std::map<Site, SiteStats> sites_ FML_GUARDED_BY(mutex_);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TaskStats);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TASK_STATS_H_
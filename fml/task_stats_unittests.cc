@@ -0,0 +1,67 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/task_stats.h"
+#include "gtest/gtest.h"
+
+TEST(TaskStats, HistogramBucketsArePowersOfTwo) {
+  fml::TaskStats::Histogram histogram;
+  histogram.Add(fxl::TimeDelta::FromMicroseconds(0));
+  histogram.Add(fxl::TimeDelta::FromMicroseconds(1));
+  histogram.Add(fxl::TimeDelta::FromMicroseconds(3));
+  histogram.Add(fxl::TimeDelta::FromMicroseconds(4));
+  histogram.Add(fxl::TimeDelta::FromMicroseconds(1000));
+  ASSERT_EQ(histogram.count, 5u);
+  ASSERT_EQ(histogram.total_micros, 1008);
+  ASSERT_EQ(histogram.max_micros, 1000);
+  ASSERT_EQ(histogram.buckets[0], 1u);
+  ASSERT_EQ(histogram.buckets[1], 1u);
+  ASSERT_EQ(histogram.buckets[2], 1u);
+  ASSERT_EQ(histogram.buckets[3], 1u);
+  // 512 <= 1000 < 1024.
+  ASSERT_EQ(histogram.buckets[10], 1u);
+}
+
+TEST(TaskStats, LastHistogramBucketIsOpenEnded) {
+  fml::TaskStats::Histogram histogram;
+  histogram.Add(fxl::TimeDelta::FromSeconds(3600));
+  ASSERT_EQ(histogram.buckets[fml::TaskStats::Histogram::kBucketCount - 1],
+            1u);
+}
+
+TEST(TaskStats, NegativeDurationsAreCountedAsZero) {
+  fml::TaskStats::Histogram histogram;
+  histogram.Add(fxl::TimeDelta::FromMicroseconds(-5));
+  ASSERT_EQ(histogram.total_micros, 0);
+  ASSERT_EQ(histogram.buckets[0], 1u);
+}
+
+TEST(TaskStats, RecordsBySite) {
+  fml::TaskStats stats;
+  int site1 = 0;
+  int site2 = 0;
+  stats.Record(&site1, fxl::TimeDelta::FromMicroseconds(10),
+               fxl::TimeDelta::FromMicroseconds(100));
+  stats.Record(&site1, fxl::TimeDelta::FromMicroseconds(20),
+               fxl::TimeDelta::FromMicroseconds(200));
+  stats.Record(&site2, fxl::TimeDelta::FromMicroseconds(30),
+               fxl::TimeDelta::FromMicroseconds(300));
+
+  auto snapshot = stats.GetSnapshot();
+  ASSERT_EQ(snapshot.size(), 2u);
+  ASSERT_EQ(snapshot[&site1].queueing_delay.count, 2u);
+  ASSERT_EQ(snapshot[&site1].queueing_delay.total_micros, 30);
+  ASSERT_EQ(snapshot[&site1].run_time.total_micros, 300);
+  ASSERT_EQ(snapshot[&site2].run_time.max_micros, 300);
+
+  stats.Reset();
+  ASSERT_TRUE(stats.GetSnapshot().empty());
+}
+
+TEST(TaskStats, SiteNamesAreNotEmpty) {
+  ASSERT_FALSE(fml::TaskStats::GetSiteName(
+                   reinterpret_cast<fml::TaskStats::Site>(
+                       &fml::TaskStats::GetSiteName))
+                   .empty());
+}
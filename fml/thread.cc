@@ -11,28 +11,110 @@
 #if defined(OS_WIN)
 #include <windows.h>
 #else
+#include <limits.h>
 #include <pthread.h>
+#include <unistd.h>
 #endif
 
+#if OS_MACOSX
+#include <pthread/qos.h>
+#elif OS_LINUX || OS_ANDROID
+#include <errno.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#endif
+
+#include <algorithm>
+#include <functional>
 #include <memory>
 #include <string>
 
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/synchronization/waitable_event.h"
+#include "lib/fxl/logging.h"
 
 namespace fml {
 
-Thread::Thread(const std::string& name) : joined_(false) {
+namespace {
+
+#if !defined(OS_WIN)
+void* RunThreadClosure(void* arg) {
+  std::unique_ptr<std::function<void()>> closure(
+      static_cast<std::function<void()>*>(arg));
+  (*closure)();
+  return nullptr;
+}
+#endif
+
+#if OS_LINUX || OS_ANDROID
+// The niceness of Android's THREAD_PRIORITY_DISPLAY is -4. Run the threads
+// that generate frames just above normal priority so that they do not compete
+// with the ones of the platform.
+constexpr int kDisplayNiceness = -1;
+// Android describes a niceness of -8 as "most important display threads, for
+// compositing the screen and retrieving input events". Conservatively run
+// raster threads at slightly lower priority than those.
+constexpr int kRasterNiceness = -5;
+// The niceness of Android's THREAD_PRIORITY_BACKGROUND.
+constexpr int kBackgroundNiceness = 10;
+
+// Raising the priority of a thread may not be allowed at all on desktop Linux
+// and, depending on the OEM, not as far as |kRasterNiceness| on Android.
+constexpr int kFallbackRasterNiceness = -2;
+
+bool SetCurrentThreadNiceness(int niceness) {
+  // On Linux, the niceness of a thread id only applies to that thread.
+  const int thread_id = static_cast<int>(syscall(SYS_gettid));
+  return ::setpriority(PRIO_PROCESS, thread_id, niceness) == 0;
+}
+#endif
+
+}  // namespace
+
+Thread::Thread(const std::string& name) : Thread(name, Config()) {}
+
+Thread::Thread(const std::string& name, const Config& config)
+    : joined_(false) {
   fml::AutoResetWaitableEvent latch;
   fxl::RefPtr<fml::TaskRunner> runner;
-  thread_ = std::make_unique<std::thread>([&latch, &runner, name]() -> void {
+  auto thread_main = [&latch, &runner, name, config]() -> void {
     SetCurrentThreadName(name);
+    SetCurrentThreadPriority(config.priority);
+    SetCurrentThreadAffinity(config.cpu_affinity_mask);
     fml::MessageLoop::EnsureInitializedForCurrentThread();
     auto& loop = MessageLoop::GetCurrent();
     runner = loop.GetTaskRunner();
     latch.Signal();
     loop.Run();
-  });
+  };
+#if defined(OS_WIN)
+  if (config.stack_size != 0) {
+    FXL_DLOG(INFO) << "Custom thread stack sizes are not supported on this "
+                      "platform.";
+  }
+  thread_ = std::make_unique<std::thread>(std::move(thread_main));
+#else
+  pthread_attr_t attributes;
+  FXL_CHECK(pthread_attr_init(&attributes) == 0);
+  if (config.stack_size != 0) {
+    // Some platforms only accept multiples of the page size.
+    const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t stack_size = std::max<size_t>(config.stack_size, PTHREAD_STACK_MIN);
+    stack_size = (stack_size + page_size - 1) / page_size * page_size;
+    if (pthread_attr_setstacksize(&attributes, stack_size) != 0) {
+      FXL_DLOG(ERROR) << "Could not set the stack size of thread '" << name
+                      << "' to " << stack_size << " bytes.";
+    }
+  }
+  auto closure =
+      std::make_unique<std::function<void()>>(std::move(thread_main));
+  FXL_CHECK(pthread_create(&thread_, &attributes, &RunThreadClosure,
+                           closure.get()) == 0);
+  // The thread owns the closure now.
+  closure.release();
+  pthread_attr_destroy(&attributes);
+#endif
   latch.Wait();
   task_runner_ = runner;
 }
@@ -51,7 +133,11 @@ void Thread::Join() {
   }
   joined_ = true;
   task_runner_->PostTask([]() { MessageLoop::GetCurrent().Terminate(); });
+#if defined(OS_WIN)
   thread_->join();
+#else
+  pthread_join(thread_, nullptr);
+#endif
 }
 
 #if defined(OS_WIN)
@@ -91,4 +177,79 @@ void Thread::SetCurrentThreadName(const std::string& name) {
 #endif
 }
 
+void Thread::SetCurrentThreadPriority(Priority priority) {
+  if (priority == Priority::kNormal) {
+    return;
+  }
+#if OS_MACOSX
+  // Darwin schedules threads by their quality of service class.
+  const qos_class_t qos_class = priority == Priority::kBackground
+                                    ? QOS_CLASS_UTILITY
+                                    : QOS_CLASS_USER_INTERACTIVE;
+  if (pthread_set_qos_class_self_np(qos_class, 0) != 0) {
+    FXL_DLOG(ERROR) << "Could not set the quality of service class of the "
+                       "current thread.";
+  }
+#elif OS_LINUX || OS_ANDROID
+  bool success = false;
+  switch (priority) {
+    case Priority::kDisplay:
+      success = SetCurrentThreadNiceness(kDisplayNiceness);
+      break;
+    case Priority::kRaster:
+      success = SetCurrentThreadNiceness(kRasterNiceness) ||
+                SetCurrentThreadNiceness(kFallbackRasterNiceness);
+      break;
+    default:
+      success = SetCurrentThreadNiceness(kBackgroundNiceness);
+      break;
+  }
+  if (!success) {
+    // Unprivileged processes may not raise the priority of their threads,
+    // which is expected on desktop Linux.
+    if (errno == EACCES || errno == EPERM) {
+      FXL_DLOG(INFO) << "Not permitted to raise the priority of the current "
+                        "thread.";
+    } else {
+      FXL_DLOG(ERROR) << "Could not set the priority of the current thread.";
+    }
+  }
+#elif OS_WIN
+  const int thread_priority = priority == Priority::kBackground
+                                  ? THREAD_PRIORITY_BELOW_NORMAL
+                                  : THREAD_PRIORITY_ABOVE_NORMAL;
+  if (!SetThreadPriority(GetCurrentThread(), thread_priority)) {
+    FXL_DLOG(ERROR) << "Could not set the priority of the current thread.";
+  }
+#else
+  FXL_DLOG(INFO) << "Could not set the thread priority on this platform.";
+#endif
+}
+
+void Thread::SetCurrentThreadAffinity(uint64_t cpu_affinity_mask) {
+  if (cpu_affinity_mask == 0) {
+    return;
+  }
+#if OS_LINUX || OS_ANDROID
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (int cpu = 0; cpu < 64 && cpu < CPU_SETSIZE; cpu++) {
+    if (cpu_affinity_mask & (uint64_t{1} << cpu)) {
+      CPU_SET(cpu, &cpu_set);
+    }
+  }
+  if (sched_setaffinity(0, sizeof(cpu_set), &cpu_set) != 0) {
+    FXL_DLOG(ERROR) << "Could not set the CPU affinity of the current thread.";
+  }
+#elif OS_WIN
+  if (SetThreadAffinityMask(GetCurrentThread(),
+                            static_cast<DWORD_PTR>(cpu_affinity_mask)) == 0) {
+    FXL_DLOG(ERROR) << "Could not set the CPU affinity of the current thread.";
+  }
+#else
+  // Darwin only supports affinity hints between threads, not masks of CPUs.
+  FXL_DLOG(INFO) << "Could not set the CPU affinity on this platform.";
+#endif
+}
+
 }  // namespace fml
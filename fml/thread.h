@@ -5,19 +5,57 @@
 #ifndef FLUTTER_FML_THREAD_H_
 #define FLUTTER_FML_THREAD_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <atomic>
 #include <memory>
+#include <string>
 #include <thread>
 
+#include "flutter/fml/build_config.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
 
+#if !defined(OS_WIN)
+#include <pthread.h>
+#endif
+
 namespace fml {
 
 class Thread {
  public:
+  enum class Priority {
+    // The default priority of threads of the process.
+    kNormal,
+    // For threads that generate the content of frames. Missing their deadline
+    // is visible to the user as jank.
+    kDisplay,
+    // For threads that rasterize frames. Like |kDisplay| but closer to the
+    // priority of the platform compositor.
+    kRaster,
+    // For threads whose work may be delayed in favor of other threads, e.g.
+    // the loading of resources.
+    kBackground,
+  };
+
+  struct Config {
+    Priority priority = Priority::kNormal;
+    // Bit N allows the thread to run on CPU N. The thread may run on any CPU
+    // if no bits are set.
+    uint64_t cpu_affinity_mask = 0;
+    // The size of the stack of the thread in bytes. The platform default is
+    // used if zero.
+    size_t stack_size = 0;
+  };
+
   explicit Thread(const std::string& name = "");
 
+  // The configuration is applied on a best effort basis. Configuration the
+  // platform does not support or the process is not allowed to apply is
+  // ignored.
+  Thread(const std::string& name, const Config& config);
+
   ~Thread();
 
   fxl::RefPtr<fml::TaskRunner> GetTaskRunner() const;
@@ -25,12 +63,20 @@ class Thread {
   void Join();
 
  private:
+#if defined(OS_WIN)
   std::unique_ptr<std::thread> thread_;
+#else
+  pthread_t thread_;
+#endif
   fxl::RefPtr<fml::TaskRunner> task_runner_;
   std::atomic_bool joined_;
 
   static void SetCurrentThreadName(const std::string& name);
 
+  static void SetCurrentThreadPriority(Priority priority);
+
+  static void SetCurrentThreadAffinity(uint64_t cpu_affinity_mask);
+
   FML_DISALLOW_COPY_AND_ASSIGN(Thread);
 };
 
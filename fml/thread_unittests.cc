@@ -4,8 +4,18 @@
 
 #include "gtest/gtest.h"
 
+#include "flutter/fml/build_config.h"
 #include "flutter/fml/thread.h"
 
+#if OS_LINUX
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 TEST(Thread, CanStartAndEnd) {
   fml::Thread thread;
   ASSERT_TRUE(thread.GetTaskRunner());
@@ -24,3 +34,72 @@ TEST(Thread, HasARunningMessageLoop) {
   thread.Join();
   ASSERT_TRUE(done);
 }
+
+#if OS_LINUX
+
+TEST(Thread, AppliesConfigOnLinux) {
+  cpu_set_t process_cpus;
+  CPU_ZERO(&process_cpus);
+  ASSERT_EQ(sched_getaffinity(0, sizeof(process_cpus), &process_cpus), 0);
+  int first_cpu = 0;
+  while (first_cpu < 64 && !CPU_ISSET(first_cpu, &process_cpus)) {
+    first_cpu++;
+  }
+  ASSERT_LT(first_cpu, 64);
+
+  fml::Thread::Config config;
+  // Lowering the priority of a thread is always allowed.
+  config.priority = fml::Thread::Priority::kBackground;
+  config.cpu_affinity_mask = uint64_t{1} << first_cpu;
+  config.stack_size = 1024 * 1024;
+  fml::Thread thread("config_test", config);
+
+  int niceness = 0;
+  cpu_set_t thread_cpus;
+  CPU_ZERO(&thread_cpus);
+  size_t stack_size = 0;
+  thread.GetTaskRunner()->PostTask(
+      [&niceness, &thread_cpus, &stack_size]() {
+        errno = 0;
+        niceness = getpriority(PRIO_PROCESS, syscall(SYS_gettid));
+        ASSERT_EQ(errno, 0);
+        ASSERT_EQ(sched_getaffinity(0, sizeof(thread_cpus), &thread_cpus), 0);
+        pthread_attr_t attributes;
+        ASSERT_EQ(pthread_getattr_np(pthread_self(), &attributes), 0);
+        pthread_attr_getstacksize(&attributes, &stack_size);
+        pthread_attr_destroy(&attributes);
+      });
+  thread.Join();
+
+  ASSERT_GT(niceness, 0);
+  ASSERT_EQ(CPU_COUNT(&thread_cpus), 1);
+  ASSERT_TRUE(CPU_ISSET(first_cpu, &thread_cpus));
+  ASSERT_GE(stack_size, config.stack_size);
+}
+
+static int GetThreadNiceness(fml::Thread::Priority priority) {
+  fml::Thread::Config config;
+  config.priority = priority;
+  fml::Thread thread("priority_test", config);
+  int niceness = 0;
+  thread.GetTaskRunner()->PostTask([&niceness]() {
+    niceness = getpriority(PRIO_PROCESS, syscall(SYS_gettid));
+  });
+  thread.Join();
+  return niceness;
+}
+
+TEST(Thread, OrdersPrioritiesOnLinux) {
+  const int normal = GetThreadNiceness(fml::Thread::Priority::kNormal);
+  const int display = GetThreadNiceness(fml::Thread::Priority::kDisplay);
+  const int raster = GetThreadNiceness(fml::Thread::Priority::kRaster);
+  const int background = GetThreadNiceness(fml::Thread::Priority::kBackground);
+
+  // Raising the priority is not allowed without privileges, in which case the
+  // thread keeps the niceness of the process.
+  ASSERT_LE(raster, display);
+  ASSERT_LE(display, normal);
+  ASSERT_GT(background, normal);
+}
+
+#endif  // OS_LINUX
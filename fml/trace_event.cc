@@ -4,11 +4,15 @@
 
 #include "flutter/fml/trace_event.h"
 
+#include <atomic>
+
 #include "third_party/dart/runtime/include/dart_tools_api.h"
 
 namespace fml {
 namespace tracing {
 
+static std::atomic_bool gTraceEnabled(false);
+
 void TraceEvent0(TraceArg category_group, TraceArg name) {
   Dart_TimelineEvent(name,                       // label
                      Dart_TimelineGetMicros(),   // timestamp0
@@ -136,6 +140,31 @@ void TraceEventInstant0(TraceArg category_group, TraceArg name) {
   );
 }
 
+void TraceCounter1(TraceArg category_group,
+                   TraceArg name,
+                   TraceArg arg1_name,
+                   int64_t arg1_val) {
+  const std::string value = std::to_string(arg1_val);
+  const char* arg_names[] = {arg1_name};
+  const char* arg_values[] = {value.c_str()};
+  Dart_TimelineEvent(name,                         // label
+                     Dart_TimelineGetMicros(),     // timestamp0
+                     0,                            // timestamp1_or_async_id
+                     Dart_Timeline_Event_Counter,  // event type
+                     1,                            // argument_count
+                     arg_names,                    // argument_names
+                     arg_values                    // argument_values
+  );
+}
+
+bool TraceCategoryEnabled(TraceArg category_group) {
+  return gTraceEnabled.load(std::memory_order_relaxed);
+}
+
+void TraceSetEnabled(bool enabled) {
+  gTraceEnabled.store(enabled, std::memory_order_relaxed);
+}
+
 void TraceEventFlowBegin0(TraceArg category_group,
                           TraceArg name,
                           TraceIDArg id) {
@@ -18,6 +18,8 @@
 #define TRACE_EVENT_ASYNC_END0(a, b, c) TRACE_ASYNC_END(a, b, c)
 #define TRACE_EVENT_ASYNC_BEGIN1(a, b, c, d, e) TRACE_ASYNC_BEGIN(a, b, c, d, e)
 #define TRACE_EVENT_ASYNC_END1(a, b, c, d, e) TRACE_ASYNC_END(a, b, c, d, e)
+#define TRACE_COUNTER1(a, b, c, d) TRACE_COUNTER(a, b, 0, c, d)
+#define TRACE_EVENT_CATEGORY_ENABLED(a) TRACE_CATEGORY_ENABLED(a)
 
 #else  // defined(__Fuchsia__)
 
@@ -61,6 +63,14 @@
 #define TRACE_EVENT_INSTANT0(category_group, name) \
   ::fml::tracing::TraceEventInstant0(category_group, name);
 
+#define TRACE_COUNTER1(category_group, name, arg1_name, arg1_val) \
+  ::fml::tracing::TraceCounter1(category_group, name, arg1_name, arg1_val);
+
+// Whether events of the category are being recorded. Trace arguments that are
+// expensive to compute should only be computed if this is true.
+#define TRACE_EVENT_CATEGORY_ENABLED(category_group) \
+  ::fml::tracing::TraceCategoryEnabled(category_group)
+
 #define TRACE_FLOW_BEGIN(category, name, id) \
   ::fml::tracing::TraceEventFlowBegin0(category, name, id);
 
@@ -114,6 +124,19 @@ void TraceEventAsyncEnd1(TraceArg category_group,
 
 void TraceEventInstant0(TraceArg category_group, TraceArg name);
 
+void TraceCounter1(TraceArg category_group,
+                   TraceArg name,
+                   TraceArg arg1_name,
+                   int64_t arg1_val);
+
+// All categories are recorded into the embedder stream of the Dart timeline.
+// So they are either all enabled or all disabled.
+bool TraceCategoryEnabled(TraceArg category_group);
+
+// Called when the recording of the embedder stream of the Dart timeline is
+// started or stopped.
+void TraceSetEnabled(bool enabled);
+
 void TraceEventFlowBegin0(TraceArg category_group,
                           TraceArg name,
                           TraceIDArg id);
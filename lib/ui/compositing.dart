@@ -222,12 +222,18 @@ class SceneBuilder extends NativeFieldWrapperClass2 {
   /// Adds a [Picture] to the scene.
   ///
   /// The picture is rasterized at the given offset.
-  void addPicture(Offset offset, Picture picture, { bool isComplexHint: false, bool willChangeHint: false }) {
+  ///
+  /// Set `isOpaqueHint` if the picture paints every pixel within its cull rect
+  /// with an opaque color. Layers that are entirely covered by opaque pictures
+  /// added after them are not painted.
+  void addPicture(Offset offset, Picture picture, { bool isComplexHint: false, bool willChangeHint: false, bool isOpaqueHint: false }) {
     int hints = 0;
     if (isComplexHint)
       hints |= 1;
     if (willChangeHint)
       hints |= 2;
+    if (isOpaqueHint)
+      hints |= 4;
     _addPicture(offset.dx, offset.dy, picture, hints);
   }
   void _addPicture(double dx, double dy, Picture picture, int hints) native 'SceneBuilder_addPicture';
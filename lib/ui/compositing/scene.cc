@@ -27,20 +27,22 @@ IMPLEMENT_WRAPPERTYPEINFO(ui, Scene);
 DART_BIND_ALL(Scene, FOR_EACH_BINDING)
 
 fxl::RefPtr<Scene> Scene::create(std::unique_ptr<flow::Layer> rootLayer,
+                                 std::unique_ptr<flow::LayerArena> arena,
                                  uint32_t rasterizerTracingThreshold,
                                  bool checkerboardRasterCacheImages,
                                  bool checkerboardOffscreenLayers) {
   return fxl::MakeRefCounted<Scene>(
-      std::move(rootLayer), rasterizerTracingThreshold,
+      std::move(rootLayer), std::move(arena), rasterizerTracingThreshold,
       checkerboardRasterCacheImages, checkerboardOffscreenLayers);
 }
 
 Scene::Scene(std::unique_ptr<flow::Layer> rootLayer,
+             std::unique_ptr<flow::LayerArena> arena,
              uint32_t rasterizerTracingThreshold,
              bool checkerboardRasterCacheImages,
              bool checkerboardOffscreenLayers)
     : m_layerTree(new flow::LayerTree()) {
-  m_layerTree->set_root_layer(std::move(rootLayer));
+  m_layerTree->set_root_layer(std::move(rootLayer), std::move(arena));
   m_layerTree->set_rasterizer_tracing_threshold(rasterizerTracingThreshold);
   m_layerTree->set_checkerboard_raster_cache_images(
       checkerboardRasterCacheImages);
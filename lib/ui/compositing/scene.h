@@ -25,6 +25,7 @@ class Scene : public RefCountedDartWrappable<Scene> {
  public:
   ~Scene() override;
   static fxl::RefPtr<Scene> create(std::unique_ptr<flow::Layer> rootLayer,
+                                   std::unique_ptr<flow::LayerArena> arena,
                                    uint32_t rasterizerTracingThreshold,
                                    bool checkerboardRasterCacheImages,
                                    bool checkerboardOffscreenLayers);
@@ -41,6 +42,7 @@ class Scene : public RefCountedDartWrappable<Scene> {
 
  private:
   explicit Scene(std::unique_ptr<flow::Layer> rootLayer,
+                 std::unique_ptr<flow::LayerArena> arena,
                  uint32_t rasterizerTracingThreshold,
                  bool checkerboardRasterCacheImages,
                  bool checkerboardOffscreenLayers);
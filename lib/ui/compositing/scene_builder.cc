@@ -88,7 +88,7 @@ void SceneBuilder::pushColorFilter(int color, int blendMode) {
 }
 
 void SceneBuilder::pushBackdropFilter(ImageFilter* filter) {
-  layer_builder_->PushBackdropFilter(filter->filter());
+  layer_builder_->PushBackdropFilter(filter->filter(), filter->blur_sigma());
 }
 
 void SceneBuilder::pushShaderMask(Shader* shader,
@@ -130,8 +130,9 @@ void SceneBuilder::addPicture(double dx,
       SkPoint::Make(dx, dy),                             //
       UIDartState::CreateGPUObject(picture->picture()),  //
       !!(hints & 1),                                     // picture is complex
-      !!(hints & 2)                                      // picture will change
-  );
+      !!(hints & 2),                                     // picture will change
+      !!(hints & 4),                                     // picture is opaque
+      picture->content_hash());
 }
 
 void SceneBuilder::addTexture(double dx,
@@ -180,7 +181,8 @@ void SceneBuilder::setCheckerboardOffscreenLayers(bool checkerboard) {
 
 fxl::RefPtr<Scene> SceneBuilder::build() {
   fxl::RefPtr<Scene> scene =
-      Scene::create(layer_builder_->TakeLayer(),
+      Scene::create(layer_builder_->TakeLayer(),  //
+                    layer_builder_->TakeArena(),  //
                     layer_builder_->GetRasterizerTracingThreshold(),
                     layer_builder_->GetCheckerboardRasterCacheImages(),
                     layer_builder_->GetCheckerboardOffscreenLayers());
@@ -2815,6 +2815,7 @@ class Canvas extends NativeFieldWrapperClass2 {
       throw new ArgumentError('"recorder" must not already be associated with another Canvas.');
     cullRect ??= Rect.largest;
     _constructor(recorder, cullRect.left, cullRect.top, cullRect.right, cullRect.bottom);
+    recorder._canvas = this;
   }
   void _constructor(PictureRecorder recorder,
                     double left,
@@ -2822,6 +2823,27 @@ class Canvas extends NativeFieldWrapperClass2 {
                     double right,
                     double bottom) native 'Canvas_constructor';
 
+  // Most operations are not sent to the engine one at a time. Instead they are
+  // accumulated here and submitted in a single native call when an operation
+  // that is not batched is encountered or when the recording ends.
+  final _DisplayListBuilder _displayList = new _DisplayListBuilder();
+
+  void _flushDisplayList() {
+    if (_displayList.isEmpty)
+      return;
+    _drawDisplayList(
+      _displayList._paths,
+      _displayList._images,
+      _displayList._shaders,
+      _displayList._ops,
+    );
+    _displayList._reset();
+  }
+  void _drawDisplayList(List<Path> paths,
+                        List<Image> images,
+                        List<Shader> shaders,
+                        Int32List ops) native 'Canvas_drawDisplayList';
+
   /// Saves a copy of the current transform and clip on the save stack.
   ///
   /// Call [restore] to pop the save stack.
@@ -2830,7 +2852,9 @@ class Canvas extends NativeFieldWrapperClass2 {
   ///
   ///  * [saveLayer], which does the same thing but additionally also groups the
   ///    commands done until the matching [restore].
-  void save() native 'Canvas_save';
+  void save() {
+    _displayList._op(_DisplayListBuilder._kSave);
+  }
 
   /// Saves a copy of the current transform and clip on the save stack, and then
   /// creates a new group which subsequent calls will become a part of. When the
@@ -2943,6 +2967,7 @@ class Canvas extends NativeFieldWrapperClass2 {
   ///    [saveLayer].
   void saveLayer(Rect bounds, Paint paint) {
     assert(paint != null);
+    _flushDisplayList();
     if (bounds == null) {
       _saveLayerWithoutBounds(paint._objects, paint._data);
     } else {
@@ -2967,7 +2992,9 @@ class Canvas extends NativeFieldWrapperClass2 {
   ///
   /// If the state was pushed with with [saveLayer], then this call will also
   /// cause the new layer to be composited into the previous layer.
-  void restore() native 'Canvas_restore';
+  void restore() {
+    _displayList._op(_DisplayListBuilder._kRestore);
+  }
 
   /// Returns the number of items on the save stack, including the
   /// initial state. This means it returns 1 for a clean canvas, and
@@ -2975,11 +3002,20 @@ class Canvas extends NativeFieldWrapperClass2 {
   /// each matching call to [restore] decrements it.
   ///
   /// This number cannot go below 1.
-  int getSaveCount() native 'Canvas_getSaveCount';
+  int getSaveCount() {
+    _flushDisplayList();
+    return _getSaveCount();
+  }
+  int _getSaveCount() native 'Canvas_getSaveCount';
 
   /// Add a translation to the current transform, shifting the coordinate space
   /// horizontally by the first argument and vertically by the second argument.
-  void translate(double dx, double dy) native 'Canvas_translate';
+  void translate(double dx, double dy) {
+    _displayList
+      .._op(_DisplayListBuilder._kTranslate)
+      .._float(dx)
+      .._float(dy);
+  }
 
   /// Add an axis-aligned scale to the current transform, scaling by the first
   /// argument in the horizontal direction and the second in the vertical
@@ -2987,18 +3023,30 @@ class Canvas extends NativeFieldWrapperClass2 {
   ///
   /// If [sy] is unspecified, [sx] will be used for the scale in both
   /// directions.
-  void scale(double sx, [double sy]) => _scale(sx, sy ?? sx);
-
-  void _scale(double sx, double sy) native 'Canvas_scale';
+  void scale(double sx, [double sy]) {
+    _displayList
+      .._op(_DisplayListBuilder._kScale)
+      .._float(sx)
+      .._float(sy ?? sx);
+  }
 
   /// Add a rotation to the current transform. The argument is in radians clockwise.
-  void rotate(double radians) native 'Canvas_rotate';
+  void rotate(double radians) {
+    _displayList
+      .._op(_DisplayListBuilder._kRotate)
+      .._float(radians);
+  }
 
   /// Add an axis-aligned skew to the current transform, with the first argument
   /// being the horizontal skew in radians clockwise around the origin, and the
   /// second argument being the vertical skew in radians clockwise around the
   /// origin.
-  void skew(double sx, double sy) native 'Canvas_skew';
+  void skew(double sx, double sy) {
+    _displayList
+      .._op(_DisplayListBuilder._kSkew)
+      .._float(sx)
+      .._float(sy);
+  }
 
   /// Multiply the current transform by the specified 4⨉4 transformation matrix
   /// specified as a list of values in column-major order.
@@ -3006,6 +3054,7 @@ class Canvas extends NativeFieldWrapperClass2 {
     assert(matrix4 != null);
     if (matrix4.length != 16)
       throw new ArgumentError('"matrix4" must have 16 entries.');
+    _flushDisplayList();
     _transform(matrix4);
   }
   void _transform(Float64List matrix4) native 'Canvas_transform';
@@ -3025,14 +3074,12 @@ class Canvas extends NativeFieldWrapperClass2 {
     assert(_rectIsValid(rect));
     assert(clipOp != null);
     assert(doAntiAlias != null);
-    _clipRect(rect.left, rect.top, rect.right, rect.bottom, clipOp.index, doAntiAlias);
+    _displayList
+      .._op(_DisplayListBuilder._kClipRect)
+      .._rect(rect)
+      .._int(clipOp.index)
+      .._bool(doAntiAlias);
   }
-  void _clipRect(double left,
-                 double top,
-                 double right,
-                 double bottom,
-                 int clipOp,
-                 bool doAntiAlias) native 'Canvas_clipRect';
 
   /// Reduces the clip region to the intersection of the current clip and the
   /// given rounded rectangle.
@@ -3045,9 +3092,11 @@ class Canvas extends NativeFieldWrapperClass2 {
   void clipRRect(RRect rrect, {bool doAntiAlias = true}) {
     assert(_rrectIsValid(rrect));
     assert(doAntiAlias != null);
-    _clipRRect(rrect._value, doAntiAlias);
+    _displayList
+      .._op(_DisplayListBuilder._kClipRRect)
+      .._rrect(rrect)
+      .._bool(doAntiAlias);
   }
-  void _clipRRect(Float32List rrect, bool doAntiAlias) native 'Canvas_clipRRect';
 
   /// Reduces the clip region to the intersection of the current clip and the
   /// given [Path].
@@ -3061,9 +3110,13 @@ class Canvas extends NativeFieldWrapperClass2 {
   void clipPath(Path path, {bool doAntiAlias = true}) {
     assert(path != null); // path is checked on the engine side
     assert(doAntiAlias != null);
-    _clipPath(path, doAntiAlias);
+    _displayList
+      .._op(_DisplayListBuilder._kClipPath)
+      .._path(path)
+      .._bool(doAntiAlias);
+    // Paths are mutable, so submit it before the caller can change it.
+    _flushDisplayList();
   }
-  void _clipPath(Path path, bool doAntiAlias) native 'Canvas_clipPath';
 
   /// Paints the given [Color] onto the canvas, applying the given
   /// [BlendMode], with the given color being the source and the background
@@ -3071,9 +3124,11 @@ class Canvas extends NativeFieldWrapperClass2 {
   void drawColor(Color color, BlendMode blendMode) {
     assert(color != null);
     assert(blendMode != null);
-    _drawColor(color.value, blendMode.index);
+    _displayList
+      .._op(_DisplayListBuilder._kDrawColor)
+      .._int(color.value)
+      .._int(blendMode.index);
   }
-  void _drawColor(int color, int blendMode) native 'Canvas_drawColor';
 
   /// Draws a line between the given points using the given paint. The line is
   /// stroked, the value of the [Paint.style] is ignored for this call.
@@ -3083,14 +3138,12 @@ class Canvas extends NativeFieldWrapperClass2 {
     assert(_offsetIsValid(p1));
     assert(_offsetIsValid(p2));
     assert(paint != null);
-    _drawLine(p1.dx, p1.dy, p2.dx, p2.dy, paint._objects, paint._data);
+    _displayList
+      .._op(_DisplayListBuilder._kDrawLine)
+      .._offset(p1)
+      .._offset(p2)
+      .._paint(paint);
   }
-  void _drawLine(double x1,
-                 double y1,
-                 double x2,
-                 double y2,
-                 List<dynamic> paintObjects,
-                 ByteData paintData) native 'Canvas_drawLine';
 
   /// Fills the canvas with the given [Paint].
   ///
@@ -3098,35 +3151,32 @@ class Canvas extends NativeFieldWrapperClass2 {
   /// [drawColor] instead.
   void drawPaint(Paint paint) {
     assert(paint != null);
-    _drawPaint(paint._objects, paint._data);
+    _displayList
+      .._op(_DisplayListBuilder._kDrawPaint)
+      .._paint(paint);
   }
-  void _drawPaint(List<dynamic> paintObjects, ByteData paintData) native 'Canvas_drawPaint';
 
   /// Draws a rectangle with the given [Paint]. Whether the rectangle is filled
   /// or stroked (or both) is controlled by [Paint.style].
   void drawRect(Rect rect, Paint paint) {
     assert(_rectIsValid(rect));
     assert(paint != null);
-    _drawRect(rect.left, rect.top, rect.right, rect.bottom,
-              paint._objects, paint._data);
+    _displayList
+      .._op(_DisplayListBuilder._kDrawRect)
+      .._rect(rect)
+      .._paint(paint);
   }
-  void _drawRect(double left,
-                 double top,
-                 double right,
-                 double bottom,
-                 List<dynamic> paintObjects,
-                 ByteData paintData) native 'Canvas_drawRect';
 
   /// Draws a rounded rectangle with the given [Paint]. Whether the rectangle is
   /// filled or stroked (or both) is controlled by [Paint.style].
   void drawRRect(RRect rrect, Paint paint) {
     assert(_rrectIsValid(rrect));
     assert(paint != null);
-    _drawRRect(rrect._value, paint._objects, paint._data);
+    _displayList
+      .._op(_DisplayListBuilder._kDrawRRect)
+      .._rrect(rrect)
+      .._paint(paint);
   }
-  void _drawRRect(Float32List rrect,
-                  List<dynamic> paintObjects,
-                  ByteData paintData) native 'Canvas_drawRRect';
 
   /// Draws a shape consisting of the difference between two rounded rectangles
   /// with the given [Paint]. Whether this shape is filled or stroked (or both)
@@ -3137,12 +3187,12 @@ class Canvas extends NativeFieldWrapperClass2 {
     assert(_rrectIsValid(outer));
     assert(_rrectIsValid(inner));
     assert(paint != null);
-    _drawDRRect(outer._value, inner._value, paint._objects, paint._data);
+    _displayList
+      .._op(_DisplayListBuilder._kDrawDRRect)
+      .._rrect(outer)
+      .._rrect(inner)
+      .._paint(paint);
   }
-  void _drawDRRect(Float32List outer,
-                   Float32List inner,
-                   List<dynamic> paintObjects,
-                   ByteData paintData) native 'Canvas_drawDRRect';
 
   /// Draws an axis-aligned oval that fills the given axis-aligned rectangle
   /// with the given [Paint]. Whether the oval is filled or stroked (or both) is
@@ -3150,15 +3200,11 @@ class Canvas extends NativeFieldWrapperClass2 {
   void drawOval(Rect rect, Paint paint) {
     assert(_rectIsValid(rect));
     assert(paint != null);
-    _drawOval(rect.left, rect.top, rect.right, rect.bottom,
-              paint._objects, paint._data);
+    _displayList
+      .._op(_DisplayListBuilder._kDrawOval)
+      .._rect(rect)
+      .._paint(paint);
   }
-  void _drawOval(double left,
-                 double top,
-                 double right,
-                 double bottom,
-                 List<dynamic> paintObjects,
-                 ByteData paintData) native 'Canvas_drawOval';
 
   /// Draws a circle centered at the point given by the first argument and
   /// that has the radius given by the second argument, with the [Paint] given in
@@ -3167,13 +3213,12 @@ class Canvas extends NativeFieldWrapperClass2 {
   void drawCircle(Offset c, double radius, Paint paint) {
     assert(_offsetIsValid(c));
     assert(paint != null);
-    _drawCircle(c.dx, c.dy, radius, paint._objects, paint._data);
+    _displayList
+      .._op(_DisplayListBuilder._kDrawCircle)
+      .._offset(c)
+      .._float(radius)
+      .._paint(paint);
   }
-  void _drawCircle(double x,
-                   double y,
-                   double radius,
-                   List<dynamic> paintObjects,
-                   ByteData paintData) native 'Canvas_drawCircle';
 
   /// Draw an arc scaled to fit inside the given rectangle. It starts from
   /// startAngle radians around the oval up to startAngle + sweepAngle
@@ -3188,6 +3233,7 @@ class Canvas extends NativeFieldWrapperClass2 {
   void drawArc(Rect rect, double startAngle, double sweepAngle, bool useCenter, Paint paint) {
     assert(_rectIsValid(rect));
     assert(paint != null);
+    _flushDisplayList();
     _drawArc(rect.left, rect.top, rect.right, rect.bottom, startAngle,
              sweepAngle, useCenter, paint._objects, paint._data);
   }
@@ -3207,11 +3253,13 @@ class Canvas extends NativeFieldWrapperClass2 {
   void drawPath(Path path, Paint paint) {
     assert(path != null); // path is checked on the engine side
     assert(paint != null);
-    _drawPath(path, paint._objects, paint._data);
+    _displayList
+      .._op(_DisplayListBuilder._kDrawPath)
+      .._path(path)
+      .._paint(paint);
+    // Paths are mutable, so submit it before the caller can change it.
+    _flushDisplayList();
   }
-  void _drawPath(Path path,
-                 List<dynamic> paintObjects,
-                 ByteData paintData) native 'Canvas_drawPath';
 
   /// Draws the given [Image] into the canvas with its top-left corner at the
   /// given [Offset]. The image is composited into the canvas using the given [Paint].
@@ -3219,13 +3267,12 @@ class Canvas extends NativeFieldWrapperClass2 {
     assert(image != null); // image is checked on the engine side
     assert(_offsetIsValid(p));
     assert(paint != null);
-    _drawImage(image, p.dx, p.dy, paint._objects, paint._data);
+    _displayList
+      .._op(_DisplayListBuilder._kDrawImage)
+      .._image(image)
+      .._offset(p)
+      .._paint(paint);
   }
-  void _drawImage(Image image,
-                  double x,
-                  double y,
-                  List<dynamic> paintObjects,
-                  ByteData paintData) native 'Canvas_drawImage';
 
   /// Draws the subset of the given image described by the `src` argument into
   /// the canvas in the axis-aligned rectangle given by the `dst` argument.
@@ -3241,29 +3288,13 @@ class Canvas extends NativeFieldWrapperClass2 {
     assert(_rectIsValid(src));
     assert(_rectIsValid(dst));
     assert(paint != null);
-    _drawImageRect(image,
-                   src.left,
-                   src.top,
-                   src.right,
-                   src.bottom,
-                   dst.left,
-                   dst.top,
-                   dst.right,
-                   dst.bottom,
-                   paint._objects,
-                   paint._data);
+    _displayList
+      .._op(_DisplayListBuilder._kDrawImageRect)
+      .._image(image)
+      .._rect(src)
+      .._rect(dst)
+      .._paint(paint);
   }
-  void _drawImageRect(Image image,
-                      double srcLeft,
-                      double srcTop,
-                      double srcRight,
-                      double srcBottom,
-                      double dstLeft,
-                      double dstTop,
-                      double dstRight,
-                      double dstBottom,
-                      List<dynamic> paintObjects,
-                      ByteData paintData) native 'Canvas_drawImageRect';
 
   /// Draws the given [Image] into the canvas using the given [Paint].
   ///
@@ -3283,6 +3314,7 @@ class Canvas extends NativeFieldWrapperClass2 {
     assert(_rectIsValid(center));
     assert(_rectIsValid(dst));
     assert(paint != null);
+    _flushDisplayList();
     _drawImageNine(image,
                    center.left,
                    center.top,
@@ -3311,6 +3343,7 @@ class Canvas extends NativeFieldWrapperClass2 {
   /// [PictureRecorder].
   void drawPicture(Picture picture) {
     assert(picture != null); // picture is checked on the engine side
+    _flushDisplayList();
     _drawPicture(picture);
   }
   void _drawPicture(Picture picture) native 'Canvas_drawPicture';
@@ -3338,6 +3371,7 @@ class Canvas extends NativeFieldWrapperClass2 {
   void drawParagraph(Paragraph paragraph, Offset offset) {
     assert(paragraph != null);
     assert(_offsetIsValid(offset));
+    _flushDisplayList();
     paragraph._paint(this, offset.dx, offset.dy);
   }
 
@@ -3353,6 +3387,7 @@ class Canvas extends NativeFieldWrapperClass2 {
     assert(pointMode != null);
     assert(points != null);
     assert(paint != null);
+    _flushDisplayList();
     _drawPoints(paint._objects, paint._data, pointMode.index, _encodePointList(points));
   }
 
@@ -3371,6 +3406,7 @@ class Canvas extends NativeFieldWrapperClass2 {
     assert(paint != null);
     if (points.length % 2 != 0)
       throw new ArgumentError('"points" must have an even number of values.');
+    _flushDisplayList();
     _drawPoints(paint._objects, paint._data, pointMode.index, points);
   }
 
@@ -3383,6 +3419,7 @@ class Canvas extends NativeFieldWrapperClass2 {
     assert(vertices != null); // vertices is checked on the engine side
     assert(paint != null);
     assert(blendMode != null);
+    _flushDisplayList();
     _drawVertices(vertices, blendMode.index, paint._objects, paint._data);
   }
   void _drawVertices(Vertices vertices,
@@ -3439,6 +3476,7 @@ class Canvas extends NativeFieldWrapperClass2 {
     final Int32List colorBuffer = colors.isEmpty ? null : _encodeColorList(colors);
     final Float32List cullRectBuffer = cullRect?._value;
 
+    _flushDisplayList();
     _drawAtlas(
       paint._objects, paint._data, atlas, rstTransformBuffer, rectBuffer,
       colorBuffer, blendMode.index, cullRectBuffer
@@ -3482,6 +3520,7 @@ class Canvas extends NativeFieldWrapperClass2 {
     if (colors != null && colors.length * 4 != rectCount)
       throw new ArgumentError('If non-null, "colors" length must be one fourth the length of "rstTransforms" and "rects".');
 
+    _flushDisplayList();
     _drawAtlas(
       paint._objects, paint._data, atlas, rstTransforms, rects,
       colors, blendMode.index, cullRect?._value
@@ -3507,6 +3546,7 @@ class Canvas extends NativeFieldWrapperClass2 {
     assert(path != null); // path is checked on the engine side
     assert(color != null);
     assert(transparentOccluder != null);
+    _flushDisplayList();
     _drawShadow(path, color.value, elevation, transparentOccluder);
   }
   void _drawShadow(Path path,
@@ -3576,7 +3616,147 @@ class PictureRecorder extends NativeFieldWrapperClass2 {
   /// and the canvas objects are invalid and cannot be used further.
   ///
   /// Returns null if the PictureRecorder is not associated with a canvas.
-  Picture endRecording() native 'PictureRecorder_endRecording';
+  Picture endRecording() {
+    _canvas?._flushDisplayList();
+    _canvas = null;
+    return _endRecording();
+  }
+  Picture _endRecording() native 'PictureRecorder_endRecording';
+
+  Canvas _canvas;
+}
+
+/// Encodes [Canvas] operations into the engine's display list format so that
+/// a whole batch of them can be submitted with a single native call.
+///
+/// The binary format must match the decoding code in display_list.cc.
+class _DisplayListBuilder {
+  static const int _kSave = 1;
+  static const int _kRestore = 2;
+  static const int _kTranslate = 3;
+  static const int _kScale = 4;
+  static const int _kRotate = 5;
+  static const int _kSkew = 6;
+  static const int _kClipRect = 7;
+  static const int _kClipRRect = 8;
+  static const int _kClipPath = 9;
+  static const int _kDrawColor = 10;
+  static const int _kDrawLine = 11;
+  static const int _kDrawPaint = 12;
+  static const int _kDrawRect = 13;
+  static const int _kDrawRRect = 14;
+  static const int _kDrawDRRect = 15;
+  static const int _kDrawOval = 16;
+  static const int _kDrawCircle = 17;
+  static const int _kDrawPath = 18;
+  static const int _kDrawImage = 19;
+  static const int _kDrawImageRect = 20;
+
+  static const int _kNoObject = 0xFFFFFFFF;
+  static const int _kPaintDataWordCount = 15;
+  static const int _kRRectWordCount = 12;
+  static const int _kInitialCapacity = 256;
+
+  Int32List _words = new Int32List(_kInitialCapacity);
+  Float32List _floats;
+  int _length = 0;
+
+  // Objects are referenced by the index at which they were first used.
+  final List<Path> _paths = <Path>[];
+  final List<Image> _images = <Image>[];
+  final List<Shader> _shaders = <Shader>[];
+  final Map<Object, int> _objectIndices = new Map<Object, int>.identity();
+
+  bool get isEmpty => _length == 0;
+
+  /// A view of the operations encoded so far. The engine copies the view so
+  /// the builder can be reused once it has been submitted.
+  Int32List get _ops => new Int32List.view(_words.buffer, 0, _length);
+
+  void _reset() {
+    _length = 0;
+    _paths.clear();
+    _images.clear();
+    _shaders.clear();
+    _objectIndices.clear();
+  }
+
+  void _reserve(int count) {
+    if (_length + count <= _words.length)
+      return;
+    int capacity = _words.length * 2;
+    while (capacity < _length + count)
+      capacity *= 2;
+    final Int32List words = new Int32List(capacity);
+    words.setRange(0, _length, _words);
+    _words = words;
+    _floats = null;
+  }
+
+  void _op(int op) {
+    _reserve(1);
+    _words[_length++] = op;
+  }
+
+  void _int(int value) {
+    _reserve(1);
+    _words[_length++] = value;
+  }
+
+  void _bool(bool value) {
+    _int(value ? 1 : 0);
+  }
+
+  void _float(double value) {
+    _reserve(1);
+    _floats ??= _words.buffer.asFloat32List();
+    _floats[_length++] = value;
+  }
+
+  void _offset(Offset offset) {
+    _float(offset.dx);
+    _float(offset.dy);
+  }
+
+  void _rect(Rect rect) {
+    _float(rect.left);
+    _float(rect.top);
+    _float(rect.right);
+    _float(rect.bottom);
+  }
+
+  void _rrect(RRect rrect) {
+    final Float32List value = rrect._value;
+    assert(value.length == _kRRectWordCount);
+    _reserve(_kRRectWordCount);
+    _floats ??= _words.buffer.asFloat32List();
+    _floats.setRange(_length, _length + _kRRectWordCount, value);
+    _length += _kRRectWordCount;
+  }
+
+  int _objectIndex<T>(List<T> objects, T object) {
+    return _objectIndices.putIfAbsent(object, () {
+      objects.add(object);
+      return objects.length - 1;
+    });
+  }
+
+  void _path(Path path) {
+    _int(_objectIndex<Path>(_paths, path));
+  }
+
+  void _image(Image image) {
+    _int(_objectIndex<Image>(_images, image));
+  }
+
+  void _paint(Paint paint) {
+    _reserve(1 + _kPaintDataWordCount);
+    final Shader shader = paint.shader;
+    _int(shader == null ? _kNoObject : _objectIndex<Shader>(_shaders, shader));
+    _words.setRange(_length, _length + _kPaintDataWordCount,
+                    paint._data.buffer.asInt32List(paint._data.offsetInBytes, _kPaintDataWordCount));
+    _length += _kPaintDataWordCount;
+  }
 }
 
 /// Generic callback signature, used by [_futurize].
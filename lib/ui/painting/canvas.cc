@@ -6,8 +6,11 @@
 
 #define _USE_MATH_DEFINES
 #include <math.h>
+#include <string.h>
 
 #include "flutter/flow/layers/physical_shape_layer.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/lib/ui/painting/display_list.h"
 #include "flutter/lib/ui/painting/image.h"
 #include "flutter/lib/ui/painting/matrix.h"
 #include "flutter/lib/ui/ui_dart_state.h"
@@ -31,40 +34,25 @@ static void Canvas_constructor(Dart_NativeArguments args) {
 IMPLEMENT_WRAPPERTYPEINFO(ui, Canvas);
 
 #define FOR_EACH_BINDING(V)         \
-  V(Canvas, save)                   \
   V(Canvas, saveLayerWithoutBounds) \
   V(Canvas, saveLayer)              \
-  V(Canvas, restore)                \
   V(Canvas, getSaveCount)           \
-  V(Canvas, translate)              \
-  V(Canvas, scale)                  \
-  V(Canvas, rotate)                 \
-  V(Canvas, skew)                   \
   V(Canvas, transform)              \
-  V(Canvas, clipRect)               \
-  V(Canvas, clipRRect)              \
-  V(Canvas, clipPath)               \
-  V(Canvas, drawColor)              \
-  V(Canvas, drawLine)               \
-  V(Canvas, drawPaint)              \
-  V(Canvas, drawRect)               \
-  V(Canvas, drawRRect)              \
-  V(Canvas, drawDRRect)             \
-  V(Canvas, drawOval)               \
-  V(Canvas, drawCircle)             \
   V(Canvas, drawArc)                \
-  V(Canvas, drawPath)               \
-  V(Canvas, drawImage)              \
-  V(Canvas, drawImageRect)          \
   V(Canvas, drawImageNine)          \
   V(Canvas, drawPicture)            \
   V(Canvas, drawPoints)             \
   V(Canvas, drawVertices)           \
   V(Canvas, drawAtlas)              \
-  V(Canvas, drawShadow)
+  V(Canvas, drawShadow)             \
+  V(Canvas, drawDisplayList)
 
 FOR_EACH_BINDING(DART_NATIVE_CALLBACK)
 
+static uint64_t HashCombine(uint64_t seed, uint64_t value) {
+  return seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+}
+
 void Canvas::RegisterNatives(tonic::DartLibraryNatives* natives) {
   natives->Register({{"Canvas_constructor", Canvas_constructor, 6, true},
                      FOR_EACH_BINDING(DART_REGISTER_NATIVE)});
@@ -82,6 +70,12 @@ fxl::RefPtr<Canvas> Canvas::Create(PictureRecorder* recorder,
   fxl::RefPtr<Canvas> canvas = fxl::MakeRefCounted<Canvas>(
       recorder->BeginRecording(SkRect::MakeLTRB(left, top, right, bottom)));
   recorder->set_canvas(canvas);
+  // Pictures with different bounds are never interchangeable.
+  for (double value : {left, top, right, bottom}) {
+    uint64_t bits = 0;
+    memcpy(&bits, &value, sizeof(bits));
+    canvas->content_hash_seed_ = HashCombine(canvas->content_hash_seed_, bits);
+  }
   return canvas;
 }
 
@@ -89,16 +83,11 @@ Canvas::Canvas(SkCanvas* canvas) : canvas_(canvas) {}
 
 Canvas::~Canvas() {}
 
-void Canvas::save() {
-  if (!canvas_)
-    return;
-  canvas_->save();
-}
-
 void Canvas::saveLayerWithoutBounds(const Paint& paint,
                                     const PaintData& paint_data) {
   if (!canvas_)
     return;
+  InvalidateContentHash();
   canvas_->saveLayer(nullptr, paint.paint());
 }
 
@@ -110,151 +99,24 @@ void Canvas::saveLayer(double left,
                        const PaintData& paint_data) {
   if (!canvas_)
     return;
+  InvalidateContentHash();
   SkRect bounds = SkRect::MakeLTRB(left, top, right, bottom);
   canvas_->saveLayer(&bounds, paint.paint());
 }
 
-void Canvas::restore() {
-  if (!canvas_)
-    return;
-  canvas_->restore();
-}
-
 int Canvas::getSaveCount() {
   if (!canvas_)
     return 0;
   return canvas_->getSaveCount();
 }
 
-void Canvas::translate(double dx, double dy) {
-  if (!canvas_)
-    return;
-  canvas_->translate(dx, dy);
-}
-
-void Canvas::scale(double sx, double sy) {
-  if (!canvas_)
-    return;
-  canvas_->scale(sx, sy);
-}
-
-void Canvas::rotate(double radians) {
-  if (!canvas_)
-    return;
-  canvas_->rotate(radians * 180.0 / M_PI);
-}
-
-void Canvas::skew(double sx, double sy) {
-  if (!canvas_)
-    return;
-  canvas_->skew(sx, sy);
-}
-
 void Canvas::transform(const tonic::Float64List& matrix4) {
   if (!canvas_)
     return;
+  InvalidateContentHash();
   canvas_->concat(ToSkMatrix(matrix4));
 }
 
-void Canvas::clipRect(double left,
-                      double top,
-                      double right,
-                      double bottom,
-                      SkClipOp clipOp,
-                      bool doAntiAlias) {
-  if (!canvas_)
-    return;
-  canvas_->clipRect(SkRect::MakeLTRB(left, top, right, bottom), clipOp,
-                    doAntiAlias);
-}
-
-void Canvas::clipRRect(const RRect& rrect, bool doAntiAlias) {
-  if (!canvas_)
-    return;
-  canvas_->clipRRect(rrect.sk_rrect, doAntiAlias);
-}
-
-void Canvas::clipPath(const CanvasPath* path, bool doAntiAlias) {
-  if (!canvas_)
-    return;
-  if (!path)
-    Dart_ThrowException(
-        ToDart("Canvas.clipPath called with non-genuine Path."));
-  canvas_->clipPath(path->path(), doAntiAlias);
-}
-
-void Canvas::drawColor(SkColor color, SkBlendMode blend_mode) {
-  if (!canvas_)
-    return;
-  canvas_->drawColor(color, blend_mode);
-}
-
-void Canvas::drawLine(double x1,
-                      double y1,
-                      double x2,
-                      double y2,
-                      const Paint& paint,
-                      const PaintData& paint_data) {
-  if (!canvas_)
-    return;
-  canvas_->drawLine(x1, y1, x2, y2, *paint.paint());
-}
-
-void Canvas::drawPaint(const Paint& paint, const PaintData& paint_data) {
-  if (!canvas_)
-    return;
-  canvas_->drawPaint(*paint.paint());
-}
-
-void Canvas::drawRect(double left,
-                      double top,
-                      double right,
-                      double bottom,
-                      const Paint& paint,
-                      const PaintData& paint_data) {
-  if (!canvas_)
-    return;
-  canvas_->drawRect(SkRect::MakeLTRB(left, top, right, bottom), *paint.paint());
-}
-
-void Canvas::drawRRect(const RRect& rrect,
-                       const Paint& paint,
-                       const PaintData& paint_data) {
-  if (!canvas_)
-    return;
-  canvas_->drawRRect(rrect.sk_rrect, *paint.paint());
-}
-
-void Canvas::drawDRRect(const RRect& outer,
-                        const RRect& inner,
-                        const Paint& paint,
-                        const PaintData& paint_data) {
-  if (!canvas_)
-    return;
-  canvas_->drawDRRect(outer.sk_rrect, inner.sk_rrect, *paint.paint());
-}
-
-void Canvas::drawOval(double left,
-                      double top,
-                      double right,
-                      double bottom,
-                      const Paint& paint,
-                      const PaintData& paint_data) {
-  if (!canvas_)
-    return;
-  canvas_->drawOval(SkRect::MakeLTRB(left, top, right, bottom), *paint.paint());
-}
-
-void Canvas::drawCircle(double x,
-                        double y,
-                        double radius,
-                        const Paint& paint,
-                        const PaintData& paint_data) {
-  if (!canvas_)
-    return;
-  canvas_->drawCircle(x, y, radius, *paint.paint());
-}
-
 void Canvas::drawArc(double left,
                      double top,
                      double right,
@@ -266,57 +128,12 @@ void Canvas::drawArc(double left,
                      const PaintData& paint_data) {
   if (!canvas_)
     return;
+  InvalidateContentHash();
   canvas_->drawArc(SkRect::MakeLTRB(left, top, right, bottom),
                    startAngle * 180.0 / M_PI, sweepAngle * 180.0 / M_PI,
                    useCenter, *paint.paint());
 }
 
-void Canvas::drawPath(const CanvasPath* path,
-                      const Paint& paint,
-                      const PaintData& paint_data) {
-  if (!canvas_)
-    return;
-  if (!path)
-    Dart_ThrowException(
-        ToDart("Canvas.drawPath called with non-genuine Path."));
-  canvas_->drawPath(path->path(), *paint.paint());
-}
-
-void Canvas::drawImage(const CanvasImage* image,
-                       double x,
-                       double y,
-                       const Paint& paint,
-                       const PaintData& paint_data) {
-  if (!canvas_)
-    return;
-  if (!image)
-    Dart_ThrowException(
-        ToDart("Canvas.drawImage called with non-genuine Image."));
-  canvas_->drawImage(image->image(), x, y, paint.paint());
-}
-
-void Canvas::drawImageRect(const CanvasImage* image,
-                           double src_left,
-                           double src_top,
-                           double src_right,
-                           double src_bottom,
-                           double dst_left,
-                           double dst_top,
-                           double dst_right,
-                           double dst_bottom,
-                           const Paint& paint,
-                           const PaintData& paint_data) {
-  if (!canvas_)
-    return;
-  if (!image)
-    Dart_ThrowException(
-        ToDart("Canvas.drawImageRect called with non-genuine Image."));
-  SkRect src = SkRect::MakeLTRB(src_left, src_top, src_right, src_bottom);
-  SkRect dst = SkRect::MakeLTRB(dst_left, dst_top, dst_right, dst_bottom);
-  canvas_->drawImageRect(image->image(), src, dst, paint.paint(),
-                         SkCanvas::kFast_SrcRectConstraint);
-}
-
 void Canvas::drawImageNine(const CanvasImage* image,
                            double center_left,
                            double center_top,
@@ -330,6 +147,7 @@ void Canvas::drawImageNine(const CanvasImage* image,
                            const PaintData& paint_data) {
   if (!canvas_)
     return;
+  InvalidateContentHash();
   if (!image)
     Dart_ThrowException(
         ToDart("Canvas.drawImageNine called with non-genuine Image."));
@@ -344,6 +162,7 @@ void Canvas::drawImageNine(const CanvasImage* image,
 void Canvas::drawPicture(Picture* picture) {
   if (!canvas_)
     return;
+  InvalidateContentHash();
   if (!picture)
     Dart_ThrowException(
         ToDart("Canvas.drawPicture called with non-genuine Picture."));
@@ -356,6 +175,7 @@ void Canvas::drawPoints(const Paint& paint,
                         const tonic::Float32List& points) {
   if (!canvas_)
     return;
+  InvalidateContentHash();
 
   static_assert(sizeof(SkPoint) == sizeof(float) * 2,
                 "SkPoint doesn't use floats.");
@@ -372,6 +192,7 @@ void Canvas::drawVertices(const Vertices* vertices,
                           const PaintData& paint_data) {
   if (!canvas_)
     return;
+  InvalidateContentHash();
   if (!vertices)
     Dart_ThrowException(
         ToDart("Canvas.drawVertices called with non-genuine Vertices."));
@@ -389,6 +210,7 @@ void Canvas::drawAtlas(const Paint& paint,
                        const tonic::Float32List& cull_rect) {
   if (!canvas_)
     return;
+  InvalidateContentHash();
   if (!atlas)
     Dart_ThrowException(
         ToDart("Canvas.drawAtlas or Canvas.drawRawAtlas called with "
@@ -414,6 +236,7 @@ void Canvas::drawShadow(const CanvasPath* path,
                         SkColor color,
                         double elevation,
                         bool transparentOccluder) {
+  InvalidateContentHash();
   if (!path)
     Dart_ThrowException(
         ToDart("Canvas.drawShader called with non-genuine Path."));
@@ -423,6 +246,66 @@ void Canvas::drawShadow(const CanvasPath* path,
                                        transparentOccluder, dpr);
 }
 
+void Canvas::drawDisplayList(const std::vector<CanvasPath*>& paths,
+                             const std::vector<CanvasImage*>& images,
+                             const std::vector<Shader*>& shaders,
+                             Dart_Handle ops_handle) {
+  TRACE_EVENT0("flutter", "Canvas::drawDisplayList");
+  if (!canvas_)
+    return;
+
+  // The VM cannot be re-entered to throw once the ops view is acquired.
+  DisplayList::Objects objects;
+  objects.paths.reserve(paths.size());
+  for (const CanvasPath* path : paths) {
+    if (!path) {
+      InvalidateContentHash();
+      Dart_ThrowException(
+          ToDart("Canvas.drawDisplayList called with non-genuine Path."));
+      return;
+    }
+    objects.paths.push_back(path->path());
+  }
+  objects.images.reserve(images.size());
+  for (const CanvasImage* image : images) {
+    if (!image) {
+      InvalidateContentHash();
+      Dart_ThrowException(
+          ToDart("Canvas.drawDisplayList called with non-genuine Image."));
+      return;
+    }
+    objects.images.push_back(image->image());
+  }
+  objects.shaders.reserve(shaders.size());
+  for (Shader* shader : shaders) {
+    objects.shaders.push_back(shader ? shader->shader() : nullptr);
+  }
+
+  tonic::Int32List ops(ops_handle);
+  const uint32_t* words = reinterpret_cast<const uint32_t*>(ops.data());
+  DisplayList display_list({words, words + ops.num_elements()},
+                           std::move(objects));
+  ops.Release();
+
+  // The content hash is only computed if the raster cache asks for it, so
+  // only keep what it is computed from.
+  if (content_hash_valid_) {
+    DisplayList::HashInput hash_input;
+    if (display_list.GetHashInput(&hash_input)) {
+      content_hash_inputs_.push_back(std::move(hash_input));
+    } else {
+      InvalidateContentHash();
+    }
+  }
+
+  // A malformed list must not leave the saves it made before the malformed
+  // operation on the canvas.
+  const int save_count = canvas_->getSaveCount();
+  if (!display_list.Replay(canvas_)) {
+    canvas_->restoreToCount(save_count);
+  }
+}
+
 void Canvas::Clear() {
   canvas_ = nullptr;
 }
@@ -431,4 +314,26 @@ bool Canvas::IsRecording() const {
   return !!canvas_;
 }
 
+void Canvas::InvalidateContentHash() {
+  content_hash_valid_ = false;
+  content_hash_inputs_.clear();
+}
+
+std::shared_ptr<flow::PictureContentHash> Canvas::TakeContentHash() {
+  if (!content_hash_valid_) {
+    return nullptr;
+  }
+  content_hash_valid_ = false;
+  return std::make_shared<flow::PictureContentHash>(
+      [seed = content_hash_seed_,
+       inputs = std::move(content_hash_inputs_)]() -> uint64_t {
+        uint64_t hash = seed;
+        for (const DisplayList::HashInput& input : inputs) {
+          hash = HashCombine(hash, input.ComputeHash());
+        }
+        // Zero is reserved to mean that a picture has no content hash.
+        return hash == 0 ? 1 : hash;
+      });
+}
+
 }  // namespace blink
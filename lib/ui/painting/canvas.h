@@ -5,12 +5,18 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_CANVAS_H_
 #define FLUTTER_LIB_UI_PAINTING_CANVAS_H_
 
+#include <memory>
+#include <vector>
+
+#include "flutter/flow/picture_content_hash.h"
 #include "flutter/lib/ui/dart_wrapper.h"
+#include "flutter/lib/ui/painting/display_list.h"
 #include "flutter/lib/ui/painting/paint.h"
 #include "flutter/lib/ui/painting/path.h"
 #include "flutter/lib/ui/painting/picture.h"
 #include "flutter/lib/ui/painting/picture_recorder.h"
 #include "flutter/lib/ui/painting/rrect.h"
+#include "flutter/lib/ui/painting/shader.h"
 #include "flutter/lib/ui/painting/vertices.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/utils/SkShadowUtils.h"
@@ -38,7 +44,6 @@ class Canvas : public RefCountedDartWrappable<Canvas> {
 
   ~Canvas() override;
 
-  void save();
   void saveLayerWithoutBounds(const Paint& paint, const PaintData& paint_data);
   void saveLayer(double left,
                  double top,
@@ -46,56 +51,10 @@ class Canvas : public RefCountedDartWrappable<Canvas> {
                  double bottom,
                  const Paint& paint,
                  const PaintData& paint_data);
-  void restore();
   int getSaveCount();
 
-  void translate(double dx, double dy);
-  void scale(double sx, double sy);
-  void rotate(double radians);
-  void skew(double sx, double sy);
   void transform(const tonic::Float64List& matrix4);
 
-  void clipRect(double left,
-                double top,
-                double right,
-                double bottom,
-                SkClipOp clipOp,
-                bool doAntiAlias = true);
-  void clipRRect(const RRect& rrect, bool doAntiAlias = true);
-  void clipPath(const CanvasPath* path, bool doAntiAlias = true);
-
-  void drawColor(SkColor color, SkBlendMode blend_mode);
-  void drawLine(double x1,
-                double y1,
-                double x2,
-                double y2,
-                const Paint& paint,
-                const PaintData& paint_data);
-  void drawPaint(const Paint& paint, const PaintData& paint_data);
-  void drawRect(double left,
-                double top,
-                double right,
-                double bottom,
-                const Paint& paint,
-                const PaintData& paint_data);
-  void drawRRect(const RRect& rrect,
-                 const Paint& paint,
-                 const PaintData& paint_data);
-  void drawDRRect(const RRect& outer,
-                  const RRect& inner,
-                  const Paint& paint,
-                  const PaintData& paint_data);
-  void drawOval(double left,
-                double top,
-                double right,
-                double bottom,
-                const Paint& paint,
-                const PaintData& paint_data);
-  void drawCircle(double x,
-                  double y,
-                  double radius,
-                  const Paint& paint,
-                  const PaintData& paint_data);
   void drawArc(double left,
                double top,
                double right,
@@ -105,25 +64,6 @@ class Canvas : public RefCountedDartWrappable<Canvas> {
                bool useCenter,
                const Paint& paint,
                const PaintData& paint_data);
-  void drawPath(const CanvasPath* path,
-                const Paint& paint,
-                const PaintData& paint_data);
-  void drawImage(const CanvasImage* image,
-                 double x,
-                 double y,
-                 const Paint& paint,
-                 const PaintData& paint_data);
-  void drawImageRect(const CanvasImage* image,
-                     double src_left,
-                     double src_top,
-                     double src_right,
-                     double src_bottom,
-                     double dst_left,
-                     double dst_top,
-                     double dst_right,
-                     double dst_bottom,
-                     const Paint& paint,
-                     const PaintData& paint_data);
   void drawImageNine(const CanvasImage* image,
                      double center_left,
                      double center_top,
@@ -166,10 +106,27 @@ class Canvas : public RefCountedDartWrappable<Canvas> {
                   double elevation,
                   bool transparentOccluder);
 
+  // Replays a batch of operations recorded by the framework. See
+  // |DisplayList| for the encoding of |ops_handle|, an Int32List. The objects
+  // referenced by the operations are checked before the list is accessed.
+  void drawDisplayList(const std::vector<CanvasPath*>& paths,
+                       const std::vector<CanvasImage*>& images,
+                       const std::vector<Shader*>& shaders,
+                       Dart_Handle ops_handle);
+
   SkCanvas* canvas() const { return canvas_; }
   void Clear();
   bool IsRecording() const;
 
+  // Operations that are drawn directly on |canvas()|, rather than through a
+  // display list, make the content hash of the recording unavailable.
+  void InvalidateContentHash();
+
+  // Returns the fingerprint of the content drawn, or null if it cannot be
+  // fingerprinted. The fingerprint is only computed when it is first asked
+  // for, and is never zero. Must only be called once recording finished.
+  std::shared_ptr<flow::PictureContentHash> TakeContentHash();
+
   static void RegisterNatives(tonic::DartLibraryNatives* natives);
 
  private:
@@ -179,6 +136,13 @@ class Canvas : public RefCountedDartWrappable<Canvas> {
   // which does not transfer ownership.  For this reason, we hold a raw
   // pointer and manually set to null in Clear.
   SkCanvas* canvas_;
+
+  // What the fingerprint of everything recorded on this canvas is computed
+  // from: the bounds of the recording and the display lists drawn. Only
+  // operations batched into display lists can be fingerprinted.
+  uint64_t content_hash_seed_ = 0;
+  std::vector<DisplayList::HashInput> content_hash_inputs_;
+  bool content_hash_valid_ = true;
 };
 
 }  // namespace blink
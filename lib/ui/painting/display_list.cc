@@ -0,0 +1,340 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/display_list.h"
+
+#define _USE_MATH_DEFINES
+#include <math.h>
+#include <string.h>
+
+#include "flutter/fml/hash.h"
+#include "flutter/lib/ui/painting/paint.h"
+#include "lib/fxl/logging.h"
+#include "third_party/skia/include/core/SkRRect.h"
+
+namespace blink {
+
+namespace {
+
+class DisplayListReader {
+ public:
+  DisplayListReader(const std::vector<uint32_t>& words,
+                    const DisplayList::Objects& objects)
+      : words_(words), objects_(objects) {}
+
+  bool done() const { return position_ >= words_.size(); }
+
+  bool ReadWord(uint32_t* value) {
+    if (done()) {
+      return false;
+    }
+    *value = words_[position_++];
+    return true;
+  }
+
+  bool ReadFloat(float* value) {
+    static_assert(sizeof(float) == sizeof(uint32_t), "float is not 32 bits.");
+    uint32_t word = 0;
+    if (!ReadWord(&word)) {
+      return false;
+    }
+    memcpy(value, &word, sizeof(word));
+    return true;
+  }
+
+  bool ReadBool(bool* value) {
+    uint32_t word = 0;
+    if (!ReadWord(&word)) {
+      return false;
+    }
+    *value = word != 0;
+    return true;
+  }
+
+  bool ReadRect(SkRect* rect) {
+    float ltrb[4];
+    for (float& value : ltrb) {
+      if (!ReadFloat(&value)) {
+        return false;
+      }
+    }
+    *rect = SkRect::MakeLTRB(ltrb[0], ltrb[1], ltrb[2], ltrb[3]);
+    return true;
+  }
+
+  // Same layout as the RRect Float32List in painting.dart.
+  bool ReadRRect(SkRRect* rrect) {
+    SkRect rect;
+    if (!ReadRect(&rect)) {
+      return false;
+    }
+    SkVector radii[4];
+    for (SkVector& radius : radii) {
+      if (!ReadFloat(&radius.fX) || !ReadFloat(&radius.fY)) {
+        return false;
+      }
+    }
+    rrect->setRectRadii(rect, radii);
+    return true;
+  }
+
+  bool ReadPath(const SkPath** path) {
+    uint32_t index = 0;
+    if (!ReadWord(&index) || index >= objects_.paths.size()) {
+      return false;
+    }
+    *path = &objects_.paths[index];
+    return true;
+  }
+
+  bool ReadImage(SkImage** image) {
+    uint32_t index = 0;
+    if (!ReadWord(&index) || index >= objects_.images.size() ||
+        !objects_.images[index]) {
+      return false;
+    }
+    *image = objects_.images[index].get();
+    return true;
+  }
+
+  bool ReadPaint(SkPaint* paint) {
+    uint32_t shader_index = 0;
+    if (!ReadWord(&shader_index)) {
+      return false;
+    }
+    if (position_ + kPaintDataWordCount > words_.size()) {
+      return false;
+    }
+    *paint = SkPaint();
+    Paint::DecodeData(&words_[position_], paint);
+    position_ += kPaintDataWordCount;
+    if (shader_index != DisplayList::kNoObject) {
+      if (shader_index >= objects_.shaders.size()) {
+        return false;
+      }
+      paint->setShader(objects_.shaders[shader_index]);
+    }
+    return true;
+  }
+
+ private:
+  const std::vector<uint32_t>& words_;
+  const DisplayList::Objects& objects_;
+  size_t position_ = 0;
+};
+
+// Replays a single operation. Returns false if it was malformed.
+bool ReplayOp(DisplayListReader& reader, SkCanvas* canvas) {
+  using Op = DisplayList::Op;
+
+  uint32_t op = 0;
+  if (!reader.ReadWord(&op)) {
+    return false;
+  }
+
+  SkPaint paint;
+  SkRect rect, rect2;
+  SkRRect rrect, rrect2;
+  const SkPath* path = nullptr;
+  SkImage* image = nullptr;
+  float x = 0.0f, y = 0.0f, x2 = 0.0f, y2 = 0.0f;
+  uint32_t value = 0, value2 = 0;
+  bool flag = false;
+
+  switch (static_cast<Op>(op)) {
+    case Op::kSave:
+      canvas->save();
+      return true;
+    case Op::kRestore:
+      canvas->restore();
+      return true;
+    case Op::kTranslate:
+      if (!reader.ReadFloat(&x) || !reader.ReadFloat(&y)) {
+        return false;
+      }
+      canvas->translate(x, y);
+      return true;
+    case Op::kScale:
+      if (!reader.ReadFloat(&x) || !reader.ReadFloat(&y)) {
+        return false;
+      }
+      canvas->scale(x, y);
+      return true;
+    case Op::kRotate:
+      if (!reader.ReadFloat(&x)) {
+        return false;
+      }
+      canvas->rotate(x * 180.0 / M_PI);
+      return true;
+    case Op::kSkew:
+      if (!reader.ReadFloat(&x) || !reader.ReadFloat(&y)) {
+        return false;
+      }
+      canvas->skew(x, y);
+      return true;
+    case Op::kClipRect:
+      if (!reader.ReadRect(&rect) || !reader.ReadWord(&value) ||
+          !reader.ReadBool(&flag)) {
+        return false;
+      }
+      canvas->clipRect(rect, static_cast<SkClipOp>(value), flag);
+      return true;
+    case Op::kClipRRect:
+      if (!reader.ReadRRect(&rrect) || !reader.ReadBool(&flag)) {
+        return false;
+      }
+      canvas->clipRRect(rrect, flag);
+      return true;
+    case Op::kClipPath:
+      if (!reader.ReadPath(&path) || !reader.ReadBool(&flag)) {
+        return false;
+      }
+      canvas->clipPath(*path, flag);
+      return true;
+    case Op::kDrawColor:
+      if (!reader.ReadWord(&value) || !reader.ReadWord(&value2)) {
+        return false;
+      }
+      canvas->drawColor(value, static_cast<SkBlendMode>(value2));
+      return true;
+    case Op::kDrawLine:
+      if (!reader.ReadFloat(&x) || !reader.ReadFloat(&y) ||
+          !reader.ReadFloat(&x2) || !reader.ReadFloat(&y2) ||
+          !reader.ReadPaint(&paint)) {
+        return false;
+      }
+      canvas->drawLine(x, y, x2, y2, paint);
+      return true;
+    case Op::kDrawPaint:
+      if (!reader.ReadPaint(&paint)) {
+        return false;
+      }
+      canvas->drawPaint(paint);
+      return true;
+    case Op::kDrawRect:
+      if (!reader.ReadRect(&rect) || !reader.ReadPaint(&paint)) {
+        return false;
+      }
+      canvas->drawRect(rect, paint);
+      return true;
+    case Op::kDrawRRect:
+      if (!reader.ReadRRect(&rrect) || !reader.ReadPaint(&paint)) {
+        return false;
+      }
+      canvas->drawRRect(rrect, paint);
+      return true;
+    case Op::kDrawDRRect:
+      if (!reader.ReadRRect(&rrect) || !reader.ReadRRect(&rrect2) ||
+          !reader.ReadPaint(&paint)) {
+        return false;
+      }
+      canvas->drawDRRect(rrect, rrect2, paint);
+      return true;
+    case Op::kDrawOval:
+      if (!reader.ReadRect(&rect) || !reader.ReadPaint(&paint)) {
+        return false;
+      }
+      canvas->drawOval(rect, paint);
+      return true;
+    case Op::kDrawCircle:
+      if (!reader.ReadFloat(&x) || !reader.ReadFloat(&y) ||
+          !reader.ReadFloat(&x2) || !reader.ReadPaint(&paint)) {
+        return false;
+      }
+      canvas->drawCircle(x, y, x2, paint);
+      return true;
+    case Op::kDrawPath:
+      if (!reader.ReadPath(&path) || !reader.ReadPaint(&paint)) {
+        return false;
+      }
+      canvas->drawPath(*path, paint);
+      return true;
+    case Op::kDrawImage:
+      if (!reader.ReadImage(&image) || !reader.ReadFloat(&x) ||
+          !reader.ReadFloat(&y) || !reader.ReadPaint(&paint)) {
+        return false;
+      }
+      canvas->drawImage(image, x, y, &paint);
+      return true;
+    case Op::kDrawImageRect:
+      if (!reader.ReadImage(&image) || !reader.ReadRect(&rect) ||
+          !reader.ReadRect(&rect2) || !reader.ReadPaint(&paint)) {
+        return false;
+      }
+      canvas->drawImageRect(image, rect, rect2, &paint,
+                            SkCanvas::kFast_SrcRectConstraint);
+      return true;
+  }
+
+  return false;
+}
+
+}  // namespace
+
+DisplayList::DisplayList(std::vector<uint32_t> words, Objects objects)
+    : words_(std::move(words)), objects_(std::move(objects)) {}
+
+DisplayList::~DisplayList() = default;
+
+bool DisplayList::Replay(SkCanvas* canvas) const {
+  FXL_DCHECK(canvas);
+  DisplayListReader reader(words_, objects_);
+  while (!reader.done()) {
+    if (!ReplayOp(reader, canvas)) {
+      FXL_LOG(ERROR) << "Malformed display list operation.";
+      return false;
+    }
+  }
+  return true;
+}
+
+bool DisplayList::GetHashInput(HashInput* input) const {
+  // Shaders have no notion of content identity that is cheap to compute.
+  if (!objects_.shaders.empty()) {
+    return false;
+  }
+
+  input->words = words_;
+  input->paths = objects_.paths;
+  // Image IDs are never reused so they are a stable proxy for the content.
+  input->image_ids.clear();
+  input->image_ids.reserve(objects_.images.size());
+  for (const sk_sp<SkImage>& image : objects_.images) {
+    input->image_ids.push_back(image ? image->uniqueID() : 0u);
+  }
+  return true;
+}
+
+uint64_t DisplayList::HashInput::ComputeHash() const {
+  // Objects are referenced by the index at which they were first used, so
+  // identical recordings produce identical operation streams.
+  uint64_t result = fml::kHashSeed;
+  result =
+      fml::HashBytes(result, words.data(), words.size() * sizeof(uint32_t));
+
+  std::vector<uint8_t> path_data;
+  for (const SkPath& path : paths) {
+    path_data.resize(path.writeToMemory(nullptr));
+    path.writeToMemory(path_data.data());
+    result = fml::HashValue(result, path_data.size());
+    result = fml::HashBytes(result, path_data.data(), path_data.size());
+  }
+
+  for (uint32_t image_id : image_ids) {
+    result = fml::HashValue(result, image_id);
+  }
+
+  return result;
+}
+
+bool DisplayList::ComputeContentHash(uint64_t* hash) const {
+  HashInput input;
+  if (!GetHashInput(&input)) {
+    return false;
+  }
+  *hash = input.ComputeHash();
+  return true;
+}
+
+}  // namespace blink
@@ -0,0 +1,111 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_DISPLAY_LIST_H_
+#define FLUTTER_LIB_UI_PAINTING_DISPLAY_LIST_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "lib/fxl/macros.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkPath.h"
+#include "third_party/skia/include/core/SkShader.h"
+
+namespace blink {
+
+// A compact, engine-owned encoding of a sequence of canvas operations. The
+// framework appends operations to a buffer on the Dart side and submits the
+// whole buffer with a single native call instead of crossing into the engine
+// once per operation.
+//
+// The operations are a stream of 32-bit words. Each operation starts with its
+// |Op| followed by its arguments. Floating point arguments are stored as
+// 32-bit floats. Operations that take a paint end with a paint record: the
+// index of the paint shader in |Objects::shaders| (or |kNoObject|) followed
+// by |kPaintDataWordCount| words of the same encoding used by the Paint class
+// in painting.dart. Paths, images and shaders are referenced by their index
+// in the corresponding |Objects| list.
+//
+// Must be kept in sync with _DisplayListBuilder in painting.dart.
+class DisplayList {
+ public:
+  enum class Op : uint32_t {
+    kSave = 1,         //
+    kRestore,          //
+    kTranslate,        // dx, dy
+    kScale,            // sx, sy
+    kRotate,           // radians
+    kSkew,             // sx, sy
+    kClipRect,         // ltrb, clip op, anti alias
+    kClipRRect,        // rrect, anti alias
+    kClipPath,         // path, anti alias
+    kDrawColor,        // color, blend mode
+    kDrawLine,         // x1, y1, x2, y2, paint
+    kDrawPaint,        // paint
+    kDrawRect,         // ltrb, paint
+    kDrawRRect,        // rrect, paint
+    kDrawDRRect,       // outer rrect, inner rrect, paint
+    kDrawOval,         // ltrb, paint
+    kDrawCircle,       // x, y, radius, paint
+    kDrawPath,         // path, paint
+    kDrawImage,        // image, x, y, paint
+    kDrawImageRect,    // image, src ltrb, dst ltrb, paint
+    kLastOp = kDrawImageRect,
+  };
+
+  static constexpr uint32_t kNoObject = 0xFFFFFFFF;
+
+  struct Objects {
+    std::vector<SkPath> paths;
+    std::vector<sk_sp<SkImage>> images;
+    std::vector<sk_sp<SkShader>> shaders;
+  };
+
+  DisplayList(std::vector<uint32_t> words, Objects objects);
+
+  ~DisplayList();
+
+  const std::vector<uint32_t>& words() const { return words_; }
+
+  const Objects& objects() const { return objects_; }
+
+  // Replays all operations onto |canvas|. Returns false (after replaying the
+  // operations preceding it) if a malformed operation is encountered.
+  bool Replay(SkCanvas* canvas) const;
+
+  // What the content hash of a display list is computed from. Unlike the
+  // display list it references no images, so it can be kept after the display
+  // list was replayed and hashed later on any thread.
+  struct HashInput {
+    std::vector<uint32_t> words;
+    std::vector<SkPath> paths;
+    std::vector<uint32_t> image_ids;
+
+    uint64_t ComputeHash() const;
+  };
+
+  // Returns false if the display list references objects whose content cannot
+  // be hashed cheaply (shaders).
+  bool GetHashInput(HashInput* input) const;
+
+  // Computes a hash of the contents of the display list. Two display lists
+  // that draw the same content hash to the same value even if the objects
+  // they reference were re-created. Returns false if the display list
+  // references objects whose content cannot be hashed cheaply (shaders).
+  bool ComputeContentHash(uint64_t* hash) const;
+
+ private:
+  const std::vector<uint32_t> words_;
+  const Objects objects_;
+
+  FXL_DISALLOW_COPY_AND_ASSIGN(DisplayList);
+};
+
+}  // namespace blink
+
+#endif  // FLUTTER_LIB_UI_PAINTING_DISPLAY_LIST_H_
@@ -0,0 +1,122 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string.h>
+
+#include "flutter/lib/ui/painting/display_list.h"
+#include "flutter/lib/ui/painting/paint.h"
+#include "third_party/benchmark/include/benchmark/benchmark_api.h"
+#include "third_party/skia/include/core/SkBBHFactory.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+
+namespace blink {
+
+namespace {
+
+constexpr SkScalar kCellSize = 8;
+constexpr int kColumns = 64;
+
+SkRect CellRect(int index) {
+  return SkRect::MakeXYWH((index % kColumns) * kCellSize,
+                          (index / kColumns) * kCellSize, kCellSize - 1,
+                          kCellSize - 1);
+}
+
+SkColor CellColor(int index) {
+  return SkColorSetARGB(0xFF, index & 0xFF, (index >> 8) & 0xFF, 0x80);
+}
+
+void PushFloat(std::vector<uint32_t>& words, float value) {
+  uint32_t word;
+  memcpy(&word, &value, sizeof(word));
+  words.push_back(word);
+}
+
+// Encodes the operations the same way _DisplayListBuilder in painting.dart
+// does.
+std::vector<uint32_t> EncodeRects(int count) {
+  std::vector<uint32_t> words;
+  for (int i = 0; i < count; i++) {
+    const SkRect rect = CellRect(i);
+    words.push_back(static_cast<uint32_t>(DisplayList::Op::kSave));
+    words.push_back(static_cast<uint32_t>(DisplayList::Op::kTranslate));
+    PushFloat(words, 0.5f);
+    PushFloat(words, 0.5f);
+    words.push_back(static_cast<uint32_t>(DisplayList::Op::kDrawRect));
+    PushFloat(words, rect.left());
+    PushFloat(words, rect.top());
+    PushFloat(words, rect.right());
+    PushFloat(words, rect.bottom());
+    words.push_back(DisplayList::kNoObject);
+    for (size_t field = 0; field < kPaintDataWordCount; field++) {
+      // The color is encoded XOR'd with the default (opaque black).
+      words.push_back(field == 1 ? CellColor(i) ^ 0xFF000000 : 0);
+    }
+    words.push_back(static_cast<uint32_t>(DisplayList::Op::kRestore));
+  }
+  return words;
+}
+
+SkRect BenchmarkBounds() {
+  return SkRect::MakeWH(kColumns * kCellSize, kColumns * kCellSize);
+}
+
+}  // namespace
+
+// Baseline: one Skia call per operation, as the per-operation natives did.
+static void BM_RecordDirect(benchmark::State& state) {
+  const int count = state.range(0);
+  SkRTreeFactory rtree_factory;
+  while (state.KeepRunning()) {
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(BenchmarkBounds(),
+                                               &rtree_factory);
+    for (int i = 0; i < count; i++) {
+      SkPaint paint;
+      paint.setAntiAlias(true);
+      paint.setColor(CellColor(i));
+      canvas->save();
+      canvas->translate(0.5f, 0.5f);
+      canvas->drawRect(CellRect(i), paint);
+      canvas->restore();
+    }
+    benchmark::DoNotOptimize(recorder.finishRecordingAsPicture());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_RecordDirect)->Range(64, 4096);
+
+// The operations are decoded from a single display list submission.
+static void BM_RecordDisplayList(benchmark::State& state) {
+  const int count = state.range(0);
+  const std::vector<uint32_t> words = EncodeRects(count);
+  SkRTreeFactory rtree_factory;
+  while (state.KeepRunning()) {
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(BenchmarkBounds(),
+                                               &rtree_factory);
+    DisplayList display_list(words, {});
+    display_list.Replay(canvas);
+    benchmark::DoNotOptimize(recorder.finishRecordingAsPicture());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_RecordDisplayList)->Range(64, 4096);
+
+static void BM_DisplayListContentHash(benchmark::State& state) {
+  const int count = state.range(0);
+  DisplayList display_list(EncodeRects(count), {});
+  while (state.KeepRunning()) {
+    uint64_t hash = 0;
+    display_list.ComputeContentHash(&hash);
+    benchmark::DoNotOptimize(hash);
+  }
+  state.SetBytesProcessed(state.iterations() * display_list.words().size() *
+                          sizeof(uint32_t));
+}
+BENCHMARK(BM_DisplayListContentHash)->Range(64, 4096);
+
+}  // namespace blink
+
+BENCHMARK_MAIN();
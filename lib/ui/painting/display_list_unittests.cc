@@ -0,0 +1,201 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string.h>
+
+#include "flutter/lib/ui/painting/display_list.h"
+#include "flutter/lib/ui/painting/paint.h"
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace blink {
+
+namespace {
+
+void PushOp(std::vector<uint32_t>& words, DisplayList::Op op) {
+  words.push_back(static_cast<uint32_t>(op));
+}
+
+void PushFloat(std::vector<uint32_t>& words, float value) {
+  uint32_t word;
+  memcpy(&word, &value, sizeof(word));
+  words.push_back(word);
+}
+
+void PushRect(std::vector<uint32_t>& words, const SkRect& rect) {
+  PushFloat(words, rect.left());
+  PushFloat(words, rect.top());
+  PushFloat(words, rect.right());
+  PushFloat(words, rect.bottom());
+}
+
+// Encodes a paint the same way _DisplayListBuilder in painting.dart does.
+void PushPaint(std::vector<uint32_t>& words, SkColor color) {
+  words.push_back(DisplayList::kNoObject);
+  for (size_t field = 0; field < kPaintDataWordCount; field++) {
+    // The color is encoded XOR'd with the default (opaque black).
+    words.push_back(field == 1 ? color ^ 0xFF000000 : 0);
+  }
+}
+
+void PushDrawRect(std::vector<uint32_t>& words,
+                  const SkRect& rect,
+                  SkColor color) {
+  PushOp(words, DisplayList::Op::kDrawRect);
+  PushRect(words, rect);
+  PushPaint(words, color);
+}
+
+sk_sp<SkSurface> MakeSurface() {
+  sk_sp<SkSurface> surface = SkSurface::MakeRasterN32Premul(100, 100);
+  surface->getCanvas()->clear(SK_ColorWHITE);
+  return surface;
+}
+
+SkColor GetPixel(SkSurface* surface, int x, int y) {
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(1, 1);
+  surface->readPixels(bitmap, x, y);
+  return bitmap.getColor(0, 0);
+}
+
+}  // namespace
+
+TEST(DisplayList, ReplaysOperations) {
+  std::vector<uint32_t> words;
+  PushOp(words, DisplayList::Op::kSave);
+  PushOp(words, DisplayList::Op::kTranslate);
+  PushFloat(words, 50);
+  PushFloat(words, 0);
+  PushDrawRect(words, SkRect::MakeWH(10, 10), SK_ColorRED);
+  PushOp(words, DisplayList::Op::kRestore);
+  PushDrawRect(words, SkRect::MakeXYWH(0, 50, 10, 10), SK_ColorBLUE);
+
+  DisplayList display_list(words, {});
+  sk_sp<SkSurface> surface = MakeSurface();
+  ASSERT_TRUE(display_list.Replay(surface->getCanvas()));
+  ASSERT_EQ(surface->getCanvas()->getSaveCount(), 1);
+  ASSERT_EQ(GetPixel(surface.get(), 55, 5), SK_ColorRED);
+  ASSERT_EQ(GetPixel(surface.get(), 5, 5), SK_ColorWHITE);
+  ASSERT_EQ(GetPixel(surface.get(), 5, 55), SK_ColorBLUE);
+}
+
+TEST(DisplayList, ReplaysPathsAndImages) {
+  DisplayList::Objects objects;
+  objects.paths.push_back(SkPath().addRect(SkRect::MakeWH(10, 10)));
+  sk_sp<SkSurface> image_surface = SkSurface::MakeRasterN32Premul(10, 10);
+  image_surface->getCanvas()->clear(SK_ColorGREEN);
+  objects.images.push_back(image_surface->makeImageSnapshot());
+
+  std::vector<uint32_t> words;
+  PushOp(words, DisplayList::Op::kDrawPath);
+  words.push_back(0);
+  PushPaint(words, SK_ColorRED);
+  PushOp(words, DisplayList::Op::kDrawImage);
+  words.push_back(0);
+  PushFloat(words, 50);
+  PushFloat(words, 50);
+  PushPaint(words, SK_ColorBLACK);
+
+  DisplayList display_list(words, std::move(objects));
+  sk_sp<SkSurface> surface = MakeSurface();
+  ASSERT_TRUE(display_list.Replay(surface->getCanvas()));
+  ASSERT_EQ(GetPixel(surface.get(), 5, 5), SK_ColorRED);
+  ASSERT_EQ(GetPixel(surface.get(), 55, 55), SK_ColorGREEN);
+}
+
+TEST(DisplayList, StopsAtTruncatedOperation) {
+  std::vector<uint32_t> words;
+  PushDrawRect(words, SkRect::MakeWH(10, 10), SK_ColorRED);
+  PushOp(words, DisplayList::Op::kSave);
+  PushOp(words, DisplayList::Op::kDrawRect);
+  PushFloat(words, 50);
+
+  DisplayList display_list(words, {});
+  sk_sp<SkSurface> surface = MakeSurface();
+  ASSERT_FALSE(display_list.Replay(surface->getCanvas()));
+  // The operations preceding the malformed one are replayed.
+  ASSERT_EQ(GetPixel(surface.get(), 5, 5), SK_ColorRED);
+  ASSERT_EQ(surface->getCanvas()->getSaveCount(), 2);
+}
+
+TEST(DisplayList, RejectsUnknownOperations) {
+  std::vector<uint32_t> words;
+  words.push_back(0);
+  ASSERT_FALSE(DisplayList(words, {}).Replay(MakeSurface()->getCanvas()));
+
+  words.clear();
+  words.push_back(static_cast<uint32_t>(DisplayList::Op::kLastOp) + 1);
+  ASSERT_FALSE(DisplayList(words, {}).Replay(MakeSurface()->getCanvas()));
+}
+
+TEST(DisplayList, RejectsMissingObjects) {
+  std::vector<uint32_t> words;
+  PushOp(words, DisplayList::Op::kDrawPath);
+  words.push_back(0);
+  PushPaint(words, SK_ColorRED);
+  ASSERT_FALSE(DisplayList(words, {}).Replay(MakeSurface()->getCanvas()));
+
+  DisplayList::Objects objects;
+  objects.images.push_back(nullptr);
+  words.clear();
+  PushOp(words, DisplayList::Op::kDrawImage);
+  words.push_back(0);
+  PushFloat(words, 0);
+  PushFloat(words, 0);
+  PushPaint(words, SK_ColorBLACK);
+  ASSERT_FALSE(DisplayList(words, std::move(objects))
+                   .Replay(MakeSurface()->getCanvas()));
+}
+
+TEST(DisplayList, ContentHashDependsOnContent) {
+  std::vector<uint32_t> words;
+  PushOp(words, DisplayList::Op::kDrawPath);
+  words.push_back(0);
+  PushPaint(words, SK_ColorRED);
+
+  DisplayList::Objects objects1;
+  objects1.paths.push_back(SkPath().addRect(SkRect::MakeWH(10, 10)));
+  DisplayList::Objects objects2;
+  objects2.paths.push_back(SkPath().addRect(SkRect::MakeWH(10, 10)));
+  DisplayList::Objects objects3;
+  objects3.paths.push_back(SkPath().addOval(SkRect::MakeWH(10, 10)));
+
+  uint64_t hash1 = 0, hash2 = 0, hash3 = 0;
+  ASSERT_TRUE(DisplayList(words, std::move(objects1)).ComputeContentHash(
+      &hash1));
+  ASSERT_TRUE(DisplayList(words, std::move(objects2)).ComputeContentHash(
+      &hash2));
+  ASSERT_TRUE(DisplayList(words, std::move(objects3)).ComputeContentHash(
+      &hash3));
+  ASSERT_EQ(hash1, hash2);
+  ASSERT_NE(hash1, hash3);
+
+  DisplayList::Objects objects4;
+  objects4.shaders.push_back(nullptr);
+  uint64_t hash4 = 0;
+  ASSERT_FALSE(DisplayList({}, std::move(objects4)).ComputeContentHash(&hash4));
+}
+
+TEST(DisplayList, HashInputHashesLikeTheDisplayList) {
+  std::vector<uint32_t> words;
+  PushOp(words, DisplayList::Op::kDrawPath);
+  words.push_back(0);
+  PushPaint(words, SK_ColorRED);
+
+  DisplayList::Objects objects;
+  objects.paths.push_back(SkPath().addRect(SkRect::MakeWH(10, 10)));
+  objects.images.push_back(nullptr);
+  DisplayList display_list(words, std::move(objects));
+
+  DisplayList::HashInput input;
+  ASSERT_TRUE(display_list.GetHashInput(&input));
+  ASSERT_EQ(input.image_ids.size(), 1u);
+
+  uint64_t hash = 0;
+  ASSERT_TRUE(display_list.ComputeContentHash(&hash));
+  ASSERT_EQ(input.ComputeHash(), hash);
+}
+
+}  // namespace blink
@@ -45,15 +45,18 @@ ImageFilter::~ImageFilter() {}
 
 void ImageFilter::initImage(CanvasImage* image) {
   filter_ = SkImageSource::Make(image->image());
+  blur_sigma_.set(0, 0);
 }
 
 void ImageFilter::initPicture(Picture* picture) {
   filter_ = SkPictureImageFilter::Make(picture->picture());
+  blur_sigma_.set(0, 0);
 }
 
 void ImageFilter::initBlur(double sigma_x, double sigma_y) {
   filter_ = SkBlurImageFilter::Make(sigma_x, sigma_y, nullptr, nullptr,
                                     SkBlurImageFilter::kClamp_TileMode);
+  blur_sigma_.set(sigma_x, sigma_y);
 }
 
 void ImageFilter::initMatrix(const tonic::Float64List& matrix4,
@@ -61,6 +64,7 @@ void ImageFilter::initMatrix(const tonic::Float64List& matrix4,
   filter_ = SkImageFilter::MakeMatrixFilter(
       ToSkMatrix(matrix4), static_cast<SkFilterQuality>(filterQuality),
       nullptr);
+  blur_sigma_.set(0, 0);
 }
 
 }  // namespace blink
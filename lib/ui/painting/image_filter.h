@@ -28,12 +28,16 @@ class ImageFilter : public RefCountedDartWrappable<ImageFilter> {
 
   const sk_sp<SkImageFilter>& filter() { return filter_; }
 
+  // The sigma of the filter if it is a plain Gaussian blur, zero otherwise.
+  const SkVector& blur_sigma() const { return blur_sigma_; }
+
   static void RegisterNatives(tonic::DartLibraryNatives* natives);
 
  private:
   ImageFilter();
 
   sk_sp<SkImageFilter> filter_;
+  SkVector blur_sigma_ = SkVector::Make(0, 0);
 };
 
 }  // namespace blink
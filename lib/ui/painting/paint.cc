@@ -31,6 +31,8 @@ constexpr int kMaskFilterIndex = 12;
 constexpr int kMaskFilterBlurStyleIndex = 13;
 constexpr int kMaskFilterSigmaIndex = 14;
 constexpr size_t kDataByteCount = 75;  // 4 * (last index + 1)
+static_assert(kMaskFilterSigmaIndex + 1 == kPaintDataWordCount,
+              "kPaintDataWordCount must match the encoded fields.");
 
 // Indices for objects.
 constexpr int kShaderIndex = 0;
@@ -75,52 +77,56 @@ Paint::Paint(Dart_Handle paint_objects, Dart_Handle paint_data) {
   tonic::DartByteData byte_data(paint_data);
   FXL_CHECK(byte_data.length_in_bytes() == kDataByteCount);
 
-  const uint32_t* uint_data = static_cast<const uint32_t*>(byte_data.data());
-  const float* float_data = static_cast<const float*>(byte_data.data());
+  DecodeData(byte_data.data(), &paint_);
+}
+
+void Paint::DecodeData(const void* data, SkPaint* paint) {
+  const uint32_t* uint_data = static_cast<const uint32_t*>(data);
+  const float* float_data = static_cast<const float*>(data);
 
-  paint_.setAntiAlias(uint_data[kIsAntiAliasIndex] == 0);
+  paint->setAntiAlias(uint_data[kIsAntiAliasIndex] == 0);
 
   uint32_t encoded_color = uint_data[kColorIndex];
   if (encoded_color) {
     SkColor color = encoded_color ^ kColorDefault;
-    paint_.setColor(color);
+    paint->setColor(color);
   }
 
   uint32_t encoded_blend_mode = uint_data[kBlendModeIndex];
   if (encoded_blend_mode) {
     uint32_t blend_mode = encoded_blend_mode ^ kBlendModeDefault;
-    paint_.setBlendMode(static_cast<SkBlendMode>(blend_mode));
+    paint->setBlendMode(static_cast<SkBlendMode>(blend_mode));
   }
 
   uint32_t style = uint_data[kStyleIndex];
   if (style)
-    paint_.setStyle(static_cast<SkPaint::Style>(style));
+    paint->setStyle(static_cast<SkPaint::Style>(style));
 
   float stroke_width = float_data[kStrokeWidthIndex];
   if (stroke_width != 0.0)
-    paint_.setStrokeWidth(stroke_width);
+    paint->setStrokeWidth(stroke_width);
 
   uint32_t stroke_cap = uint_data[kStrokeCapIndex];
   if (stroke_cap)
-    paint_.setStrokeCap(static_cast<SkPaint::Cap>(stroke_cap));
+    paint->setStrokeCap(static_cast<SkPaint::Cap>(stroke_cap));
 
   uint32_t stroke_join = uint_data[kStrokeJoinIndex];
   if (stroke_join)
-    paint_.setStrokeJoin(static_cast<SkPaint::Join>(stroke_join));
+    paint->setStrokeJoin(static_cast<SkPaint::Join>(stroke_join));
 
   float stroke_miter_limit = float_data[kStrokeMiterLimitIndex];
   if (stroke_miter_limit != 0.0)
-    paint_.setStrokeMiter(stroke_miter_limit + kStrokeMiterLimitDefault);
+    paint->setStrokeMiter(stroke_miter_limit + kStrokeMiterLimitDefault);
 
   uint32_t filter_quality = uint_data[kFilterQualityIndex];
   if (filter_quality)
-    paint_.setFilterQuality(static_cast<SkFilterQuality>(filter_quality));
+    paint->setFilterQuality(static_cast<SkFilterQuality>(filter_quality));
 
   if (uint_data[kColorFilterIndex]) {
     SkColor color = uint_data[kColorFilterColorIndex];
     SkBlendMode blend_mode =
         static_cast<SkBlendMode>(uint_data[kColorFilterBlendModeIndex]);
-    paint_.setColorFilter(SkColorFilter::MakeModeFilter(color, blend_mode));
+    paint->setColorFilter(SkColorFilter::MakeModeFilter(color, blend_mode));
   }
 
   switch (uint_data[kMaskFilterIndex]) {
@@ -130,7 +136,7 @@ Paint::Paint(Dart_Handle paint_objects, Dart_Handle paint_data) {
       SkBlurStyle blur_style =
           static_cast<SkBlurStyle>(uint_data[kMaskFilterBlurStyleIndex]);
       double sigma = float_data[kMaskFilterSigmaIndex];
-      paint_.setMaskFilter(SkMaskFilter::MakeBlur(blur_style, sigma));
+      paint->setMaskFilter(SkMaskFilter::MakeBlur(blur_style, sigma));
       break;
   }
 }
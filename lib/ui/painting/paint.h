@@ -10,11 +10,19 @@
 
 namespace blink {
 
+// The number of 32-bit fields of the encoded paint data that carry values.
+// Must be kept in sync with the Paint class in painting.dart.
+constexpr size_t kPaintDataWordCount = 15;
+
 class Paint {
  public:
   Paint() = default;
   Paint(Dart_Handle paint_objects, Dart_Handle paint_data);
 
+  // Applies the |kPaintDataWordCount| fields of encoded paint data at |data|
+  // to |paint|. Objects (such as the shader) are not part of the encoded data.
+  static void DecodeData(const void* data, SkPaint* paint);
+
   const SkPaint* paint() const { return is_null_ ? nullptr : &paint_; }
 
  private:
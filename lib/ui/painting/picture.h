@@ -5,6 +5,9 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_PICTURE_H_
 #define FLUTTER_LIB_UI_PAINTING_PICTURE_H_
 
+#include <memory>
+
+#include "flutter/flow/picture_content_hash.h"
 #include "flutter/flow/skia_gpu_object.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "flutter/lib/ui/painting/image.h"
@@ -27,6 +30,15 @@ class Picture : public RefCountedDartWrappable<Picture> {
 
   sk_sp<SkPicture> picture() const { return picture_.get(); }
 
+  // A fingerprint of the content of the picture that is stable across
+  // recordings, or null if the content could not be fingerprinted.
+  const std::shared_ptr<flow::PictureContentHash>& content_hash() const {
+    return content_hash_;
+  }
+  void set_content_hash(std::shared_ptr<flow::PictureContentHash> hash) {
+    content_hash_ = std::move(hash);
+  }
+
   fxl::RefPtr<CanvasImage> toImage(int width, int height);
 
   void dispose();
@@ -39,6 +51,7 @@ class Picture : public RefCountedDartWrappable<Picture> {
   explicit Picture(flow::SkiaGPUObject<SkPicture> picture);
 
   flow::SkiaGPUObject<SkPicture> picture_;
+  std::shared_ptr<flow::PictureContentHash> content_hash_;
 };
 
 }  // namespace blink
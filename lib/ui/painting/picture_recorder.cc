@@ -53,6 +53,7 @@ fxl::RefPtr<Picture> PictureRecorder::endRecording() {
 
   fxl::RefPtr<Picture> picture = Picture::Create(UIDartState::CreateGPUObject(
       picture_recorder_.finishRecordingAsPicture()));
+  picture->set_content_hash(canvas_->TakeContentHash());
   canvas_->Clear();
   canvas_->ClearDartWrapper();
   canvas_ = nullptr;
@@ -995,6 +995,28 @@ class Paragraph extends NativeFieldWrapperClass2 {
   void layout(ParagraphConstraints constraints) => _layout(constraints.width);
   void _layout(double width) native 'Paragraph_layout';
 
+  /// Computes the size and position of each glyph in each of the given
+  /// paragraphs, using the [ParagraphConstraints] at the same index of
+  /// `constraints`.
+  ///
+  /// This is equivalent to calling [layout] on each of the paragraphs in turn,
+  /// but the paragraphs share their font lookups and the buffers used while
+  /// laying them out. Prefer this method when laying out many similar
+  /// paragraphs at once, such as the items of a list.
+  static void layoutAll(List<Paragraph> paragraphs, List<ParagraphConstraints> constraints) {
+    assert(paragraphs != null);
+    assert(constraints != null);
+    if (paragraphs.length != constraints.length)
+      throw new ArgumentError('"paragraphs" and "constraints" arguments must have equal length.');
+    final Float64List widths = new Float64List(constraints.length);
+    for (int i = 0; i < constraints.length; i += 1)
+      widths[i] = constraints[i].width;
+    final String error = _layoutAll(paragraphs, widths);
+    if (error != null)
+      throw new ArgumentError(error);
+  }
+  static String _layoutAll(List<Paragraph> paragraphs, Float64List widths) native 'Paragraph_layoutAll';
+
   /// Returns a list of text boxes that enclose the given text range.
   List<TextBox> getBoxesForRange(int start, int end) native 'Paragraph_getRectsForRange';
 
@@ -4,6 +4,16 @@
 
 #include "flutter/lib/ui/text/asset_manager_font_provider.h"
 
+#include "flutter/fml/build_config.h"
+
+#if OS_POSIX && !OS_FUCHSIA
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+
+#include "flutter/fml/trace_event.h"
 #include "lib/fxl/logging.h"
 #include "third_party/skia/include/core/SkData.h"
 #include "third_party/skia/include/core/SkStream.h"
@@ -18,6 +28,38 @@ void MappingReleaseProc(const void* ptr, void* context) {
   delete reinterpret_cast<fml::Mapping*>(context);
 }
 
+size_t GetResidentSize(const SkData& data) {
+#if OS_POSIX && !OS_FUCHSIA
+  if (data.size() == 0) {
+    return 0;
+  }
+
+  static const uintptr_t page_size = ::sysconf(_SC_PAGESIZE);
+  const uintptr_t start =
+      reinterpret_cast<uintptr_t>(data.data()) & ~(page_size - 1);
+  const uintptr_t end = reinterpret_cast<uintptr_t>(data.bytes()) + data.size();
+  const size_t page_count = (end - start + page_size - 1) / page_size;
+
+#if OS_MACOSX
+  std::vector<char> residency(page_count);
+#else
+  std::vector<unsigned char> residency(page_count);
+#endif
+  if (::mincore(reinterpret_cast<void*>(start), end - start,
+                residency.data()) != 0) {
+    return data.size();
+  }
+
+  size_t resident_pages = 0;
+  for (auto page : residency) {
+    resident_pages += page & 1;
+  }
+  return std::min<size_t>(resident_pages * page_size, data.size());
+#else
+  return data.size();
+#endif  // OS_POSIX && !OS_FUCHSIA
+}
+
 }  // anonymous namespace
 
 AssetManagerFontProvider::AssetManagerFontProvider(
@@ -63,6 +105,14 @@ void AssetManagerFontProvider::RegisterAsset(std::string family_name,
   family_it->second.registerAsset(asset);
 }
 
+size_t AssetManagerFontProvider::GetResidentBytes() const {
+  size_t resident_bytes = 0;
+  for (const auto& family : registered_families_) {
+    resident_bytes += family.second.GetResidentBytes();
+  }
+  return resident_bytes;
+}
+
 AssetManagerFontStyleSet::AssetManagerFontStyleSet(
     fml::RefPtr<blink::AssetManager> asset_manager)
     : asset_manager_(asset_manager) {}
@@ -73,6 +123,16 @@ void AssetManagerFontStyleSet::registerAsset(std::string asset) {
   assets_.emplace_back(asset);
 }
 
+size_t AssetManagerFontStyleSet::GetResidentBytes() const {
+  size_t resident_bytes = 0;
+  for (const TypefaceAsset& asset : assets_) {
+    if (asset.data) {
+      resident_bytes += GetResidentSize(*asset.data);
+    }
+  }
+  return resident_bytes;
+}
+
 int AssetManagerFontStyleSet::count() {
   return assets_.size();
 }
@@ -90,6 +150,7 @@ SkTypeface* AssetManagerFontStyleSet::createTypeface(int i) {
 
   TypefaceAsset& asset = assets_[index];
   if (!asset.typeface) {
+    TRACE_EVENT0("flutter", "AssetManagerFontStyleSet::createTypeface");
     std::unique_ptr<fml::Mapping> asset_mapping =
         asset_manager_->GetAsMapping(asset.asset);
     if (asset_mapping == nullptr) {
@@ -102,10 +163,12 @@ SkTypeface* AssetManagerFontStyleSet::createTypeface(int i) {
         MappingReleaseProc, asset_mapping_ptr);
     std::unique_ptr<SkMemoryStream> stream = SkMemoryStream::Make(asset_data);
 
-    // Ownership of the stream is transferred.
+    // Ownership of the stream is transferred. The stream does not copy the
+    // data so only the tables the typeface reads are paged in.
     asset.typeface = SkTypeface::MakeFromStream(stream.release());
     if (!asset.typeface)
       return nullptr;
+    asset.data = std::move(asset_data);
   }
 
   return SkRef(asset.typeface.get());
@@ -119,7 +182,7 @@ SkTypeface* AssetManagerFontStyleSet::matchStyle(const SkFontStyle& pattern) {
     if (asset.typeface && asset.typeface->fontStyle() == pattern)
       return SkRef(asset.typeface.get());
 
-  return SkRef(assets_[0].typeface.get());
+  return createTypeface(0);
 }
 
 }  // namespace blink
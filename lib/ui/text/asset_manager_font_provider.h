@@ -24,6 +24,10 @@ class AssetManagerFontStyleSet : public SkFontStyleSet {
 
   void registerAsset(std::string asset);
 
+  // The number of bytes of font data of the typefaces created so far that are
+  // backed by physical memory.
+  size_t GetResidentBytes() const;
+
   // |SkFontStyleSet|
   int count() override;
 
@@ -42,7 +46,10 @@ class AssetManagerFontStyleSet : public SkFontStyleSet {
   struct TypefaceAsset {
     TypefaceAsset(std::string a) : asset(std::move(a)) {}
     std::string asset;
+    // Created on first use. Backed by the data of the asset which is mapped
+    // in place when the asset store allows it.
     sk_sp<SkTypeface> typeface;
+    sk_sp<SkData> data;
   };
   std::vector<TypefaceAsset> assets_;
 
@@ -56,6 +63,11 @@ class AssetManagerFontProvider : public txt::FontAssetProvider {
 
   void RegisterAsset(std::string family_name, std::string asset);
 
+  // The number of bytes of the font assets used so far that are backed by
+  // physical memory. Assets that are mapped from storage only become resident
+  // as their glyphs are used.
+  size_t GetResidentBytes() const;
+
   // |FontAssetProvider|
   size_t GetFamilyCount() const override;
 
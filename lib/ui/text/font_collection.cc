@@ -21,10 +21,19 @@
 namespace blink {
 
 FontCollection::FontCollection()
-    : collection_(std::make_shared<txt::FontCollection>()) {
+    : collection_(std::make_shared<txt::FontCollection>()),
+      is_shared_(false),
+      asset_font_provider_(nullptr) {
   collection_->SetDefaultFontManager(SkFontMgr::RefDefault());
 }
 
+FontCollection::FontCollection(std::shared_ptr<txt::FontCollection> collection)
+    : collection_(std::move(collection)),
+      is_shared_(true),
+      asset_font_provider_(nullptr) {
+  FXL_DCHECK(collection_);
+}
+
 FontCollection::~FontCollection() {
   collection_.reset();
   SkGraphics::PurgeFontCache();
@@ -35,6 +44,10 @@ std::shared_ptr<txt::FontCollection> FontCollection::GetFontCollection() const {
 }
 
 void FontCollection::RegisterFonts(fml::RefPtr<AssetManager> asset_manager) {
+  if (is_shared_) {
+    return;
+  }
+
   std::unique_ptr<fml::Mapping> manifest_mapping =
       asset_manager->GetAsMapping("FontManifest.json");
   if (manifest_mapping == nullptr) {
@@ -90,11 +103,31 @@ void FontCollection::RegisterFonts(fml::RefPtr<AssetManager> asset_manager) {
     }
   }
 
+  asset_font_provider_ = font_provider.get();
   collection_->SetAssetFontManager(
       sk_make_sp<txt::AssetFontManager>(std::move(font_provider)));
 }
 
+void FontCollection::SetFallbackFontCachePath(
+    std::string path,
+    txt::FontCollection::FileTaskRunner file_task_runner) {
+  if (is_shared_) {
+    return;
+  }
+
+  collection_->SetFallbackFontCachePath(std::move(path),
+                                        std::move(file_task_runner));
+}
+
+size_t FontCollection::GetResidentAssetFontBytes() const {
+  return asset_font_provider_ ? asset_font_provider_->GetResidentBytes() : 0;
+}
+
 void FontCollection::RegisterTestFonts() {
+  if (is_shared_) {
+    return;
+  }
+
   sk_sp<SkTypeface> test_typeface =
       SkTypeface::MakeFromStream(GetTestFontData().release());
 
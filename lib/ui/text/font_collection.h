@@ -6,9 +6,11 @@
 #define FLUTTER_LIB_UI_TEXT_FONT_COLLECTION_H_
 
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "flutter/assets/asset_manager.h"
+#include "flutter/lib/ui/text/asset_manager_font_provider.h"
 #include "lib/fxl/macros.h"
 #include "lib/fxl/memory/ref_ptr.h"
 #include "txt/font_collection.h"
@@ -19,6 +21,10 @@ class FontCollection {
  public:
   FontCollection();
 
+  // Shares the fonts of a collection that is owned by another engine. Fonts
+  // are only registered by the owner of the collection.
+  explicit FontCollection(std::shared_ptr<txt::FontCollection> collection);
+
   ~FontCollection();
 
   std::shared_ptr<txt::FontCollection> GetFontCollection() const;
@@ -27,8 +33,22 @@ class FontCollection {
 
   void RegisterTestFonts();
 
+  // Remembers the fallback fonts resolved for missing characters in the file
+  // at |path| across runs. Only the owner of a collection sets the path. See
+  // |txt::FontCollection::SetFallbackFontCachePath|.
+  void SetFallbackFontCachePath(
+      std::string path,
+      txt::FontCollection::FileTaskRunner file_task_runner);
+
+  // The number of bytes of the registered font assets that are backed by
+  // physical memory. Zero for shared collections.
+  size_t GetResidentAssetFontBytes() const;
+
  private:
   std::shared_ptr<txt::FontCollection> collection_;
+  const bool is_shared_;
+  // Owned by the asset font manager of the collection.
+  AssetManagerFontProvider* asset_font_provider_;
 
   FXL_DISALLOW_COPY_AND_ASSIGN(FontCollection);
 };
@@ -6,12 +6,15 @@
 
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/third_party/txt/src/txt/paragraph_batch.h"
 #include "lib/fxl/logging.h"
 #include "lib/fxl/tasks/task_runner.h"
 #include "third_party/tonic/converter/dart_converter.h"
 #include "third_party/tonic/dart_args.h"
 #include "third_party/tonic/dart_binding_macros.h"
 #include "third_party/tonic/dart_library_natives.h"
+#include "third_party/tonic/typed_data/float64_list.h"
 
 using tonic::ToDart;
 
@@ -33,7 +36,14 @@ IMPLEMENT_WRAPPERTYPEINFO(ui, Paragraph);
   V(Paragraph, getRectsForRange)    \
   V(Paragraph, getPositionForOffset)
 
-DART_BIND_ALL(Paragraph, FOR_EACH_BINDING)
+FOR_EACH_BINDING(DART_NATIVE_CALLBACK)
+
+void Paragraph::RegisterNatives(tonic::DartLibraryNatives* natives) {
+  natives->Register({
+      {"Paragraph_layoutAll", Paragraph::layoutAll, 2, true},
+  });
+  natives->Register({FOR_EACH_BINDING(DART_REGISTER_NATIVE)});
+}
 
 Paragraph::Paragraph(std::unique_ptr<txt::Paragraph> paragraph)
     : m_paragraphImpl(
@@ -80,6 +90,51 @@ void Paragraph::layout(double width) {
   m_paragraphImpl->layout(width);
 }
 
+void Paragraph::layoutAll(Dart_NativeArguments args) {
+  TRACE_EVENT0("flutter", "Paragraph::layoutAll");
+
+  // Read the paragraphs before the widths are acquired since the Dart API can
+  // not be used while typed data is acquired.
+  Dart_Handle paragraphs_handle = Dart_GetNativeArgument(args, 0);
+  intptr_t length = 0;
+  if (Dart_IsError(Dart_ListLength(paragraphs_handle, &length))) {
+    Dart_SetReturnValue(args, ToDart("Paragraphs must be a list"));
+    return;
+  }
+  std::vector<Paragraph*> paragraphs;
+  paragraphs.reserve(length);
+  for (intptr_t i = 0; i < length; ++i) {
+    Paragraph* paragraph = tonic::DartConverter<Paragraph*>::FromDart(
+        Dart_ListGetAt(paragraphs_handle, i));
+    if (!paragraph) {
+      Dart_SetReturnValue(args, ToDart("Paragraphs must not be null"));
+      return;
+    }
+    paragraphs.push_back(paragraph);
+  }
+
+  Dart_Handle exception = nullptr;
+  tonic::Float64List widths =
+      tonic::DartConverter<tonic::Float64List>::FromArguments(args, 1,
+                                                              exception);
+  if (exception) {
+    Dart_SetReturnValue(args, exception);
+    return;
+  }
+  if (widths.num_elements() != length) {
+    widths.Release();
+    Dart_SetReturnValue(args, ToDart("Each paragraph must have a width"));
+    return;
+  }
+
+  txt::ParagraphBatch batch;
+  for (intptr_t i = 0; i < length; ++i) {
+    paragraphs[i]->m_paragraphImpl->addToBatch(&batch, widths[i]);
+  }
+  widths.Release();
+  batch.Layout();
+}
+
 void Paragraph::paint(Canvas* canvas, double x, double y) {
   m_paragraphImpl->paint(canvas, x, y);
 }
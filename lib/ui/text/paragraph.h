@@ -48,6 +48,10 @@ class Paragraph : public RefCountedDartWrappable<Paragraph> {
 
   virtual size_t GetAllocationSize() override;
 
+  // Lays out a list of paragraphs, each with the width at the same index of a
+  // Float64List, in one batch. Returns an error message on failure.
+  static void layoutAll(Dart_NativeArguments args);
+
   static void RegisterNatives(tonic::DartLibraryNatives* natives);
 
  private:
@@ -8,6 +8,10 @@
 #include "flutter/lib/ui/painting/canvas.h"
 #include "flutter/lib/ui/text/text_box.h"
 
+namespace txt {
+class ParagraphBatch;
+}  // namespace txt
+
 namespace blink {
 
 class ParagraphImpl {
@@ -30,6 +34,10 @@ class ParagraphImpl {
 
   virtual void layout(double width) = 0;
 
+  // Adds the paragraph to |batch| to be laid out with |width| instead of laying
+  // it out right away.
+  virtual void addToBatch(txt::ParagraphBatch* batch, double width) = 0;
+
   virtual void paint(Canvas* canvas, double x, double y) = 0;
 
   virtual std::vector<TextBox> getRectsForRange(unsigned start,
@@ -7,6 +7,7 @@
 #include "flutter/common/task_runners.h"
 #include "flutter/lib/ui/text/paragraph.h"
 #include "flutter/lib/ui/text/paragraph_impl.h"
+#include "flutter/third_party/txt/src/txt/paragraph_batch.h"
 #include "lib/fxl/logging.h"
 #include "lib/fxl/tasks/task_runner.h"
 #include "third_party/skia/include/core/SkPoint.h"
@@ -54,10 +55,16 @@ void ParagraphImplTxt::layout(double width) {
   m_paragraph->Layout(width);
 }
 
+void ParagraphImplTxt::addToBatch(txt::ParagraphBatch* batch, double width) {
+  m_width = width;
+  batch->AddParagraph(m_paragraph.get(), width);
+}
+
 void ParagraphImplTxt::paint(Canvas* canvas, double x, double y) {
   SkCanvas* sk_canvas = canvas->canvas();
   if (!sk_canvas)
     return;
+  canvas->InvalidateContentHash();
   m_paragraph->Paint(sk_canvas, x, y);
 }
 
@@ -27,6 +27,7 @@ class ParagraphImplTxt : public ParagraphImpl {
   bool didExceedMaxLines() override;
 
   void layout(double width) override;
+  void addToBatch(txt::ParagraphBatch* batch, double width) override;
   void paint(Canvas* canvas, double x, double y) override;
 
   std::vector<TextBox> getRectsForRange(unsigned start, unsigned end) override;
@@ -402,6 +402,19 @@ DartVM::DartVM(const Settings& settings,
 
   Dart_SetFileModifiedCallback(&DartFileModifiedCallback);
 
+#if !defined(OS_FUCHSIA)
+  // Lets the engine skip computing trace arguments nobody records. Tools start
+  // and stop recording via the service protocol.
+  bool trace_enabled = settings.trace_startup;
+  for (const std::string& flag : settings.dart_flags) {
+    trace_enabled |= flag.find("--timeline_streams") == 0;
+  }
+  fml::tracing::TraceSetEnabled(trace_enabled);
+  Dart_SetEmbedderTimelineCallbacks(
+      []() { fml::tracing::TraceSetEnabled(true); },
+      []() { fml::tracing::TraceSetEnabled(false); });
+#endif  // !defined(OS_FUCHSIA)
+
   {
     TRACE_EVENT0("flutter", "Dart_Initialize");
     Dart_InitializeParams params = {};
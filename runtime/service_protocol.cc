@@ -30,6 +30,12 @@ const fxl::StringView ServiceProtocol::kFlushUIThreadTasksExtensionName =
     "_flutter.flushUIThreadTasks";
 const fxl::StringView ServiceProtocol::kSetAssetBundlePathExtensionName =
     "_flutter.setAssetBundlePath";
+const fxl::StringView ServiceProtocol::kNotifyMemoryPressureExtensionName =
+    "_flutter.notifyMemoryPressure";
+const fxl::StringView ServiceProtocol::kGetStartupTimelineExtensionName =
+    "_flutter.getStartupTimeline";
+const fxl::StringView ServiceProtocol::kGetTaskStatsExtensionName =
+    "_flutter.getTaskStats";
 
 static constexpr fxl::StringView kViewIdPrefx = "_flutterView/";
 static constexpr fxl::StringView kListViewsExtensionName = "_flutter.listViews";
@@ -45,6 +51,9 @@ ServiceProtocol::ServiceProtocol()
           kRunInViewExtensionName,
           kFlushUIThreadTasksExtensionName,
           kSetAssetBundlePathExtensionName,
+          kNotifyMemoryPressureExtensionName,
+          kGetStartupTimelineExtensionName,
+          kGetTaskStatsExtensionName,
       }) {}
 
 ServiceProtocol::~ServiceProtocol() {
@@ -25,6 +25,9 @@ class ServiceProtocol {
   static const fxl::StringView kRunInViewExtensionName;
   static const fxl::StringView kFlushUIThreadTasksExtensionName;
   static const fxl::StringView kSetAssetBundlePathExtensionName;
+  static const fxl::StringView kNotifyMemoryPressureExtensionName;
+  static const fxl::StringView kGetStartupTimelineExtensionName;
+  static const fxl::StringView kGetTaskStatsExtensionName;
 
   class Handler {
    public:
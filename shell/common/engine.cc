@@ -4,10 +4,12 @@
 
 #include "flutter/shell/common/engine.h"
 
+#include <functional>
 #include <memory>
 #include <utility>
 
 #include "flutter/common/settings.h"
+#include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/lib/snapshot/snapshot.h"
 #include "flutter/lib/ui/text/font_collection.h"
@@ -19,6 +21,7 @@
 #include "lib/fxl/files/path.h"
 #include "lib/fxl/files/unique_fd.h"
 #include "lib/fxl/functional/make_copyable.h"
+#include "third_party/dart/runtime/include/dart_tools_api.h"
 #include "third_party/rapidjson/rapidjson/document.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
@@ -34,6 +37,10 @@ static constexpr char kLifecycleChannel[] = "flutter/lifecycle";
 static constexpr char kNavigationChannel[] = "flutter/navigation";
 static constexpr char kLocalizationChannel[] = "flutter/localization";
 static constexpr char kSettingsChannel[] = "flutter/settings";
+static constexpr char kSystemChannel[] = "flutter/system";
+
+// The time the VM is given to collect garbage under critical memory pressure.
+static constexpr int64_t kMemoryPressureIdleTimeMicros = 100000;
 
 Engine::Engine(Delegate& delegate,
                blink::DartVM& vm,
@@ -43,14 +50,23 @@ Engine::Engine(Delegate& delegate,
                blink::Settings settings,
                std::unique_ptr<Animator> animator,
                fml::WeakPtr<GrContext> resource_context,
-               fxl::RefPtr<flow::SkiaUnrefQueue> unref_queue)
+               fxl::RefPtr<flow::SkiaUnrefQueue> unref_queue,
+               std::shared_ptr<txt::FontCollection> shared_font_collection)
     : delegate_(delegate),
       settings_(std::move(settings)),
       animator_(std::move(animator)),
+      unref_queue_(unref_queue),
       load_script_error_(tonic::kNoError),
       activity_running_(false),
       have_surface_(false),
+      font_collection_(
+          shared_font_collection
+              ? std::make_unique<blink::FontCollection>(
+                    std::move(shared_font_collection))
+              : std::make_unique<blink::FontCollection>()),
       weak_factory_(this) {
+  fxl::RefPtr<fxl::TaskRunner> io_task_runner = task_runners.GetIOTaskRunner();
+
   // Runtime controller is initialized here because it takes a reference to this
   // object as its delegate. The delegate may be called in the constructor and
   // we want to be fully initilazed by that point.
@@ -65,6 +81,17 @@ Engine::Engine(Delegate& delegate,
       settings_.advisory_script_uri,        // advisory script uri
       settings_.advisory_script_entrypoint  // advisory script entrypoint
   );
+
+  if (!settings_.temp_directory_path.empty()) {
+    // Fallback fonts are resolved during layout, so the file is appended to
+    // on the IO thread.
+    font_collection_->SetFallbackFontCachePath(
+        fml::paths::JoinPaths(
+            {settings_.temp_directory_path, "flutter_fallback_fonts"}),
+        [io_task_runner](std::function<void()> task) {
+          io_task_runner->PostTask(std::move(task));
+        });
+  }
 }
 
 Engine::~Engine() = default;
@@ -87,9 +114,9 @@ bool Engine::UpdateAssetManager(
 
   // Using libTXT as the text engine.
   if (settings_.use_test_fonts) {
-    font_collection_.RegisterTestFonts();
+    font_collection_->RegisterTestFonts();
   } else {
-    font_collection_.RegisterFonts(asset_manager_);
+    font_collection_->RegisterFonts(asset_manager_);
   }
 
   return true;
@@ -182,6 +209,19 @@ void Engine::BeginFrame(fxl::TimePoint frame_time) {
 void Engine::NotifyIdle(int64_t deadline) {
   TRACE_EVENT0("flutter", "Engine::NotifyIdle");
   runtime_controller_->NotifyIdle(deadline);
+
+  // Measuring the resident bytes walks the pages of every asset font.
+  if (TRACE_EVENT_CATEGORY_ENABLED("flutter")) {
+    TRACE_COUNTER1("flutter", "AssetFontBytesResident", "bytes",
+                   font_collection_->GetResidentAssetFontBytes());
+  }
+
+  // The deadline is on the Dart timeline clock.
+  if (unref_queue_) {
+    unref_queue_->NotifyIdle(
+        fxl::TimePoint::Now() +
+        fxl::TimeDelta::FromMicroseconds(deadline - Dart_TimelineGetMicros()));
+  }
 }
 
 std::pair<bool, uint32_t> Engine::GetUIIsolateReturnCode() {
@@ -349,6 +389,27 @@ void Engine::SetAssistiveTechnologyEnabled(bool enabled) {
   runtime_controller_->SetAssistiveTechnologyEnabled(enabled);
 }
 
+void Engine::NotifyMemoryPressure(MemoryPressureLevel level) {
+  TRACE_EVENT0("flutter", "Engine::NotifyMemoryPressure");
+  // The framework evicts its image cache in response. It does not distinguish
+  // between levels.
+  static constexpr char kMemoryPressureMessage[] =
+      "{\"type\":\"memoryPressure\"}";
+  std::vector<uint8_t> data(
+      kMemoryPressureMessage,
+      kMemoryPressureMessage + sizeof(kMemoryPressureMessage) - 1);
+  DispatchPlatformMessage(fxl::MakeRefCounted<blink::PlatformMessage>(
+      kSystemChannel, std::move(data), nullptr));
+
+  if (level == MemoryPressureLevel::kCritical) {
+    // Give the VM a chance to collect the garbage right away instead of
+    // waiting for the next idle period, which may never come while the
+    // application is in the background.
+    runtime_controller_->NotifyIdle(Dart_TimelineGetMicros() +
+                                    kMemoryPressureIdleTimeMicros);
+  }
+}
+
 void Engine::StopAnimator() {
   animator_->Stop();
 }
@@ -398,7 +459,7 @@ void Engine::HandlePlatformMessage(
 }
 
 blink::FontCollection& Engine::GetFontCollection() {
-  return font_collection_;
+  return *font_collection_;
 }
 
 void Engine::HandleAssetPlatformMessage(
@@ -10,6 +10,7 @@
 
 #include "flutter/assets/asset_manager.h"
 #include "flutter/common/task_runners.h"
+#include "flutter/flow/skia_gpu_object.h"
 #include "flutter/lib/ui/semantics/custom_accessibility_action.h"
 #include "flutter/lib/ui/semantics/semantics_node.h"
 #include "flutter/lib/ui/text/font_collection.h"
@@ -19,6 +20,7 @@
 #include "flutter/runtime/runtime_controller.h"
 #include "flutter/runtime/runtime_delegate.h"
 #include "flutter/shell/common/animator.h"
+#include "flutter/shell/common/memory_pressure_level.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/run_configuration.h"
 #include "lib/fxl/macros.h"
@@ -41,6 +43,8 @@ class Engine final : public blink::RuntimeDelegate {
         fxl::RefPtr<blink::PlatformMessage> message) = 0;
   };
 
+  // If |shared_font_collection| is specified, its fonts are used instead of
+  // the fonts in the assets of this engine.
   Engine(Delegate& delegate,
          blink::DartVM& vm,
          fxl::RefPtr<blink::DartSnapshot> isolate_snapshot,
@@ -49,7 +53,8 @@ class Engine final : public blink::RuntimeDelegate {
          blink::Settings settings,
          std::unique_ptr<Animator> animator,
          fml::WeakPtr<GrContext> resource_context,
-         fxl::RefPtr<flow::SkiaUnrefQueue> unref_queue);
+         fxl::RefPtr<flow::SkiaUnrefQueue> unref_queue,
+         std::shared_ptr<txt::FontCollection> shared_font_collection);
 
   ~Engine() override;
 
@@ -101,6 +106,10 @@ class Engine final : public blink::RuntimeDelegate {
 
   void SetAssistiveTechnologyEnabled(bool enabled);
 
+  // Asks the framework to evict its image cache. At
+  // |MemoryPressureLevel::kCritical|, the VM collects garbage as well.
+  void NotifyMemoryPressure(MemoryPressureLevel level);
+
   void ScheduleFrame(bool regenerate_layer_tree = true) override;
 
   // |blink::RuntimeDelegate|
@@ -110,6 +119,8 @@ class Engine final : public blink::RuntimeDelegate {
   Engine::Delegate& delegate_;
   const blink::Settings settings_;
   std::unique_ptr<Animator> animator_;
+  // Also held by the runtime controller. Drained when the UI thread is idle.
+  fxl::RefPtr<flow::SkiaUnrefQueue> unref_queue_;
   std::unique_ptr<blink::RuntimeController> runtime_controller_;
   tonic::DartErrorHandleType load_script_error_;
   std::string initial_route_;
@@ -117,7 +128,7 @@ class Engine final : public blink::RuntimeDelegate {
   fml::RefPtr<blink::AssetManager> asset_manager_;
   bool activity_running_;
   bool have_surface_;
-  blink::FontCollection font_collection_;
+  std::unique_ptr<blink::FontCollection> font_collection_;
   fml::WeakPtrFactory<Engine> weak_factory_;
 
   // |blink::RuntimeDelegate|
@@ -5,6 +5,7 @@
 #include "flutter/shell/common/io_manager.h"
 
 #include "flutter/fml/message_loop.h"
+#include "flutter/shell/common/persistent_cache.h"
 #include "third_party/skia/include/gpu/gl/GrGLInterface.h"
 
 namespace shell {
@@ -27,7 +28,11 @@ sk_sp<GrContext> IOManager::CreateCompatibleResourceLoadingContext(
   // ES2 shading language when the ES3 external image extension is missing.
   options.fPreferExternalImagesOverES3 = true;
 
-  if (auto context = GrContext::MakeGL(GrGLMakeNativeInterface(), options)) {
+  auto interface = GrGLMakeNativeInterface();
+  options.fPersistentCache =
+      PersistentCache::GetCacheForGLContext(interface.get());
+
+  if (auto context = GrContext::MakeGL(std::move(interface), options)) {
     // Do not cache textures created by the image decoder.  These textures
     // should be deleted when they are no longer referenced by an SkImage.
     context->setResourceCacheLimits(0, 0);
@@ -67,6 +72,10 @@ fml::WeakPtr<GrContext> IOManager::GetResourceContext() const {
              : fml::WeakPtr<GrContext>();
 }
 
+sk_sp<GrContext> IOManager::GetSharedResourceContext() const {
+  return resource_context_;
+}
+
 fxl::RefPtr<flow::SkiaUnrefQueue> IOManager::GetSkiaUnrefQueue() const {
   return unref_queue_;
 }
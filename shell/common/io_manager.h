@@ -30,6 +30,9 @@ class IOManager {
 
   fml::WeakPtr<GrContext> GetResourceContext() const;
 
+  // Used to create IO managers for other shells on the same IO task runner.
+  sk_sp<GrContext> GetSharedResourceContext() const;
+
   fxl::RefPtr<flow::SkiaUnrefQueue> GetSkiaUnrefQueue() const;
 
  private:
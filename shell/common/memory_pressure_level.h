@@ -0,0 +1,22 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_MEMORY_PRESSURE_LEVEL_H_
+#define FLUTTER_SHELL_COMMON_MEMORY_PRESSURE_LEVEL_H_
+
+namespace shell {
+
+// The values must be kept in sync with |FlutterMemoryPressureLevel| in
+// embedder.h and the levels passed by FlutterView.java.
+enum class MemoryPressureLevel {
+  // Caches that are cheap to rebuild should be trimmed. For example, when the
+  // application moves to the background.
+  kModerate = 0,
+  // As much memory as possible should be released.
+  kCritical = 1,
+};
+
+}  // namespace shell
+
+#endif  // FLUTTER_SHELL_COMMON_MEMORY_PRESSURE_LEVEL_H_
@@ -0,0 +1,186 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/persistent_cache.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <map>
+#include <mutex>
+#include <sstream>
+
+#include "flutter/fml/hash.h"
+#include "flutter/fml/paths.h"
+#include "flutter/fml/trace_event.h"
+#include "lib/fxl/files/directory.h"
+#include "lib/fxl/files/file.h"
+#include "lib/fxl/logging.h"
+#include "third_party/skia/include/core/SkMilestone.h"
+
+namespace shell {
+
+namespace {
+
+// These are defined here to avoid resolving the platform GL headers. See the
+// note in gpu_surface_gl.cc.
+constexpr GrGLenum kGLVendor = 0x1F00;
+constexpr GrGLenum kGLRenderer = 0x1F01;
+constexpr GrGLenum kGLVersion = 0x1F02;
+
+std::string ToHexString(uint64_t value) {
+  std::stringstream stream;
+  stream << std::hex << value;
+  return stream.str();
+}
+
+std::string GetGLString(const GrGLInterface* interface, GrGLenum name) {
+  const GrGLubyte* value = interface->fFunctions.fGetString(name);
+  return value ? reinterpret_cast<const char*>(value) : "";
+}
+
+struct ProcessCaches {
+  std::mutex mutex;
+  std::string directory_path;
+  // Keyed by the directory of the cache.
+  std::map<std::string, PersistentCache*> caches;
+};
+
+ProcessCaches& GetProcessCaches() {
+  static ProcessCaches* caches = new ProcessCaches();
+  return *caches;
+}
+
+// Entries are stored as the size of the key, the size of the data, the key and
+// then the data. The key is checked on load since file names are only a hash
+// of the key. The size of the data detects truncated entries.
+using EntrySize = uint32_t;
+constexpr size_t kEntryHeaderSize = 2 * sizeof(EntrySize);
+
+}  // namespace
+
+void PersistentCache::SetCacheDirectoryPath(std::string path) {
+  ProcessCaches& process_caches = GetProcessCaches();
+  std::lock_guard<std::mutex> lock(process_caches.mutex);
+  process_caches.directory_path = std::move(path);
+}
+
+std::string PersistentCache::GetCacheDirectoryPath() {
+  ProcessCaches& process_caches = GetProcessCaches();
+  std::lock_guard<std::mutex> lock(process_caches.mutex);
+  return process_caches.directory_path;
+}
+
+PersistentCache* PersistentCache::GetCacheForGLContext(
+    const GrGLInterface* interface) {
+  if (interface == nullptr) {
+    return nullptr;
+  }
+
+  std::stringstream driver;
+  driver << GetGLString(interface, kGLVendor) << '\n'
+         << GetGLString(interface, kGLRenderer) << '\n'
+         << GetGLString(interface, kGLVersion);
+  return GetCacheForDriver(driver.str());
+}
+
+PersistentCache* PersistentCache::GetCacheForDriver(const std::string& driver) {
+  ProcessCaches& process_caches = GetProcessCaches();
+  std::lock_guard<std::mutex> lock(process_caches.mutex);
+  if (process_caches.directory_path.empty()) {
+    return nullptr;
+  }
+
+  // Program binaries are invalidated by driver updates as well as by changes
+  // to the shaders Skia generates.
+  const uint64_t driver_hash =
+      fml::HashBytes(fml::kHashSeed, driver.data(), driver.size());
+  const std::string directory = fml::paths::JoinPaths(
+      {process_caches.directory_path, "flutter_gpu_program_cache",
+       "skia-" + std::to_string(SK_MILESTONE) + "-" +
+           ToHexString(driver_hash)});
+
+  auto found = process_caches.caches.find(directory);
+  if (found != process_caches.caches.end()) {
+    return found->second;
+  }
+
+  if (!files::CreateDirectory(directory)) {
+    FXL_LOG(ERROR) << "Could not create the GPU program cache directory at "
+                   << directory;
+    return nullptr;
+  }
+
+  // Intentionally leaked since GrContexts only hold a raw pointer to it.
+  auto cache = new PersistentCache(directory);
+  process_caches.caches[directory] = cache;
+  return cache;
+}
+
+PersistentCache::PersistentCache(std::string directory)
+    : directory_(std::move(directory)), temp_file_count_(0) {}
+
+PersistentCache::~PersistentCache() = default;
+
+std::string PersistentCache::GetPathForKey(const SkData& key) const {
+  return fml::paths::JoinPaths(
+      {directory_,
+       ToHexString(fml::HashBytes(fml::kHashSeed, key.data(), key.size()))});
+}
+
+// |GrContextOptions::PersistentCache|
+sk_sp<SkData> PersistentCache::load(const SkData& key) {
+  TRACE_EVENT0("flutter", "PersistentCache::load");
+  std::string entry;
+  if (!files::ReadFileToString(GetPathForKey(key), &entry)) {
+    return nullptr;
+  }
+
+  EntrySize sizes[2] = {};
+  if (entry.size() < kEntryHeaderSize) {
+    return nullptr;
+  }
+  memcpy(sizes, entry.data(), kEntryHeaderSize);
+  const size_t key_size = sizes[0];
+  const size_t data_size = sizes[1];
+  if (key_size != key.size() ||
+      entry.size() != kEntryHeaderSize + key_size + data_size) {
+    // A hash collision or a truncated entry.
+    return nullptr;
+  }
+  if (memcmp(entry.data() + kEntryHeaderSize, key.data(), key_size) != 0) {
+    return nullptr;
+  }
+
+  return SkData::MakeWithCopy(entry.data() + kEntryHeaderSize + key_size,
+                              data_size);
+}
+
+// |GrContextOptions::PersistentCache|
+void PersistentCache::store(const SkData& key, const SkData& data) {
+  TRACE_EVENT0("flutter", "PersistentCache::store");
+  const EntrySize sizes[2] = {static_cast<EntrySize>(key.size()),
+                              static_cast<EntrySize>(data.size())};
+  std::string entry;
+  entry.reserve(kEntryHeaderSize + key.size() + data.size());
+  entry.append(reinterpret_cast<const char*>(sizes), kEntryHeaderSize);
+  entry.append(static_cast<const char*>(key.data()), key.size());
+  entry.append(static_cast<const char*>(data.data()), data.size());
+
+  // Write to a temporary file first so that other contexts (or the next run of
+  // the application) never see a partially written entry.
+  const std::string path = GetPathForKey(key);
+  const std::string temp_path =
+      path + ".tmp" + std::to_string(temp_file_count_++);
+  if (!files::WriteFile(temp_path, entry.data(), entry.size())) {
+    FXL_DLOG(WARNING) << "Could not write the GPU program cache entry at "
+                      << temp_path;
+    return;
+  }
+  if (::rename(temp_path.c_str(), path.c_str()) != 0) {
+    ::remove(temp_path.c_str());
+  }
+}
+
+}  // namespace shell
@@ -0,0 +1,67 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_PERSISTENT_CACHE_H_
+#define FLUTTER_SHELL_COMMON_PERSISTENT_CACHE_H_
+
+#include <atomic>
+#include <string>
+
+#include "lib/fxl/macros.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/gpu/GrContextOptions.h"
+#include "third_party/skia/include/gpu/gl/GrGLInterface.h"
+
+namespace shell {
+
+// A disk backed cache of the GPU programs compiled by Skia. Supplied to
+// GrContexts via |GrContextOptions::fPersistentCache| so that shaders compiled
+// on a previous run of the application are not compiled again.
+//
+// Program binaries are only valid for the GPU driver and the version of Skia
+// that produced them. Each combination gets its own directory under the cache
+// directory of the process.
+class PersistentCache : public GrContextOptions::PersistentCache {
+ public:
+  // Sets the directory under which the caches of all drivers are stored.
+  // Caching is disabled until a directory is set. Only affects GrContexts
+  // created after the call.
+  static void SetCacheDirectoryPath(std::string path);
+
+  // Returns the directory set by |SetCacheDirectoryPath| or an empty string if
+  // caching is disabled. Used by backends that persist their own caches.
+  static std::string GetCacheDirectoryPath();
+
+  // Returns the cache for the driver of the OpenGL context that is current on
+  // the calling thread, or null if caching is disabled. Caches live for the
+  // lifetime of the process.
+  static PersistentCache* GetCacheForGLContext(const GrGLInterface* interface);
+
+  // Returns the cache for the driver described by |driver|, or null if caching
+  // is disabled. Entries stored for one description are not seen by others.
+  static PersistentCache* GetCacheForDriver(const std::string& driver);
+
+  ~PersistentCache() override;
+
+  // The file in which the entry for |key| is stored.
+  std::string GetPathForKey(const SkData& key) const;
+
+  // |GrContextOptions::PersistentCache|
+  sk_sp<SkData> load(const SkData& key) override;
+
+  // |GrContextOptions::PersistentCache|
+  void store(const SkData& key, const SkData& data) override;
+
+ private:
+  const std::string directory_;
+  std::atomic<uint32_t> temp_file_count_;
+
+  explicit PersistentCache(std::string directory);
+
+  FXL_DISALLOW_COPY_AND_ASSIGN(PersistentCache);
+};
+
+}  // namespace shell
+
+#endif  // FLUTTER_SHELL_COMMON_PERSISTENT_CACHE_H_
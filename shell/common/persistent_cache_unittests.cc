@@ -0,0 +1,134 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stdint.h>
+#include <string.h>
+
+#include <sstream>
+#include <string>
+
+#include "flutter/fml/hash.h"
+#include "flutter/shell/common/persistent_cache.h"
+#include "gtest/gtest.h"
+#include "lib/fxl/files/file.h"
+#include "lib/fxl/files/scoped_temp_dir.h"
+
+namespace shell {
+namespace {
+
+constexpr char kDriver[] = "Vendor\nRenderer\nOpenGL ES 3.2 V1.0";
+constexpr char kUpdatedDriver[] = "Vendor\nRenderer\nOpenGL ES 3.2 V1.1";
+
+sk_sp<SkData> MakeData(const std::string& string) {
+  return SkData::MakeWithCopy(string.data(), string.size());
+}
+
+std::string ToString(const sk_sp<SkData>& data) {
+  return std::string(static_cast<const char*>(data->data()), data->size());
+}
+
+class PersistentCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    PersistentCache::SetCacheDirectoryPath(temp_dir_.path());
+  }
+
+  void TearDown() override { PersistentCache::SetCacheDirectoryPath(""); }
+
+ private:
+  files::ScopedTempDir temp_dir_;
+};
+
+}  // namespace
+
+TEST_F(PersistentCacheTest, IsDisabledWithoutADirectory) {
+  PersistentCache::SetCacheDirectoryPath("");
+  ASSERT_EQ(PersistentCache::GetCacheForDriver(kDriver), nullptr);
+}
+
+TEST_F(PersistentCacheTest, LoadsStoredEntries) {
+  PersistentCache* cache = PersistentCache::GetCacheForDriver(kDriver);
+  ASSERT_NE(cache, nullptr);
+
+  auto key = MakeData("key");
+  ASSERT_FALSE(cache->load(*key));
+
+  cache->store(*key, *MakeData("program"));
+  auto loaded = cache->load(*key);
+  ASSERT_TRUE(loaded);
+  ASSERT_EQ(ToString(loaded), "program");
+  ASSERT_FALSE(cache->load(*MakeData("other key")));
+
+  // Later stores replace the entry.
+  cache->store(*key, *MakeData("recompiled program"));
+  ASSERT_EQ(ToString(cache->load(*key)), "recompiled program");
+}
+
+TEST_F(PersistentCacheTest, NamesEntriesByTheHashOfTheirKey) {
+  PersistentCache* cache = PersistentCache::GetCacheForDriver(kDriver);
+  ASSERT_NE(cache, nullptr);
+
+  const std::string key = "key";
+  std::stringstream name;
+  name << '/' << std::hex
+       << fml::HashBytes(fml::kHashSeed, key.data(), key.size());
+  const std::string path = cache->GetPathForKey(*MakeData(key));
+  ASSERT_GT(path.size(), name.str().size());
+  ASSERT_EQ(path.substr(path.size() - name.str().size()), name.str());
+  ASSERT_NE(cache->GetPathForKey(*MakeData("other key")), path);
+}
+
+TEST_F(PersistentCacheTest, DriverUpdatesInvalidateEntries) {
+  PersistentCache* cache = PersistentCache::GetCacheForDriver(kDriver);
+  ASSERT_NE(cache, nullptr);
+  ASSERT_EQ(PersistentCache::GetCacheForDriver(kDriver), cache);
+
+  auto key = MakeData("key");
+  cache->store(*key, *MakeData("program"));
+
+  PersistentCache* updated_cache =
+      PersistentCache::GetCacheForDriver(kUpdatedDriver);
+  ASSERT_NE(updated_cache, nullptr);
+  ASSERT_NE(updated_cache, cache);
+  ASSERT_NE(updated_cache->GetPathForKey(*key), cache->GetPathForKey(*key));
+  ASSERT_FALSE(updated_cache->load(*key));
+  ASSERT_TRUE(cache->load(*key));
+}
+
+TEST_F(PersistentCacheTest, IgnoresCorruptEntries) {
+  PersistentCache* cache = PersistentCache::GetCacheForDriver(kDriver);
+  ASSERT_NE(cache, nullptr);
+
+  auto key = MakeData("key");
+  const std::string path = cache->GetPathForKey(*key);
+  cache->store(*key, *MakeData("program"));
+  std::string entry;
+  ASSERT_TRUE(files::ReadFileToString(path, &entry));
+
+  // Truncated within the header, within the key and within the data.
+  for (size_t size : {size_t{0}, size_t{6}, size_t{10}, entry.size() - 1}) {
+    ASSERT_TRUE(files::WriteFile(path, entry.data(), size));
+    ASSERT_FALSE(cache->load(*key)) << "Truncated to " << size << " bytes";
+  }
+
+  // Trailing garbage.
+  std::string extended = entry + "garbage";
+  ASSERT_TRUE(files::WriteFile(path, extended.data(), extended.size()));
+  ASSERT_FALSE(cache->load(*key));
+
+  // The entry of another key that collides with this one.
+  std::string collision = entry;
+  collision[2 * sizeof(uint32_t)] = 'K';
+  ASSERT_TRUE(files::WriteFile(path, collision.data(), collision.size()));
+  ASSERT_FALSE(cache->load(*key));
+
+  // A key size that runs past the end of the entry.
+  std::string oversized = entry;
+  const uint32_t key_size = 1000;
+  memcpy(&oversized[0], &key_size, sizeof(key_size));
+  ASSERT_TRUE(files::WriteFile(path, oversized.data(), oversized.size()));
+  ASSERT_FALSE(cache->load(*key));
+}
+
+}  // namespace shell
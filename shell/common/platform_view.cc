@@ -100,6 +100,10 @@ void PlatformView::MarkTextureFrameAvailable(int64_t texture_id) {
   delegate_.OnPlatformViewMarkTextureFrameAvailable(*this, texture_id);
 }
 
+void PlatformView::NotifyMemoryPressure(MemoryPressureLevel level) {
+  delegate_.OnPlatformViewNotifyMemoryPressure(*this, level);
+}
+
 std::unique_ptr<Surface> PlatformView::CreateRenderingSurface() {
   // We have a default implementation because tests create a platform view but
   // never a rendering surface.
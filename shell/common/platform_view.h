@@ -15,6 +15,7 @@
 #include "flutter/lib/ui/window/platform_message.h"
 #include "flutter/lib/ui/window/pointer_data_packet.h"
 #include "flutter/lib/ui/window/viewport_metrics.h"
+#include "flutter/shell/common/memory_pressure_level.h"
 #include "flutter/shell/common/surface.h"
 #include "flutter/shell/common/vsync_waiter.h"
 #include "lib/fxl/macros.h"
@@ -72,6 +73,10 @@ class PlatformView {
     virtual void OnPlatformViewMarkTextureFrameAvailable(
         const PlatformView& view,
         int64_t texture_id) = 0;
+
+    virtual void OnPlatformViewNotifyMemoryPressure(
+        const PlatformView& view,
+        MemoryPressureLevel level) = 0;
   };
 
   explicit PlatformView(Delegate& delegate, blink::TaskRunners task_runners);
@@ -122,6 +127,11 @@ class PlatformView {
   // Called once per texture update (e.g. video frame), on the platform thread.
   void MarkTextureFrameAvailable(int64_t texture_id);
 
+  // Called when the system is low on memory or the application is moved to
+  // the background. Trims the GPU and raster caches and asks the framework to
+  // evict its image cache.
+  void NotifyMemoryPressure(MemoryPressureLevel level);
+
  protected:
   PlatformView::Delegate& delegate_;
   const blink::TaskRunners task_runners_;
@@ -4,8 +4,11 @@
 
 #include "flutter/shell/common/rasterizer.h"
 
+#include <chrono>
 #include <utility>
 
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkEncodedImageFormat.h"
 #include "third_party/skia/include/core/SkImageEncoder.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
@@ -15,6 +18,10 @@
 
 namespace shell {
 
+// Under moderate memory pressure, GPU resources that were not used for this
+// long are released.
+static constexpr std::chrono::milliseconds kUnusedResourcePurgeAge(5000);
+
 Rasterizer::Rasterizer(blink::TaskRunners task_runners)
     : Rasterizer(std::move(task_runners),
                  std::make_unique<flow::CompositorContext>()) {}
@@ -206,6 +213,65 @@ static sk_sp<SkData> ScreenshotLayerTreeAsImage(
   return SkData::MakeWithCopy(pixmap.addr32(), pixmap.computeByteSize());
 }
 
+void Rasterizer::WarmUpShaderCache(const std::string& skp_path) {
+  TRACE_EVENT0("flutter", "Rasterizer::WarmUpShaderCache");
+  GrContext* context = surface_ ? surface_->GetContext() : nullptr;
+  if (shader_cache_warmed_up_ || context == nullptr) {
+    return;
+  }
+  shader_cache_warmed_up_ = true;
+
+  fml::FileMapping mapping(skp_path);
+  sk_sp<SkPicture> picture =
+      mapping.GetMapping() != nullptr
+          ? SkPicture::MakeFromData(mapping.GetMapping(), mapping.GetSize())
+          : nullptr;
+  if (!picture) {
+    FXL_LOG(ERROR) << "Could not read the shader warm up picture at "
+                   << skp_path;
+    return;
+  }
+
+  if (!surface_->MakeRenderContextCurrent()) {
+    return;
+  }
+
+  const SkIRect bounds = picture->cullRect().roundOut();
+  auto warmup_surface = SkSurface::MakeRenderTarget(
+      context, SkBudgeted::kNo,
+      SkImageInfo::MakeN32Premul(bounds.width(), bounds.height()));
+  if (!warmup_surface) {
+    return;
+  }
+
+  // The pixels are thrown away. Only the programs compiled (and stored in the
+  // persistent cache) along the way are of interest.
+  SkCanvas* canvas = warmup_surface->getCanvas();
+  canvas->translate(-bounds.left(), -bounds.top());
+  canvas->drawPicture(picture);
+  canvas->flush();
+}
+
+void Rasterizer::NotifyMemoryPressure(MemoryPressureLevel level) {
+  TRACE_EVENT0("flutter", "Rasterizer::NotifyMemoryPressure");
+  // Cached rasterizations are rebuilt within a few frames.
+  compositor_context_->raster_cache().Clear();
+
+  if (level == MemoryPressureLevel::kCritical) {
+    last_layer_tree_.reset();
+  }
+
+  GrContext* context = surface_ ? surface_->GetContext() : nullptr;
+  if (context == nullptr || !surface_->MakeRenderContextCurrent()) {
+    return;
+  }
+  if (level == MemoryPressureLevel::kCritical) {
+    context->freeGpuResources();
+  } else {
+    context->purgeResourcesNotUsedInMs(kUnusedResourcePurgeAge);
+  }
+}
+
 Rasterizer::Screenshot Rasterizer::ScreenshotLastLayerTree(
     Rasterizer::ScreenshotType type,
     bool base64_encode) {
@@ -6,12 +6,14 @@
 #define SHELL_COMMON_RASTERIZER_H_
 
 #include <memory>
+#include <string>
 
 #include "flutter/common/task_runners.h"
 #include "flutter/flow/compositor_context.h"
 #include "flutter/flow/layers/layer_tree.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/shell/common/memory_pressure_level.h"
 #include "flutter/shell/common/surface.h"
 #include "flutter/synchronization/pipeline.h"
 #include "lib/fxl/functional/closure.h"
@@ -59,6 +61,17 @@ class Rasterizer final {
 
   Screenshot ScreenshotLastLayerTree(ScreenshotType type, bool base64_encode);
 
+  // Draws the picture at |skp_path| (in the format produced by
+  // |ScreenshotLastLayerTree| with |ScreenshotType::SkiaPicture|) offscreen so
+  // that the GPU programs it needs are compiled ahead of the first frame.
+  // Only does anything the first time it is called on a GPU surface.
+  void WarmUpShaderCache(const std::string& skp_path);
+
+  // Releases GPU resources and caches. At |MemoryPressureLevel::kCritical|,
+  // the last layer tree is dropped as well so it cannot be redrawn until the
+  // next frame is produced.
+  void NotifyMemoryPressure(MemoryPressureLevel level);
+
   // Sets a callback that will be executed after the next frame is submitted to
   // the surface on the GPU task runner.
   void SetNextFrameCallback(fxl::Closure callback);
@@ -69,6 +82,7 @@ class Rasterizer final {
   std::unique_ptr<flow::CompositorContext> compositor_context_;
   std::unique_ptr<flow::LayerTree> last_layer_tree_;
   fxl::Closure next_frame_callback_;
+  bool shader_cache_warmed_up_ = false;
   fml::WeakPtrFactory<Rasterizer> weak_factory_;
 
   void DoDraw(std::unique_ptr<flow::LayerTree> layer_tree);
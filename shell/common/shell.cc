@@ -6,6 +6,8 @@
 
 #include "flutter/shell/common/shell.h"
 
+#include <algorithm>
+#include <future>
 #include <memory>
 #include <sstream>
 #include <vector>
@@ -20,6 +22,7 @@
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/runtime/start_up.h"
 #include "flutter/shell/common/engine.h"
+#include "flutter/shell/common/persistent_cache.h"
 #include "flutter/shell/common/skia_event_tracer_impl.h"
 #include "flutter/shell/common/switches.h"
 #include "flutter/shell/common/vsync_waiter.h"
@@ -29,6 +32,7 @@
 #include "lib/fxl/log_settings.h"
 #include "lib/fxl/logging.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
+#include "third_party/skia/include/core/SkFontMgr.h"
 #include "third_party/skia/include/core/SkGraphics.h"
 
 #ifdef ERROR
@@ -37,18 +41,39 @@
 
 namespace shell {
 
+// Process wide initialization that is only needed once an engine is created on
+// the UI thread. Runs in the background while the VM and the other components
+// of the first shell are created.
+static std::shared_future<void>& GetBackgroundInitialization() {
+  static std::shared_future<void>* initialization =
+      new std::shared_future<void>();
+  return *initialization;
+}
+
+static void WaitForBackgroundInitialization() {
+  // Wait on a copy. Waiting on the same future from several threads races.
+  std::shared_future<void> initialization = GetBackgroundInitialization();
+  if (initialization.valid()) {
+    TRACE_EVENT0("flutter", "WaitForBackgroundInitialization");
+    initialization.wait();
+  }
+}
+
 std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
     blink::TaskRunners task_runners,
     blink::Settings settings,
     fxl::RefPtr<blink::DartSnapshot> isolate_snapshot,
     fxl::RefPtr<blink::DartSnapshot> shared_snapshot,
     Shell::CreateCallback<PlatformView> on_create_platform_view,
-    Shell::CreateCallback<Rasterizer> on_create_rasterizer) {
+    Shell::CreateCallback<Rasterizer> on_create_rasterizer,
+    const Shell* spawning_shell,
+    std::shared_ptr<StartupTimeline> startup_timeline) {
   if (!task_runners.IsValid()) {
     return nullptr;
   }
 
-  auto shell = std::unique_ptr<Shell>(new Shell(task_runners, settings));
+  auto shell = std::unique_ptr<Shell>(
+      new Shell(task_runners, settings, std::move(startup_timeline)));
 
   // Create the platform view on the platform thread (this thread).
   auto platform_view = on_create_platform_view(*shell.get());
@@ -63,10 +88,13 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
     return nullptr;
   }
 
-  // Create the IO manager on the IO thread. The IO manager must be initialized
-  // first because it has state that the other subsystems depend on. It must
-  // first be booted and the necessary references obtained to initialize the
-  // other subsystems.
+  // The IO manager and the rasterizer are created concurrently on their own
+  // threads. The engine needs the resource context of the IO manager, so it is
+  // only created once the IO manager is. The wait for it happens on this
+  // thread rather than on the UI thread because custom task runners of the
+  // embedder may run the UI and IO tasks on the same thread in any order.
+
+  // Create the IO manager on the IO thread.
   fml::AutoResetWaitableEvent io_latch;
   std::unique_ptr<IOManager> io_manager;
   fml::WeakPtr<GrContext> resource_context;
@@ -74,20 +102,28 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
   auto io_task_runner = shell->GetTaskRunners().GetIOTaskRunner();
   fml::TaskRunner::RunNowOrPostTask(
       io_task_runner,
-      [&io_latch,          //
-       &io_manager,        //
-       &resource_context,  //
-       &unref_queue,       //
-       &platform_view,     //
-       io_task_runner      //
+      [&io_latch,           //
+       &io_manager,         //
+       &resource_context,   //
+       &unref_queue,        //
+       &platform_view,      //
+       io_task_runner,      //
+       spawning_shell,      //
+       shell = shell.get()  //
   ]() {
+        // Spawned shells run on the same IO task runner and can share the
+        // resource context instead of creating one of their own.
         io_manager = std::make_unique<IOManager>(
-            platform_view->CreateResourceContext(), io_task_runner);
+            spawning_shell
+                ? spawning_shell->io_manager_->GetSharedResourceContext()
+                : platform_view->CreateResourceContext(),
+            io_task_runner);
         resource_context = io_manager->GetResourceContext();
         unref_queue = io_manager->GetSkiaUnrefQueue();
+        shell->startup_timeline_->Record(
+            StartupTimeline::Phase::kIOManagerCreated);
         io_latch.Signal();
       });
-  io_latch.Wait();
 
   // Create the rasterizer on the GPU thread.
   fml::AutoResetWaitableEvent gpu_latch;
@@ -101,9 +137,19 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
         if (auto new_rasterizer = on_create_rasterizer(*shell)) {
           rasterizer = std::move(new_rasterizer);
         }
+        shell->startup_timeline_->Record(
+            StartupTimeline::Phase::kRasterizerCreated);
         gpu_latch.Signal();
       });
 
+  // The engine creates a font collection and lays out text with ICU. The
+  // background initialization of both overlaps with the creation of the IO
+  // manager and the rasterizer.
+  if (!spawning_shell) {
+    WaitForBackgroundInitialization();
+  }
+  io_latch.Wait();
+
   // Create the engine on the UI thread.
   fml::AutoResetWaitableEvent ui_latch;
   std::unique_ptr<Engine> engine;
@@ -111,12 +157,13 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
       shell->GetTaskRunners().GetUITaskRunner(),
       fxl::MakeCopyable([&ui_latch,                                       //
                          &engine,                                         //
+                         &resource_context,                               //
+                         &unref_queue,                                    //
                          shell = shell.get(),                             //
                          isolate_snapshot = std::move(isolate_snapshot),  //
                          shared_snapshot = std::move(shared_snapshot),    //
                          vsync_waiter = std::move(vsync_waiter),          //
-                         resource_context = std::move(resource_context),  //
-                         unref_queue = std::move(unref_queue)             //
+                         spawning_shell                                   //
   ]() mutable {
         const auto& task_runners = shell->GetTaskRunners();
 
@@ -125,6 +172,12 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
         auto animator = std::make_unique<Animator>(*shell, task_runners,
                                                    std::move(vsync_waiter));
 
+        std::shared_ptr<txt::FontCollection> shared_font_collection;
+        if (spawning_shell) {
+          shared_font_collection = spawning_shell->engine_->GetFontCollection()
+                                       .GetFontCollection();
+        }
+
         engine = std::make_unique<Engine>(*shell,                       //
                                           shell->GetDartVM(),           //
                                           std::move(isolate_snapshot),  //
@@ -133,8 +186,11 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
                                           shell->GetSettings(),         //
                                           std::move(animator),          //
                                           std::move(resource_context),  //
-                                          std::move(unref_queue)        //
+                                          std::move(unref_queue),       //
+                                          std::move(shared_font_collection)  //
         );
+        shell->startup_timeline_->Record(
+            StartupTimeline::Phase::kEngineCreated);
         ui_latch.Signal();
       }));
 
@@ -151,6 +207,8 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
     return nullptr;
   }
 
+  shell->startup_timeline_->Record(StartupTimeline::Phase::kShellSetUp);
+
   return shell;
 }
 
@@ -197,11 +255,24 @@ static void PerformInitializationTasks(const blink::Settings& settings) {
       FXL_DLOG(INFO) << "Skia deterministic rendering is enabled.";
     }
 
-    if (settings.icu_data_path.size() != 0) {
-      fml::icu::InitializeICU(settings.icu_data_path);
-    } else {
+    if (settings.icu_data_path.size() == 0) {
       FXL_DLOG(WARNING) << "Skipping ICU initialization in the shell.";
     }
+
+    // Mapping the ICU data and creating the font manager (which parses the
+    // system font configuration on some platforms) are not needed till the
+    // engine is created. Overlap them with the creation of the VM and of the
+    // other components of the shell.
+    GetBackgroundInitialization() =
+        std::async(std::launch::async,
+                   [icu_data_path = settings.icu_data_path]() {
+                     TRACE_EVENT0("flutter", "BackgroundInitialization");
+                     if (icu_data_path.size() != 0) {
+                       fml::icu::InitializeICU(icu_data_path);
+                     }
+                     SkFontMgr::RefDefault();
+                   })
+            .share();
   });
 }
 
@@ -210,16 +281,20 @@ std::unique_ptr<Shell> Shell::Create(
     blink::Settings settings,
     Shell::CreateCallback<PlatformView> on_create_platform_view,
     Shell::CreateCallback<Rasterizer> on_create_rasterizer) {
+  auto startup_timeline = std::make_shared<StartupTimeline>();
+  startup_timeline->Record(StartupTimeline::Phase::kShellCreateStarted);
+
   PerformInitializationTasks(settings);
 
   auto vm = blink::DartVM::ForProcess(settings);
   FXL_CHECK(vm) << "Must be able to initialize the VM.";
-  return Shell::Create(std::move(task_runners),             //
-                       std::move(settings),                 //
-                       vm->GetIsolateSnapshot(),            //
-                       blink::DartSnapshot::Empty(),        //
-                       std::move(on_create_platform_view),  //
-                       std::move(on_create_rasterizer)      //
+  return CreateWithSnapshots(std::move(task_runners),             //
+                             std::move(settings),                 //
+                             vm->GetIsolateSnapshot(),            //
+                             blink::DartSnapshot::Empty(),        //
+                             std::move(on_create_platform_view),  //
+                             std::move(on_create_rasterizer),     //
+                             std::move(startup_timeline)          //
   );
 }
 
@@ -230,6 +305,27 @@ std::unique_ptr<Shell> Shell::Create(
     fxl::RefPtr<blink::DartSnapshot> shared_snapshot,
     Shell::CreateCallback<PlatformView> on_create_platform_view,
     Shell::CreateCallback<Rasterizer> on_create_rasterizer) {
+  auto startup_timeline = std::make_shared<StartupTimeline>();
+  startup_timeline->Record(StartupTimeline::Phase::kShellCreateStarted);
+
+  return CreateWithSnapshots(std::move(task_runners),             //
+                             std::move(settings),                 //
+                             std::move(isolate_snapshot),         //
+                             std::move(shared_snapshot),          //
+                             std::move(on_create_platform_view),  //
+                             std::move(on_create_rasterizer),     //
+                             std::move(startup_timeline)          //
+  );
+}
+
+std::unique_ptr<Shell> Shell::CreateWithSnapshots(
+    blink::TaskRunners task_runners,
+    blink::Settings settings,
+    fxl::RefPtr<blink::DartSnapshot> isolate_snapshot,
+    fxl::RefPtr<blink::DartSnapshot> shared_snapshot,
+    Shell::CreateCallback<PlatformView> on_create_platform_view,
+    Shell::CreateCallback<Rasterizer> on_create_rasterizer,
+    std::shared_ptr<StartupTimeline> startup_timeline) {
   PerformInitializationTasks(settings);
 
   if (!task_runners.IsValid() || !on_create_platform_view ||
@@ -248,14 +344,17 @@ std::unique_ptr<Shell> Shell::Create(
        isolate_snapshot = std::move(isolate_snapshot),  //
        shared_snapshot = std::move(shared_snapshot),    //
        on_create_platform_view,                         //
-       on_create_rasterizer                             //
+       on_create_rasterizer,                            //
+       startup_timeline = std::move(startup_timeline)   //
   ]() {
         shell = CreateShellOnPlatformThread(std::move(task_runners),      //
                                             settings,                     //
                                             std::move(isolate_snapshot),  //
                                             std::move(shared_snapshot),   //
                                             on_create_platform_view,      //
-                                            on_create_rasterizer          //
+                                            on_create_rasterizer,         //
+                                            nullptr,  // spawning shell
+                                            startup_timeline              //
         );
         latch.Signal();
       });
@@ -263,13 +362,52 @@ std::unique_ptr<Shell> Shell::Create(
   return shell;
 }
 
-Shell::Shell(blink::TaskRunners task_runners, blink::Settings settings)
+std::unique_ptr<Shell> Shell::Spawn(
+    blink::Settings settings,
+    Shell::CreateCallback<PlatformView> on_create_platform_view,
+    Shell::CreateCallback<Rasterizer> on_create_rasterizer) const {
+  FXL_DCHECK(is_setup_);
+  FXL_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+  TRACE_EVENT0("flutter", "Shell::Spawn");
+
+  if (!on_create_platform_view || !on_create_rasterizer) {
+    return nullptr;
+  }
+
+  auto startup_timeline = std::make_shared<StartupTimeline>();
+  startup_timeline->Record(StartupTimeline::Phase::kShellCreateStarted);
+
+  return CreateShellOnPlatformThread(task_runners_,                       //
+                                     std::move(settings),                 //
+                                     vm_->GetIsolateSnapshot(),           //
+                                     blink::DartSnapshot::Empty(),        //
+                                     std::move(on_create_platform_view),  //
+                                     std::move(on_create_rasterizer),     //
+                                     this,  // spawning shell
+                                     std::move(startup_timeline)          //
+  );
+}
+
+Shell::Shell(blink::TaskRunners task_runners,
+             blink::Settings settings,
+             std::shared_ptr<StartupTimeline> startup_timeline)
     : task_runners_(std::move(task_runners)),
       settings_(std::move(settings)),
-      vm_(blink::DartVM::ForProcess(settings_)) {
+      vm_(blink::DartVM::ForProcess(settings_)),
+      startup_timeline_(std::move(startup_timeline)) {
+  FXL_DCHECK(startup_timeline_);
   FXL_DCHECK(task_runners_.IsValid());
   FXL_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
+  // Must happen before any GrContext is created.
+  if (!settings_.temp_directory_path.empty()) {
+    PersistentCache::SetCacheDirectoryPath(settings_.temp_directory_path);
+  }
+
+  if (settings_.enable_task_stats) {
+    EnableTaskStats();
+  }
+
   // Install service protocol handlers.
 
   service_protocol_handlers_[blink::ServiceProtocol::kScreenshotExtensionName
@@ -297,6 +435,49 @@ Shell::Shell(blink::TaskRunners task_runners, blink::Settings settings)
           task_runners_.GetUITaskRunner(),
           std::bind(&Shell::OnServiceProtocolSetAssetBundlePath, this,
                     std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [blink::ServiceProtocol::kNotifyMemoryPressureExtensionName
+           .ToString()] = {
+          task_runners_.GetPlatformTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolNotifyMemoryPressure, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [blink::ServiceProtocol::kGetStartupTimelineExtensionName.ToString()] = {
+          task_runners_.GetPlatformTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetStartupTimeline, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [blink::ServiceProtocol::kGetTaskStatsExtensionName.ToString()] = {
+          task_runners_.GetPlatformTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetTaskStats, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+}
+
+void Shell::EnableTaskStats() {
+  const std::pair<const char*, fxl::RefPtr<fxl::TaskRunner>> runners[] = {
+      {"platform", task_runners_.GetPlatformTaskRunner()},
+      {"ui", task_runners_.GetUITaskRunner()},
+      {"gpu", task_runners_.GetGPUTaskRunner()},
+      {"io", task_runners_.GetIOTaskRunner()},
+  };
+  for (const auto& task_runner : runners) {
+    // The other threads are not doing anything yet. So this does not hold up
+    // shell creation for long.
+    fml::AutoResetWaitableEvent latch;
+    std::shared_ptr<fml::TaskStats> stats;
+    fml::TaskRunner::RunNowOrPostTask(task_runner.second, [&latch, &stats]() {
+      // Task runners supplied by embedders need not be backed by a message
+      // loop.
+      if (fml::MessageLoop::IsInitializedForCurrentThread()) {
+        stats = fml::MessageLoop::GetCurrent().EnableTaskStats();
+      }
+      latch.Signal();
+    });
+    latch.Wait();
+    if (stats) {
+      task_stats_.emplace_back(task_runner.first, std::move(stats));
+    }
+  }
 }
 
 Shell::~Shell() {
@@ -403,6 +584,10 @@ blink::DartVM& Shell::GetDartVM() const {
   return *vm_;
 }
 
+const StartupTimeline& Shell::GetStartupTimeline() const {
+  return *startup_timeline_;
+}
+
 // |shell::PlatformView::Delegate|
 void Shell::OnPlatformViewCreated(const PlatformView& view,
                                   std::unique_ptr<Surface> surface) {
@@ -416,16 +601,22 @@ void Shell::OnPlatformViewCreated(const PlatformView& view,
   // a synchronous fashion.
 
   fml::AutoResetWaitableEvent latch;
-  auto gpu_task = fxl::MakeCopyable([rasterizer = rasterizer_->GetWeakPtr(),  //
-                                     surface = std::move(surface),            //
-                                     &latch]() mutable {
-    if (rasterizer) {
-      rasterizer->Setup(std::move(surface));
-    }
-    // Step 2: All done. Signal the latch that the platform thread is waiting
-    // on.
-    latch.Signal();
-  });
+  auto gpu_task = fxl::MakeCopyable(
+      [rasterizer = rasterizer_->GetWeakPtr(),              //
+       surface = std::move(surface),                        //
+       warmup_skp_path = settings_.shader_warmup_skp_path,  //
+       &latch]() mutable {
+        if (rasterizer) {
+          rasterizer->Setup(std::move(surface));
+        }
+        // Step 2: All done. Signal the latch that the platform thread is
+        // waiting on.
+        latch.Signal();
+        // The platform thread does not need to wait for the warm up.
+        if (rasterizer && !warmup_skp_path.empty()) {
+          rasterizer->WarmUpShaderCache(warmup_skp_path);
+        }
+      });
 
   auto ui_task = [engine = engine_->GetWeakPtr(),                      //
                   gpu_task_runner = task_runners_.GetGPUTaskRunner(),  //
@@ -671,12 +862,40 @@ void Shell::OnPlatformViewSetNextFrameCallback(const PlatformView& view,
       });
 }
 
+// |shell::PlatformView::Delegate|
+void Shell::OnPlatformViewNotifyMemoryPressure(const PlatformView& view,
+                                               MemoryPressureLevel level) {
+  FXL_DCHECK(is_setup_);
+  FXL_DCHECK(&view == platform_view_.get());
+  FXL_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+
+  NotifyMemoryPressure(level);
+}
+
+void Shell::NotifyMemoryPressure(MemoryPressureLevel level) {
+  task_runners_.GetGPUTaskRunner()->PostTask(
+      [rasterizer = rasterizer_->GetWeakPtr(), level]() {
+        if (rasterizer) {
+          rasterizer->NotifyMemoryPressure(level);
+        }
+      });
+
+  task_runners_.GetUITaskRunner()->PostTask(
+      [engine = engine_->GetWeakPtr(), level]() {
+        if (engine) {
+          engine->NotifyMemoryPressure(level);
+        }
+      });
+}
+
 // |shell::Animator::Delegate|
 void Shell::OnAnimatorBeginFrame(const Animator& animator,
                                  fxl::TimePoint frame_time) {
   FXL_DCHECK(is_setup_);
   FXL_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
 
+  startup_timeline_->Record(StartupTimeline::Phase::kFirstFrameBegun);
+
   if (engine_) {
     engine_->BeginFrame(frame_time);
   }
@@ -699,10 +918,16 @@ void Shell::OnAnimatorDraw(
   FXL_DCHECK(is_setup_);
 
   task_runners_.GetGPUTaskRunner()->PostTask(
-      [rasterizer = rasterizer_->GetWeakPtr(),
-       pipeline = std::move(pipeline)]() {
+      [rasterizer = rasterizer_->GetWeakPtr(), pipeline = std::move(pipeline),
+       startup_timeline = startup_timeline_]() {
         if (rasterizer) {
           rasterizer->Draw(pipeline);
+          // The last layer tree is only updated when it was drawn onto the
+          // surface.
+          if (rasterizer->GetLastLayerTree()) {
+            startup_timeline->Record(
+                StartupTimeline::Phase::kFirstFrameRasterized);
+          }
         }
       });
 }
@@ -970,6 +1195,131 @@ bool Shell::OnServiceProtocolSetAssetBundlePath(
   return false;
 }
 
+// Service protocol handler
+bool Shell::OnServiceProtocolNotifyMemoryPressure(
+    const blink::ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document& response) {
+  FXL_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+
+  MemoryPressureLevel level = MemoryPressureLevel::kModerate;
+  auto found = params.find("level");
+  if (found != params.end()) {
+    if (found->second == "critical") {
+      level = MemoryPressureLevel::kCritical;
+    } else if (found->second != "moderate") {
+      ServiceProtocolParameterError(
+          response, "'level' must be either 'moderate' or 'critical'.");
+      return false;
+    }
+  }
+
+  NotifyMemoryPressure(level);
+  response.SetObject();
+  response.AddMember("type", "Success", response.GetAllocator());
+  return true;
+}
+
+// Service protocol handler
+bool Shell::OnServiceProtocolGetStartupTimeline(
+    const blink::ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document& response) {
+  FXL_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+
+  auto& allocator = response.GetAllocator();
+  response.SetObject();
+  response.AddMember("type", "StartupTimeline", allocator);
+  // Timestamps are in microseconds. Phases that have not completed yet are
+  // omitted.
+  if (blink::engine_main_enter_ts != 0) {
+    response.AddMember("engineMainEnter", blink::engine_main_enter_ts,
+                       allocator);
+  }
+  for (size_t i = 0; i < StartupTimeline::kPhaseCount; i++) {
+    const auto phase = static_cast<StartupTimeline::Phase>(i);
+    const int64_t timestamp = startup_timeline_->Get(phase);
+    if (timestamp != 0) {
+      response.AddMember(
+          rapidjson::StringRef(StartupTimeline::GetPhaseName(phase)),
+          timestamp, allocator);
+    }
+  }
+  return true;
+}
+
+static void WriteTaskHistogram(const fml::TaskStats::Histogram& histogram,
+                               rapidjson::Value& value,
+                               rapidjson::MemoryPoolAllocator<>& allocator) {
+  value.SetObject();
+  value.AddMember("count", histogram.count, allocator);
+  value.AddMember("totalMicros", histogram.total_micros, allocator);
+  value.AddMember("maxMicros", histogram.max_micros, allocator);
+  rapidjson::Value buckets(rapidjson::kArrayType);
+  for (uint64_t bucket : histogram.buckets) {
+    buckets.PushBack(bucket, allocator);
+  }
+  value.AddMember("buckets", buckets, allocator);
+}
+
+// Service protocol handler
+bool Shell::OnServiceProtocolGetTaskStats(
+    const blink::ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document& response) {
+  FXL_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+
+  bool reset = false;
+  auto found = params.find("reset");
+  if (found != params.end()) {
+    if (found->second == "true") {
+      reset = true;
+    } else if (found->second != "false") {
+      ServiceProtocolParameterError(
+          response, "'reset' must be either 'true' or 'false'.");
+      return false;
+    }
+  }
+
+  auto& allocator = response.GetAllocator();
+  response.SetObject();
+  response.AddMember("type", "TaskStats", allocator);
+  response.AddMember("enabled", settings_.enable_task_stats, allocator);
+  // Bucket i of a histogram counts the tasks that took [2^(i-1), 2^i)
+  // microseconds. Sites are sorted by decreasing total run time so that the
+  // callers blocking a thread the most come first.
+  rapidjson::Value threads(rapidjson::kArrayType);
+  for (const auto& task_stats : task_stats_) {
+    auto snapshot = task_stats.second->GetSnapshot();
+    if (reset) {
+      task_stats.second->Reset();
+    }
+    std::vector<std::pair<fml::TaskStats::Site, fml::TaskStats::SiteStats>>
+        sites(snapshot.begin(), snapshot.end());
+    std::sort(sites.begin(), sites.end(), [](const auto& a, const auto& b) {
+      return a.second.run_time.total_micros > b.second.run_time.total_micros;
+    });
+
+    rapidjson::Value sites_value(rapidjson::kArrayType);
+    for (const auto& site : sites) {
+      rapidjson::Value site_value(rapidjson::kObjectType);
+      site_value.AddMember("site", fml::TaskStats::GetSiteName(site.first),
+                           allocator);
+      rapidjson::Value queueing_delay, run_time;
+      WriteTaskHistogram(site.second.queueing_delay, queueing_delay,
+                         allocator);
+      WriteTaskHistogram(site.second.run_time, run_time, allocator);
+      site_value.AddMember("queueingDelay", queueing_delay, allocator);
+      site_value.AddMember("runTime", run_time, allocator);
+      sites_value.PushBack(site_value, allocator);
+    }
+
+    rapidjson::Value thread(rapidjson::kObjectType);
+    thread.AddMember("name", task_stats.first, allocator);
+    thread.AddMember("sites", sites_value, allocator);
+    threads.PushBack(thread, allocator);
+  }
+  response.AddMember("threads", threads, allocator);
+  return true;
+}
+
 Rasterizer::Screenshot Shell::Screenshot(
     Rasterizer::ScreenshotType screenshot_type,
     bool base64_encode) {
@@ -6,7 +6,11 @@
 #define SHELL_COMMON_SHELL_H_
 
 #include <functional>
+#include <memory>
+#include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
@@ -14,6 +18,7 @@
 #include "flutter/fml/memory/thread_checker.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/task_stats.h"
 #include "flutter/fml/thread.h"
 #include "flutter/lib/ui/semantics/custom_accessibility_action.h"
 #include "flutter/lib/ui/semantics/semantics_node.h"
@@ -24,6 +29,7 @@
 #include "flutter/shell/common/io_manager.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/rasterizer.h"
+#include "flutter/shell/common/startup_timeline.h"
 #include "flutter/shell/common/surface.h"
 #include "lib/fxl/functional/closure.h"
 #include "lib/fxl/macros.h"
@@ -63,6 +69,18 @@ class Shell final : public PlatformView::Delegate,
 
   ~Shell();
 
+  // Creates a shell that runs on the task runners of this shell. The new shell
+  // shares the isolate snapshot of the VM, the font collection and the resource
+  // context of this shell instead of creating its own. Process wide settings
+  // are those of the VM. Fonts are only registered with the font collection by
+  // this shell, so the asset fonts of the spawned shell are ignored. Must be
+  // called on the platform task runner. The platform must keep the resource
+  // context of this shell usable for as long as the spawned shell is alive.
+  std::unique_ptr<Shell> Spawn(
+      blink::Settings settings,
+      CreateCallback<PlatformView> on_create_platform_view,
+      CreateCallback<Rasterizer> on_create_rasterizer) const;
+
   const blink::Settings& GetSettings() const;
 
   const blink::TaskRunners& GetTaskRunners() const;
@@ -77,6 +95,10 @@ class Shell final : public PlatformView::Delegate,
 
   bool IsSetup() const;
 
+  // The times at which the phases of the startup of this shell completed. Also
+  // available to tools via the service protocol.
+  const StartupTimeline& GetStartupTimeline() const;
+
   Rasterizer::Screenshot Screenshot(Rasterizer::ScreenshotType type,
                                     bool base64_encode);
 
@@ -92,6 +114,13 @@ class Shell final : public PlatformView::Delegate,
   std::unique_ptr<Engine> engine_;               // on UI task runner
   std::unique_ptr<Rasterizer> rasterizer_;       // on GPU task runner
   std::unique_ptr<IOManager> io_manager_;        // on IO task runner
+  // Shared with the tasks that record phases.
+  std::shared_ptr<StartupTimeline> startup_timeline_;
+  // The task stats of the threads of the task runners by task runner name.
+  // Empty unless |blink::Settings::enable_task_stats| is set. Task runners
+  // that share a thread share their stats.
+  std::vector<std::pair<std::string, std::shared_ptr<fml::TaskStats>>>
+      task_stats_;
 
   std::unordered_map<std::string,  // method
                      std::pair<fxl::RefPtr<fxl::TaskRunner>,
@@ -101,7 +130,21 @@ class Shell final : public PlatformView::Delegate,
       service_protocol_handlers_;
   bool is_setup_ = false;
 
-  Shell(blink::TaskRunners task_runners, blink::Settings settings);
+  Shell(blink::TaskRunners task_runners,
+        blink::Settings settings,
+        std::shared_ptr<StartupTimeline> startup_timeline);
+
+  // Enables the task stats of the threads of all task runners.
+  void EnableTaskStats();
+
+  static std::unique_ptr<Shell> CreateWithSnapshots(
+      blink::TaskRunners task_runners,
+      blink::Settings settings,
+      fxl::RefPtr<blink::DartSnapshot> isolate_snapshot,
+      fxl::RefPtr<blink::DartSnapshot> shared_snapshot,
+      CreateCallback<PlatformView> on_create_platform_view,
+      CreateCallback<Rasterizer> on_create_rasterizer,
+      std::shared_ptr<StartupTimeline> startup_timeline);
 
   static std::unique_ptr<Shell> CreateShellOnPlatformThread(
       blink::TaskRunners task_runners,
@@ -109,7 +152,9 @@ class Shell final : public PlatformView::Delegate,
       fxl::RefPtr<blink::DartSnapshot> isolate_snapshot,
       fxl::RefPtr<blink::DartSnapshot> shared_snapshot,
       Shell::CreateCallback<PlatformView> on_create_platform_view,
-      Shell::CreateCallback<Rasterizer> on_create_rasterizer);
+      Shell::CreateCallback<Rasterizer> on_create_rasterizer,
+      const Shell* spawning_shell,
+      std::shared_ptr<StartupTimeline> startup_timeline);
 
   bool Setup(std::unique_ptr<PlatformView> platform_view,
              std::unique_ptr<Engine> engine,
@@ -170,6 +215,10 @@ class Shell final : public PlatformView::Delegate,
   void OnPlatformViewSetNextFrameCallback(const PlatformView& view,
                                           fxl::Closure closure) override;
 
+  // |shell::PlatformView::Delegate|
+  void OnPlatformViewNotifyMemoryPressure(const PlatformView& view,
+                                          MemoryPressureLevel level) override;
+
   // |shell::Animator::Delegate|
   void OnAnimatorBeginFrame(const Animator& animator,
                             fxl::TimePoint frame_time) override;
@@ -236,6 +285,23 @@ class Shell final : public PlatformView::Delegate,
       const blink::ServiceProtocol::Handler::ServiceProtocolMap& params,
       rapidjson::Document& response);
 
+  // Service protocol handler
+  bool OnServiceProtocolNotifyMemoryPressure(
+      const blink::ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document& response);
+
+  // Service protocol handler
+  bool OnServiceProtocolGetStartupTimeline(
+      const blink::ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document& response);
+
+  // Service protocol handler
+  bool OnServiceProtocolGetTaskStats(
+      const blink::ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document& response);
+
+  void NotifyMemoryPressure(MemoryPressureLevel level);
+
   FXL_DISALLOW_COPY_AND_ASSIGN(Shell);
 };
 
@@ -15,6 +15,8 @@
 #include "flutter/shell/common/shell.h"
 #include "flutter/shell/common/thread_host.h"
 #include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
 
 #define CURRENT_TEST_NAME                                           \
   std::string {                                                     \
@@ -23,6 +25,34 @@
 
 namespace shell {
 
+static sk_sp<SkPicture> CreateTestPicture() {
+  SkPictureRecorder recorder;
+  recorder.beginRecording(SkRect::MakeWH(100, 100));
+  SkPaint paint;
+  paint.setColor(SK_ColorRED);
+  recorder.getRecordingCanvas()->drawRect(SkRect::MakeXYWH(10, 10, 80, 80),
+                                          paint);
+  return recorder.finishRecordingAsPicture();
+}
+
+// Prerolls |picture| for as many frames as it takes the raster cache to
+// rasterize it. Returns whether it was rasterized.
+static bool CachePicture(flow::RasterCache& cache, SkPicture* picture) {
+  for (size_t frame = 0; frame < 10; frame++) {
+    if (cache.GetPrerolledImage(nullptr, picture, SkMatrix::I(), nullptr,
+                                true, false)) {
+      return true;
+    }
+    cache.SweepAfterFrame();
+  }
+  return false;
+}
+
+static bool IsPictureCached(flow::RasterCache& cache, SkPicture* picture) {
+  return static_cast<bool>(cache.GetPrerolledImage(
+      nullptr, picture, SkMatrix::I(), nullptr, true, false));
+}
+
 TEST(ShellTest, InitializeWithInvalidThreads) {
   blink::Settings settings = {};
   settings.task_observer_add = [](intptr_t, fxl::Closure) {};
@@ -125,4 +155,159 @@ TEST(ShellTest, InitializeWithMultipleThreadButCallingThreadAsPlatformThread) {
   ASSERT_TRUE(shell);
 }
 
+TEST(ShellTest, StartupPhasesAreRecordedInOrder) {
+  blink::Settings settings = {};
+  settings.task_observer_add = [](intptr_t, fxl::Closure) {};
+  settings.task_observer_remove = [](intptr_t) {};
+  ThreadHost thread_host("io.flutter.test." + CURRENT_TEST_NAME + ".",
+                         ThreadHost::Type::Platform | ThreadHost::Type::GPU |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  blink::TaskRunners task_runners("test",
+                                  thread_host.platform_thread->GetTaskRunner(),
+                                  thread_host.gpu_thread->GetTaskRunner(),
+                                  thread_host.ui_thread->GetTaskRunner(),
+                                  thread_host.io_thread->GetTaskRunner());
+  auto shell = Shell::Create(
+      std::move(task_runners), settings,
+      [](Shell& shell) {
+        return std::make_unique<PlatformView>(shell, shell.GetTaskRunners());
+      },
+      [](Shell& shell) {
+        return std::make_unique<Rasterizer>(shell.GetTaskRunners());
+      });
+  ASSERT_TRUE(shell);
+
+  using Phase = StartupTimeline::Phase;
+  const auto& timeline = shell->GetStartupTimeline();
+  const int64_t started = timeline.Get(Phase::kShellCreateStarted);
+  const int64_t set_up = timeline.Get(Phase::kShellSetUp);
+  ASSERT_GT(started, 0);
+  for (auto phase : {Phase::kIOManagerCreated, Phase::kRasterizerCreated,
+                     Phase::kEngineCreated}) {
+    ASSERT_GE(timeline.Get(phase), started);
+    ASSERT_LE(timeline.Get(phase), set_up);
+  }
+  // The engine needs the resource context of the IO manager.
+  ASSERT_GE(timeline.Get(Phase::kEngineCreated),
+            timeline.Get(Phase::kIOManagerCreated));
+  // Nothing was drawn.
+  ASSERT_EQ(timeline.Get(Phase::kFirstFrameBegun), 0);
+  ASSERT_EQ(timeline.Get(Phase::kFirstFrameRasterized), 0);
+}
+
+TEST(ShellTest, TaskStatsAreRecordedWhenEnabled) {
+  blink::Settings settings = {};
+  settings.task_observer_add = [](intptr_t, fxl::Closure) {};
+  settings.task_observer_remove = [](intptr_t) {};
+  settings.enable_task_stats = true;
+  ThreadHost thread_host("io.flutter.test." + CURRENT_TEST_NAME + ".",
+                         ThreadHost::Type::Platform | ThreadHost::Type::GPU |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  blink::TaskRunners task_runners("test",
+                                  thread_host.platform_thread->GetTaskRunner(),
+                                  thread_host.gpu_thread->GetTaskRunner(),
+                                  thread_host.ui_thread->GetTaskRunner(),
+                                  thread_host.io_thread->GetTaskRunner());
+  auto shell = Shell::Create(
+      task_runners, settings,
+      [](Shell& shell) {
+        return std::make_unique<PlatformView>(shell, shell.GetTaskRunners());
+      },
+      [](Shell& shell) {
+        return std::make_unique<Rasterizer>(shell.GetTaskRunners());
+      });
+  ASSERT_TRUE(shell);
+
+  // The engine was created by a task on the UI thread after the shell enabled
+  // the stats of its loop.
+  fml::AutoResetWaitableEvent latch;
+  size_t recorded_tasks = 0;
+  task_runners.GetUITaskRunner()->PostTask([&latch, &recorded_tasks]() {
+    auto stats = fml::MessageLoop::GetCurrent().EnableTaskStats();
+    for (const auto& site : stats->GetSnapshot()) {
+      recorded_tasks += site.second.run_time.count;
+    }
+    latch.Signal();
+  });
+  latch.Wait();
+  ASSERT_GT(recorded_tasks, 0u);
+}
+
+TEST(ShellTest, RasterizerClearsRasterCacheUnderMemoryPressure) {
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  auto task_runner = fml::MessageLoop::GetCurrent().GetTaskRunner();
+  blink::TaskRunners task_runners("test", task_runner, task_runner, task_runner,
+                                  task_runner);
+  auto picture = CreateTestPicture();
+
+  for (auto level :
+       {MemoryPressureLevel::kModerate, MemoryPressureLevel::kCritical}) {
+    auto compositor_context = std::make_unique<flow::CompositorContext>();
+    auto& raster_cache = compositor_context->raster_cache();
+    Rasterizer rasterizer(task_runners, std::move(compositor_context));
+
+    ASSERT_TRUE(CachePicture(raster_cache, picture.get()));
+    ASSERT_TRUE(IsPictureCached(raster_cache, picture.get()));
+
+    rasterizer.NotifyMemoryPressure(level);
+    ASSERT_FALSE(IsPictureCached(raster_cache, picture.get()));
+  }
+}
+
+TEST(ShellTest, MemoryPressureIsForwardedToTheRasterizer) {
+  blink::Settings settings = {};
+  settings.task_observer_add = [](intptr_t, fxl::Closure) {};
+  settings.task_observer_remove = [](intptr_t) {};
+  ThreadHost thread_host("io.flutter.test." + CURRENT_TEST_NAME + ".",
+                         ThreadHost::Type::Platform | ThreadHost::Type::GPU |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  blink::TaskRunners task_runners("test",
+                                  thread_host.platform_thread->GetTaskRunner(),
+                                  thread_host.gpu_thread->GetTaskRunner(),
+                                  thread_host.ui_thread->GetTaskRunner(),
+                                  thread_host.io_thread->GetTaskRunner());
+  flow::RasterCache* raster_cache = nullptr;
+  auto shell = Shell::Create(
+      task_runners, settings,
+      [](Shell& shell) {
+        return std::make_unique<PlatformView>(shell, shell.GetTaskRunners());
+      },
+      [&raster_cache](Shell& shell) {
+        auto compositor_context = std::make_unique<flow::CompositorContext>();
+        raster_cache = &compositor_context->raster_cache();
+        return std::make_unique<Rasterizer>(shell.GetTaskRunners(),
+                                            std::move(compositor_context));
+      });
+  ASSERT_TRUE(shell);
+  ASSERT_NE(raster_cache, nullptr);
+
+  auto picture = CreateTestPicture();
+  auto run_and_wait = [](fxl::RefPtr<fxl::TaskRunner> task_runner,
+                         fxl::Closure task) {
+    fml::AutoResetWaitableEvent latch;
+    task_runner->PostTask([&latch, &task]() {
+      task();
+      latch.Signal();
+    });
+    latch.Wait();
+  };
+
+  bool cached = false;
+  run_and_wait(task_runners.GetGPUTaskRunner(), [&]() {
+    cached = CachePicture(*raster_cache, picture.get());
+  });
+  ASSERT_TRUE(cached);
+
+  run_and_wait(task_runners.GetPlatformTaskRunner(), [&shell]() {
+    shell->GetPlatformView()->NotifyMemoryPressure(
+        MemoryPressureLevel::kModerate);
+  });
+
+  // The shell posted the notification to the GPU thread before this task.
+  run_and_wait(task_runners.GetGPUTaskRunner(), [&]() {
+    cached = IsPictureCached(*raster_cache, picture.get());
+  });
+  ASSERT_FALSE(cached);
+}
+
 }  // namespace shell
@@ -0,0 +1,49 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/startup_timeline.h"
+
+#include "third_party/dart/runtime/include/dart_tools_api.h"
+
+namespace shell {
+
+StartupTimeline::StartupTimeline() {
+  for (auto& timestamp : timestamps_) {
+    timestamp = 0;
+  }
+}
+
+StartupTimeline::~StartupTimeline() = default;
+
+void StartupTimeline::Record(Phase phase) {
+  int64_t expected = 0;
+  timestamps_[static_cast<size_t>(phase)].compare_exchange_strong(
+      expected, Dart_TimelineGetMicros());
+}
+
+int64_t StartupTimeline::Get(Phase phase) const {
+  return timestamps_[static_cast<size_t>(phase)];
+}
+
+const char* StartupTimeline::GetPhaseName(Phase phase) {
+  switch (phase) {
+    case Phase::kShellCreateStarted:
+      return "shellCreateStarted";
+    case Phase::kIOManagerCreated:
+      return "ioManagerCreated";
+    case Phase::kRasterizerCreated:
+      return "rasterizerCreated";
+    case Phase::kEngineCreated:
+      return "engineCreated";
+    case Phase::kShellSetUp:
+      return "shellSetUp";
+    case Phase::kFirstFrameBegun:
+      return "firstFrameBegun";
+    case Phase::kFirstFrameRasterized:
+      return "firstFrameRasterized";
+  }
+  return "";
+}
+
+}  // namespace shell
@@ -0,0 +1,70 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_STARTUP_TIMELINE_H_
+#define FLUTTER_SHELL_COMMON_STARTUP_TIMELINE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+#include "lib/fxl/macros.h"
+
+namespace shell {
+
+// The times at which the phases of the startup of a shell completed. Times are
+// in microseconds on the clock of the Dart timeline, which is also the clock
+// of |blink::engine_main_enter_ts|. So the time to the first frame of the
+// application is |Get(Phase::kFirstFrameRasterized)| minus that timestamp.
+//
+// Phases are recorded on the threads they complete on. They may be read on any
+// thread.
+class StartupTimeline {
+ public:
+  enum class Phase {
+    // |Shell::Create| was called.
+    kShellCreateStarted,
+    // The IO manager, and so the resource context, was created on the IO
+    // thread.
+    kIOManagerCreated,
+    // The rasterizer was created on the GPU thread.
+    kRasterizerCreated,
+    // The engine was created on the UI thread.
+    kEngineCreated,
+    // The shell was set up and handed back to the platform.
+    kShellSetUp,
+    // The UI thread began producing the first frame.
+    kFirstFrameBegun,
+    // The first frame was drawn onto the surface of the rasterizer.
+    kFirstFrameRasterized,
+  };
+
+  static constexpr size_t kPhaseCount =
+      static_cast<size_t>(Phase::kFirstFrameRasterized) + 1;
+
+  StartupTimeline();
+
+  ~StartupTimeline();
+
+  // Records the current time for |phase| unless it has already been recorded.
+  void Record(Phase phase);
+
+  // Returns the time at which |phase| was recorded or zero if it has not been
+  // recorded yet.
+  int64_t Get(Phase phase) const;
+
+  // The name of the phase as used in trace events and in service protocol
+  // responses.
+  static const char* GetPhaseName(Phase phase);
+
+ private:
+  std::atomic<int64_t> timestamps_[kPhaseCount];
+
+  FXL_DISALLOW_COPY_AND_ASSIGN(StartupTimeline);
+};
+
+}  // namespace shell
+
+#endif  // FLUTTER_SHELL_COMMON_STARTUP_TIMELINE_H_
@@ -64,4 +64,8 @@ Surface::Surface() = default;
 
 Surface::~Surface() = default;
 
+bool Surface::MakeRenderContextCurrent() {
+  return true;
+}
+
 }  // namespace shell
@@ -53,6 +53,10 @@ class Surface {
 
   virtual GrContext* GetContext() = 0;
 
+  // Makes the client rendering API context of this surface current on the
+  // calling thread so that |GetContext| may be used outside of a frame.
+  virtual bool MakeRenderContextCurrent();
+
  private:
   FXL_DISALLOW_COPY_AND_ASSIGN(Surface);
 };
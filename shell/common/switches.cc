@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <stdlib.h>
+
 #include <algorithm>
 #include <iomanip>
 #include <iostream>
@@ -112,6 +114,49 @@ static bool GetSwitchValue(const fxl::CommandLine& command_line,
   return false;
 }
 
+static void GetThreadConfig(const fxl::CommandLine& command_line,
+                            shell::Switch priority_switch,
+                            shell::Switch cpu_affinity_switch,
+                            fml::Thread::Config* config) {
+  std::string priority;
+  if (command_line.GetOptionValue(shell::FlagForSwitch(priority_switch),
+                                  &priority)) {
+    if (priority == "normal") {
+      config->priority = fml::Thread::Priority::kNormal;
+    } else if (priority == "display") {
+      config->priority = fml::Thread::Priority::kDisplay;
+    } else if (priority == "raster") {
+      config->priority = fml::Thread::Priority::kRaster;
+    } else if (priority == "background") {
+      config->priority = fml::Thread::Priority::kBackground;
+    } else {
+      FXL_LOG(INFO) << "Unknown thread priority '" << priority
+                    << "'. Will use the default.";
+    }
+  }
+
+  std::string cpu_affinity;
+  if (command_line.GetOptionValue(shell::FlagForSwitch(cpu_affinity_switch),
+                                  &cpu_affinity)) {
+    // Accepts decimal, octal and hexadecimal masks.
+    char* end = nullptr;
+    uint64_t mask = strtoull(cpu_affinity.c_str(), &end, 0);
+    if (cpu_affinity.empty() || *end != '\0') {
+      FXL_LOG(INFO) << "CPU affinity mask '" << cpu_affinity
+                    << "' is malformed. Will default to any CPU.";
+    } else {
+      config->cpu_affinity_mask = mask;
+    }
+  }
+
+  if (command_line.HasOption(FlagForSwitch(Switch::ThreadStackSize)) &&
+      !GetSwitchValue(command_line, Switch::ThreadStackSize,
+                      &config->stack_size)) {
+    FXL_LOG(INFO) << "Thread stack size specified was malformed. Will default "
+                     "to the platform default.";
+  }
+}
+
 blink::Settings SettingsFromCommandLine(const fxl::CommandLine& command_line) {
   blink::Settings settings = {};
 
@@ -144,6 +189,9 @@ blink::Settings SettingsFromCommandLine(const fxl::CommandLine& command_line) {
   settings.enable_software_rendering =
       command_line.HasOption(FlagForSwitch(Switch::EnableSoftwareRendering));
 
+  settings.enable_task_stats =
+      command_line.HasOption(FlagForSwitch(Switch::EnableTaskStats));
+
   settings.endless_trace_buffer =
       command_line.HasOption(FlagForSwitch(Switch::EndlessTraceBuffer));
 
@@ -211,6 +259,9 @@ blink::Settings SettingsFromCommandLine(const fxl::CommandLine& command_line) {
   command_line.GetOptionValue(FlagForSwitch(Switch::CacheDirPath),
                               &settings.temp_directory_path);
 
+  command_line.GetOptionValue(FlagForSwitch(Switch::ShaderWarmupSkpPath),
+                              &settings.shader_warmup_skp_path);
+
   command_line.GetOptionValue(FlagForSwitch(Switch::ICUDataFilePath),
                               &settings.icu_data_path);
 
@@ -227,6 +278,29 @@ blink::Settings SettingsFromCommandLine(const fxl::CommandLine& command_line) {
       settings.dart_flags.push_back(*it);
   }
 
+  GetThreadConfig(command_line, Switch::UIThreadPriority,
+                  Switch::UIThreadCPUAffinity, &settings.ui_thread_config);
+  GetThreadConfig(command_line, Switch::GPUThreadPriority,
+                  Switch::GPUThreadCPUAffinity, &settings.gpu_thread_config);
+  GetThreadConfig(command_line, Switch::IOThreadPriority,
+                  Switch::IOThreadCPUAffinity, &settings.io_thread_config);
+
+  settings.vulkan_prefer_low_latency_present_mode =
+      command_line.HasOption(FlagForSwitch(Switch::VulkanLowLatencyPresent));
+
+  size_t frames_in_flight = 0;
+  if (command_line.HasOption(FlagForSwitch(Switch::VulkanFramesInFlight))) {
+    if (GetSwitchValue(command_line, Switch::VulkanFramesInFlight,
+                       &frames_in_flight) &&
+        frames_in_flight > 0) {
+      settings.vulkan_frames_in_flight = frames_in_flight;
+    } else {
+      FXL_LOG(INFO) << "Vulkan frames in flight specified was malformed. Will "
+                       "default to "
+                    << settings.vulkan_frames_in_flight;
+    }
+  }
+
 #if FLUTTER_RUNTIME_MODE != FLUTTER_RUNTIME_MODE_RELEASE && \
     FLUTTER_RUNTIME_MODE != FLUTTER_RUNTIME_MODE_DYNAMIC_RELEASE
   settings.trace_skia =
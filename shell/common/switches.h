@@ -77,6 +77,17 @@ DEF_SWITCH(EnableSoftwareRendering,
            "Enable rendering using the Skia software backend. This is useful"
            "when testing Flutter on emulators. By default, Flutter will"
            "attempt to either use OpenGL or Vulkan.")
+DEF_SWITCH(EnableTaskStats,
+           "enable-task-stats",
+           "Record histograms of how long the tasks of the threads of the "
+           "shell wait to run and how long they run, by the site they were "
+           "posted from. The histograms are available through the "
+           "_flutter.getTaskStats service protocol extension.")
+DEF_SWITCH(ShaderWarmupSkpPath,
+           "shader-warmup-skp",
+           "Path to an SKP captured with the screenshot SKP service extension. "
+           "It is drawn offscreen at startup so that the GPU programs it uses "
+           "are compiled and cached before the first frame.")
 DEF_SWITCH(SkiaDeterministicRendering,
            "skia-deterministic-rendering",
            "Skips the call to SkGraphics::Init(), thus avoiding swapping out"
@@ -129,6 +140,43 @@ DEF_SWITCH(DartNonCheckedMode,
            "precompiled and checked mode is unsupported. However, this flag "
            "may be specified if the user wishes to run in the debug product "
            "mode (i.e. with JIT or DBC) with checked mode off.")
+DEF_SWITCH(UIThreadPriority,
+           "ui-thread-priority",
+           "The priority of the UI thread. One of 'normal', 'display', "
+           "'raster' or 'background'. The default is 'display'.")
+DEF_SWITCH(GPUThreadPriority,
+           "gpu-thread-priority",
+           "The priority of the GPU thread. One of 'normal', 'display', "
+           "'raster' or 'background'. The default is 'raster'.")
+DEF_SWITCH(IOThreadPriority,
+           "io-thread-priority",
+           "The priority of the IO thread. One of 'normal', 'display', "
+           "'raster' or 'background'. The default is 'normal'.")
+DEF_SWITCH(UIThreadCPUAffinity,
+           "ui-thread-cpu-affinity",
+           "A mask of the CPUs the UI thread may run on, e.g. 0xf0 for CPUs 4 "
+           "to 7. By default, the thread may run on any CPU. Not supported "
+           "on iOS and macOS.")
+DEF_SWITCH(GPUThreadCPUAffinity,
+           "gpu-thread-cpu-affinity",
+           "A mask of the CPUs the GPU thread may run on. See "
+           "ui-thread-cpu-affinity.")
+DEF_SWITCH(IOThreadCPUAffinity,
+           "io-thread-cpu-affinity",
+           "A mask of the CPUs the IO thread may run on. See "
+           "ui-thread-cpu-affinity.")
+DEF_SWITCH(ThreadStackSize,
+           "thread-stack-size",
+           "The size in bytes of the stacks of the UI, GPU and IO threads. By "
+           "default, the platform default is used.")
+DEF_SWITCH(VulkanLowLatencyPresent,
+           "vulkan-low-latency-present",
+           "Present frames with the mailbox or immediate present mode instead "
+           "of FIFO if the Vulkan surface supports it.")
+DEF_SWITCH(VulkanFramesInFlight,
+           "vulkan-frames-in-flight",
+           "The number of frames the CPU may record ahead of the GPU when "
+           "rendering with Vulkan. The default is 2.")
 DEF_SWITCHES_END
 
 void PrintUsage(const std::string& executable_name);
@@ -8,21 +8,33 @@ namespace shell {
 
 ThreadHost::ThreadHost() = default;
 
-ThreadHost::ThreadHost(std::string name_prefix, uint64_t mask) {
+ThreadHost::ThreadHost(std::string name_prefix, uint64_t mask)
+    : ThreadHost(std::move(name_prefix),
+                 mask,
+                 fml::Thread::Config(),
+                 fml::Thread::Config(),
+                 fml::Thread::Config()) {}
+
+ThreadHost::ThreadHost(std::string name_prefix,
+                       uint64_t mask,
+                       const fml::Thread::Config& ui_config,
+                       const fml::Thread::Config& gpu_config,
+                       const fml::Thread::Config& io_config) {
   if (mask & ThreadHost::Type::Platform) {
     platform_thread = std::make_unique<fml::Thread>(name_prefix + ".platform");
   }
 
   if (mask & ThreadHost::Type::UI) {
-    ui_thread = std::make_unique<fml::Thread>(name_prefix + ".ui");
+    ui_thread = std::make_unique<fml::Thread>(name_prefix + ".ui", ui_config);
   }
 
   if (mask & ThreadHost::Type::GPU) {
-    gpu_thread = std::make_unique<fml::Thread>(name_prefix + ".gpu");
+    gpu_thread =
+        std::make_unique<fml::Thread>(name_prefix + ".gpu", gpu_config);
   }
 
   if (mask & ThreadHost::Type::IO) {
-    io_thread = std::make_unique<fml::Thread>(name_prefix + ".io");
+    io_thread = std::make_unique<fml::Thread>(name_prefix + ".io", io_config);
   }
 }
 
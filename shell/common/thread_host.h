@@ -33,6 +33,14 @@ struct ThreadHost {
 
   ThreadHost(std::string name_prefix, uint64_t type_mask);
 
+  // The configurations of the UI, GPU and IO threads. The platform thread is
+  // always created with the default configuration.
+  ThreadHost(std::string name_prefix,
+             uint64_t type_mask,
+             const fml::Thread::Config& ui_config,
+             const fml::Thread::Config& gpu_config,
+             const fml::Thread::Config& io_config);
+
   ~ThreadHost();
 
   void Reset();
@@ -4,7 +4,10 @@
 
 #include "gpu_surface_gl.h"
 
+#include <algorithm>
+
 #include "flutter/fml/trace_event.h"
+#include "flutter/shell/common/persistent_cache.h"
 #include "lib/fxl/arraysize.h"
 #include "lib/fxl/logging.h"
 #include "third_party/skia/include/core/SkColorFilter.h"
@@ -26,10 +29,24 @@ namespace shell {
 // Default maximum number of budgeted resources in the cache.
 static const int kGrCacheMaxCount = 8192;
 
-// Default maximum number of bytes of GPU memory of budgeted resources in the
-// cache.
+// The GPU memory budget of the cache is this many times the size of a full
+// screen RGBA buffer. It is bounded by |kGrCacheMinByteSize| and
+// |kGrCacheMaxByteSize|.
+static const size_t kGrCacheScreenCount = 12;
+
+// Budget used until the size of the screen is known.
+static const size_t kGrCacheMinByteSize = 24 * (1 << 20);
+
 static const size_t kGrCacheMaxByteSize = 512 * (1 << 20);
 
+static size_t GetResourceCacheMaxByteSize(const SkISize& screen_size) {
+  const size_t screen_bytes = static_cast<size_t>(screen_size.width()) *
+                              static_cast<size_t>(screen_size.height()) * 4;
+  return std::min(
+      std::max(screen_bytes * kGrCacheScreenCount, kGrCacheMinByteSize),
+      kGrCacheMaxByteSize);
+}
+
 GPUSurfaceGL::GPUSurfaceGL(GPUSurfaceGLDelegate* delegate)
     : delegate_(delegate), weak_factory_(this) {
   if (!delegate_->GLContextMakeCurrent()) {
@@ -45,7 +62,11 @@ GPUSurfaceGL::GPUSurfaceGL(GPUSurfaceGLDelegate* delegate)
   // ES2 shading language when the ES3 external image extension is missing.
   options.fPreferExternalImagesOverES3 = true;
 
-  auto context = GrContext::MakeGL(GrGLMakeNativeInterface(), options);
+  auto interface = GrGLMakeNativeInterface();
+  options.fPersistentCache =
+      PersistentCache::GetCacheForGLContext(interface.get());
+
+  auto context = GrContext::MakeGL(std::move(interface), options);
 
   if (context == nullptr) {
     FXL_LOG(ERROR) << "Failed to setup Skia Gr context.";
@@ -54,7 +75,7 @@ GPUSurfaceGL::GPUSurfaceGL(GPUSurfaceGLDelegate* delegate)
 
   context_ = std::move(context);
 
-  context_->setResourceCacheLimits(kGrCacheMaxCount, kGrCacheMaxByteSize);
+  context_->setResourceCacheLimits(kGrCacheMaxCount, kGrCacheMinByteSize);
 
   delegate_->GLContextClearCurrent();
 
@@ -184,6 +205,9 @@ bool GPUSurfaceGL::CreateOrUpdateSurfaces(const SkISize& size) {
   onscreen_surface_ = std::move(onscreen_surface);
   offscreen_surface_ = std::move(offscreen_surface);
 
+  context_->setResourceCacheLimits(kGrCacheMaxCount,
+                                   GetResourceCacheMaxByteSize(size));
+
   return true;
 }
 
@@ -247,4 +271,8 @@ GrContext* GPUSurfaceGL::GetContext() {
   return context_.get();
 }
 
+bool GPUSurfaceGL::MakeRenderContextCurrent() {
+  return delegate_->GLContextMakeCurrent();
+}
+
 }  // namespace shell
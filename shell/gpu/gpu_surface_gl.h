@@ -37,6 +37,8 @@ class GPUSurfaceGL : public Surface {
 
   GrContext* GetContext() override;
 
+  bool MakeRenderContextCurrent() override;
+
  private:
   GPUSurfaceGLDelegate* delegate_;
   sk_sp<GrContext> context_;
@@ -3,14 +3,21 @@
 // found in the LICENSE file.
 
 #include "flutter/shell/gpu/gpu_surface_vulkan.h"
+#include "flutter/shell/common/persistent_cache.h"
 #include "lib/fxl/logging.h"
 
 namespace shell {
 
 GPUSurfaceVulkan::GPUSurfaceVulkan(
     fxl::RefPtr<vulkan::VulkanProcTable> proc_table,
-    std::unique_ptr<vulkan::VulkanNativeSurface> native_surface)
-    : window_(std::move(proc_table), std::move(native_surface)),
+    std::unique_ptr<vulkan::VulkanNativeSurface> native_surface,
+    vulkan::VulkanSwapchainOptions swapchain_options,
+    fxl::RefPtr<fxl::TaskRunner> io_task_runner)
+    : window_(std::move(proc_table),
+              std::move(native_surface),
+              std::move(swapchain_options),
+              PersistentCache::GetCacheDirectoryPath(),
+              std::move(io_task_runner)),
       weak_factory_(this) {}
 
 GPUSurfaceVulkan::~GPUSurfaceVulkan() = default;
@@ -17,8 +17,11 @@ namespace shell {
 
 class GPUSurfaceVulkan : public Surface {
  public:
+  // The pipeline cache of the surface is written to disk on |io_task_runner|.
   GPUSurfaceVulkan(fxl::RefPtr<vulkan::VulkanProcTable> proc_table,
-                   std::unique_ptr<vulkan::VulkanNativeSurface> native_surface);
+                   std::unique_ptr<vulkan::VulkanNativeSurface> native_surface,
+                   vulkan::VulkanSwapchainOptions swapchain_options,
+                   fxl::RefPtr<fxl::TaskRunner> io_task_runner);
 
   ~GPUSurfaceVulkan() override;
 
@@ -7,8 +7,6 @@
 #include "flutter/shell/platform/android/android_shell_holder.h"
 
 #include <pthread.h>
-#include <sys/resource.h>
-#include <sys/time.h>
 
 #include <sstream>
 #include <string>
@@ -31,8 +29,12 @@ AndroidShellHolder::AndroidShellHolder(
   FXL_CHECK(pthread_key_create(&thread_destruct_key_, ThreadDestructCallback) ==
             0);
 
-  thread_host_ = {thread_label, ThreadHost::Type::UI | ThreadHost::Type::GPU |
-                                    ThreadHost::Type::IO};
+  thread_host_ = {thread_label,
+                  ThreadHost::Type::UI | ThreadHost::Type::GPU |
+                      ThreadHost::Type::IO,
+                  settings_.ui_thread_config,   // ui
+                  settings_.gpu_thread_config,  // gpu
+                  settings_.io_thread_config};  // io
 
   // Detach from JNI when the UI and GPU threads exit.
   auto jni_exit_task([key = thread_destruct_key_]() {
@@ -48,8 +50,7 @@ AndroidShellHolder::AndroidShellHolder(
             shell,                   // delegate
             shell.GetTaskRunners(),  // task runners
             java_object,             // java object handle for JNI interop
-            shell.GetSettings()
-                .enable_software_rendering  // use software rendering
+            shell.GetSettings()      // settings
         );
         weak_platform_view = platform_view_android->GetWeakPtr();
         return platform_view_android;
@@ -82,26 +83,6 @@ AndroidShellHolder::AndroidShellHolder(
   FXL_DCHECK(platform_view_);
 
   is_valid_ = shell_ != nullptr;
-
-  if (is_valid_) {
-    task_runners.GetGPUTaskRunner()->PostTask([]() {
-      // Android describes -8 as "most important display threads, for
-      // compositing the screen and retrieving input events". Conservatively
-      // set the GPU thread to slightly lower priority than it.
-      if (::setpriority(PRIO_PROCESS, gettid(), -5) != 0) {
-        // Defensive fallback. Depending on the OEM, it may not be possible
-        // to set priority to -5.
-        if (::setpriority(PRIO_PROCESS, gettid(), -2) != 0) {
-          FXL_LOG(ERROR) << "Failed to set GPU task runner priority";
-        }
-      }
-    });
-    task_runners.GetUITaskRunner()->PostTask([]() {
-      if (::setpriority(PRIO_PROCESS, gettid(), -1) != 0) {
-        FXL_LOG(ERROR) << "Failed to set UI task runner priority";
-      }
-    });
-  }
 }
 
 AndroidShellHolder::~AndroidShellHolder() {
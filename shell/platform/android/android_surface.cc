@@ -15,13 +15,19 @@
 namespace shell {
 
 std::unique_ptr<AndroidSurface> AndroidSurface::Create(
-    bool use_software_rendering) {
-  if (use_software_rendering) {
+    const blink::Settings& settings,
+    fxl::RefPtr<fxl::TaskRunner> io_task_runner) {
+  if (settings.enable_software_rendering) {
     auto software_surface = std::make_unique<AndroidSurfaceSoftware>();
     return software_surface->IsValid() ? std::move(software_surface) : nullptr;
   }
 #if SHELL_ENABLE_VULKAN
-  auto vulkan_surface = std::make_unique<AndroidSurfaceVulkan>();
+  vulkan::VulkanSwapchainOptions swapchain_options;
+  swapchain_options.frames_in_flight = settings.vulkan_frames_in_flight;
+  swapchain_options.prefer_low_latency_present_mode =
+      settings.vulkan_prefer_low_latency_present_mode;
+  auto vulkan_surface = std::make_unique<AndroidSurfaceVulkan>(
+      swapchain_options, std::move(io_task_runner));
   return vulkan_surface->IsValid() ? std::move(vulkan_surface) : nullptr;
 #else   // SHELL_ENABLE_VULKAN
   auto gl_surface = std::make_unique<AndroidSurfaceGL>();
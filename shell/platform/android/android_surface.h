@@ -7,6 +7,7 @@
 
 #include <memory>
 
+#include "flutter/common/settings.h"
 #include "flutter/fml/platform/android/jni_util.h"
 #include "flutter/fml/platform/android/jni_weak_ref.h"
 #include "flutter/shell/common/platform_view.h"
@@ -19,7 +20,11 @@ namespace shell {
 
 class AndroidSurface {
  public:
-  static std::unique_ptr<AndroidSurface> Create(bool use_software_rendering);
+  // Background work of the surface, like writing caches to disk, is done on
+  // |io_task_runner|.
+  static std::unique_ptr<AndroidSurface> Create(
+      const blink::Settings& settings,
+      fxl::RefPtr<fxl::TaskRunner> io_task_runner);
 
   virtual ~AndroidSurface();
 
@@ -12,8 +12,12 @@
 
 namespace shell {
 
-AndroidSurfaceVulkan::AndroidSurfaceVulkan()
-    : proc_table_(fxl::MakeRefCounted<vulkan::VulkanProcTable>()) {}
+AndroidSurfaceVulkan::AndroidSurfaceVulkan(
+    vulkan::VulkanSwapchainOptions swapchain_options,
+    fxl::RefPtr<fxl::TaskRunner> io_task_runner)
+    : proc_table_(fxl::MakeRefCounted<vulkan::VulkanProcTable>()),
+      swapchain_options_(std::move(swapchain_options)),
+      io_task_runner_(std::move(io_task_runner)) {}
 
 AndroidSurfaceVulkan::~AndroidSurfaceVulkan() = default;
 
@@ -45,7 +49,8 @@ std::unique_ptr<Surface> AndroidSurfaceVulkan::CreateGPUSurface() {
   }
 
   auto gpu_surface = std::make_unique<GPUSurfaceVulkan>(
-      proc_table_, std::move(vulkan_surface_android));
+      proc_table_, std::move(vulkan_surface_android), swapchain_options_,
+      io_task_runner_);
 
   if (!gpu_surface->IsValid()) {
     return nullptr;
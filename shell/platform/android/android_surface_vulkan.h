@@ -16,7 +16,8 @@ namespace shell {
 
 class AndroidSurfaceVulkan : public AndroidSurface {
  public:
-  AndroidSurfaceVulkan();
+  AndroidSurfaceVulkan(vulkan::VulkanSwapchainOptions swapchain_options,
+                       fxl::RefPtr<fxl::TaskRunner> io_task_runner);
 
   ~AndroidSurfaceVulkan() override;
 
@@ -41,6 +42,8 @@ class AndroidSurfaceVulkan : public AndroidSurface {
  private:
   fxl::RefPtr<vulkan::VulkanProcTable> proc_table_;
   fxl::RefPtr<AndroidNativeWindow> native_window_;
+  const vulkan::VulkanSwapchainOptions swapchain_options_;
+  fxl::RefPtr<fxl::TaskRunner> io_task_runner_;
 
   FXL_DISALLOW_COPY_AND_ASSIGN(AndroidSurfaceVulkan);
 };
@@ -272,16 +272,30 @@ public final class FlutterActivityDelegate
 
     @Override
     public void onTrimMemory(int level) {
-        // Use a trim level delivered while the application is running so the
-        // framework has a chance to react to the notification.
-        if (level == TRIM_MEMORY_RUNNING_LOW) {
-            flutterView.onMemoryPressure();
+        switch (level) {
+            // The UI was hidden or the process is at the top of the LRU list.
+            // Trim the caches that are cheap to rebuild so that the process is
+            // less likely to be killed in the background.
+            case TRIM_MEMORY_UI_HIDDEN:
+            case TRIM_MEMORY_BACKGROUND:
+            case TRIM_MEMORY_RUNNING_LOW:
+                flutterView.onMemoryPressure(false);
+                break;
+            // The process is about to be killed or the system can no longer
+            // keep background processes around.
+            case TRIM_MEMORY_MODERATE:
+            case TRIM_MEMORY_COMPLETE:
+            case TRIM_MEMORY_RUNNING_CRITICAL:
+                flutterView.onMemoryPressure(true);
+                break;
+            default:
+                break;
         }
     }
 
     @Override
     public void onLowMemory() {
-        flutterView.onMemoryPressure();
+        flutterView.onMemoryPressure(true);
     }
 
     @Override
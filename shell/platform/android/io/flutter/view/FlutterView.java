@@ -277,9 +277,19 @@ public class FlutterView
     }
 
     public void onMemoryPressure() {
-        Map<String, Object> message = new HashMap<>(1);
-        message.put("type", "memoryPressure");
-        mFlutterSystemChannel.send(message);
+        onMemoryPressure(false);
+    }
+
+    /**
+     * Trims the GPU resource and raster caches and asks the framework to evict
+     * its image cache. Critical pressure releases as much memory as possible.
+     */
+    public void onMemoryPressure(boolean isCritical) {
+        if (!isAttached()) {
+            return;
+        }
+        // These values must be kept in sync with shell::MemoryPressureLevel.
+        nativeNotifyMemoryPressure(mNativeView.get(), isCritical ? 1 : 0);
     }
 
     /**
@@ -659,6 +669,9 @@ public class FlutterView
     private static native void nativeSetAssistiveTechnologyEnabled(
             long nativePlatformViewAndroid, boolean enabled);
 
+    private static native void nativeNotifyMemoryPressure(
+            long nativePlatformViewAndroid, int level);
+
     private static native boolean nativeGetIsSoftwareRenderingEnabled();
 
     private static native void nativeRegisterTexture(
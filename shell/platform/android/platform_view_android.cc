@@ -21,10 +21,11 @@ PlatformViewAndroid::PlatformViewAndroid(
     PlatformView::Delegate& delegate,
     blink::TaskRunners task_runners,
     fml::jni::JavaObjectWeakGlobalRef java_object,
-    bool use_software_rendering)
+    const blink::Settings& settings)
     : PlatformView(delegate, std::move(task_runners)),
       java_object_(java_object),
-      android_surface_(AndroidSurface::Create(use_software_rendering)) {
+      android_surface_(
+          AndroidSurface::Create(settings, task_runners_.GetIOTaskRunner())) {
   FXL_CHECK(android_surface_)
       << "Could not create an OpenGL, Vulkan or Software surface to setup "
          "rendering.";
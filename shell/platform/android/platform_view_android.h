@@ -27,7 +27,7 @@ class PlatformViewAndroid final : public PlatformView {
   PlatformViewAndroid(PlatformView::Delegate& delegate,
                       blink::TaskRunners task_runners,
                       fml::jni::JavaObjectWeakGlobalRef java_object,
-                      bool use_software_rendering);
+                      const blink::Settings& settings);
 
   ~PlatformViewAndroid() override;
 
@@ -439,6 +439,16 @@ static void SetAssistiveTechnologyEnabled(JNIEnv* env,
       enabled);
 }
 
+static void NotifyMemoryPressure(JNIEnv* env,
+                                 jobject jcaller,
+                                 jlong shell_holder,
+                                 jint level) {
+  ANDROID_SHELL_HOLDER->GetPlatformView()->NotifyMemoryPressure(
+      level == static_cast<jint>(MemoryPressureLevel::kCritical)
+          ? MemoryPressureLevel::kCritical
+          : MemoryPressureLevel::kModerate);
+}
+
 static jboolean GetIsSoftwareRendering(JNIEnv* env, jobject jcaller) {
   return FlutterMain::Get().GetSettings().enable_software_rendering;
 }
@@ -616,6 +626,11 @@ bool PlatformViewAndroid::Register(JNIEnv* env) {
           .fnPtr =
               reinterpret_cast<void*>(&shell::SetAssistiveTechnologyEnabled),
       },
+      {
+          .name = "nativeNotifyMemoryPressure",
+          .signature = "(JI)V",
+          .fnPtr = reinterpret_cast<void*>(&shell::NotifyMemoryPressure),
+      },
       {
           .name = "nativeGetIsSoftwareRenderingEnabled",
           .signature = "()Z",
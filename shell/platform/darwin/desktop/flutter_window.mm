@@ -94,19 +94,6 @@ static std::string CreateThreadLabel() {
 
   auto thread_label = CreateThreadLabel();
 
-  // Create the threads on which to run the shell.
-  _thread_host = {thread_label, shell::ThreadHost::Type::GPU | shell::ThreadHost::Type::UI |
-                                    shell::ThreadHost::Type::IO};
-
-  // Grab the task runners for the newly created threads.
-  fml::MessageLoop::EnsureInitializedForCurrentThread();
-  blink::TaskRunners task_runners(thread_label,                                    // label
-                                  fml::MessageLoop::GetCurrent().GetTaskRunner(),  // platform
-                                  _thread_host.gpu_thread->GetTaskRunner(),        // GPU
-                                  _thread_host.ui_thread->GetTaskRunner(),         // UI
-                                  _thread_host.io_thread->GetTaskRunner()          // IO
-  );
-
   // Figure out the settings from the command line arguments.
   auto settings = shell::SettingsFromCommandLine(shell::CommandLineFromNSProcessInfo());
 
@@ -123,6 +110,23 @@ static std::string CreateThreadLabel() {
     fml::MessageLoop::GetCurrent().RemoveTaskObserver(key);
   };
 
+  // Create the threads on which to run the shell.
+  _thread_host = {thread_label,
+                  shell::ThreadHost::Type::GPU | shell::ThreadHost::Type::UI |
+                      shell::ThreadHost::Type::IO,
+                  settings.ui_thread_config,   // UI
+                  settings.gpu_thread_config,  // GPU
+                  settings.io_thread_config};  // IO
+
+  // Grab the task runners for the newly created threads.
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  blink::TaskRunners task_runners(thread_label,                                    // label
+                                  fml::MessageLoop::GetCurrent().GetTaskRunner(),  // platform
+                                  _thread_host.gpu_thread->GetTaskRunner(),        // GPU
+                                  _thread_host.ui_thread->GetTaskRunner(),         // UI
+                                  _thread_host.io_thread->GetTaskRunner()          // IO
+  );
+
   // Setup the callback that will be run on the appropriate threads.
   shell::Shell::CreateCallback<shell::PlatformView> on_create_platform_view =
       [render_surface = self.renderSurface](shell::Shell& shell) {
@@ -121,9 +121,14 @@
 
   auto threadLabel = [NSString stringWithFormat:@"io.flutter.%zu", shell_count++];
 
+  const blink::Settings& settings = [_dartProject settings];
   _threadHost = {
       threadLabel.UTF8String,  // label
-      shell::ThreadHost::Type::UI | shell::ThreadHost::Type::GPU | shell::ThreadHost::Type::IO};
+      shell::ThreadHost::Type::UI | shell::ThreadHost::Type::GPU | shell::ThreadHost::Type::IO,
+      settings.ui_thread_config,   // ui
+      settings.gpu_thread_config,  // gpu
+      settings.io_thread_config    // io
+  };
 
   // The current thread will be used as the platform thread. Ensure that the message loop is
   // initialized.
@@ -157,7 +162,7 @@
 
   // Create the shell.
   _shell = shell::Shell::Create(std::move(task_runners),  //
-                                [_dartProject settings],  //
+                                settings,                 //
                                 on_create_platform_view,  //
                                 on_create_rasterizer      //
   );
@@ -456,6 +461,10 @@
   TRACE_EVENT0("flutter", "applicationDidEnterBackground");
   [self surfaceUpdated:NO];
   [_lifecycleChannel.get() sendMessage:@"AppLifecycleState.paused"];
+  // iOS does not warn about memory before terminating background
+  // applications. Trim the caches that are cheap to rebuild right away.
+  _shell->GetPlatformView()->NotifyMemoryPressure(
+      shell::MemoryPressureLevel::kModerate);
 }
 
 - (void)applicationWillEnterForeground:(NSNotification*)notification {
@@ -809,7 +818,10 @@ static inline blink::PointerData::DeviceKind DeviceKindFromTouchType(UITouch* to
 #pragma mark - Memory Notifications
 
 - (void)onMemoryWarning:(NSNotification*)notification {
-  [_systemChannel.get() sendMessage:@{@"type" : @"memoryPressure"}];
+  // The shell forwards the notification to the framework on the system
+  // channel after trimming its own caches.
+  _shell->GetPlatformView()->NotifyMemoryPressure(
+      shell::MemoryPressureLevel::kCritical);
 }
 
 #pragma mark - Locale updates
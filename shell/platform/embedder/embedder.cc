@@ -15,6 +15,7 @@
 #include "flutter/shell/platform/embedder/embedder.h"
 
 #include <type_traits>
+#include <vector>
 
 #include "flutter/assets/directory_asset_bundle.h"
 #include "flutter/common/task_runners.h"
@@ -25,6 +26,7 @@
 #include "flutter/shell/common/switches.h"
 #include "flutter/shell/platform/embedder/embedder.h"
 #include "flutter/shell/platform/embedder/embedder_engine.h"
+#include "flutter/shell/platform/embedder/embedder_task_runner.h"
 #include "flutter/shell/platform/embedder/platform_view_embedder.h"
 #include "lib/fxl/command_line.h"
 #include "lib/fxl/files/file.h"
@@ -40,8 +42,8 @@
     return static_cast<decltype(pointer->member)>((default_value));      \
   })()
 
-bool IsRendererValid(const FlutterRendererConfig* config) {
-  if (config == nullptr || config->type != kOpenGL) {
+static bool IsOpenGLRendererConfigValid(const FlutterRendererConfig* config) {
+  if (config->type != kOpenGL) {
     return false;
   }
 
@@ -57,50 +59,178 @@ bool IsRendererValid(const FlutterRendererConfig* config) {
   return true;
 }
 
-struct _FlutterPlatformMessageResponseHandle {
-  fxl::RefPtr<blink::PlatformMessage> message;
-};
-
-FlutterResult FlutterEngineRun(size_t version,
-                               const FlutterRendererConfig* config,
-                               const FlutterProjectArgs* args,
-                               void* user_data,
-                               FlutterEngine* engine_out) {
-  // Step 0: Figure out arguments for shell creation.
-  if (version != FLUTTER_ENGINE_VERSION) {
-    return kInvalidLibraryVersion;
+static bool IsSoftwareRendererConfigValid(
+    const FlutterRendererConfig* config) {
+  if (config->type != kSoftware) {
+    return false;
   }
 
-  if (engine_out == nullptr) {
-    return kInvalidArguments;
-  }
+  const FlutterSoftwareRendererConfig* software_config = &config->software;
 
-  if (args == nullptr) {
-    return kInvalidArguments;
+  if (SAFE_ACCESS(software_config, surface_present_callback, nullptr) ==
+      nullptr) {
+    return false;
   }
 
-  if (SAFE_ACCESS(args, assets_path, nullptr) == nullptr ||
-      SAFE_ACCESS(args, main_path, nullptr) == nullptr ||
-      SAFE_ACCESS(args, packages_path, nullptr) == nullptr) {
-    return kInvalidArguments;
+  return true;
+}
+
+bool IsRendererValid(const FlutterRendererConfig* config) {
+  if (config == nullptr) {
+    return false;
   }
 
-  if (!IsRendererValid(config)) {
-    return kInvalidArguments;
+  switch (config->type) {
+    case kOpenGL:
+      return IsOpenGLRendererConfigValid(config);
+    case kSoftware:
+      return IsSoftwareRendererConfigValid(config);
+    default:
+      return false;
   }
 
-  auto make_current = [ptr = config->open_gl.make_current,
-                       user_data]() -> bool { return ptr(user_data); };
+  return false;
+}
+
+static shell::PlatformViewEmbedder::DispatchTable
+CreateOpenGLDispatchTable(const FlutterRendererConfig* config,
+                          void* user_data) {
+  shell::PlatformViewEmbedder::DispatchTable dispatch_table;
+
+  dispatch_table.gl_make_current_callback =
+      [ptr = config->open_gl.make_current, user_data]() -> bool {
+    return ptr(user_data);
+  };
+
+  dispatch_table.gl_clear_current_callback =
+      [ptr = config->open_gl.clear_current, user_data]() -> bool {
+    return ptr(user_data);
+  };
 
-  auto clear_current = [ptr = config->open_gl.clear_current,
-                        user_data]() -> bool { return ptr(user_data); };
+  dispatch_table.gl_present_callback = [ptr = config->open_gl.present,
+                                        user_data]() -> bool {
+    return ptr(user_data);
+  };
 
-  auto present = [ptr = config->open_gl.present, user_data]() -> bool {
+  dispatch_table.gl_fbo_callback = [ptr = config->open_gl.fbo_callback,
+                                    user_data]() -> intptr_t {
     return ptr(user_data);
   };
 
-  auto fbo_callback = [ptr = config->open_gl.fbo_callback,
-                       user_data]() -> intptr_t { return ptr(user_data); };
+  const FlutterOpenGLRendererConfig* open_gl_config = &config->open_gl;
+  if (SAFE_ACCESS(open_gl_config, make_resource_current, nullptr) != nullptr) {
+    dispatch_table.gl_make_resource_current_callback =
+        [ptr = config->open_gl.make_resource_current, user_data]() {
+          return ptr(user_data);
+        };
+  }
+
+  return dispatch_table;
+}
+
+static shell::PlatformViewEmbedder::DispatchTable
+CreateSoftwareDispatchTable(const FlutterRendererConfig* config,
+                            void* user_data) {
+  shell::PlatformViewEmbedder::DispatchTable dispatch_table;
+
+  dispatch_table.software_present_callback =
+      [ptr = config->software.surface_present_callback, user_data](
+          const void* allocation, size_t row_bytes, size_t height) -> bool {
+    return ptr(user_data, allocation, row_bytes, height);
+  };
+
+  const FlutterSoftwareRendererConfig* software_config = &config->software;
+  if (SAFE_ACCESS(software_config, surface_buffer_callback, nullptr) !=
+      nullptr) {
+    dispatch_table.software_buffer_callback =
+        [ptr = config->software.surface_buffer_callback, user_data](
+            size_t width, size_t height, size_t* row_bytes) -> void* {
+      return ptr(user_data, width, height, row_bytes);
+    };
+  }
+
+  return dispatch_table;
+}
+
+static bool IsTaskRunnerDescriptionValid(
+    const FlutterTaskRunnerDescription* description) {
+  if (description == nullptr) {
+    // Custom task runners are optional.
+    return true;
+  }
+
+  return SAFE_ACCESS(description, runs_task_on_current_thread_callback,
+                     nullptr) != nullptr &&
+         SAFE_ACCESS(description, post_task_callback, nullptr) != nullptr;
+}
+
+static bool AreCustomTaskRunnersValid(
+    const FlutterCustomTaskRunners* custom_task_runners) {
+  if (custom_task_runners == nullptr) {
+    return true;
+  }
+
+  return IsTaskRunnerDescriptionValid(
+             SAFE_ACCESS(custom_task_runners, platform_task_runner, nullptr)) &&
+         IsTaskRunnerDescriptionValid(
+             SAFE_ACCESS(custom_task_runners, render_task_runner, nullptr)) &&
+         IsTaskRunnerDescriptionValid(
+             SAFE_ACCESS(custom_task_runners, ui_task_runner, nullptr)) &&
+         IsTaskRunnerDescriptionValid(
+             SAFE_ACCESS(custom_task_runners, io_task_runner, nullptr));
+}
+
+// Returns null if the embedder did not specify a task runner for the role.
+static fxl::RefPtr<shell::EmbedderTaskRunner> CreateEmbedderTaskRunner(
+    const FlutterTaskRunnerDescription* description) {
+  if (description == nullptr) {
+    return nullptr;
+  }
+
+  shell::EmbedderTaskRunner::DispatchTable dispatch_table;
+
+  dispatch_table.post_task_callback =
+      [ptr = description->post_task_callback,
+       user_data = description->user_data](shell::EmbedderTaskRunner* runner,
+                                            uint64_t task_baton,
+                                            fxl::TimePoint target_time) {
+        const FlutterTask task = {
+            reinterpret_cast<FlutterTaskRunner>(runner),  // runner
+            task_baton,                                   // task
+        };
+        ptr(task, target_time.ToEpochDelta().ToNanoseconds(), user_data);
+      };
+
+  dispatch_table.runs_task_on_current_thread_callback =
+      [ptr = description->runs_task_on_current_thread_callback,
+       user_data = description->user_data]() -> bool { return ptr(user_data); };
+
+  return fxl::MakeRefCounted<shell::EmbedderTaskRunner>(
+      std::move(dispatch_table));
+}
+
+struct _FlutterPlatformMessageResponseHandle {
+  fxl::RefPtr<blink::PlatformMessage> message;
+};
+
+static bool AreProjectArgsValid(const FlutterProjectArgs* args) {
+  if (args == nullptr) {
+    return false;
+  }
+
+  return SAFE_ACCESS(args, assets_path, nullptr) != nullptr &&
+         SAFE_ACCESS(args, main_path, nullptr) != nullptr &&
+         SAFE_ACCESS(args, packages_path, nullptr) != nullptr;
+}
+
+static shell::PlatformViewEmbedder::DispatchTable CreateDispatchTable(
+    const FlutterRendererConfig* config,
+    const FlutterProjectArgs* args,
+    void* user_data) {
+  shell::PlatformViewEmbedder::DispatchTable dispatch_table =
+      config->type == kSoftware
+          ? CreateSoftwareDispatchTable(config, user_data)
+          : CreateOpenGLDispatchTable(config, user_data);
 
   shell::PlatformViewEmbedder::PlatformMessageResponseCallback
       platform_message_response_callback = nullptr;
@@ -121,14 +251,21 @@ FlutterResult FlutterEngineRun(size_t version,
         };
   }
 
-  const FlutterOpenGLRendererConfig* open_gl_config = &config->open_gl;
-  std::function<bool()> make_resource_current_callback = nullptr;
-  if (SAFE_ACCESS(open_gl_config, make_resource_current, nullptr) != nullptr) {
-    make_resource_current_callback = [ptr =
-                                          config->open_gl.make_resource_current,
-                                      user_data]() { return ptr(user_data); };
+  dispatch_table.platform_message_response_callback =
+      std::move(platform_message_response_callback);
+
+  if (SAFE_ACCESS(args, vsync_callback, nullptr) != nullptr) {
+    dispatch_table.vsync_callback = [ptr = args->vsync_callback,
+                                     user_data](intptr_t baton) {
+      return ptr(user_data, baton);
+    };
   }
 
+  return dispatch_table;
+}
+
+static blink::Settings CreateSettings(const FlutterRendererConfig* config,
+                                      const FlutterProjectArgs* args) {
   std::string icu_data_path;
   if (SAFE_ACCESS(args, icu_data_path, nullptr) != nullptr) {
     icu_data_path = SAFE_ACCESS(args, icu_data_path, nullptr);
@@ -145,6 +282,9 @@ FlutterResult FlutterEngineRun(size_t version,
   blink::Settings settings = shell::SettingsFromCommandLine(command_line);
   settings.icu_data_path = icu_data_path;
   settings.assets_path = args->assets_path;
+  if (config->type == kSoftware) {
+    settings.enable_software_rendering = true;
+  }
 
   // Check whether the assets path contains Dart 2 kernel assets.
   const std::string kApplicationKernelSnapshotFileName = "kernel_blob.bin";
@@ -164,69 +304,61 @@ FlutterResult FlutterEngineRun(size_t version,
     settings.packages_file_path = args->packages_path;
   }
 
+  // Threads managed by the embedder have no message loop of their own.
   settings.task_observer_add = [](intptr_t key, fxl::Closure callback) {
-    fml::MessageLoop::GetCurrent().AddTaskObserver(key, std::move(callback));
+    if (fml::MessageLoop::IsInitializedForCurrentThread()) {
+      fml::MessageLoop::GetCurrent().AddTaskObserver(key, std::move(callback));
+    } else {
+      shell::EmbedderTaskRunner::AddTaskObserverForCurrentThread(
+          key, std::move(callback));
+    }
   };
   settings.task_observer_remove = [](intptr_t key) {
-    fml::MessageLoop::GetCurrent().RemoveTaskObserver(key);
+    if (fml::MessageLoop::IsInitializedForCurrentThread()) {
+      fml::MessageLoop::GetCurrent().RemoveTaskObserver(key);
+    } else {
+      shell::EmbedderTaskRunner::RemoveTaskObserverForCurrentThread(key);
+    }
   };
 
-  // Create a thread host with the current thread as the platform thread and all
-  // other threads managed.
-  shell::ThreadHost thread_host("io.flutter", shell::ThreadHost::Type::GPU |
-                                                  shell::ThreadHost::Type::IO |
-                                                  shell::ThreadHost::Type::UI);
-  fml::MessageLoop::EnsureInitializedForCurrentThread();
-  blink::TaskRunners task_runners(
-      "io.flutter",
-      fml::MessageLoop::GetCurrent().GetTaskRunner(),  // platform
-      thread_host.gpu_thread->GetTaskRunner(),         // gpu
-      thread_host.ui_thread->GetTaskRunner(),          // ui
-      thread_host.io_thread->GetTaskRunner()           // io
-  );
+  return settings;
+}
 
-  shell::PlatformViewEmbedder::DispatchTable dispatch_table = {
-      make_current,                        // gl_make_current_callback
-      clear_current,                       // gl_clear_current_callback
-      present,                             // gl_present_callback
-      fbo_callback,                        // gl_fbo_callback
-      platform_message_response_callback,  // platform_message_response_callback
-      make_resource_current_callback,      // gl_make_resource_current_callback
+static shell::Shell::CreateCallback<shell::PlatformView>
+CreatePlatformViewCallback(
+    shell::PlatformViewEmbedder::DispatchTable dispatch_table) {
+  return [dispatch_table](shell::Shell& shell) {
+    return std::make_unique<shell::PlatformViewEmbedder>(
+        shell,                   // delegate
+        shell.GetTaskRunners(),  // task runners
+        dispatch_table           // embedder dispatch table
+    );
   };
+}
 
-  shell::Shell::CreateCallback<shell::PlatformView> on_create_platform_view =
-      [dispatch_table](shell::Shell& shell) {
-        return std::make_unique<shell::PlatformViewEmbedder>(
-            shell,                   // delegate
-            shell.GetTaskRunners(),  // task runners
-            dispatch_table           // embedder dispatch table
-        );
-      };
-
-  shell::Shell::CreateCallback<shell::Rasterizer> on_create_rasterizer =
-      [](shell::Shell& shell) {
-        return std::make_unique<shell::Rasterizer>(shell.GetTaskRunners());
-      };
-
-  // Step 1: Create the engine.
-  auto embedder_engine =
-      std::make_unique<shell::EmbedderEngine>(std::move(thread_host),   //
-                                              std::move(task_runners),  //
-                                              settings,                 //
-                                              on_create_platform_view,  //
-                                              on_create_rasterizer      //
-      );
+static shell::Shell::CreateCallback<shell::Rasterizer>
+CreateRasterizerCallback() {
+  return [](shell::Shell& shell) {
+    return std::make_unique<shell::Rasterizer>(shell.GetTaskRunners());
+  };
+}
 
-  if (!embedder_engine->IsValid()) {
+// Sets up the rendering surface of a newly created engine and runs it.
+// Ownership of the engine is released to the caller on success.
+static FlutterResult RunEmbedderEngine(
+    std::unique_ptr<shell::EmbedderEngine> embedder_engine,
+    const blink::Settings& settings,
+    FlutterEngine* engine_out) {
+  if (!embedder_engine || !embedder_engine->IsValid()) {
     return kInvalidArguments;
   }
 
-  // Step 2: Setup the rendering surface.
+  // Setup the rendering surface.
   if (!embedder_engine->NotifyCreated()) {
     return kInvalidArguments;
   }
 
-  // Step 3: Run the engine.
+  // Run the engine.
   auto run_configuration = shell::RunConfiguration::InferFromSettings(settings);
 
   run_configuration.AddAssetResolver(
@@ -246,11 +378,157 @@ FlutterResult FlutterEngineRun(size_t version,
   return kSuccess;
 }
 
+FlutterResult FlutterEngineRun(size_t version,
+                               const FlutterRendererConfig* config,
+                               const FlutterProjectArgs* args,
+                               void* user_data,
+                               FlutterEngine* engine_out) {
+  // Step 0: Figure out arguments for shell creation.
+  if (version != FLUTTER_ENGINE_VERSION) {
+    return kInvalidLibraryVersion;
+  }
+
+  if (engine_out == nullptr) {
+    return kInvalidArguments;
+  }
+
+  if (!AreProjectArgsValid(args)) {
+    return kInvalidArguments;
+  }
+
+  if (!IsRendererValid(config)) {
+    return kInvalidArguments;
+  }
+
+  const FlutterCustomTaskRunners* custom_task_runners =
+      SAFE_ACCESS(args, custom_task_runners, nullptr);
+  if (!AreCustomTaskRunnersValid(custom_task_runners)) {
+    return kInvalidArguments;
+  }
+
+  shell::PlatformViewEmbedder::DispatchTable dispatch_table =
+      CreateDispatchTable(config, args, user_data);
+
+  blink::Settings settings = CreateSettings(config, args);
+
+  fxl::RefPtr<fxl::TaskRunner> platform_task_runner, gpu_task_runner,
+      ui_task_runner, io_task_runner;
+  std::vector<fxl::RefPtr<shell::EmbedderTaskRunner>> embedder_task_runners;
+  if (custom_task_runners != nullptr) {
+    auto create_task_runner =
+        [&embedder_task_runners](
+            const FlutterTaskRunnerDescription* description)
+        -> fxl::RefPtr<fxl::TaskRunner> {
+      auto runner = CreateEmbedderTaskRunner(description);
+      if (runner) {
+        embedder_task_runners.push_back(runner);
+      }
+      return runner;
+    };
+    platform_task_runner = create_task_runner(
+        SAFE_ACCESS(custom_task_runners, platform_task_runner, nullptr));
+    gpu_task_runner = create_task_runner(
+        SAFE_ACCESS(custom_task_runners, render_task_runner, nullptr));
+    ui_task_runner = create_task_runner(
+        SAFE_ACCESS(custom_task_runners, ui_task_runner, nullptr));
+    io_task_runner = create_task_runner(
+        SAFE_ACCESS(custom_task_runners, io_task_runner, nullptr));
+  }
+
+  // The shell is created on the platform thread.
+  if (platform_task_runner &&
+      !platform_task_runner->RunsTasksOnCurrentThread()) {
+    return kInvalidArguments;
+  }
+
+  // Create a thread host with a thread for each task runner the embedder did
+  // not specify. Unless specified, the current thread is the platform thread.
+  // The threads are configured by the thread switches of the command line.
+  uint64_t thread_host_mask = 0;
+  thread_host_mask |= gpu_task_runner ? 0 : shell::ThreadHost::Type::GPU;
+  thread_host_mask |= ui_task_runner ? 0 : shell::ThreadHost::Type::UI;
+  thread_host_mask |= io_task_runner ? 0 : shell::ThreadHost::Type::IO;
+  shell::ThreadHost thread_host("io.flutter", thread_host_mask,
+                                settings.ui_thread_config,
+                                settings.gpu_thread_config,
+                                settings.io_thread_config);
+
+  if (!platform_task_runner) {
+    fml::MessageLoop::EnsureInitializedForCurrentThread();
+    platform_task_runner = fml::MessageLoop::GetCurrent().GetTaskRunner();
+  }
+  if (!gpu_task_runner) {
+    gpu_task_runner = thread_host.gpu_thread->GetTaskRunner();
+  }
+  if (!ui_task_runner) {
+    ui_task_runner = thread_host.ui_thread->GetTaskRunner();
+  }
+  if (!io_task_runner) {
+    io_task_runner = thread_host.io_thread->GetTaskRunner();
+  }
+
+  blink::TaskRunners task_runners("io.flutter",                    //
+                                  std::move(platform_task_runner),  // platform
+                                  std::move(gpu_task_runner),       // gpu
+                                  std::move(ui_task_runner),        // ui
+                                  std::move(io_task_runner)         // io
+  );
+
+  // Step 1: Create the engine.
+  auto embedder_engine = std::make_unique<shell::EmbedderEngine>(
+      std::move(thread_host),                                 //
+      std::move(task_runners),                                //
+      std::move(embedder_task_runners),                       //
+      settings,                                               //
+      CreatePlatformViewCallback(std::move(dispatch_table)),  //
+      CreateRasterizerCallback()                              //
+  );
+
+  // Step 2: Setup the rendering surface and run the engine.
+  return RunEmbedderEngine(std::move(embedder_engine), settings, engine_out);
+}
+
+FlutterResult FlutterEngineSpawn(FlutterEngine engine,
+                                 const FlutterRendererConfig* config,
+                                 const FlutterProjectArgs* args,
+                                 void* user_data,
+                                 FlutterEngine* engine_out) {
+  if (engine == nullptr || engine_out == nullptr) {
+    return kInvalidArguments;
+  }
+
+  if (!AreProjectArgsValid(args)) {
+    return kInvalidArguments;
+  }
+
+  if (!IsRendererValid(config)) {
+    return kInvalidArguments;
+  }
+
+  blink::Settings settings = CreateSettings(config, args);
+
+  // The task runners of the spawning engine are used. Custom task runners in
+  // the project arguments are ignored.
+  shell::PlatformViewEmbedder::DispatchTable dispatch_table =
+      CreateDispatchTable(config, args, user_data);
+  auto embedder_engine =
+      reinterpret_cast<shell::EmbedderEngine*>(engine)->Spawn(
+          settings,                                               //
+          CreatePlatformViewCallback(std::move(dispatch_table)),  //
+          CreateRasterizerCallback()                              //
+      );
+
+  return RunEmbedderEngine(std::move(embedder_engine), settings, engine_out);
+}
+
 FlutterResult FlutterEngineShutdown(FlutterEngine engine) {
   if (engine == nullptr) {
     return kInvalidArguments;
   }
   auto embedder_engine = reinterpret_cast<shell::EmbedderEngine*>(engine);
+  if (embedder_engine->HasSpawnedEngines()) {
+    return kInvalidArguments;
+  }
   embedder_engine->NotifyDestroyed();
   delete embedder_engine;
   return kSuccess;
@@ -275,6 +553,31 @@ FlutterResult FlutterEngineSendWindowMetricsEvent(
              : kInvalidArguments;
 }
 
+FlutterResult FlutterEngineNotifyMemoryPressure(
+    FlutterEngine engine,
+    FlutterMemoryPressureLevel level) {
+  if (engine == nullptr) {
+    return kInvalidArguments;
+  }
+
+  shell::MemoryPressureLevel pressure_level;
+  switch (level) {
+    case kFlutterMemoryPressureModerate:
+      pressure_level = shell::MemoryPressureLevel::kModerate;
+      break;
+    case kFlutterMemoryPressureCritical:
+      pressure_level = shell::MemoryPressureLevel::kCritical;
+      break;
+    default:
+      return kInvalidArguments;
+  }
+
+  return reinterpret_cast<shell::EmbedderEngine*>(engine)->NotifyMemoryPressure(
+             pressure_level)
+             ? kSuccess
+             : kInvalidArguments;
+}
+
 inline blink::PointerData::Change ToPointerDataChange(
     FlutterPointerPhase phase) {
   switch (phase) {
@@ -369,6 +672,52 @@ FlutterResult FlutterEngineSendPlatformMessageResponse(
   return kSuccess;
 }
 
+FlutterResult FlutterEngineOnVsync(FlutterEngine engine,
+                                   intptr_t baton,
+                                   uint64_t frame_start_time_nanos,
+                                   uint64_t frame_target_time_nanos) {
+  if (engine == nullptr || frame_target_time_nanos < frame_start_time_nanos) {
+    return kInvalidArguments;
+  }
+
+  auto start_time = fxl::TimePoint::FromEpochDelta(
+      fxl::TimeDelta::FromNanoseconds(frame_start_time_nanos));
+  auto target_time = fxl::TimePoint::FromEpochDelta(
+      fxl::TimeDelta::FromNanoseconds(frame_target_time_nanos));
+
+  return reinterpret_cast<shell::EmbedderEngine*>(engine)->OnVsyncEvent(
+             baton, start_time, target_time)
+             ? kSuccess
+             : kInvalidArguments;
+}
+
+FlutterResult FlutterEngineRunTask(FlutterEngine engine,
+                                   const FlutterTask* task) {
+  if (task == nullptr || task->runner == nullptr) {
+    return kInvalidArguments;
+  }
+
+  // The embedder has no engine yet while the tasks posted by
+  // |FlutterEngineRun| are run.
+  if (engine != nullptr &&
+      !reinterpret_cast<shell::EmbedderEngine*>(engine)->HasEmbedderTaskRunner(
+          task->runner)) {
+    return kInvalidArguments;
+  }
+
+  // Rejects tasks of task runners whose engine has been shut down.
+  auto runner = shell::EmbedderTaskRunner::GetRegistered(task->runner);
+  if (!runner) {
+    return kInvalidArguments;
+  }
+
+  return runner->RunTask(task->task) ? kSuccess : kInvalidArguments;
+}
+
+uint64_t FlutterEngineGetCurrentTime() {
+  return fxl::TimePoint::Now().ToEpochDelta().ToNanoseconds();
+}
+
 FlutterResult __FlutterEngineFlushPendingTasksNow() {
   fml::MessageLoop::GetCurrent().RunExpiredTasksNow();
   return kSuccess;
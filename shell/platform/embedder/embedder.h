@@ -27,12 +27,22 @@ typedef enum {
 
 typedef enum {
   kOpenGL,
+  kSoftware,
 } FlutterRendererType;
 
 typedef struct _FlutterEngine* FlutterEngine;
 
+typedef enum {
+  // Caches that are cheap to rebuild should be trimmed. For example, when the
+  // application moves to the background.
+  kFlutterMemoryPressureModerate,
+  // As much memory as possible should be released.
+  kFlutterMemoryPressureCritical,
+} FlutterMemoryPressureLevel;
+
 typedef bool (*BoolCallback)(void* /* user data */);
 typedef uint32_t (*UIntCallback)(void* /* user data */);
+typedef void (*VsyncCallback)(void* /* user data */, intptr_t /* baton */);
 
 typedef struct {
   // The size of this struct. Must be sizeof(FlutterOpenGLRendererConfig).
@@ -44,10 +54,39 @@ typedef struct {
   BoolCallback make_resource_current;
 } FlutterOpenGLRendererConfig;
 
+typedef bool (*SoftwareSurfacePresentCallback)(void* /* user data */,
+                                               const void* /* allocation */,
+                                               size_t /* row bytes */,
+                                               size_t /* height */);
+typedef void* (*SoftwareSurfaceBufferCallback)(void* /* user data */,
+                                               size_t /* width */,
+                                               size_t /* height */,
+                                               size_t* /* row bytes out */);
+
+typedef struct {
+  // The size of this struct. Must be sizeof(FlutterSoftwareRendererConfig).
+  size_t struct_size;
+  // Invoked on the GPU thread when a frame has been rendered. The allocation
+  // is the backing store of the surface the frame was rendered into and is
+  // handed over without a copy. It holds 32-bit premultiplied pixels in the
+  // native byte order of the platform and is only valid for the duration of
+  // the call.
+  SoftwareSurfacePresentCallback surface_present_callback;
+  // Optional. Lets the embedder supply the memory frames are rendered into,
+  // for example a shared memory segment. Invoked on the GPU thread whenever the
+  // size of the surface changes. The callback must return a buffer of at least
+  // |row bytes| * |height| bytes and set |row bytes| to at least 4 * |width|.
+  // The buffer must stay valid till the callback is invoked again or the
+  // engine is shut down. Returning NULL skips the frame. If not specified, the
+  // engine allocates the memory itself.
+  SoftwareSurfaceBufferCallback surface_buffer_callback;
+} FlutterSoftwareRendererConfig;
+
 typedef struct {
   FlutterRendererType type;
   union {
     FlutterOpenGLRendererConfig open_gl;
+    FlutterSoftwareRendererConfig software;
   };
 } FlutterRendererConfig;
 
@@ -103,6 +142,56 @@ typedef void (*FlutterPlatformMessageCallback)(
     const FlutterPlatformMessage* /* message*/,
     void* /* user data */);
 
+struct _FlutterTaskRunner;
+typedef struct _FlutterTaskRunner* FlutterTaskRunner;
+
+typedef struct {
+  FlutterTaskRunner runner;
+  uint64_t task;
+} FlutterTask;
+
+typedef void (*FlutterTaskRunnerPostTaskCallback)(
+    FlutterTask /* task */,
+    uint64_t /* target time nanos */,
+    void* /* user data */);
+
+// An event loop managed by the embedder on which the engine can run the tasks
+// of one of its task runners. The same description may be used for more than
+// one task runner, in which case the tasks of those runners are run on the
+// same thread.
+typedef struct {
+  // The size of this struct. Must be sizeof(FlutterTaskRunnerDescription).
+  size_t struct_size;
+  void* user_data;
+  // May be called from any thread. Must return true if the calling thread is
+  // the one on which the embedder runs the tasks of this task runner.
+  BoolCallback runs_task_on_current_thread_callback;
+  // May be called from any thread. The embedder must call
+  // |FlutterEngineRunTask| with the task on the thread of this task runner once
+  // the target time has been reached. Target times are on the clock returned by
+  // |FlutterEngineGetCurrentTime|. Tasks must not be run after the engine has
+  // been shut down.
+  FlutterTaskRunnerPostTaskCallback post_task_callback;
+} FlutterTaskRunnerDescription;
+
+typedef struct {
+  // The size of this struct. Must be sizeof(FlutterCustomTaskRunners).
+  size_t struct_size;
+  // Each task runner is optional. The engine creates a thread for each of the
+  // GPU, UI and IO task runners that is not specified. If the platform task
+  // runner is not specified, the platform tasks are run by an event loop
+  // managed by the engine on the thread on which |FlutterEngineRun| is called.
+  // If it is specified, |FlutterEngineRun| must be called on its thread. The
+  // priorities, CPU affinities and stack sizes of the threads created by the
+  // engine are set with the --ui-thread-priority, --ui-thread-cpu-affinity,
+  // --thread-stack-size and related switches of
+  // |FlutterProjectArgs.command_line_argv|.
+  const FlutterTaskRunnerDescription* platform_task_runner;
+  const FlutterTaskRunnerDescription* render_task_runner;
+  const FlutterTaskRunnerDescription* ui_task_runner;
+  const FlutterTaskRunnerDescription* io_task_runner;
+} FlutterCustomTaskRunners;
+
 typedef struct {
   // The size of this struct. Must be sizeof(FlutterProjectArgs).
   size_t struct_size;
@@ -132,6 +221,16 @@ typedef struct {
   // to respond to platform messages from the Dart application. The callback
   // will be invoked on the thread on which the |FlutterEngineRun| call is made.
   FlutterPlatformMessageCallback platform_message_callback;
+  // Optional. Lets the engine run its tasks on event loops managed by the
+  // embedder instead of on threads of its own. The struct can be collected
+  // after the call to |FlutterEngineRun| returns.
+  const FlutterCustomTaskRunners* custom_task_runners;
+  // Optional. Invoked on the UI task runner when the engine wants to be
+  // notified of the next vsync pulse of the display. The callback must not
+  // block. The embedder must call |FlutterEngineOnVsync| with the baton exactly
+  // once, when the next vsync pulse occurs. If not specified, the engine
+  // produces frames on a 60Hz timer.
+  VsyncCallback vsync_callback;
 } FlutterProjectArgs;
 
 FLUTTER_EXPORT
@@ -141,6 +240,25 @@ FlutterResult FlutterEngineRun(size_t version,
                                void* user_data,
                                FlutterEngine* engine_out);
 
+// Runs another engine on the threads (or custom task runners) of |engine|. The
+// new engine shares the Dart VM, the fonts and the resource loading context of
+// |engine| so its memory overhead is much lower than that of an engine created
+// with |FlutterEngineRun|. The |custom_task_runners| of |args| are ignored.
+// The fonts in the assets of |args| are not registered either: the new engine
+// only has the fonts of |engine|. Must be called on the platform thread of
+// |engine|.
+//
+// Textures of the new engine are uploaded with the resource context of
+// |engine| (see |make_resource_current|). So |engine| must outlive the new
+// engine: |FlutterEngineShutdown| fails with |kInvalidArguments| for an engine
+// whose spawned engines have not all been shut down.
+FLUTTER_EXPORT
+FlutterResult FlutterEngineSpawn(FlutterEngine engine,
+                                 const FlutterRendererConfig* config,
+                                 const FlutterProjectArgs* args,
+                                 void* user_data,
+                                 FlutterEngine* engine_out);
+
 FLUTTER_EXPORT
 FlutterResult FlutterEngineShutdown(FlutterEngine engine);
 
@@ -166,9 +284,44 @@ FlutterResult FlutterEngineSendPlatformMessageResponse(
     const uint8_t* data,
     size_t data_length);
 
+// Trims the GPU resource and raster caches and asks the framework to evict
+// its image cache. Must be called on the thread on which |FlutterEngineRun|
+// was called.
+FLUTTER_EXPORT
+FlutterResult FlutterEngineNotifyMemoryPressure(
+    FlutterEngine engine,
+    FlutterMemoryPressureLevel level);
+
+// Notifies the engine of the vsync pulse requested by the |vsync_callback| of
+// |FlutterProjectArgs|. The baton is consumed. Frame times are in nanoseconds
+// on the clock returned by |FlutterEngineGetCurrentTime|. The frame target time
+// is when the frame being produced is expected to be presented, usually the
+// time of the vsync pulse after this one. May be called on any thread.
+FLUTTER_EXPORT
+FlutterResult FlutterEngineOnVsync(FlutterEngine engine,
+                                   intptr_t baton,
+                                   uint64_t frame_start_time_nanos,
+                                   uint64_t frame_target_time_nanos);
+
+// Runs a task handed to the embedder by the |post_task_callback| of a custom
+// task runner. Must be called on the thread of that task runner. The engine
+// must be the one the task runner was specified for, or one spawned from it.
+// It may be null for tasks run before |FlutterEngineRun| has returned the
+// engine. Returns |kInvalidArguments| for tasks of other engines and of engines
+// that have been shut down.
+FLUTTER_EXPORT
+FlutterResult FlutterEngineRunTask(FlutterEngine engine,
+                                   const FlutterTask* task);
+
+// The current time in nanoseconds on the clock used for the target times of
+// the tasks of custom task runners.
+FLUTTER_EXPORT
+uint64_t FlutterEngineGetCurrentTime();
+
 // This API is only meant to be used by platforms that need to flush tasks on a
 // message loop not controlled by the Flutter engine. This API will be
-// deprecated soon.
+// deprecated soon. Such platforms should specify a platform task runner in
+// |FlutterProjectArgs.custom_task_runners| instead.
 FLUTTER_EXPORT
 FlutterResult __FlutterEngineFlushPendingTasksNow();
 
@@ -4,7 +4,9 @@
 
 #include "flutter/shell/platform/embedder/embedder_engine.h"
 
+#include "flutter/shell/platform/embedder/vsync_waiter_embedder.h"
 #include "lib/fxl/functional/make_copyable.h"
+#include "lib/fxl/logging.h"
 
 #ifdef ERROR
 #undef ERROR
@@ -12,21 +14,95 @@
 
 namespace shell {
 
+static std::vector<fxl::RefPtr<EmbedderTaskRunner>> RegisterTaskRunners(
+    std::vector<fxl::RefPtr<EmbedderTaskRunner>> runners) {
+  for (const auto& runner : runners) {
+    EmbedderTaskRunner::Register(runner.get());
+  }
+  return runners;
+}
+
 EmbedderEngine::EmbedderEngine(
     ThreadHost thread_host,
     blink::TaskRunners task_runners,
+    std::vector<fxl::RefPtr<EmbedderTaskRunner>> embedder_task_runners,
     blink::Settings settings,
     Shell::CreateCallback<PlatformView> on_create_platform_view,
     Shell::CreateCallback<Rasterizer> on_create_rasterizer)
-    : thread_host_(std::move(thread_host)),
+    : thread_host_(std::make_shared<ThreadHost>(std::move(thread_host))),
+      embedder_task_runners_(
+          RegisterTaskRunners(std::move(embedder_task_runners))),
       shell_(Shell::Create(std::move(task_runners),
                            std::move(settings),
                            on_create_platform_view,
-                           on_create_rasterizer)) {
+                           on_create_rasterizer)),
+      parent_(nullptr),
+      spawned_engine_count_(0) {
   is_valid_ = shell_ != nullptr;
 }
 
-EmbedderEngine::~EmbedderEngine() = default;
+EmbedderEngine::EmbedderEngine(std::shared_ptr<const ThreadHost> thread_host,
+                               std::unique_ptr<Shell> shell,
+                               const EmbedderEngine* parent)
+    : thread_host_(std::move(thread_host)),
+      shell_(std::move(shell)),
+      parent_(parent),
+      spawned_engine_count_(0) {
+  is_valid_ = shell_ != nullptr;
+  parent_->spawned_engine_count_++;
+}
+
+EmbedderEngine::~EmbedderEngine() {
+  FXL_DCHECK(!HasSpawnedEngines());
+  // The shell uses the resource context of the parent. So the parent may only
+  // be shut down once the shell is collected.
+  shell_.reset();
+  if (parent_) {
+    parent_->spawned_engine_count_--;
+  }
+  // The shell runs tasks while it is torn down. Tasks the embedder hands back
+  // from now on are rejected.
+  for (const auto& runner : embedder_task_runners_) {
+    EmbedderTaskRunner::Unregister(runner.get());
+  }
+}
+
+std::unique_ptr<EmbedderEngine> EmbedderEngine::Spawn(
+    blink::Settings settings,
+    Shell::CreateCallback<PlatformView> on_create_platform_view,
+    Shell::CreateCallback<Rasterizer> on_create_rasterizer) const {
+  if (!IsValid()) {
+    return nullptr;
+  }
+
+  const auto& platform_task_runner =
+      shell_->GetTaskRunners().GetPlatformTaskRunner();
+  if (!platform_task_runner->RunsTasksOnCurrentThread()) {
+    return nullptr;
+  }
+
+  auto shell = shell_->Spawn(std::move(settings), on_create_platform_view,
+                             on_create_rasterizer);
+  if (!shell) {
+    return nullptr;
+  }
+
+  return std::unique_ptr<EmbedderEngine>(
+      new EmbedderEngine(thread_host_, std::move(shell), this));
+}
+
+bool EmbedderEngine::HasSpawnedEngines() const {
+  return spawned_engine_count_ > 0;
+}
+
+bool EmbedderEngine::HasEmbedderTaskRunner(const void* runner) const {
+  for (const auto& embedder_task_runner : embedder_task_runners_) {
+    if (embedder_task_runner.get() == runner) {
+      return true;
+    }
+  }
+  return parent_ != nullptr && parent_->HasEmbedderTaskRunner(runner);
+}
 
 bool EmbedderEngine::IsValid() const {
   return is_valid_;
@@ -100,6 +176,30 @@ bool EmbedderEngine::DispatchPointerDataPacket(
   return true;
 }
 
+bool EmbedderEngine::NotifyMemoryPressure(MemoryPressureLevel level) {
+  if (!IsValid()) {
+    return false;
+  }
+
+  auto platform_view = shell_->GetPlatformView();
+  if (!platform_view) {
+    return false;
+  }
+  platform_view->NotifyMemoryPressure(level);
+  return true;
+}
+
+bool EmbedderEngine::OnVsyncEvent(intptr_t baton,
+                                  fxl::TimePoint frame_start_time,
+                                  fxl::TimePoint frame_target_time) {
+  if (!IsValid()) {
+    return false;
+  }
+
+  return VsyncWaiterEmbedder::OnEmbedderVsync(baton, frame_start_time,
+                                              frame_target_time);
+}
+
 bool EmbedderEngine::SendPlatformMessage(
     fxl::RefPtr<blink::PlatformMessage> message) {
   if (!IsValid() || !message) {
@@ -5,11 +5,15 @@
 #ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_ENGINE_H_
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_ENGINE_H_
 
+#include <atomic>
 #include <memory>
+#include <vector>
 
+#include "flutter/shell/common/memory_pressure_level.h"
 #include "flutter/shell/common/shell.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/shell/platform/embedder/embedder.h"
+#include "flutter/shell/platform/embedder/embedder_task_runner.h"
 #include "lib/fxl/macros.h"
 
 namespace shell {
@@ -18,13 +22,31 @@ namespace shell {
 // instance of the Flutter engine.
 class EmbedderEngine {
  public:
-  EmbedderEngine(ThreadHost thread_host, blink::TaskRunners task_runners,
+  // |embedder_task_runners| are those of |task_runners| that the embedder
+  // supplied. They are registered for as long as this engine uses them.
+  EmbedderEngine(ThreadHost thread_host,
+                 blink::TaskRunners task_runners,
+                 std::vector<fxl::RefPtr<EmbedderTaskRunner>>
+                     embedder_task_runners,
                  blink::Settings settings,
                  Shell::CreateCallback<PlatformView> on_create_platform_view,
                  Shell::CreateCallback<Rasterizer> on_create_rasterizer);
 
   ~EmbedderEngine();
 
+  // Creates an engine that shares the threads, the Dart VM, the fonts and the
+  // resource context of this engine. Must be called on the platform thread.
+  // This engine must outlive the spawned engine.
+  std::unique_ptr<EmbedderEngine> Spawn(
+      blink::Settings settings,
+      Shell::CreateCallback<PlatformView> on_create_platform_view,
+      Shell::CreateCallback<Rasterizer> on_create_rasterizer) const;
+
+  // Whether engines spawned from this one are still alive. They use the
+  // resource context of this engine, which the embedder may destroy once this
+  // engine is shut down.
+  bool HasSpawnedEngines() const;
+
   bool NotifyCreated();
 
   bool NotifyDestroyed();
@@ -40,11 +62,32 @@ class EmbedderEngine {
 
   bool SendPlatformMessage(fxl::RefPtr<blink::PlatformMessage> message);
 
+  bool NotifyMemoryPressure(MemoryPressureLevel level);
+
+  bool OnVsyncEvent(intptr_t baton,
+                    fxl::TimePoint frame_start_time,
+                    fxl::TimePoint frame_target_time);
+
+  // Whether the task runner is one the embedder supplied for this engine.
+  // Spawned engines use the task runners of the engine they were spawned from.
+  bool HasEmbedderTaskRunner(const void* runner) const;
+
  private:
-  const ThreadHost thread_host_;
+  // Shared with the engines spawned from this one.
+  const std::shared_ptr<const ThreadHost> thread_host_;
+  // Declared before the shell so that the task runners are registered before
+  // the shell posts tasks to them. Empty for spawned engines.
+  const std::vector<fxl::RefPtr<EmbedderTaskRunner>> embedder_task_runners_;
   std::unique_ptr<Shell> shell_;
+  // The engine this engine was spawned from. May be null.
+  const EmbedderEngine* const parent_;
+  mutable std::atomic<size_t> spawned_engine_count_;
   bool is_valid_ = false;
 
+  EmbedderEngine(std::shared_ptr<const ThreadHost> thread_host,
+                 std::unique_ptr<Shell> shell,
+                 const EmbedderEngine* parent);
+
   FXL_DISALLOW_COPY_AND_ASSIGN(EmbedderEngine);
 };
 
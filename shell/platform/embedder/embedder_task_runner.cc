@@ -0,0 +1,149 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_task_runner.h"
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <set>
+
+#include "flutter/fml/thread_local.h"
+#include "flutter/fml/trace_event.h"
+#include "lib/fxl/logging.h"
+
+namespace shell {
+
+namespace {
+
+using TaskObservers = std::map<intptr_t, fxl::Closure>;
+
+FML_THREAD_LOCAL fml::ThreadLocal tls_task_observers([](intptr_t value) {
+  delete reinterpret_cast<TaskObservers*>(value);
+});
+
+TaskObservers& GetTaskObserversForCurrentThread() {
+  auto observers = reinterpret_cast<TaskObservers*>(tls_task_observers.Get());
+  if (observers == nullptr) {
+    observers = new TaskObservers();
+    tls_task_observers.Set(reinterpret_cast<intptr_t>(observers));
+  }
+  return *observers;
+}
+
+// Batons are unique across task runners. A stale task of a task runner that
+// was destroyed never matches a pending task of another task runner that
+// happens to be registered at the same address.
+std::atomic<uint64_t> last_task_baton(0);
+
+std::mutex registered_runners_mutex;
+std::set<const void*> registered_runners;
+
+}  // namespace
+
+EmbedderTaskRunner::EmbedderTaskRunner(DispatchTable dispatch_table)
+    : dispatch_table_(std::move(dispatch_table)) {
+  FXL_DCHECK(dispatch_table_.post_task_callback);
+  FXL_DCHECK(dispatch_table_.runs_task_on_current_thread_callback);
+}
+
+EmbedderTaskRunner::~EmbedderTaskRunner() = default;
+
+// |fxl::TaskRunner|
+void EmbedderTaskRunner::PostTask(fxl::Closure task) {
+  PostTaskForTime(std::move(task), fxl::TimePoint::Now());
+}
+
+// |fxl::TaskRunner|
+void EmbedderTaskRunner::PostTaskForTime(fxl::Closure task,
+                                         fxl::TimePoint target_time) {
+  if (!task) {
+    return;
+  }
+
+  const uint64_t baton = ++last_task_baton;
+  {
+    std::lock_guard<std::mutex> lock(tasks_mutex_);
+    pending_tasks_[baton] = std::move(task);
+  }
+
+  // The lock is not held while calling out to the embedder since it may run
+  // the task right away.
+  dispatch_table_.post_task_callback(this, baton, target_time);
+}
+
+// |fxl::TaskRunner|
+void EmbedderTaskRunner::PostDelayedTask(fxl::Closure task,
+                                         fxl::TimeDelta delay) {
+  PostTaskForTime(std::move(task), fxl::TimePoint::Now() + delay);
+}
+
+// |fxl::TaskRunner|
+bool EmbedderTaskRunner::RunsTasksOnCurrentThread() {
+  return dispatch_table_.runs_task_on_current_thread_callback();
+}
+
+bool EmbedderTaskRunner::RunTask(uint64_t task_baton) {
+  fxl::Closure task;
+  {
+    std::lock_guard<std::mutex> lock(tasks_mutex_);
+    auto found = pending_tasks_.find(task_baton);
+    if (found == pending_tasks_.end()) {
+      return false;
+    }
+    task = std::move(found->second);
+    pending_tasks_.erase(found);
+  }
+
+  FXL_DCHECK(RunsTasksOnCurrentThread())
+      << "Embedder tasks must be run on the thread of their task runner.";
+
+  {
+    TRACE_EVENT0("flutter", "EmbedderTaskRunner::RunTask");
+    task();
+  }
+
+  // Same as |fml::MessageLoopImpl|. Observers are invoked after each task.
+  for (const auto& observer : GetTaskObserversForCurrentThread()) {
+    observer.second();
+  }
+
+  return true;
+}
+
+void EmbedderTaskRunner::AddTaskObserverForCurrentThread(
+    intptr_t key,
+    fxl::Closure callback) {
+  FXL_DCHECK(callback != nullptr);
+  GetTaskObserversForCurrentThread()[key] = std::move(callback);
+}
+
+void EmbedderTaskRunner::RemoveTaskObserverForCurrentThread(intptr_t key) {
+  GetTaskObserversForCurrentThread().erase(key);
+}
+
+void EmbedderTaskRunner::Register(EmbedderTaskRunner* runner) {
+  FXL_DCHECK(runner != nullptr);
+  std::lock_guard<std::mutex> lock(registered_runners_mutex);
+  registered_runners.insert(runner);
+}
+
+void EmbedderTaskRunner::Unregister(EmbedderTaskRunner* runner) {
+  std::lock_guard<std::mutex> lock(registered_runners_mutex);
+  registered_runners.erase(runner);
+}
+
+fxl::RefPtr<EmbedderTaskRunner> EmbedderTaskRunner::GetRegistered(
+    const void* address) {
+  std::lock_guard<std::mutex> lock(registered_runners_mutex);
+  if (registered_runners.count(address) == 0) {
+    return nullptr;
+  }
+  // Registered task runners are referenced by their engine, so taking another
+  // reference is safe.
+  return fxl::Ref(
+      static_cast<EmbedderTaskRunner*>(const_cast<void*>(address)));
+}
+
+}  // namespace shell
@@ -0,0 +1,88 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_TASK_RUNNER_H_
+#define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_TASK_RUNNER_H_
+
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+#include "lib/fxl/macros.h"
+#include "lib/fxl/memory/ref_counted.h"
+#include "lib/fxl/tasks/task_runner.h"
+
+namespace shell {
+
+// A task runner whose tasks are run by the embedder on a thread it manages
+// instead of on an engine owned message loop. Each task is handed to the
+// embedder as an opaque baton which the embedder hands back to |RunTask| on
+// the correct thread once the target time of the task has been reached.
+class EmbedderTaskRunner final : public fxl::TaskRunner {
+ public:
+  struct DispatchTable {
+    // Invoked with the baton of the task and its target time on the
+    // |fxl::TimePoint| clock. May be invoked on any thread.
+    std::function<void(EmbedderTaskRunner* runner,
+                       uint64_t task_baton,
+                       fxl::TimePoint target_time)>
+        post_task_callback;
+    // May be invoked on any thread.
+    std::function<bool(void)> runs_task_on_current_thread_callback;
+  };
+
+  // |fxl::TaskRunner|
+  void PostTask(fxl::Closure task) override;
+
+  // |fxl::TaskRunner|
+  void PostTaskForTime(fxl::Closure task, fxl::TimePoint target_time) override;
+
+  // |fxl::TaskRunner|
+  void PostDelayedTask(fxl::Closure task, fxl::TimeDelta delay) override;
+
+  // |fxl::TaskRunner|
+  bool RunsTasksOnCurrentThread() override;
+
+  // Runs the task previously handed to the embedder as well as the task
+  // observers of the current thread. Returns false if the baton does not refer
+  // to a pending task.
+  bool RunTask(uint64_t task_baton);
+
+  // Threads managed by the embedder have no |fml::MessageLoop| to register
+  // task observers with. Observers registered here are invoked after each task
+  // any embedder task runner runs on the current thread.
+  static void AddTaskObserverForCurrentThread(intptr_t key,
+                                              fxl::Closure callback);
+
+  static void RemoveTaskObserverForCurrentThread(intptr_t key);
+
+  // Tasks handed back by the embedder are only run while their task runner is
+  // registered. The engine registers its task runners before posting tasks to
+  // them and unregisters them before releasing them, so that stale tasks are
+  // rejected instead of run on a destroyed task runner.
+  static void Register(EmbedderTaskRunner* runner);
+
+  static void Unregister(EmbedderTaskRunner* runner);
+
+  // Returns null if no registered task runner is at the given address. The
+  // address is not dereferenced unless it is registered.
+  static fxl::RefPtr<EmbedderTaskRunner> GetRegistered(const void* address);
+
+ private:
+  const DispatchTable dispatch_table_;
+  std::mutex tasks_mutex_;
+  std::unordered_map<uint64_t, fxl::Closure> pending_tasks_;
+
+  explicit EmbedderTaskRunner(DispatchTable dispatch_table);
+
+  ~EmbedderTaskRunner() override;
+
+  FRIEND_MAKE_REF_COUNTED(EmbedderTaskRunner);
+  FRIEND_REF_COUNTED_THREAD_SAFE(EmbedderTaskRunner);
+  FXL_DISALLOW_COPY_AND_ASSIGN(EmbedderTaskRunner);
+};
+
+}  // namespace shell
+
+#endif  // FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_TASK_RUNNER_H_
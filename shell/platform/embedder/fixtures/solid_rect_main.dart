@@ -0,0 +1,29 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Fills the window with opaque green whenever its size changes.
+
+import 'dart:ui' as ui;
+
+void beginFrame(Duration timeStamp) {
+  final ui.Size size = ui.window.physicalSize;
+  if (size.isEmpty) {
+    return;
+  }
+
+  final ui.Rect bounds = ui.Offset.zero & size;
+  final ui.PictureRecorder recorder = new ui.PictureRecorder();
+  final ui.Canvas canvas = new ui.Canvas(recorder, bounds);
+  canvas.drawRect(bounds,
+                  new ui.Paint()..color = const ui.Color.fromARGB(255, 0, 255, 0));
+
+  final ui.SceneBuilder sceneBuilder = new ui.SceneBuilder()
+    ..addPicture(ui.Offset.zero, recorder.endRecording());
+  ui.window.render(sceneBuilder.build());
+}
+
+void main() {
+  ui.window.onBeginFrame = beginFrame;
+  ui.window.onMetricsChanged = ui.window.scheduleFrame;
+}
@@ -4,7 +4,9 @@
 
 #include "flutter/shell/platform/embedder/platform_view_embedder.h"
 
+#include "flutter/fml/trace_event.h"
 #include "flutter/shell/common/io_manager.h"
+#include "lib/fxl/logging.h"
 
 namespace shell {
 
@@ -32,6 +34,63 @@ intptr_t PlatformViewEmbedder::GLContextFBO() const {
   return dispatch_table_.gl_fbo_callback();
 }
 
+// |shell::GPUSurfaceSoftwareDelegate|
+sk_sp<SkSurface> PlatformViewEmbedder::AcquireBackingStore(
+    const SkISize& size) {
+  TRACE_EVENT0("flutter", "PlatformViewEmbedder::AcquireBackingStore");
+  if (software_backing_store_ != nullptr &&
+      SkISize::Make(software_backing_store_->width(),
+                    software_backing_store_->height()) == size) {
+    return software_backing_store_;
+  }
+
+  software_backing_store_ = nullptr;
+
+  const SkImageInfo image_info =
+      SkImageInfo::MakeN32Premul(size.width(), size.height());
+
+  if (!dispatch_table_.software_buffer_callback) {
+    software_backing_store_ = SkSurface::MakeRaster(image_info);
+    return software_backing_store_;
+  }
+
+  size_t row_bytes = 0;
+  void* buffer = dispatch_table_.software_buffer_callback(
+      size.width(), size.height(), &row_bytes);
+  if (buffer == nullptr || row_bytes < image_info.minRowBytes()) {
+    FXL_LOG(ERROR) << "The embedder did not supply a valid buffer for a "
+                   << size.width() << "x" << size.height() << " surface.";
+    return nullptr;
+  }
+
+  // The buffer is owned by the embedder.
+  software_backing_store_ =
+      SkSurface::MakeRasterDirect(image_info, buffer, row_bytes);
+  return software_backing_store_;
+}
+
+// |shell::GPUSurfaceSoftwareDelegate|
+bool PlatformViewEmbedder::PresentBackingStore(
+    sk_sp<SkSurface> backing_store) {
+  TRACE_EVENT0("flutter", "PlatformViewEmbedder::PresentBackingStore");
+  if (backing_store == nullptr) {
+    return false;
+  }
+
+  SkPixmap pixmap;
+  if (!backing_store->peekPixels(&pixmap)) {
+    return false;
+  }
+
+  // The pixels are handed to the embedder in place.
+  return dispatch_table_.software_present_callback(
+      pixmap.addr(), pixmap.rowBytes(), pixmap.height());
+}
+
+bool PlatformViewEmbedder::IsSoftwareRenderer() const {
+  return static_cast<bool>(dispatch_table_.software_present_callback);
+}
+
 void PlatformViewEmbedder::HandlePlatformMessage(
     fxl::RefPtr<blink::PlatformMessage> message) {
   if (!message) {
@@ -51,10 +110,17 @@ void PlatformViewEmbedder::HandlePlatformMessage(
 }
 
 std::unique_ptr<Surface> PlatformViewEmbedder::CreateRenderingSurface() {
+  if (IsSoftwareRenderer()) {
+    return std::make_unique<GPUSurfaceSoftware>(this);
+  }
   return std::make_unique<GPUSurfaceGL>(this);
 }
 
 sk_sp<GrContext> PlatformViewEmbedder::CreateResourceContext() const {
+  // Images are decoded into raster memory on the software backend.
+  if (IsSoftwareRenderer()) {
+    return nullptr;
+  }
   auto callback = dispatch_table_.gl_make_resource_current_callback;
   if (callback && callback()) {
     return IOManager::CreateCompatibleResourceLoadingContext(
@@ -63,4 +129,12 @@ sk_sp<GrContext> PlatformViewEmbedder::CreateResourceContext() const {
   return nullptr;
 }
 
+std::unique_ptr<VsyncWaiter> PlatformViewEmbedder::CreateVSyncWaiter() {
+  if (!dispatch_table_.vsync_callback) {
+    return PlatformView::CreateVSyncWaiter();
+  }
+  return std::make_unique<VsyncWaiterEmbedder>(dispatch_table_.vsync_callback,
+                                               task_runners_);
+}
+
 }  // namespace shell
@@ -0,0 +1,102 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "flutter/shell/platform/embedder/embedder_task_runner.h"
+#include "gtest/gtest.h"
+
+namespace shell {
+namespace {
+
+fxl::RefPtr<EmbedderTaskRunner> CreateTaskRunner(
+    std::vector<uint64_t>* batons) {
+  EmbedderTaskRunner::DispatchTable dispatch_table;
+  dispatch_table.post_task_callback = [batons](EmbedderTaskRunner*,
+                                               uint64_t baton,
+                                               fxl::TimePoint) {
+    batons->push_back(baton);
+  };
+  dispatch_table.runs_task_on_current_thread_callback = []() { return true; };
+  return fxl::MakeRefCounted<EmbedderTaskRunner>(std::move(dispatch_table));
+}
+
+TEST(EmbedderTaskRunner, RunsEachPostedTaskOnce) {
+  std::vector<uint64_t> batons;
+  auto runner = CreateTaskRunner(&batons);
+
+  size_t run_count = 0;
+  runner->PostTask([&run_count]() { run_count++; });
+  ASSERT_EQ(batons.size(), 1u);
+  ASSERT_EQ(run_count, 0u);
+
+  ASSERT_TRUE(runner->RunTask(batons[0]));
+  ASSERT_EQ(run_count, 1u);
+  ASSERT_FALSE(runner->RunTask(batons[0]));
+  ASSERT_FALSE(runner->RunTask(batons[0] + 1));
+  ASSERT_EQ(run_count, 1u);
+}
+
+TEST(EmbedderTaskRunner, DoesNotRunTasksOfOtherTaskRunners) {
+  std::vector<uint64_t> batons;
+  auto runner = CreateTaskRunner(&batons);
+  std::vector<uint64_t> other_batons;
+  auto other_runner = CreateTaskRunner(&other_batons);
+
+  // A task runner may be created at the address of a destroyed one. Stale
+  // tasks of the destroyed runner must not match its pending tasks.
+  bool ran = false;
+  runner->PostTask([&ran]() { ran = true; });
+  other_runner->PostTask([]() {});
+  ASSERT_NE(batons[0], other_batons[0]);
+  ASSERT_FALSE(runner->RunTask(other_batons[0]));
+  ASSERT_FALSE(ran);
+  ASSERT_TRUE(runner->RunTask(batons[0]));
+  ASSERT_TRUE(ran);
+}
+
+TEST(EmbedderTaskRunner, RunsTaskObserversOfTheCurrentThreadAfterEachTask) {
+  std::vector<uint64_t> batons;
+  auto runner = CreateTaskRunner(&batons);
+
+  std::vector<std::string> events;
+  runner->PostTask([&events]() { events.push_back("task"); });
+  runner->PostTask([&events]() { events.push_back("task"); });
+
+  const intptr_t key = 1;
+  EmbedderTaskRunner::AddTaskObserverForCurrentThread(
+      key, [&events]() { events.push_back("observer"); });
+
+  // Observers registered on other threads are not invoked.
+  std::thread([&events]() {
+    EmbedderTaskRunner::AddTaskObserverForCurrentThread(
+        key, [&events]() { events.push_back("other thread"); });
+  }).join();
+
+  ASSERT_TRUE(runner->RunTask(batons[0]));
+  ASSERT_EQ(events, std::vector<std::string>({"task", "observer"}));
+
+  EmbedderTaskRunner::RemoveTaskObserverForCurrentThread(key);
+  ASSERT_TRUE(runner->RunTask(batons[1]));
+  ASSERT_EQ(events, std::vector<std::string>({"task", "observer", "task"}));
+}
+
+TEST(EmbedderTaskRunner, OnlyRegisteredTaskRunnersAreFound) {
+  std::vector<uint64_t> batons;
+  auto runner = CreateTaskRunner(&batons);
+
+  ASSERT_FALSE(EmbedderTaskRunner::GetRegistered(runner.get()));
+
+  EmbedderTaskRunner::Register(runner.get());
+  ASSERT_EQ(EmbedderTaskRunner::GetRegistered(runner.get()), runner);
+  ASSERT_FALSE(EmbedderTaskRunner::GetRegistered(&batons));
+
+  EmbedderTaskRunner::Unregister(runner.get());
+  ASSERT_FALSE(EmbedderTaskRunner::GetRegistered(runner.get()));
+}
+
+}  // namespace
+}  // namespace shell
@@ -2,9 +2,323 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 #include "embedder.h"
+#include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/testing/testing.h"
+#include "lib/fxl/build_config.h"
+#include "lib/fxl/macros.h"
+
+#if OS_LINUX
+#include <dirent.h>
+#include <unistd.h>
+
+#include <fstream>
+#endif  // OS_LINUX
+
+namespace {
+
+// The renderer configuration and project arguments of an engine that runs a
+// fixture. Tests adjust them before running the engine.
+class EmbedderTestConfig {
+ public:
+  explicit EmbedderTestConfig(FlutterRendererType type,
+                              const std::string& fixture = "simple_main.dart")
+      : main_path_(std::string(testing::GetFixturesPath()) + "/" + fixture) {
+    renderer_config_.type = type;
+    switch (type) {
+      case FlutterRendererType::kOpenGL: {
+        FlutterOpenGLRendererConfig& open_gl = renderer_config_.open_gl;
+        open_gl.struct_size = sizeof(FlutterOpenGLRendererConfig);
+        open_gl.make_current = [](void*) { return false; };
+        open_gl.clear_current = [](void*) { return false; };
+        open_gl.present = [](void*) { return false; };
+        open_gl.fbo_callback = [](void*) -> uint32_t { return 0; };
+        open_gl.make_resource_current = [](void*) { return false; };
+        break;
+      }
+      case FlutterRendererType::kSoftware: {
+        FlutterSoftwareRendererConfig& software = renderer_config_.software;
+        software.struct_size = sizeof(FlutterSoftwareRendererConfig);
+        software.surface_present_callback =
+            [](void*, const void*, size_t, size_t) { return true; };
+        break;
+      }
+    }
+
+    project_args_.struct_size = sizeof(FlutterProjectArgs);
+    project_args_.assets_path = "";
+    project_args_.main_path = main_path_.c_str();
+    project_args_.packages_path = "";
+
+    custom_task_runners_.struct_size = sizeof(FlutterCustomTaskRunners);
+  }
+
+  FlutterRendererConfig& renderer_config() { return renderer_config_; }
+
+  FlutterProjectArgs& project_args() { return project_args_; }
+
+  // The engine copies the descriptions when it is run.
+  void SetPlatformTaskRunner(const FlutterTaskRunnerDescription* description) {
+    custom_task_runners_.platform_task_runner = description;
+    project_args_.custom_task_runners = &custom_task_runners_;
+  }
+
+  void SetUITaskRunner(const FlutterTaskRunnerDescription* description) {
+    custom_task_runners_.ui_task_runner = description;
+    project_args_.custom_task_runners = &custom_task_runners_;
+  }
+
+  FlutterResult Run(FlutterEngine* engine, void* user_data = nullptr) const {
+    return FlutterEngineRun(FLUTTER_ENGINE_VERSION, &renderer_config_,
+                            &project_args_, user_data, engine);
+  }
+
+  FlutterResult Spawn(FlutterEngine parent,
+                      FlutterEngine* engine,
+                      void* user_data = nullptr) const {
+    return FlutterEngineSpawn(parent, &renderer_config_, &project_args_,
+                              user_data, engine);
+  }
+
+ private:
+  const std::string main_path_;
+  FlutterRendererConfig renderer_config_ = {};
+  FlutterProjectArgs project_args_ = {};
+  FlutterCustomTaskRunners custom_task_runners_ = {};
+
+  FXL_DISALLOW_COPY_AND_ASSIGN(EmbedderTestConfig);
+};
+
+FlutterResult SendWindowMetrics(FlutterEngine engine,
+                                size_t width = 64,
+                                size_t height = 64) {
+  FlutterWindowMetricsEvent metrics = {};
+  metrics.struct_size = sizeof(FlutterWindowMetricsEvent);
+  metrics.width = width;
+  metrics.height = height;
+  metrics.pixel_ratio = 1.0;
+  return FlutterEngineSendWindowMetricsEvent(engine, &metrics);
+}
+
+// An event loop managed by the embedder. Tasks are run regardless of their
+// target time. A loop for the current thread runs them when
+// |RunPendingTasks| is called. A loop with a thread of its own runs them as
+// soon as they are posted.
+class TestEventLoop {
+ public:
+  enum class Thread { kCurrent, kOwn };
+
+  explicit TestEventLoop(Thread thread = Thread::kCurrent)
+      : thread_id_(std::this_thread::get_id()) {
+    if (thread == Thread::kOwn) {
+      thread_ = std::make_unique<std::thread>([this]() { Run(); });
+    }
+  }
+
+  ~TestEventLoop() {
+    if (!thread_) {
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      terminated_ = true;
+    }
+    condition_.notify_one();
+    thread_->join();
+  }
+
+  // The engine is not known until |FlutterEngineRun| returns. Until then,
+  // tasks are run without it.
+  void SetEngine(FlutterEngine engine) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    engine_ = engine;
+  }
+
+  size_t run_count() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return run_count_;
+  }
+
+  // Posted tasks are queued but not run while the loop is paused.
+  void SetPaused(bool paused) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      paused_ = paused;
+    }
+    condition_.notify_one();
+  }
+
+  std::vector<FlutterTask> GetQueuedTasks() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tasks_;
+  }
+
+  // Only for loops of the current thread.
+  void RunPendingTasks() {
+    ASSERT_FALSE(thread_);
+    std::unique_lock<std::mutex> lock(mutex_);
+    RunQueuedTasks(lock);
+  }
+
+  FlutterTaskRunnerDescription GetDescription() {
+    FlutterTaskRunnerDescription description = {};
+    description.struct_size = sizeof(FlutterTaskRunnerDescription);
+    description.user_data = this;
+    description.runs_task_on_current_thread_callback = [](void* user_data) {
+      return reinterpret_cast<TestEventLoop*>(user_data)
+          ->RunsTasksOnCurrentThread();
+    };
+    description.post_task_callback = [](FlutterTask task, uint64_t,
+                                        void* user_data) {
+      auto loop = reinterpret_cast<TestEventLoop*>(user_data);
+      {
+        std::lock_guard<std::mutex> lock(loop->mutex_);
+        loop->tasks_.push_back(task);
+      }
+      loop->condition_.notify_one();
+    };
+    return description;
+  }
+
+ private:
+  const std::thread::id thread_id_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::vector<FlutterTask> tasks_;
+  FlutterEngine engine_ = nullptr;
+  size_t run_count_ = 0;
+  bool paused_ = false;
+  bool terminated_ = false;
+  // Last, so that it is started once the other members are initialized.
+  std::unique_ptr<std::thread> thread_;
+
+  bool RunsTasksOnCurrentThread() const {
+    return (thread_ ? thread_->get_id() : thread_id_) ==
+           std::this_thread::get_id();
+  }
+
+  void Run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      condition_.wait(lock, [this]() {
+        return terminated_ || (!paused_ && !tasks_.empty());
+      });
+      if (terminated_) {
+        return;
+      }
+      RunQueuedTasks(lock);
+    }
+  }
+
+  // Runs the queued tasks without holding the lock, since tasks may post
+  // other tasks.
+  void RunQueuedTasks(std::unique_lock<std::mutex>& lock) {
+    std::vector<FlutterTask> pending;
+    pending.swap(tasks_);
+    FlutterEngine engine = engine_;
+    lock.unlock();
+    for (const FlutterTask& task : pending) {
+      EXPECT_EQ(FlutterEngineRunTask(engine, &task), FlutterResult::kSuccess);
+    }
+    lock.lock();
+    run_count_ += pending.size();
+  }
+
+  FXL_DISALLOW_COPY_AND_ASSIGN(TestEventLoop);
+};
+
+// Records the frames presented by the software renderer. Passed to the engine
+// as the user data of its callbacks.
+class SoftwareFrameRecorder {
+ public:
+  static constexpr uint32_t kGreen = 0xFF00FF00;
+
+  // Frames are rendered into |buffer| instead of memory of the engine.
+  void SupplyBuffer(EmbedderTestConfig& config) {
+    config.renderer_config().software.surface_buffer_callback =
+        [](void* user_data, size_t width, size_t height,
+           size_t* row_bytes) -> void* {
+      auto recorder = reinterpret_cast<SoftwareFrameRecorder*>(user_data);
+      std::lock_guard<std::mutex> lock(recorder->mutex_);
+      // Padded rows, as some embedders use.
+      *row_bytes = (width + 8) * sizeof(uint32_t);
+      recorder->buffer_.assign(*row_bytes / sizeof(uint32_t) * height, 0);
+      return recorder->buffer_.data();
+    };
+  }
+
+  void RecordFrames(EmbedderTestConfig& config) {
+    config.renderer_config().software.surface_present_callback =
+        [](void* user_data, const void* allocation, size_t row_bytes,
+           size_t height) {
+          auto recorder = reinterpret_cast<SoftwareFrameRecorder*>(user_data);
+          {
+            std::lock_guard<std::mutex> lock(recorder->mutex_);
+            recorder->allocation_ = allocation;
+            recorder->row_bytes_ = row_bytes;
+            recorder->height_ = height;
+            // The allocation is only valid during the call.
+            auto pixels = reinterpret_cast<const uint32_t*>(allocation);
+            recorder->pixels_.assign(
+                pixels, pixels + row_bytes / sizeof(uint32_t) * height);
+          }
+          recorder->presented_.Signal();
+          return true;
+        };
+  }
+
+  // Waits for a frame of the given height to be presented.
+  void WaitForFrame(size_t height) {
+    while (true) {
+      presented_.Wait();
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (height_ == height) {
+        return;
+      }
+    }
+  }
+
+  const void* buffer() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return buffer_.data();
+  }
+
+  const void* allocation() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return allocation_;
+  }
+
+  size_t row_bytes() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return row_bytes_;
+  }
+
+  // Returns zero for pixels outside the frame.
+  uint32_t GetPixel(size_t x, size_t y) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const size_t index = y * row_bytes_ / sizeof(uint32_t) + x;
+    return index < pixels_.size() ? pixels_[index] : 0;
+  }
+
+ private:
+  std::mutex mutex_;
+  fml::AutoResetWaitableEvent presented_;
+  std::vector<uint32_t> buffer_;
+  const void* allocation_ = nullptr;
+  size_t row_bytes_ = 0;
+  size_t height_ = 0;
+  std::vector<uint32_t> pixels_;
+};
+
+constexpr uint32_t SoftwareFrameRecorder::kGreen;
+
+}  // namespace
 
 TEST(EmbedderTest, MustNotRunWithInvalidArgs) {
   FlutterEngine engine = nullptr;
@@ -16,31 +330,285 @@ TEST(EmbedderTest, MustNotRunWithInvalidArgs) {
 }
 
 TEST(EmbedderTest, CanLaunchAndShutdownWithValidProjectArgs) {
-  FlutterOpenGLRendererConfig renderer = {};
-  renderer.struct_size = sizeof(FlutterOpenGLRendererConfig);
-  renderer.make_current = [](void*) { return false; };
-  renderer.clear_current = [](void*) { return false; };
-  renderer.present = [](void*) { return false; };
-  renderer.fbo_callback = [](void*) -> uint32_t { return 0; };
+  EmbedderTestConfig config(FlutterRendererType::kOpenGL);
 
-  std::string main =
-      std::string(testing::GetFixturesPath()) + "/simple_main.dart";
+  FlutterEngine engine = nullptr;
+  FlutterResult result = config.Run(&engine);
+  ASSERT_EQ(result, FlutterResult::kSuccess);
 
-  FlutterRendererConfig config = {};
-  config.type = FlutterRendererType::kOpenGL;
-  config.open_gl = renderer;
+  result = FlutterEngineShutdown(engine);
+  ASSERT_EQ(result, FlutterResult::kSuccess);
+}
 
-  FlutterProjectArgs args = {};
-  args.struct_size = sizeof(FlutterProjectArgs);
-  args.assets_path = "";
-  args.main_path = main.c_str();
-  args.packages_path = "";
+TEST(EmbedderTest, MustNotRunWithoutSoftwarePresentCallback) {
+  EmbedderTestConfig config(FlutterRendererType::kSoftware);
+  config.renderer_config().software.surface_present_callback = nullptr;
+
+  FlutterEngine engine = nullptr;
+  FlutterResult result = config.Run(&engine);
+  ASSERT_EQ(result, FlutterResult::kInvalidArguments);
+}
+
+TEST(EmbedderTest, CanRenderWithSoftwareRenderer) {
+  EmbedderTestConfig config(FlutterRendererType::kSoftware,
+                            "solid_rect_main.dart");
+  SoftwareFrameRecorder recorder;
+  recorder.RecordFrames(config);
+
+  FlutterEngine engine = nullptr;
+  FlutterResult result = config.Run(&engine, &recorder);
+  ASSERT_EQ(result, FlutterResult::kSuccess);
+
+  result = SendWindowMetrics(engine, 64, 32);
+  ASSERT_EQ(result, FlutterResult::kSuccess);
+  recorder.WaitForFrame(32);
+
+  // The frame is handed over in the memory of the engine.
+  ASSERT_NE(recorder.allocation(), nullptr);
+  ASSERT_GE(recorder.row_bytes(), 64 * sizeof(uint32_t));
+  ASSERT_EQ(recorder.GetPixel(0, 0), SoftwareFrameRecorder::kGreen);
+  ASSERT_EQ(recorder.GetPixel(63, 31), SoftwareFrameRecorder::kGreen);
+
+  result = FlutterEngineShutdown(engine);
+  ASSERT_EQ(result, FlutterResult::kSuccess);
+}
+
+TEST(EmbedderTest, CanRenderIntoEmbedderSuppliedBuffer) {
+  EmbedderTestConfig config(FlutterRendererType::kSoftware,
+                            "solid_rect_main.dart");
+  SoftwareFrameRecorder recorder;
+  recorder.SupplyBuffer(config);
+  recorder.RecordFrames(config);
+
+  FlutterEngine engine = nullptr;
+  FlutterResult result = config.Run(&engine, &recorder);
+  ASSERT_EQ(result, FlutterResult::kSuccess);
+
+  result = SendWindowMetrics(engine, 64, 32);
+  ASSERT_EQ(result, FlutterResult::kSuccess);
+  recorder.WaitForFrame(32);
+
+  // The frame is rendered into the buffer without a copy, with the row bytes
+  // the embedder asked for.
+  ASSERT_EQ(recorder.allocation(), recorder.buffer());
+  ASSERT_EQ(recorder.row_bytes(), (64 + 8) * sizeof(uint32_t));
+  ASSERT_EQ(recorder.GetPixel(0, 0), SoftwareFrameRecorder::kGreen);
+  ASSERT_EQ(recorder.GetPixel(63, 31), SoftwareFrameRecorder::kGreen);
+  // The padding is not drawn to.
+  ASSERT_EQ(recorder.GetPixel(64, 0), 0u);
+
+  result = FlutterEngineShutdown(engine);
+  ASSERT_EQ(result, FlutterResult::kSuccess);
+}
+
+TEST(EmbedderTest, MustNotRunWithInvalidCustomTaskRunner) {
+  EmbedderTestConfig config(FlutterRendererType::kOpenGL);
+
+  // The post task callback is missing.
+  FlutterTaskRunnerDescription ui_task_runner = {};
+  ui_task_runner.struct_size = sizeof(FlutterTaskRunnerDescription);
+  ui_task_runner.runs_task_on_current_thread_callback = [](void*) {
+    return false;
+  };
+  config.SetUITaskRunner(&ui_task_runner);
+
+  FlutterEngine engine = nullptr;
+  FlutterResult result = config.Run(&engine);
+  ASSERT_EQ(result, FlutterResult::kInvalidArguments);
+}
+
+TEST(EmbedderTest, CanLaunchAndShutdownWithCustomPlatformTaskRunner) {
+  EmbedderTestConfig config(FlutterRendererType::kSoftware);
+
+  TestEventLoop event_loop;
+  const FlutterTaskRunnerDescription platform_task_runner =
+      event_loop.GetDescription();
+  config.SetPlatformTaskRunner(&platform_task_runner);
+
+  FlutterEngine engine = nullptr;
+  FlutterResult result = config.Run(&engine);
+  ASSERT_EQ(result, FlutterResult::kSuccess);
+
+  event_loop.SetEngine(engine);
+  event_loop.RunPendingTasks();
+
+  result = FlutterEngineShutdown(engine);
+  ASSERT_EQ(result, FlutterResult::kSuccess);
+}
+
+TEST(EmbedderTest, CanLaunchAndShutdownWithCustomUITaskRunner) {
+  EmbedderTestConfig config(FlutterRendererType::kSoftware);
+
+  // The shell waits for the UI thread while it is created, so the UI tasks
+  // must be run by another thread than the one calling |FlutterEngineRun|.
+  TestEventLoop ui_event_loop(TestEventLoop::Thread::kOwn);
+  const FlutterTaskRunnerDescription ui_task_runner =
+      ui_event_loop.GetDescription();
+  config.SetUITaskRunner(&ui_task_runner);
+
+  FlutterEngine engine = nullptr;
+  FlutterResult result = config.Run(&engine);
+  ASSERT_EQ(result, FlutterResult::kSuccess);
+  ui_event_loop.SetEngine(engine);
+  ASSERT_GT(ui_event_loop.run_count(), 0u);
+
+  // Window metrics are applied by a task on the UI thread.
+  ui_event_loop.SetPaused(true);
+  result = SendWindowMetrics(engine);
+  ASSERT_EQ(result, FlutterResult::kSuccess);
+  const std::vector<FlutterTask> tasks = ui_event_loop.GetQueuedTasks();
+  ASSERT_FALSE(tasks.empty());
+  ui_event_loop.SetPaused(false);
+
+  result = FlutterEngineShutdown(engine);
+  ASSERT_EQ(result, FlutterResult::kSuccess);
+
+  // The task runner is released with the engine. Its tasks are rejected
+  // instead of run on a destroyed task runner.
+  ASSERT_EQ(FlutterEngineRunTask(nullptr, &tasks.front()),
+            FlutterResult::kInvalidArguments);
+}
+
+TEST(EmbedderTest, TasksAreOnlyRunWithTheirEngine) {
+  EmbedderTestConfig other_config(FlutterRendererType::kSoftware);
+
+  // An engine with task runners of its own.
+  FlutterEngine other_engine = nullptr;
+  FlutterResult result = other_config.Run(&other_engine);
+  ASSERT_EQ(result, FlutterResult::kSuccess);
+
+  EmbedderTestConfig config(FlutterRendererType::kSoftware);
+  TestEventLoop ui_event_loop(TestEventLoop::Thread::kOwn);
+  const FlutterTaskRunnerDescription ui_task_runner =
+      ui_event_loop.GetDescription();
+  config.SetUITaskRunner(&ui_task_runner);
 
   FlutterEngine engine = nullptr;
-  FlutterResult result = FlutterEngineRun(FLUTTER_ENGINE_VERSION, &config,
-                                          &args, nullptr, &engine);
+  result = config.Run(&engine);
   ASSERT_EQ(result, FlutterResult::kSuccess);
+  ui_event_loop.SetEngine(engine);
+
+  ui_event_loop.SetPaused(true);
+  result = SendWindowMetrics(engine);
+  ASSERT_EQ(result, FlutterResult::kSuccess);
+
+  // The tasks are still pending, but not for the other engine. The event loop
+  // runs them with their own engine once it resumes.
+  for (const FlutterTask& task : ui_event_loop.GetQueuedTasks()) {
+    ASSERT_EQ(FlutterEngineRunTask(other_engine, &task),
+              FlutterResult::kInvalidArguments);
+  }
+  ui_event_loop.SetPaused(false);
 
   result = FlutterEngineShutdown(engine);
   ASSERT_EQ(result, FlutterResult::kSuccess);
+  result = FlutterEngineShutdown(other_engine);
+  ASSERT_EQ(result, FlutterResult::kSuccess);
+}
+
+TEST(EmbedderTest, SpawningEngineMustOutliveSpawnedEngines) {
+  EmbedderTestConfig config(FlutterRendererType::kOpenGL);
+
+  FlutterEngine parent = nullptr;
+  FlutterResult result = config.Run(&parent);
+  ASSERT_EQ(result, FlutterResult::kSuccess);
+
+  FlutterEngine child = nullptr;
+  result = config.Spawn(parent, &child);
+  ASSERT_EQ(result, FlutterResult::kSuccess);
+  FlutterEngine grandchild = nullptr;
+  result = config.Spawn(child, &grandchild);
+  ASSERT_EQ(result, FlutterResult::kSuccess);
+
+  // The spawned engines use the resource context of the parent.
+  ASSERT_EQ(FlutterEngineShutdown(parent), FlutterResult::kInvalidArguments);
+  ASSERT_EQ(FlutterEngineShutdown(child), FlutterResult::kInvalidArguments);
+
+  // The engines that could not be shut down are still usable.
+  ASSERT_EQ(SendWindowMetrics(child), FlutterResult::kSuccess);
+
+  ASSERT_EQ(FlutterEngineShutdown(grandchild), FlutterResult::kSuccess);
+  ASSERT_EQ(FlutterEngineShutdown(child), FlutterResult::kSuccess);
+  ASSERT_EQ(FlutterEngineShutdown(parent), FlutterResult::kSuccess);
+}
+
+#if OS_LINUX
+
+namespace {
+
+// The number of threads created for engines. They are named after the
+// "io.flutter" prefix of their thread host. Threads of the Dart VM and of
+// thread pools start lazily and are not counted.
+size_t GetEngineThreadCount() {
+  size_t count = 0;
+  DIR* tasks = opendir("/proc/self/task");
+  if (tasks == nullptr) {
+    return 0;
+  }
+  while (struct dirent* entry = readdir(tasks)) {
+    if (entry->d_name[0] == '.') {
+      continue;
+    }
+    std::ifstream comm(std::string("/proc/self/task/") + entry->d_name +
+                       "/comm");
+    std::string name;
+    std::getline(comm, name);
+    if (name.compare(0, 11, "io.flutter.") == 0) {
+      count++;
+    }
+  }
+  closedir(tasks);
+  return count;
+}
+
+// In bytes.
+size_t GetResidentSetSize() {
+  std::ifstream statm("/proc/self/statm");
+  size_t total_pages = 0, resident_pages = 0;
+  statm >> total_pages >> resident_pages;
+  return resident_pages * sysconf(_SC_PAGESIZE);
+}
+
+}  // namespace
+
+TEST(EmbedderTest, SpawnedEnginesShareThreadsOfTheirParent) {
+  EmbedderTestConfig config(FlutterRendererType::kSoftware);
+
+  FlutterEngine parent = nullptr;
+  FlutterResult result = config.Run(&parent);
+  ASSERT_EQ(result, FlutterResult::kSuccess);
+
+  const size_t thread_count = GetEngineThreadCount();
+  ASSERT_GT(thread_count, 0u);
+  const size_t resident_set_size = GetResidentSetSize();
+
+  constexpr size_t kSpawnCount = 8;
+  std::vector<FlutterEngine> spawned;
+  for (size_t i = 0; i < kSpawnCount; i++) {
+    FlutterEngine engine = nullptr;
+    result = config.Spawn(parent, &engine);
+    ASSERT_EQ(result, FlutterResult::kSuccess);
+    spawned.push_back(engine);
+  }
+
+  ASSERT_EQ(GetEngineThreadCount(), thread_count);
+  const int64_t overhead = (static_cast<int64_t>(GetResidentSetSize()) -
+                            static_cast<int64_t>(resident_set_size)) /
+                           static_cast<int64_t>(kSpawnCount);
+  RecordProperty("resident_kb_per_spawned_engine",
+                 static_cast<int>(overhead / 1024));
+  // Mostly the root isolate of the engine. A spawned engine that creates its
+  // own VM, threads or resource context exceeds this.
+  constexpr int64_t kMaxSpawnedEngineOverhead = 16 << 20;
+  ASSERT_LT(overhead, kMaxSpawnedEngineOverhead);
+
+  for (FlutterEngine engine : spawned) {
+    result = FlutterEngineShutdown(engine);
+    ASSERT_EQ(result, FlutterResult::kSuccess);
+  }
+
+  result = FlutterEngineShutdown(parent);
+  ASSERT_EQ(result, FlutterResult::kSuccess);
 }
+
+#endif  // OS_LINUX
@@ -0,0 +1,78 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+
+#include "flutter/common/task_runners.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+#include "flutter/shell/platform/embedder/vsync_waiter_embedder.h"
+#include "flutter/testing/testing.h"
+
+namespace {
+
+// Frames are driven by a synthetic 120Hz clock that is unrelated to the
+// current time.
+constexpr int64_t kSyntheticEpochNanos = 1000000000;
+constexpr int64_t kFrameIntervalNanos = 8333333;
+
+fxl::TimePoint SyntheticVsyncTime(int frame) {
+  return fxl::TimePoint::FromEpochDelta(fxl::TimeDelta::FromNanoseconds(
+      kSyntheticEpochNanos + frame * kFrameIntervalNanos));
+}
+
+}  // namespace
+
+TEST(VsyncWaiterEmbedderTest, FiresCallbackWithEmbedderFrameTimes) {
+  fml::Thread thread;
+  auto task_runner = thread.GetTaskRunner();
+  blink::TaskRunners task_runners("test", task_runner, task_runner,
+                                  task_runner, task_runner);
+
+  intptr_t pending_baton = 0;
+  std::shared_ptr<shell::VsyncWaiter> waiter =
+      std::make_shared<shell::VsyncWaiterEmbedder>(
+          [&pending_baton](intptr_t baton) { pending_baton = baton; },
+          task_runners);
+
+  for (int frame = 0; frame < 3; frame++) {
+    fml::AutoResetWaitableEvent latch;
+    fxl::TimePoint fired_start_time, fired_target_time;
+    waiter->AsyncWaitForVsync([&](fxl::TimePoint frame_start_time,
+                                  fxl::TimePoint frame_target_time) {
+      fired_start_time = frame_start_time;
+      fired_target_time = frame_target_time;
+      latch.Signal();
+    });
+    ASSERT_NE(pending_baton, 0);
+
+    ASSERT_TRUE(shell::VsyncWaiterEmbedder::OnEmbedderVsync(
+        pending_baton, SyntheticVsyncTime(frame),
+        SyntheticVsyncTime(frame + 1)));
+    pending_baton = 0;
+    latch.Wait();
+
+    ASSERT_EQ(fired_start_time, SyntheticVsyncTime(frame));
+    ASSERT_EQ(fired_target_time, SyntheticVsyncTime(frame + 1));
+  }
+}
+
+TEST(VsyncWaiterEmbedderTest, BatonOutlivingTheWaiterIsIgnored) {
+  fml::Thread thread;
+  auto task_runner = thread.GetTaskRunner();
+  blink::TaskRunners task_runners("test", task_runner, task_runner,
+                                  task_runner, task_runner);
+
+  intptr_t pending_baton = 0;
+  std::shared_ptr<shell::VsyncWaiter> waiter =
+      std::make_shared<shell::VsyncWaiterEmbedder>(
+          [&pending_baton](intptr_t baton) { pending_baton = baton; },
+          task_runners);
+  waiter->AsyncWaitForVsync([](fxl::TimePoint, fxl::TimePoint) {});
+  ASSERT_NE(pending_baton, 0);
+
+  waiter.reset();
+  ASSERT_FALSE(shell::VsyncWaiterEmbedder::OnEmbedderVsync(
+      pending_baton, SyntheticVsyncTime(0), SyntheticVsyncTime(1)));
+}
@@ -0,0 +1,47 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/vsync_waiter_embedder.h"
+
+#include "lib/fxl/logging.h"
+
+namespace shell {
+
+VsyncWaiterEmbedder::VsyncWaiterEmbedder(VsyncCallback vsync_callback,
+                                         blink::TaskRunners task_runners)
+    : VsyncWaiter(std::move(task_runners)),
+      vsync_callback_(std::move(vsync_callback)) {
+  FXL_DCHECK(vsync_callback_);
+}
+
+VsyncWaiterEmbedder::~VsyncWaiterEmbedder() = default;
+
+// |shell::VsyncWaiter|
+void VsyncWaiterEmbedder::AwaitVSync() {
+  // Same as the Android waiter. The baton keeps the waiter alive only as long
+  // as the animator does.
+  auto* weak_waiter = new std::weak_ptr<VsyncWaiter>(shared_from_this());
+  vsync_callback_(reinterpret_cast<intptr_t>(weak_waiter));
+}
+
+bool VsyncWaiterEmbedder::OnEmbedderVsync(intptr_t baton,
+                                          fxl::TimePoint frame_start_time,
+                                          fxl::TimePoint frame_target_time) {
+  if (baton == 0) {
+    return false;
+  }
+
+  auto* weak_waiter = reinterpret_cast<std::weak_ptr<VsyncWaiter>*>(baton);
+  auto strong_waiter = weak_waiter->lock();
+  delete weak_waiter;
+
+  if (!strong_waiter) {
+    return false;
+  }
+
+  strong_waiter->FireCallback(frame_start_time, frame_target_time);
+  return true;
+}
+
+}  // namespace shell
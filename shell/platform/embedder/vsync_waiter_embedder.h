@@ -0,0 +1,43 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_VSYNC_WAITER_EMBEDDER_H_
+#define FLUTTER_SHELL_PLATFORM_EMBEDDER_VSYNC_WAITER_EMBEDDER_H_
+
+#include <functional>
+
+#include "flutter/shell/common/vsync_waiter.h"
+#include "lib/fxl/macros.h"
+
+namespace shell {
+
+// Waits for the vsync pulses of the display the embedder presents to instead
+// of the timer of |VsyncWaiterFallback|.
+class VsyncWaiterEmbedder final : public VsyncWaiter {
+ public:
+  // Invoked with a baton that the embedder must hand back to |OnEmbedderVsync|
+  // exactly once, when the next vsync pulse occurs.
+  using VsyncCallback = std::function<void(intptr_t)>;
+
+  VsyncWaiterEmbedder(VsyncCallback callback, blink::TaskRunners task_runners);
+
+  ~VsyncWaiterEmbedder() override;
+
+  // Consumes the baton. Returns false if the baton is invalid.
+  static bool OnEmbedderVsync(intptr_t baton,
+                              fxl::TimePoint frame_start_time,
+                              fxl::TimePoint frame_target_time);
+
+ private:
+  const VsyncCallback vsync_callback_;
+
+  // |shell::VsyncWaiter|
+  void AwaitVSync() override;
+
+  FXL_DISALLOW_COPY_AND_ASSIGN(VsyncWaiterEmbedder);
+};
+
+}  // namespace shell
+
+#endif  // FLUTTER_SHELL_PLATFORM_EMBEDDER_VSYNC_WAITER_EMBEDDER_H_
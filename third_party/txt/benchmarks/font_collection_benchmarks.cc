@@ -0,0 +1,76 @@
+/*
+ * Copyright 2018 Google, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "third_party/benchmark/include/benchmark/benchmark_api.h"
+
+#include "flutter/third_party/txt/tests/txt_test_utils.h"
+#include "lib/fxl/logging.h"
+#include "minikin/FontCollection.h"
+#include "third_party/icu/source/common/unicode/unistr.h"
+#include "txt/font_collection.h"
+
+namespace txt {
+
+static void ItemizeText(benchmark::State& state, const char* text) {
+  auto icu_text = icu::UnicodeString::fromUTF8(text);
+  std::u16string u16_text(icu_text.getBuffer(),
+                          icu_text.getBuffer() + icu_text.length());
+
+  std::shared_ptr<minikin::FontCollection> collection =
+      GetTestFontCollection()->GetMinikinFontCollectionForFamily("Roboto",
+                                                                 "en-US");
+  FXL_CHECK(collection);
+
+  minikin::FontStyle style;
+  std::vector<minikin::FontCollection::Run> runs;
+  while (state.KeepRunning()) {
+    runs.clear();
+    collection->itemize(reinterpret_cast<const uint16_t*>(u16_text.data()),
+                        u16_text.size(), style, &runs);
+  }
+  state.SetItemsProcessed(state.iterations() * u16_text.size());
+}
+
+static void BM_FontCollectionItemizeLatin(benchmark::State& state) {
+  ItemizeText(
+      state,
+      "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod "
+      "tempor incididunt ut labore et dolore magna aliqua. Ut enim ad minim "
+      "veniam, quis nostrud exercitation ullamco laboris nisi ut aliquip ex ea "
+      "commodo consequat. Duis aute irure dolor in reprehenderit in voluptate "
+      "velit esse cillum dolore eu fugiat nulla pariatur. Excepteur sint "
+      "occaecat cupidatat non proident, sunt in culpa qui officia deserunt "
+      "mollit anim id est laborum.");
+}
+BENCHMARK(BM_FontCollectionItemizeLatin);
+
+static void BM_FontCollectionItemizeLatin1(benchmark::State& state) {
+  ItemizeText(state,
+              "Über den Wolken muß die Freiheit wohl grenzenlos sein. Ça "
+              "ne fait rien, señor, déjà vu à la crème brûlée. Ångström, "
+              "smørrebrød og æbleskiver på færøsk. Ísland, Þórsmörk, Ðóra.");
+}
+BENCHMARK(BM_FontCollectionItemizeLatin1);
+
+static void BM_FontCollectionItemizeMixedScripts(benchmark::State& state) {
+  ItemizeText(state,
+              "Hello world, 你好世界 and привет мир. Γειά σου κόσμε, "
+              "مرحبا بالعالم and नमस्ते दुनिया. こんにちは世界 or "
+              "안녕하세요 세계, back to Latin text for the rest of it.");
+}
+BENCHMARK(BM_FontCollectionItemizeMixedScripts);
+
+}  // namespace txt
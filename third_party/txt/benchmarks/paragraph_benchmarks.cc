@@ -25,11 +25,13 @@
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkColor.h"
+#include "third_party/skia/include/core/SkFontMgr.h"
 #include "txt/font_collection.h"
 #include "txt/font_skia.h"
 #include "txt/font_style.h"
 #include "txt/font_weight.h"
 #include "txt/paragraph.h"
+#include "txt/paragraph_batch.h"
 #include "txt/paragraph_builder.h"
 
 namespace txt {
@@ -228,6 +230,188 @@ BENCHMARK(BM_ParagraphStylesBigO)
     ->Range(1 << 3, 1 << 12)
     ->Complexity(benchmark::oN);
 
+static const std::u16string kHitTestLine =
+    u"Each line has a few words to hit test.\n";
+
+// Lays out a paragraph of |line_count| lines for hit testing.
+static std::unique_ptr<Paragraph> BuildLinesParagraph(size_t line_count) {
+  std::u16string u16_text;
+  for (size_t i = 0; i < line_count; ++i) {
+    u16_text += kHitTestLine;
+  }
+
+  txt::ParagraphStyle paragraph_style;
+
+  txt::TextStyle text_style;
+  text_style.font_family = "Roboto";
+  text_style.color = SK_ColorBLACK;
+
+  txt::ParagraphBuilder builder(paragraph_style, GetTestFontCollection());
+
+  builder.PushStyle(text_style);
+  builder.AddText(u16_text);
+  builder.Pop();
+  auto paragraph = builder.Build();
+  paragraph->Layout(1000, true);
+  return paragraph;
+}
+
+static void BM_ParagraphGetGlyphPositionAtCoordinateBigO(
+    benchmark::State& state) {
+  auto paragraph = BuildLinesParagraph(state.range(0));
+  const double dy = paragraph->GetHeight() * 0.75;
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(
+        paragraph->GetGlyphPositionAtCoordinate(120, dy));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_ParagraphGetGlyphPositionAtCoordinateBigO)
+    ->RangeMultiplier(4)
+    ->Range(1 << 4, 10000)
+    ->Complexity(benchmark::oLogN);
+
+static void BM_ParagraphGetRectsForRangeBigO(benchmark::State& state) {
+  auto paragraph = BuildLinesParagraph(state.range(0));
+  // A selection of a few words within a line three quarters of the way down.
+  const size_t start = (state.range(0) * 3 / 4) * kHitTestLine.size() + 5;
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(paragraph->GetRectsForRange(start, start + 12));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_ParagraphGetRectsForRangeBigO)
+    ->RangeMultiplier(4)
+    ->Range(1 << 4, 10000)
+    ->Complexity(benchmark::oLogN);
+
+// The items of a list, such as the rows of a settings page.
+static std::vector<std::unique_ptr<Paragraph>> BuildListParagraphs(
+    size_t count) {
+  txt::ParagraphStyle paragraph_style;
+
+  txt::TextStyle title_style;
+  title_style.font_family = "Roboto";
+  title_style.font_size = 16;
+  title_style.color = SK_ColorBLACK;
+
+  txt::TextStyle subtitle_style = title_style;
+  subtitle_style.font_size = 14;
+  subtitle_style.font_weight = txt::FontWeight::w300;
+
+  auto font_collection = GetTestFontCollection();
+  std::vector<std::unique_ptr<Paragraph>> paragraphs;
+  for (size_t i = 0; i < count; ++i) {
+    txt::ParagraphBuilder builder(paragraph_style, font_collection);
+    builder.PushStyle(title_style);
+    builder.AddText(u"List item " +
+                    std::u16string(1, static_cast<char16_t>(u'A' + i % 26)));
+    builder.Pop();
+    builder.PushStyle(subtitle_style);
+    builder.AddText(u"\nA secondary line of text describing the item.");
+    builder.Pop();
+    paragraphs.push_back(builder.Build());
+  }
+  return paragraphs;
+}
+
+static void BM_ParagraphListLayout(benchmark::State& state) {
+  auto paragraphs = BuildListParagraphs(state.range(0));
+  while (state.KeepRunning()) {
+    for (auto& paragraph : paragraphs) {
+      paragraph->SetDirty();
+      paragraph->Layout(300);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * paragraphs.size());
+}
+BENCHMARK(BM_ParagraphListLayout)->Arg(50);
+
+static void BM_ParagraphBatchLayout(benchmark::State& state) {
+  auto paragraphs = BuildListParagraphs(state.range(0));
+  ParagraphBatch batch;
+  while (state.KeepRunning()) {
+    for (auto& paragraph : paragraphs) {
+      paragraph->SetDirty();
+      batch.AddParagraph(paragraph.get(), 300);
+    }
+    batch.Layout();
+  }
+  state.SetItemsProcessed(state.iterations() * paragraphs.size());
+}
+BENCHMARK(BM_ParagraphBatchLayout)->Arg(50);
+
+// Chat messages in several scripts. The characters that are missing from
+// Roboto are found in the fonts of the system.
+static const char* kMultilingualMessages[] = {
+    "Hello! Are we still meeting tomorrow?",
+    "もちろん、明日の午後に会いましょう。",
+    "좋아요, 내일 봐요!",
+    "отлично, до завтра",
+    "ممتاز، أراك غداً",
+    "ठीक है, कल मिलते हैं",
+    "แล้วเจอกันพรุ่งนี้",
+    "מעולה, נתראה מחר",
+    "好的，明天见！ Sounds good καλό",
+};
+
+static std::shared_ptr<FontCollection> GetMultilingualFontCollection() {
+  std::shared_ptr<FontCollection> collection = GetTestFontCollection();
+  collection->SetDefaultFontManager(SkFontMgr::RefDefault());
+  return collection;
+}
+
+static std::unique_ptr<Paragraph> BuildMultilingualParagraph(
+    std::shared_ptr<FontCollection> font_collection,
+    const char* message) {
+  auto icu_text = icu::UnicodeString::fromUTF8(message);
+  std::u16string u16_text(icu_text.getBuffer(),
+                          icu_text.getBuffer() + icu_text.length());
+
+  txt::ParagraphStyle paragraph_style;
+
+  txt::TextStyle text_style;
+  text_style.font_family = "Roboto";
+  text_style.color = SK_ColorBLACK;
+
+  txt::ParagraphBuilder builder(paragraph_style, std::move(font_collection));
+  builder.PushStyle(text_style);
+  builder.AddText(u16_text);
+  builder.Pop();
+  return builder.Build();
+}
+
+// Lays out a conversation once all the fallback fonts it needs are known.
+static void BM_ParagraphMultilingualLayout(benchmark::State& state) {
+  auto font_collection = GetMultilingualFontCollection();
+  std::vector<std::unique_ptr<Paragraph>> paragraphs;
+  for (const char* message : kMultilingualMessages) {
+    paragraphs.push_back(BuildMultilingualParagraph(font_collection, message));
+  }
+  while (state.KeepRunning()) {
+    for (auto& paragraph : paragraphs) {
+      paragraph->SetDirty();
+      paragraph->Layout(300, true);
+    }
+  }
+}
+BENCHMARK(BM_ParagraphMultilingualLayout);
+
+// Lays out a conversation with a new font collection, so every message
+// introduces a script the collection has not seen before.
+static void BM_ParagraphMultilingualColdLayout(benchmark::State& state) {
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    auto font_collection = GetMultilingualFontCollection();
+    state.ResumeTiming();
+    for (const char* message : kMultilingualMessages) {
+      auto paragraph = BuildMultilingualParagraph(font_collection, message);
+      paragraph->Layout(300, true);
+    }
+  }
+}
+BENCHMARK(BM_ParagraphMultilingualColdLayout);
+
 static void BM_ParagraphPaintSimple(benchmark::State& state) {
   const char* text = "Hello world! This is a simple sentence to test drawing.";
   auto icu_text = icu::UnicodeString::fromUTF8(text);
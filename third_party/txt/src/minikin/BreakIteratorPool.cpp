@@ -0,0 +1,86 @@
+/*
+ * Copyright 2018 Google, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <minikin/BreakIteratorPool.h>
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace minikin {
+
+namespace {
+
+typedef std::pair<BreakIteratorPool::Type, std::string> PoolKey;
+
+struct Pool {
+  std::mutex mutex;
+  std::map<PoolKey, std::vector<std::unique_ptr<icu::BreakIterator>>>
+      idleIterators;
+};
+
+Pool& getPool() {
+  static Pool* pool = new Pool();
+  return *pool;
+}
+
+}  // namespace
+
+std::unique_ptr<icu::BreakIterator> BreakIteratorPool::acquire(
+    Type type,
+    const icu::Locale& locale) {
+  {
+    Pool& pool = getPool();
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    auto found = pool.idleIterators.find(PoolKey(type, locale.getName()));
+    if (found != pool.idleIterators.end() && !found->second.empty()) {
+      std::unique_ptr<icu::BreakIterator> iterator =
+          std::move(found->second.back());
+      found->second.pop_back();
+      return iterator;
+    }
+  }
+
+  // Create new iterators outside of the lock since it is slow.
+  UErrorCode status = U_ZERO_ERROR;
+  std::unique_ptr<icu::BreakIterator> iterator(
+      type == kType_Line
+          ? icu::BreakIterator::createLineInstance(locale, status)
+          : icu::BreakIterator::createWordInstance(locale, status));
+  if (!U_SUCCESS(status)) {
+    return nullptr;
+  }
+  return iterator;
+}
+
+void BreakIteratorPool::release(Type type,
+                                const icu::Locale& locale,
+                                std::unique_ptr<icu::BreakIterator> iterator) {
+  if (!iterator) {
+    return;
+  }
+  Pool& pool = getPool();
+  std::lock_guard<std::mutex> lock(pool.mutex);
+  std::vector<std::unique_ptr<icu::BreakIterator>>& idleIterators =
+      pool.idleIterators[PoolKey(type, locale.getName())];
+  if (idleIterators.size() < kMaxIdleIterators) {
+    idleIterators.push_back(std::move(iterator));
+  }
+}
+
+}  // namespace minikin
@@ -0,0 +1,56 @@
+/*
+ * Copyright 2018 Google, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINIKIN_BREAK_ITERATOR_POOL_H
+#define MINIKIN_BREAK_ITERATOR_POOL_H
+
+#include <memory>
+
+#include "unicode/brkiter.h"
+#include "unicode/locid.h"
+
+namespace minikin {
+
+// libtxt: a process wide pool of ICU break iterators. Creating a break
+// iterator loads and compiles the break rules of its locale, which costs far
+// more than pointing an existing iterator at new text. Iterators acquired from
+// the pool are owned by the caller until they are released back to it.
+class BreakIteratorPool {
+ public:
+  enum Type {
+    kType_Line = 0,
+    kType_Word = 1,
+  };
+
+  // Returns an iterator of |type| for |locale|. The text of the iterator must
+  // be set before it is used. Returns nullptr if ICU could not create one.
+  static std::unique_ptr<icu::BreakIterator> acquire(
+      Type type,
+      const icu::Locale& locale);
+
+  // Returns |iterator| to the pool. |type| and |locale| must be the ones it
+  // was acquired with. The iterator is deleted if the pool is full.
+  static void release(Type type,
+                      const icu::Locale& locale,
+                      std::unique_ptr<icu::BreakIterator> iterator);
+
+  // The number of idle iterators the pool keeps for each type and locale.
+  static const size_t kMaxIdleIterators = 4;
+};
+
+}  // namespace minikin
+
+#endif  // MINIKIN_BREAK_ITERATOR_POOL_H
@@ -19,6 +19,13 @@
 #define LOG_TAG "Minikin"
 
 #include <algorithm>
+#include <iterator>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
 
 #include <log/log.h>
 #include "unicode/unistr.h"
@@ -94,6 +101,17 @@ void FontCollection::init(
                       "Font collection must have at least one valid typeface");
   LOG_ALWAYS_FATAL_IF(nTypefaces > 254,
                       "Font collection may only have up to 254 font families.");
+
+  // libtxt: cache the Latin-1 coverage of the first family for itemize.
+  const SparseBitSet& firstCoverage = mFamilies[0]->getCoverage();
+  std::fill(std::begin(mFirstFamilyLatin1Coverage),
+            std::end(mFirstFamilyLatin1Coverage), 0);
+  for (uint32_t ch = 0; ch < kLatin1CharCount; ch++) {
+    if (firstCoverage.get(ch)) {
+      mFirstFamilyLatin1Coverage[ch >> 5] |= 1u << (ch & 31);
+    }
+  }
+
   size_t nPages = (mMaxChar + kPageMask) >> kLogCharsPerPage;
   // TODO: Use variation selector map for mRanges construction.
   // A font can have a glyph for a base code point and variation selector pair
@@ -433,6 +451,59 @@ bool FontCollection::hasVariationSelector(uint32_t baseCodepoint,
   return false;
 }
 
+// libtxt: the number of UTF-16 code units checked at a time for code points
+// outside Latin-1.
+static const size_t kLatin1BlockSize = 8;
+
+// libtxt: returns the number of Latin-1 code units at the start of a block of
+// up to kLatin1BlockSize code units.
+static size_t countLatin1BlockChars(const uint16_t* units, size_t size) {
+#if defined(__SSE2__)
+  if (size >= kLatin1BlockSize) {
+    const __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(units));
+    const __m128i highBytes =
+        _mm_and_si128(block, _mm_set1_epi16(static_cast<int16_t>(0xFF00)));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi16(highBytes, _mm_setzero_si128())) ==
+        0xFFFF) {
+      return kLatin1BlockSize;
+    }
+  }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+  if (size >= kLatin1BlockSize) {
+    const uint64x2_t highBytes =
+        vreinterpretq_u64_u16(vshrq_n_u16(vld1q_u16(units), 8));
+    if ((vgetq_lane_u64(highBytes, 0) | vgetq_lane_u64(highBytes, 1)) == 0) {
+      return kLatin1BlockSize;
+    }
+  }
+#endif
+  size_t count = 0;
+  while (count < size && count < kLatin1BlockSize && units[count] < 0x100) {
+    count++;
+  }
+  return count;
+}
+
+size_t FontCollection::countFirstFamilyLatin1Chars(const uint16_t* string,
+                                                   size_t string_size) const {
+  size_t count = 0;
+  while (count < string_size) {
+    const size_t blockSize =
+        countLatin1BlockChars(string + count, string_size - count);
+    for (size_t i = 0; i < blockSize; i++, count++) {
+      const uint16_t ch = string[count];
+      if ((mFirstFamilyLatin1Coverage[ch >> 5] & (1u << (ch & 31))) == 0) {
+        return count;
+      }
+    }
+    if (blockSize < kLatin1BlockSize) {
+      break;
+    }
+  }
+  return count;
+}
+
 void FontCollection::itemize(const uint16_t* string,
                              size_t string_size,
                              FontStyle style,
@@ -507,6 +578,23 @@ void FontCollection::itemize(const uint16_t* string,
     }
     prevCh = ch;
     run->end = nextUtf16Pos;  // exclusive
+
+    // libtxt: the first family wins for every character it covers, so
+    // characters it covers extend its run without being scored. The last of
+    // them is left to the loop since it may be followed by a variation
+    // selector or a combining mark.
+    if (mLatin1FastPathEnabled && lastFamily == mFamilies[0].get() &&
+        nextCh != kEndOfString) {
+      const size_t count = countFirstFamilyLatin1Chars(
+          string + nextUtf16Pos, string_size - nextUtf16Pos);
+      if (count > 1) {
+        nextUtf16Pos += count - 1;
+        prevCh = string[nextUtf16Pos - 1];
+        run->end = nextUtf16Pos;
+        readLength = nextUtf16Pos;
+        U16_NEXT(string, readLength, string_size, nextCh);
+      }
+    }
   } while (nextCh != kEndOfString);
 }
 
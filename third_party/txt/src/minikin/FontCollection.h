@@ -53,6 +53,13 @@ class FontCollection {
                FontStyle style,
                std::vector<Run>* result) const;
 
+  // libtxt: whether itemize skips over Latin-1 code points covered by the
+  // first family instead of scoring the families for each of them. Only
+  // disabled by tests that compare the result with that of the regular path.
+  void setLatin1FastPathEnabled(bool enabled) {
+    mLatin1FastPathEnabled = enabled;
+  }
+
   // Returns true if there is a glyph for the code point and variation selector
   // pair. Returns false if no fonts have a glyph for the code point and
   // variation selector pair, or invalid variation selector is passed.
@@ -81,6 +88,10 @@ class FontCollection {
   static const int kLogCharsPerPage = 8;
   static const int kPageMask = (1 << kLogCharsPerPage) - 1;
 
+  // libtxt: the number of code points at the start of Unicode whose coverage
+  // by the first family is cached in mFirstFamilyLatin1Coverage.
+  static const uint32_t kLatin1CharCount = 0x100;
+
   // mFamilyVec holds the indices of the mFamilies and mRanges holds the range
   // of indices of mFamilyVec. The maximum number of pages is 0x10FF (U+10FFFF
   // >> 8). The maximum number of the fonts is 0xFF. Thus, technically the
@@ -95,6 +106,12 @@ class FontCollection {
   // Initialize the FontCollection.
   void init(const std::vector<std::shared_ptr<FontFamily>>& typefaces);
 
+  // libtxt: returns the number of UTF-16 code units at the start of |string|
+  // that are Latin-1 code points covered by the first family. Itemization
+  // assigns all of them to the first family.
+  size_t countFirstFamilyLatin1Chars(const uint16_t* string,
+                                     size_t string_size) const;
+
   const std::shared_ptr<FontFamily>& getFamilyForChar(uint32_t ch,
                                                       uint32_t vs,
                                                       uint32_t langListId,
@@ -139,6 +156,12 @@ class FontCollection {
   std::vector<Range> mRanges;
   std::vector<uint8_t> mFamilyVec;
 
+  // libtxt: a bit for each Latin-1 code point that the first family covers.
+  // The first family always wins for the code points it covers, so runs of
+  // these code points are itemized without scoring the families.
+  uint32_t mFirstFamilyLatin1Coverage[kLatin1CharCount / 32];
+  bool mLatin1FastPathEnabled = true;
+
   // This vector has pointers to the font family instances which have cmap 14
   // subtables.
   std::vector<std::shared_ptr<FontFamily>> mVSFamilyVec;
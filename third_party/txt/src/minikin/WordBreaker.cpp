@@ -18,6 +18,7 @@
 
 #include <log/log.h>
 
+#include <minikin/BreakIteratorPool.h>
 #include <minikin/Emoji.h>
 #include <minikin/Hyphenator.h>
 #include <minikin/WordBreaker.h>
@@ -31,9 +32,22 @@ namespace minikin {
 const uint32_t CHAR_SOFT_HYPHEN = 0x00AD;
 const uint32_t CHAR_ZWJ = 0x200D;
 
+WordBreaker::~WordBreaker() {
+  finish();
+  BreakIteratorPool::release(BreakIteratorPool::kType_Line, mLocale,
+                             std::move(mBreakIterator));
+}
+
 void WordBreaker::setLocale(const icu::Locale& locale) {
+  // libtxt: reuse the iterators of previous word breakers.
+  if (!mBreakIterator || locale != mLocale) {
+    BreakIteratorPool::release(BreakIteratorPool::kType_Line, mLocale,
+                               std::move(mBreakIterator));
+    mLocale = locale;
+    mBreakIterator =
+        BreakIteratorPool::acquire(BreakIteratorPool::kType_Line, locale);
+  }
   UErrorCode status = U_ZERO_ERROR;
-  mBreakIterator.reset(icu::BreakIterator::createLineInstance(locale, status));
   // TODO: handle failure status
   if (mText != nullptr) {
     mBreakIterator->setText(&mUText, status);
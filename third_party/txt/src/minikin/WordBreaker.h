@@ -25,13 +25,14 @@
 
 #include <memory>
 #include "unicode/brkiter.h"
+#include "unicode/locid.h"
 #include "utils/WindowsUtils.h"
 
 namespace minikin {
 
 class WordBreaker {
  public:
-  ~WordBreaker() { finish(); }
+  ~WordBreaker();
 
   void setLocale(const icu::Locale& locale);
 
@@ -59,7 +60,9 @@ class WordBreaker {
   void detectEmailOrUrl();
   ssize_t findNextBreakInEmailOrUrl();
 
+  // libtxt: acquired from BreakIteratorPool for mLocale.
   std::unique_ptr<icu::BreakIterator> mBreakIterator;
+  icu::Locale mLocale;
   UText mUText = UTEXT_INITIALIZER;
   const uint16_t* mText = nullptr;
   size_t mTextSize;
@@ -16,6 +16,8 @@
 
 #include "font_collection.h"
 
+#include <algorithm>
+#include <fstream>
 #include <list>
 #include <memory>
 #include <mutex>
@@ -78,14 +80,17 @@ size_t FontCollection::GetFontManagersCount() const {
 
 void FontCollection::SetDefaultFontManager(sk_sp<SkFontMgr> font_manager) {
   default_font_manager_ = font_manager;
+  unmatched_characters_for_locale_.clear();
 }
 
 void FontCollection::SetAssetFontManager(sk_sp<SkFontMgr> font_manager) {
   asset_font_manager_ = font_manager;
+  unmatched_characters_for_locale_.clear();
 }
 
 void FontCollection::SetTestFontManager(sk_sp<SkFontMgr> font_manager) {
   test_font_manager_ = font_manager;
+  unmatched_characters_for_locale_.clear();
 }
 
 // Return the available font managers in the order they should be queried.
@@ -104,15 +109,58 @@ void FontCollection::DisableFontFallback() {
   enable_font_fallback_ = false;
 }
 
+void FontCollection::SetFallbackFontCachePath(
+    std::string path,
+    FileTaskRunner file_task_runner) {
+  // Each line of the file is a locale and the name of a family resolved for it,
+  // separated by a tab.
+  std::ifstream file(path);
+  std::string line;
+  while (std::getline(file, line)) {
+    const size_t separator = line.find('\t');
+    if (separator == std::string::npos) {
+      continue;
+    }
+    std::string locale = line.substr(0, separator);
+    std::string family_name = line.substr(separator + 1);
+    std::vector<std::string>& family_names =
+        persisted_fallback_fonts_for_locale_[locale];
+    if (!family_name.empty() &&
+        fallback_fonts_for_locale_[locale].count(family_name) == 0 &&
+        std::find(family_names.begin(), family_names.end(), family_name) ==
+            family_names.end()) {
+      family_names.push_back(std::move(family_name));
+    }
+  }
+
+  fallback_font_cache_path_ = std::move(path);
+  fallback_font_cache_task_runner_ = std::move(file_task_runner);
+}
+
 std::shared_ptr<minikin::FontCollection>
 FontCollection::GetMinikinFontCollectionForFamily(
     const std::string& font_family,
     const std::string& locale) {
   // Look inside the font collections cache first.
   FamilyKey family_key(font_family, locale);
+  const size_t fallback_family_count = GetFallbackFamilyCount(locale);
   auto cached = font_collections_cache_.find(family_key);
   if (cached != font_collections_cache_.end()) {
-    return cached->second;
+    CachedCollection& entry = cached->second;
+    if (!entry.family) {
+      entry.collection =
+          GetMinikinFontCollectionForFamily(GetDefaultFontFamily(), "");
+      return entry.collection;
+    }
+    if (entry.fallback_family_count != fallback_family_count) {
+      // The locale gained fallback families since the collection was created.
+      // Recreate it with them so that layout does not go through the fallback
+      // font provider for every run of their scripts. The families are reused,
+      // and the collections of other locales are not affected.
+      entry.collection = CreateMinikinFontCollection(entry.family, locale);
+      entry.fallback_family_count = fallback_family_count;
+    }
+    return entry.collection;
   }
 
   for (sk_sp<SkFontMgr>& manager : GetFontManagerOrder()) {
@@ -121,25 +169,12 @@ FontCollection::GetMinikinFontCollectionForFamily(
     if (!minikin_family)
       continue;
 
-    // Create a vector of font families for the Minikin font collection.
-    std::vector<std::shared_ptr<minikin::FontFamily>> minikin_families = {
-        minikin_family,
-    };
-    if (enable_font_fallback_) {
-      for (std::string fallback_family : fallback_fonts_for_locale_[locale])
-        minikin_families.push_back(fallback_fonts_[fallback_family]);
-    }
-
-    // Create the minikin font collection.
-    auto font_collection =
-        std::make_shared<minikin::FontCollection>(std::move(minikin_families));
-    if (enable_font_fallback_) {
-      font_collection->set_fallback_font_provider(
-          std::make_unique<TxtFallbackFontProvider>(shared_from_this()));
-    }
+    auto font_collection = CreateMinikinFontCollection(minikin_family, locale);
 
     // Cache the font collection for future queries.
-    font_collections_cache_[family_key] = font_collection;
+    font_collections_cache_[family_key] = {font_collection,
+                                           std::move(minikin_family),
+                                           fallback_family_count};
 
     return font_collection;
   }
@@ -148,7 +183,7 @@ FontCollection::GetMinikinFontCollectionForFamily(
   if (font_family != default_font_family) {
     std::shared_ptr<minikin::FontCollection> default_collection =
         GetMinikinFontCollectionForFamily(default_font_family, "");
-    font_collections_cache_[family_key] = default_collection;
+    font_collections_cache_[family_key] = {default_collection, nullptr, 0};
     return default_collection;
   }
 
@@ -156,6 +191,34 @@ FontCollection::GetMinikinFontCollectionForFamily(
   return nullptr;
 }
 
+size_t FontCollection::GetFallbackFamilyCount(const std::string& locale) const {
+  auto found = fallback_fonts_for_locale_.find(locale);
+  return found == fallback_fonts_for_locale_.end() ? 0 : found->second.size();
+}
+
+std::shared_ptr<minikin::FontCollection>
+FontCollection::CreateMinikinFontCollection(
+    const std::shared_ptr<minikin::FontFamily>& family,
+    const std::string& locale) {
+  // Create a vector of font families for the Minikin font collection.
+  std::vector<std::shared_ptr<minikin::FontFamily>> minikin_families = {
+      family,
+  };
+  if (enable_font_fallback_) {
+    for (std::string fallback_family : fallback_fonts_for_locale_[locale])
+      minikin_families.push_back(fallback_fonts_[fallback_family]);
+  }
+
+  // Create the minikin font collection.
+  auto font_collection =
+      std::make_shared<minikin::FontCollection>(std::move(minikin_families));
+  if (enable_font_fallback_) {
+    font_collection->set_fallback_font_provider(
+        std::make_unique<TxtFallbackFontProvider>(shared_from_this()));
+  }
+  return font_collection;
+}
+
 std::shared_ptr<minikin::FontFamily> FontCollection::CreateMinikinFontFamily(
     const sk_sp<SkFontMgr>& manager,
     const std::string& family_name) {
@@ -192,6 +255,18 @@ std::shared_ptr<minikin::FontFamily> FontCollection::CreateMinikinFontFamily(
 const std::shared_ptr<minikin::FontFamily>& FontCollection::MatchFallbackFont(
     uint32_t ch,
     std::string locale) {
+  const std::shared_ptr<minikin::FontFamily>& resolved =
+      FindResolvedFallbackFont(ch, locale);
+  if (resolved) {
+    return resolved;
+  }
+
+  std::unordered_set<uint32_t>& unmatched_characters =
+      unmatched_characters_for_locale_[locale];
+  if (unmatched_characters.count(ch) != 0) {
+    return g_null_family;
+  }
+
   for (const sk_sp<SkFontMgr>& manager : GetFontManagerOrder()) {
     std::vector<const char*> bcp47;
     if (!locale.empty())
@@ -205,14 +280,85 @@ const std::shared_ptr<minikin::FontFamily>& FontCollection::MatchFallbackFont(
     typeface->getFamilyName(&sk_family_name);
     std::string family_name(sk_family_name.c_str());
 
-    fallback_fonts_for_locale_[locale].insert(family_name);
+    const std::shared_ptr<minikin::FontFamily>& family =
+        GetFallbackFontFamily(manager, family_name);
+    if (family) {
+      AddFallbackFont(locale, family_name, family, true);
+    }
+    return family;
+  }
+
+  unmatched_characters.insert(ch);
+  return g_null_family;
+}
+
+const std::shared_ptr<minikin::FontFamily>&
+FontCollection::FindResolvedFallbackFont(uint32_t ch,
+                                         const std::string& locale) {
+  auto resolved = fallback_families_for_locale_.find(locale);
+  if (resolved != fallback_families_for_locale_.end()) {
+    for (const auto* family : resolved->second) {
+      if ((*family)->getCoverage().get(ch)) {
+        return *family;
+      }
+    }
+  }
 
-    return GetFallbackFontFamily(manager, family_name);
+  // Families resolved by previous runs are only created once a character is
+  // missing from all the families resolved so far.
+  auto persisted = persisted_fallback_fonts_for_locale_.find(locale);
+  if (persisted == persisted_fallback_fonts_for_locale_.end()) {
+    return g_null_family;
+  }
+  std::vector<std::string>& family_names = persisted->second;
+  while (!family_names.empty()) {
+    const std::string family_name = std::move(family_names.front());
+    family_names.erase(family_names.begin());
+
+    for (const sk_sp<SkFontMgr>& manager : GetFontManagerOrder()) {
+      const std::shared_ptr<minikin::FontFamily>& family =
+          GetFallbackFontFamily(manager, family_name);
+      if (!family) {
+        continue;
+      }
+      AddFallbackFont(locale, family_name, family, false);
+      if (family->getCoverage().get(ch)) {
+        return family;
+      }
+      break;
+    }
   }
 
   return g_null_family;
 }
 
+void FontCollection::AddFallbackFont(
+    const std::string& locale,
+    const std::string& family_name,
+    const std::shared_ptr<minikin::FontFamily>& family,
+    bool persist) {
+  // Font collections created from now on include the family.
+  if (!fallback_fonts_for_locale_[locale].insert(family_name).second) {
+    return;
+  }
+
+  fallback_families_for_locale_[locale].push_back(&family);
+
+  if (persist && !fallback_font_cache_path_.empty()) {
+    std::string path = fallback_font_cache_path_;
+    std::string line = locale + '\t' + family_name + '\n';
+    auto append = [path = std::move(path), line = std::move(line)]() {
+      std::ofstream file(path, std::ios::app);
+      file << line;
+    };
+    if (fallback_font_cache_task_runner_) {
+      fallback_font_cache_task_runner_(std::move(append));
+    } else {
+      append();
+    }
+  }
+}
+
 const std::shared_ptr<minikin::FontFamily>&
 FontCollection::GetFallbackFontFamily(const sk_sp<SkFontMgr>& manager,
                                       const std::string& family_name) {
@@ -226,13 +372,11 @@ FontCollection::GetFallbackFontFamily(const sk_sp<SkFontMgr>& manager,
   if (!minikin_family)
     return g_null_family;
 
+  // Font collections that were handed out reach the new family via the
+  // fallback font provider.
   auto insert_it =
       fallback_fonts_.insert(std::make_pair(family_name, minikin_family));
 
-  // Clear the cache to force creation of new font collections that will include
-  // this fallback font.
-  font_collections_cache_.clear();
-
   return insert_it.first->second;
 }
 
@@ -17,10 +17,13 @@
 #ifndef LIB_TXT_SRC_FONT_COLLECTION_H_
 #define LIB_TXT_SRC_FONT_COLLECTION_H_
 
+#include <functional>
 #include <memory>
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include "lib/fxl/macros.h"
 #include "minikin/FontCollection.h"
 #include "minikin/FontFamily.h"
@@ -56,6 +59,18 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
   // missing from the requested font family.
   void DisableFontFallback();
 
+  // Runs a task that may block on file IO off the thread doing layout.
+  using FileTaskRunner = std::function<void(std::function<void()>)>;
+
+  // Reads the fallback fonts resolved by previous runs from the file at |path|
+  // and appends the fallback fonts resolved from now on to it. Fallback fonts
+  // read from the file are tried before the font managers are asked for a font
+  // with the character, which can be slow. The file is appended to by tasks
+  // run by |file_task_runner|, which must run them in order. The file is
+  // appended to synchronously if |file_task_runner| is null.
+  void SetFallbackFontCachePath(std::string path,
+                                FileTaskRunner file_task_runner = nullptr);
+
  private:
   struct FamilyKey {
     FamilyKey(const std::string& family, const std::string& loc)
@@ -71,21 +86,52 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
     };
   };
 
+  struct CachedCollection {
+    std::shared_ptr<minikin::FontCollection> collection;
+    // The family |collection| was created for. Null if |collection| is that of
+    // the default family, which is cached under its own key.
+    std::shared_ptr<minikin::FontFamily> family;
+    // The number of fallback families of the locale when |collection| was
+    // created.
+    size_t fallback_family_count;
+  };
+
   sk_sp<SkFontMgr> default_font_manager_;
   sk_sp<SkFontMgr> asset_font_manager_;
   sk_sp<SkFontMgr> test_font_manager_;
-  std::unordered_map<FamilyKey,
-                     std::shared_ptr<minikin::FontCollection>,
-                     FamilyKey::Hasher>
+  std::unordered_map<FamilyKey, CachedCollection, FamilyKey::Hasher>
       font_collections_cache_;
   std::unordered_map<std::string, std::shared_ptr<minikin::FontFamily>>
       fallback_fonts_;
   std::unordered_map<std::string, std::set<std::string>>
       fallback_fonts_for_locale_;
+  // The fallback families resolved for each locale in the order they were
+  // resolved. Characters missing from a font collection are looked up in the
+  // coverage of these families before the font managers are asked. Minikin
+  // font collections that were handed out before a family was added reach it
+  // via the fallback font provider, so they remain valid.
+  std::unordered_map<std::string,
+                     std::vector<const std::shared_ptr<minikin::FontFamily>*>>
+      fallback_families_for_locale_;
+  // Characters no font manager has a font for.
+  std::unordered_map<std::string, std::unordered_set<uint32_t>>
+      unmatched_characters_for_locale_;
+  // Fallback families resolved by previous runs that have not been tried yet.
+  std::unordered_map<std::string, std::vector<std::string>>
+      persisted_fallback_fonts_for_locale_;
+  std::string fallback_font_cache_path_;
+  FileTaskRunner fallback_font_cache_task_runner_;
   bool enable_font_fallback_;
 
   std::vector<sk_sp<SkFontMgr>> GetFontManagerOrder() const;
 
+  size_t GetFallbackFamilyCount(const std::string& locale) const;
+
+  // Creates a collection of |family| and the fallback families of |locale|.
+  std::shared_ptr<minikin::FontCollection> CreateMinikinFontCollection(
+      const std::shared_ptr<minikin::FontFamily>& family,
+      const std::string& locale);
+
   std::shared_ptr<minikin::FontFamily> CreateMinikinFontFamily(
       const sk_sp<SkFontMgr>& manager,
       const std::string& family_name);
@@ -94,6 +140,18 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
       const sk_sp<SkFontMgr>& manager,
       const std::string& family_name);
 
+  // Returns the resolved fallback family of |locale| that has a glyph for
+  // |ch|, trying the families resolved by previous runs if needed.
+  const std::shared_ptr<minikin::FontFamily>& FindResolvedFallbackFont(
+      uint32_t ch,
+      const std::string& locale);
+
+  // |family| must be owned by |fallback_fonts_|.
+  void AddFallbackFont(const std::string& locale,
+                       const std::string& family_name,
+                       const std::shared_ptr<minikin::FontFamily>& family,
+                       bool persist);
+
   FXL_DISALLOW_COPY_AND_ASSIGN(FontCollection);
 };
 
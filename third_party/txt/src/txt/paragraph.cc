@@ -20,11 +20,11 @@
 #include <algorithm>
 #include <limits>
 #include <map>
-#include <numeric>
 #include <utility>
 #include <vector>
 
 #include <minikin/Layout.h>
+#include "minikin/BreakIteratorPool.h"
 #include "font_collection.h"
 #include "font_skia.h"
 #include "lib/fxl/logging.h"
@@ -195,8 +195,10 @@ void Paragraph::GlyphPosition::Shift(double delta) {
   x_pos.Shift(delta);
 }
 
-Paragraph::GlyphLine::GlyphLine(std::vector<GlyphPosition>&& p, size_t tcu)
-    : positions(std::move(p)), total_code_units(tcu) {}
+Paragraph::GlyphLine::GlyphLine(std::vector<GlyphPosition>&& p,
+                                size_t scu,
+                                size_t tcu)
+    : positions(std::move(p)), start_code_unit(scu), total_code_units(tcu) {}
 
 Paragraph::CodeUnitRun::CodeUnitRun(std::vector<GlyphPosition>&& p,
                                     Range<size_t> cu,
@@ -221,6 +223,10 @@ Paragraph::Paragraph() {
   breaker_.setLocale(icu::Locale(), nullptr);
 }
 
+Paragraph::LayoutContext::LayoutContext() {
+  breaker.setLocale(icu::Locale(), nullptr);
+}
+
 Paragraph::~Paragraph() = default;
 
 void Paragraph::SetText(std::vector<uint16_t> text, StyledRuns runs) {
@@ -229,9 +235,11 @@ void Paragraph::SetText(std::vector<uint16_t> text, StyledRuns runs) {
     return;
   text_ = std::move(text);
   runs_ = std::move(runs);
+  word_boundaries_.clear();
 }
 
-bool Paragraph::ComputeLineBreaks() {
+bool Paragraph::ComputeLineBreaks(LayoutContext* context) {
+  minikin::LineBreaker& breaker = context ? context->breaker : breaker_;
   line_ranges_.clear();
   line_widths_.clear();
 
@@ -259,13 +267,13 @@ bool Paragraph::ComputeLineBreaks() {
       continue;
     }
 
-    breaker_.setLineWidths(0.0f, 0, width_);
-    breaker_.setJustified(paragraph_style_.text_align == TextAlign::justify);
-    breaker_.setStrategy(paragraph_style_.break_strategy);
-    breaker_.resize(block_size);
-    memcpy(breaker_.buffer(), text_.data() + block_start,
+    breaker.setLineWidths(0.0f, 0, width_);
+    breaker.setJustified(paragraph_style_.text_align == TextAlign::justify);
+    breaker.setStrategy(paragraph_style_.break_strategy);
+    breaker.resize(block_size);
+    memcpy(breaker.buffer(), text_.data() + block_start,
            block_size * sizeof(text_[0]));
-    breaker_.setText();
+    breaker.setText();
 
     // Add the runs that include this line to the LineBreaker.
     while (run_index < runs_.size()) {
@@ -281,7 +289,7 @@ bool Paragraph::ComputeLineBreaks() {
       minikin::MinikinPaint paint;
       GetFontAndMinikinPaint(run.style, &font, &paint);
       std::shared_ptr<minikin::FontCollection> collection =
-          GetMinikinFontCollectionForStyle(run.style);
+          GetMinikinFontCollectionForStyle(run.style, context);
       if (collection == nullptr) {
         FXL_LOG(INFO) << "Could not find font collection for family \""
                       << run.style.font_family << "\".";
@@ -290,15 +298,15 @@ bool Paragraph::ComputeLineBreaks() {
       size_t run_start = std::max(run.start, block_start) - block_start;
       size_t run_end = std::min(run.end, block_end) - block_start;
       bool isRtl = (paragraph_style_.text_direction == TextDirection::rtl);
-      breaker_.addStyleRun(&paint, collection, font, run_start, run_end, isRtl);
+      breaker.addStyleRun(&paint, collection, font, run_start, run_end, isRtl);
 
       if (run.end > block_end)
         break;
       run_index++;
     }
 
-    size_t breaks_count = breaker_.computeBreaks();
-    const int* breaks = breaker_.getBreaks();
+    size_t breaks_count = breaker.computeBreaks();
+    const int* breaks = breaker.getBreaks();
     for (size_t i = 0; i < breaks_count; ++i) {
       size_t break_start = (i > 0) ? breaks[i - 1] : 0;
       size_t line_start = break_start + block_start;
@@ -315,10 +323,10 @@ bool Paragraph::ComputeLineBreaks() {
       line_ranges_.emplace_back(line_start, line_end,
                                 line_end_excluding_whitespace,
                                 line_end_including_newline, hard_break);
-      line_widths_.push_back(breaker_.getWidths()[i]);
+      line_widths_.push_back(breaker.getWidths()[i]);
     }
 
-    breaker_.finish();
+    breaker.finish();
   }
 
   return true;
@@ -411,6 +419,10 @@ bool Paragraph::ComputeBidiRuns(std::vector<BidiRun>* result) {
 }
 
 void Paragraph::Layout(double width, bool force) {
+  Layout(width, force, nullptr);
+}
+
+void Paragraph::Layout(double width, bool force, LayoutContext* context) {
   // Do not allow calling layout multiple times without changing anything.
   if (!needs_layout_ && width == width_ && !force) {
     return;
@@ -419,7 +431,7 @@ void Paragraph::Layout(double width, bool force) {
 
   width_ = width;
 
-  if (!ComputeLineBreaks())
+  if (!ComputeLineBreaks(context))
     return;
 
   std::vector<BidiRun> bidi_runs;
@@ -437,7 +449,8 @@ void Paragraph::Layout(double width, bool force) {
   glyph_lines_.clear();
   code_unit_runs_.clear();
 
-  minikin::Layout layout;
+  minikin::Layout local_layout;
+  minikin::Layout& layout = context ? context->layout : local_layout;
   SkTextBlobBuilder builder;
   double y_offset = 0;
   double prev_max_descent = 0;
@@ -498,7 +511,7 @@ void Paragraph::Layout(double width, bool force) {
       paint.setTextSize(run.style().font_size);
 
       std::shared_ptr<minikin::FontCollection> minikin_font_collection =
-          GetMinikinFontCollectionForStyle(run.style());
+          GetMinikinFontCollectionForStyle(run.style(), context);
 
       // Lay out this run.
       uint16_t* text_ptr = text_.data();
@@ -713,7 +726,12 @@ void Paragraph::Layout(double width, bool force) {
     size_t next_line_start = (line_number < line_ranges_.size() - 1)
                                  ? line_ranges_[line_number + 1].start
                                  : text_.size();
+    size_t line_start_code_unit =
+        glyph_lines_.empty() ? 0
+                             : glyph_lines_.back().start_code_unit +
+                                   glyph_lines_.back().total_code_units;
     glyph_lines_.emplace_back(std::move(line_glyph_positions),
+                              line_start_code_unit,
                               next_line_start - line_range.start);
     code_unit_runs_.insert(code_unit_runs_.end(), line_code_unit_runs.begin(),
                            line_code_unit_runs.end());
@@ -851,7 +869,21 @@ void Paragraph::SetFontCollection(
 }
 
 std::shared_ptr<minikin::FontCollection>
-Paragraph::GetMinikinFontCollectionForStyle(const TextStyle& style) {
+Paragraph::GetMinikinFontCollectionForStyle(const TextStyle& style,
+                                            LayoutContext* context) {
+  if (context) {
+    const std::tuple<const FontCollection*, std::string, std::string> key(
+        font_collection_.get(), style.font_family, style.locale);
+    auto found = context->font_collections.find(key);
+    if (found != context->font_collections.end()) {
+      return found->second;
+    }
+    std::shared_ptr<minikin::FontCollection> collection =
+        GetMinikinFontCollectionForStyle(style, nullptr);
+    context->font_collections.emplace(key, collection);
+    return collection;
+  }
+
   std::string locale;
   if (!style.locale.empty()) {
     uint32_t language_list_id =
@@ -869,7 +901,7 @@ Paragraph::GetMinikinFontCollectionForStyle(const TextStyle& style) {
 
 sk_sp<SkTypeface> Paragraph::GetDefaultSkiaTypeface(const TextStyle& style) {
   std::shared_ptr<minikin::FontCollection> collection =
-      GetMinikinFontCollectionForStyle(style);
+      GetMinikinFontCollectionForStyle(style, nullptr);
   minikin::FakedFont faked_font =
       collection->baseFontFaked(GetMinikinFontStyle(style));
   return static_cast<FontSkia*>(faked_font.font)->GetSkTypeface();
@@ -1072,7 +1104,11 @@ std::vector<Paragraph::TextBox> Paragraph::GetRectsForRange(size_t start,
                                                             size_t end) const {
   std::map<size_t, std::vector<Paragraph::TextBox>> line_boxes;
 
-  for (const CodeUnitRun& run : code_unit_runs_) {
+  auto first_run = std::partition_point(
+      code_unit_runs_.begin(), code_unit_runs_.end(),
+      [start](const CodeUnitRun& run) { return run.code_units.end <= start; });
+  for (auto run_it = first_run; run_it != code_unit_runs_.end(); ++run_it) {
+    const CodeUnitRun& run = *run_it;
     if (run.code_units.start >= end)
       break;
     if (run.code_units.end <= start)
@@ -1103,8 +1139,12 @@ std::vector<Paragraph::TextBox> Paragraph::GetRectsForRange(size_t start,
   }
 
   // Add empty rectangles representing any newline characters within the range.
-  for (size_t line_number = 0; line_number < line_ranges_.size();
-       ++line_number) {
+  auto first_line = std::partition_point(
+      line_ranges_.begin(), line_ranges_.end(), [start](const LineRange& line) {
+        return line.end_including_newline <= start;
+      });
+  for (size_t line_number = first_line - line_ranges_.begin();
+       line_number < line_ranges_.size(); ++line_number) {
     const LineRange& line = line_ranges_[line_number];
     if (line.start >= end)
       break;
@@ -1135,48 +1175,40 @@ Paragraph::PositionWithAffinity Paragraph::GetGlyphPositionAtCoordinate(
   if (line_heights_.empty())
     return PositionWithAffinity(0, DOWNSTREAM);
 
-  size_t y_index;
-  for (y_index = 0; y_index < line_heights_.size() - 1; ++y_index) {
-    if (dy < line_heights_[y_index])
-      break;
-  }
+  // The line heights are cumulative, so the line is the first one that ends
+  // below dy. Points below the last line hit the last line.
+  size_t y_index =
+      std::upper_bound(line_heights_.begin(), line_heights_.end() - 1, dy) -
+      line_heights_.begin();
 
   const std::vector<GlyphPosition>& line_glyph_position =
       glyph_lines_[y_index].positions;
   if (line_glyph_position.empty()) {
-    int line_start_index =
-        std::accumulate(glyph_lines_.begin(), glyph_lines_.begin() + y_index, 0,
-                        [](const int a, const GlyphLine& b) {
-                          return a + static_cast<int>(b.total_code_units);
-                        });
-    return PositionWithAffinity(line_start_index, DOWNSTREAM);
-  }
-
-  size_t x_index;
-  const GlyphPosition* gp = nullptr;
-  for (x_index = 0; x_index < line_glyph_position.size(); ++x_index) {
-    double glyph_end = (x_index < line_glyph_position.size() - 1)
-                           ? line_glyph_position[x_index + 1].x_pos.start
-                           : line_glyph_position[x_index].x_pos.end;
-    if (dx < glyph_end) {
-      gp = &line_glyph_position[x_index];
-      break;
-    }
+    return PositionWithAffinity(glyph_lines_[y_index].start_code_unit,
+                                DOWNSTREAM);
   }
 
-  if (gp == nullptr) {
-    const GlyphPosition& last_glyph = line_glyph_position.back();
-    return PositionWithAffinity(last_glyph.code_units.end, UPSTREAM);
+  // Each glyph extends to the start of the next one. Find the last glyph that
+  // starts at or before dx.
+  auto next_glyph = std::upper_bound(
+      line_glyph_position.begin() + 1, line_glyph_position.end(), dx,
+      [](double x, const GlyphPosition& gp) { return x < gp.x_pos.start; });
+  const GlyphPosition* gp = &*(next_glyph - 1);
+  if (next_glyph == line_glyph_position.end() && dx >= gp->x_pos.end) {
+    return PositionWithAffinity(gp->code_units.end, UPSTREAM);
   }
 
   // Find the direction of the run that contains this glyph.
   TextDirection direction = TextDirection::ltr;
-  for (const CodeUnitRun& run : code_unit_runs_) {
-    if (gp->code_units.start >= run.code_units.start &&
-        gp->code_units.end <= run.code_units.end) {
-      direction = run.direction;
-      break;
-    }
+  auto run_it = std::partition_point(
+      code_unit_runs_.begin(), code_unit_runs_.end(),
+      [gp](const CodeUnitRun& run) {
+        return run.code_units.end < gp->code_units.end;
+      });
+  if (run_it != code_unit_runs_.end() &&
+      gp->code_units.start >= run_it->code_units.start &&
+      gp->code_units.end <= run_it->code_units.end) {
+    direction = run_it->direction;
   }
 
   double glyph_center = (gp->x_pos.start + gp->x_pos.end) / 2;
@@ -1192,23 +1224,45 @@ Paragraph::Range<size_t> Paragraph::GetWordBoundary(size_t offset) const {
   if (text_.size() == 0)
     return Range<size_t>(0, 0);
 
-  if (!word_breaker_) {
-    UErrorCode status = U_ZERO_ERROR;
-    word_breaker_.reset(
-        icu::BreakIterator::createWordInstance(icu::Locale(), status));
-    if (!U_SUCCESS(status))
-      return Range<size_t>(0, 0);
+  // Offsets within the text are answered from the cached boundaries. The
+  // boundaries always include the start and the end of the text.
+  if (offset < text_.size() && !word_boundaries_.empty()) {
+    auto next = std::upper_bound(word_boundaries_.begin(),
+                                 word_boundaries_.end(), offset);
+    return Range<size_t>(*(next - 1), *next);
   }
 
-  word_breaker_->setText(icu::UnicodeString(false, text_.data(), text_.size()));
+  std::unique_ptr<icu::BreakIterator> word_breaker =
+      minikin::BreakIteratorPool::acquire(
+          minikin::BreakIteratorPool::kType_Word, icu::Locale());
+  if (!word_breaker)
+    return Range<size_t>(0, 0);
+
+  word_breaker->setText(icu::UnicodeString(false, text_.data(), text_.size()));
+
+  Range<size_t> result(0, 0);
+  if (offset < text_.size()) {
+    for (int32_t boundary = word_breaker->first();
+         boundary != icu::BreakIterator::DONE;
+         boundary = word_breaker->next()) {
+      word_boundaries_.push_back(boundary);
+    }
+    auto next = std::upper_bound(word_boundaries_.begin(),
+                                 word_boundaries_.end(), offset);
+    result = Range<size_t>(*(next - 1), *next);
+  } else {
+    int32_t prev_boundary = word_breaker->preceding(offset + 1);
+    int32_t next_boundary = word_breaker->next();
+    if (prev_boundary == icu::BreakIterator::DONE)
+      prev_boundary = offset;
+    if (next_boundary == icu::BreakIterator::DONE)
+      next_boundary = offset;
+    result = Range<size_t>(prev_boundary, next_boundary);
+  }
 
-  int32_t prev_boundary = word_breaker_->preceding(offset + 1);
-  int32_t next_boundary = word_breaker_->next();
-  if (prev_boundary == icu::BreakIterator::DONE)
-    prev_boundary = offset;
-  if (next_boundary == icu::BreakIterator::DONE)
-    next_boundary = offset;
-  return Range<size_t>(prev_boundary, next_boundary);
+  minikin::BreakIteratorPool::release(minikin::BreakIteratorPool::kType_Word,
+                                      icu::Locale(), std::move(word_breaker));
+  return result;
 }
 
 size_t Paragraph::GetLineCount() const {
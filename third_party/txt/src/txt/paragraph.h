@@ -17,13 +17,17 @@
 #ifndef LIB_TXT_SRC_PARAGRAPH_H_
 #define LIB_TXT_SRC_PARAGRAPH_H_
 
+#include <map>
 #include <set>
+#include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
 #include "font_collection.h"
 #include "lib/fxl/compiler_specific.h"
 #include "lib/fxl/macros.h"
+#include "minikin/Layout.h"
 #include "minikin/LineBreaker.h"
 #include "paint_record.h"
 #include "paragraph_style.h"
@@ -163,6 +167,7 @@ class Paragraph {
 
  private:
   friend class ParagraphBuilder;
+  friend class ParagraphBatch;
   FRIEND_TEST(ParagraphTest, SimpleParagraph);
   FRIEND_TEST(ParagraphTest, SimpleRedParagraph);
   FRIEND_TEST(ParagraphTest, RainbowParagraph);
@@ -184,6 +189,7 @@ class Paragraph {
   FRIEND_TEST(ParagraphTest, HyphenBreakParagraph);
   FRIEND_TEST(ParagraphTest, RepeatLayoutParagraph);
   FRIEND_TEST(ParagraphTest, Ellipsize);
+  FRIEND_TEST(ParagraphTest, BatchLayoutParagraph);
 
   // Starting data to layout.
   std::vector<uint16_t> text_;
@@ -192,7 +198,24 @@ class Paragraph {
   std::shared_ptr<FontCollection> font_collection_;
 
   minikin::LineBreaker breaker_;
-  mutable std::unique_ptr<icu::BreakIterator> word_breaker_;
+
+  // State that is shared between the layouts of the paragraphs of a
+  // ParagraphBatch.
+  struct LayoutContext {
+    LayoutContext();
+
+    minikin::LineBreaker breaker;
+    minikin::Layout layout;
+    // Keyed by the font collection of the paragraph, the font family and the
+    // locale of the style.
+    std::map<std::tuple<const FontCollection*, std::string, std::string>,
+             std::shared_ptr<minikin::FontCollection>>
+        font_collections;
+  };
+
+  // The word boundaries of the text in ascending order. Computed by the first
+  // call to GetWordBoundary after the text is set.
+  mutable std::vector<size_t> word_boundaries_;
 
   struct LineRange {
     LineRange(size_t s, size_t e, size_t eew, size_t ein, bool h)
@@ -248,9 +271,11 @@ class Paragraph {
   struct GlyphLine {
     // Glyph positions sorted by x coordinate.
     const std::vector<GlyphPosition> positions;
+    // The index of the first code unit of the line.
+    const size_t start_code_unit;
     const size_t total_code_units;
 
-    GlyphLine(std::vector<GlyphPosition>&& p, size_t tcu);
+    GlyphLine(std::vector<GlyphPosition>&& p, size_t scu, size_t tcu);
   };
 
   struct CodeUnitRun {
@@ -276,7 +301,8 @@ class Paragraph {
   std::vector<GlyphLine> glyph_lines_;
 
   // Holds the positions of each range of code units in the text.
-  // Sorted in code unit index order.
+  // Sorted in code unit index order. The runs do not overlap, so their ends
+  // are sorted too and runs can be found by binary search.
   std::vector<CodeUnitRun> code_unit_runs_;
 
   // The max width of the paragraph as provided in the most recent Layout()
@@ -307,8 +333,13 @@ class Paragraph {
 
   void SetFontCollection(std::shared_ptr<FontCollection> font_collection);
 
+  // Lays out the paragraph like Layout() but uses the line breaker, the
+  // scratch buffers and the font collection lookups of |context| if there is
+  // one.
+  void Layout(double width, bool force, LayoutContext* context);
+
   // Break the text into lines.
-  bool ComputeLineBreaks();
+  bool ComputeLineBreaks(LayoutContext* context);
 
   // Break the text into runs based on LTR/RTL text direction.
   bool ComputeBidiRuns(std::vector<BidiRun>* result);
@@ -327,9 +358,11 @@ class Paragraph {
                        const PaintRecord& record,
                        SkPoint base_offset);
 
-  // Obtain a Minikin font collection matching this text style.
+  // Obtain a Minikin font collection matching this text style. The collection
+  // is remembered in |context| if there is one.
   std::shared_ptr<minikin::FontCollection> GetMinikinFontCollectionForStyle(
-      const TextStyle& style);
+      const TextStyle& style,
+      LayoutContext* context);
 
   // Get a default SkTypeface for a text style.
   sk_sp<SkTypeface> GetDefaultSkiaTypeface(const TextStyle& style);
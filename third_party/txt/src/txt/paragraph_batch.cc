@@ -0,0 +1,39 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "paragraph_batch.h"
+
+namespace txt {
+
+ParagraphBatch::ParagraphBatch() = default;
+
+ParagraphBatch::~ParagraphBatch() = default;
+
+void ParagraphBatch::AddParagraph(Paragraph* paragraph, double width) {
+  paragraphs_.emplace_back(paragraph, width);
+}
+
+void ParagraphBatch::Layout() {
+  for (const auto& entry : paragraphs_) {
+    entry.first->Layout(entry.second, false, &context_);
+  }
+  paragraphs_.clear();
+
+  // Font collections may change before the next batch.
+  context_.font_collections.clear();
+}
+
+}  // namespace txt
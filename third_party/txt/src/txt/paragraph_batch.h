@@ -0,0 +1,62 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LIB_TXT_SRC_PARAGRAPH_BATCH_H_
+#define LIB_TXT_SRC_PARAGRAPH_BATCH_H_
+
+#include <utility>
+#include <vector>
+
+#include "lib/fxl/macros.h"
+#include "paragraph.h"
+
+namespace txt {
+
+// Lays out many paragraphs in one call, such as the items of a list.
+//
+// The paragraphs share one line breaker, the scratch buffers of Minikin and
+// the lookups of their font collections. Each paragraph ends up laid out as if
+// Paragraph::Layout had been called on it.
+class ParagraphBatch {
+ public:
+  ParagraphBatch();
+
+  ~ParagraphBatch();
+
+  // Adds a paragraph to be laid out with |width| by the next call to Layout().
+  // The paragraph must not be destroyed before then.
+  void AddParagraph(Paragraph* paragraph, double width);
+
+  // Lays out the paragraphs added since the last call in the order in which
+  // they were added, and then empties the batch.
+  //
+  // Paragraphs are laid out on the calling thread. Minikin serializes shaping
+  // behind a global lock and font collections are not thread safe, so there is
+  // nothing to gain from spreading the paragraphs over several threads.
+  void Layout();
+
+  size_t size() const { return paragraphs_.size(); }
+
+ private:
+  std::vector<std::pair<Paragraph*, double>> paragraphs_;
+  Paragraph::LayoutContext context_;
+
+  FXL_DISALLOW_COPY_AND_ASSIGN(ParagraphBatch);
+};
+
+}  // namespace txt
+
+#endif  // LIB_TXT_SRC_PARAGRAPH_BATCH_H_
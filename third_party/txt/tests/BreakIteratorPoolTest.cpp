@@ -0,0 +1,47 @@
+/*
+ * Copyright 2018 Google, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "minikin/BreakIteratorPool.h"
+
+namespace minikin {
+
+TEST(BreakIteratorPoolTest, ReusesReleasedIterators) {
+  const icu::Locale locale("en-US");
+  std::unique_ptr<icu::BreakIterator> iterator =
+      BreakIteratorPool::acquire(BreakIteratorPool::kType_Line, locale);
+  ASSERT_NE(iterator, nullptr);
+  const icu::BreakIterator* released = iterator.get();
+  BreakIteratorPool::release(BreakIteratorPool::kType_Line, locale,
+                             std::move(iterator));
+
+  // Iterators are only handed out for the type and locale they were made for.
+  std::unique_ptr<icu::BreakIterator> word_iterator =
+      BreakIteratorPool::acquire(BreakIteratorPool::kType_Word, locale);
+  ASSERT_NE(word_iterator, nullptr);
+  EXPECT_NE(word_iterator.get(), released);
+  std::unique_ptr<icu::BreakIterator> other_locale_iterator =
+      BreakIteratorPool::acquire(BreakIteratorPool::kType_Line,
+                                 icu::Locale("ja-JP"));
+  ASSERT_NE(other_locale_iterator, nullptr);
+  EXPECT_NE(other_locale_iterator.get(), released);
+
+  iterator = BreakIteratorPool::acquire(BreakIteratorPool::kType_Line, locale);
+  EXPECT_EQ(iterator.get(), released);
+}
+
+}  // namespace minikin
@@ -0,0 +1,177 @@
+/*
+ * Copyright 2018 Google, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "MinikinFontForTest.h"
+#include "minikin/FontCollection.h"
+#include "minikin/FontFamily.h"
+#include "minikin/FontLanguageListCache.h"
+#include "minikin/MinikinInternal.h"
+#include "txt_test_utils.h"
+
+namespace minikin {
+
+namespace {
+
+const uint16_t kHiraganaA = 0x3042;
+const uint16_t kCombiningAcute = 0x0301;
+const uint16_t kSoftHyphen = 0x00AD;
+const uint16_t kRegistered = 0x00AE;
+const uint16_t kLatinCapitalAWithMacron = 0x0100;
+const uint16_t kTextStyleVS = 0xFE0E;
+const uint16_t kEmojiStyleVS = 0xFE0F;
+
+std::shared_ptr<FontFamily> MakeFamily(const std::string& file,
+                                       const std::string& lang = "") {
+  std::vector<Font> fonts;
+  fonts.push_back(Font(
+      std::make_shared<MinikinFontForTest>(txt::GetFontDir() + "/" + file),
+      FontStyle()));
+  if (lang.empty()) {
+    return std::make_shared<FontFamily>(std::move(fonts));
+  }
+  return std::make_shared<FontFamily>(FontLanguageListCache::getId(lang),
+                                      0,  // variant
+                                      std::move(fonts));
+}
+
+// Itemizes |text| with and without the Latin-1 fast path and expects the same
+// runs.
+void ExpectSameRuns(FontCollection& collection,
+                    const std::vector<uint16_t>& text) {
+  std::vector<FontCollection::Run> fast_runs;
+  std::vector<FontCollection::Run> regular_runs;
+  collection.setLatin1FastPathEnabled(true);
+  collection.itemize(text.data(), text.size(), FontStyle(), &fast_runs);
+  collection.setLatin1FastPathEnabled(false);
+  collection.itemize(text.data(), text.size(), FontStyle(), &regular_runs);
+  collection.setLatin1FastPathEnabled(true);
+
+  std::string description;
+  for (uint16_t unit : text) {
+    description += std::to_string(unit) + " ";
+  }
+  ASSERT_EQ(fast_runs.size(), regular_runs.size()) << description;
+  for (size_t i = 0; i < fast_runs.size(); i++) {
+    EXPECT_EQ(fast_runs[i].start, regular_runs[i].start) << description;
+    EXPECT_EQ(fast_runs[i].end, regular_runs[i].end) << description;
+    EXPECT_EQ(fast_runs[i].fakedFont.font, regular_runs[i].fakedFont.font)
+        << description;
+    EXPECT_EQ(fast_runs[i].fakedFont.fakery.isFakeBold(),
+              regular_runs[i].fakedFont.fakery.isFakeBold())
+        << description;
+    EXPECT_EQ(fast_runs[i].fakedFont.fakery.isFakeItalic(),
+              regular_runs[i].fakedFont.fakery.isFakeItalic())
+        << description;
+  }
+}
+
+std::vector<uint16_t> ToUTF16(const std::string& latin1) {
+  std::vector<uint16_t> text;
+  for (char ch : latin1) {
+    text.push_back(static_cast<uint8_t>(ch));
+  }
+  return text;
+}
+
+// Inserts each of the |inserted| sequences at every position of |base|, so
+// that they start at every offset within and across the blocks the fast path
+// checks at a time.
+void ExpectSameRunsWithInsertions(
+    FontCollection& collection,
+    const std::vector<uint16_t>& base,
+    const std::vector<std::vector<uint16_t>>& inserted) {
+  for (const auto& sequence : inserted) {
+    for (size_t position = 0; position <= base.size(); position++) {
+      std::vector<uint16_t> text(base.begin(), base.begin() + position);
+      text.insert(text.end(), sequence.begin(), sequence.end());
+      text.insert(text.end(), base.begin() + position, base.end());
+      ExpectSameRuns(collection, text);
+    }
+  }
+}
+
+class FontCollectionLatin1Test : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    std::lock_guard<std::recursive_mutex> lock(gMinikinLock);
+    // Roboto covers printable Latin-1. Regular.ttf only covers a few letters,
+    // punctuation and U+0301.
+    roboto_ = MakeFamily("Roboto-Regular.ttf");
+    regular_ = MakeFamily("Regular.ttf");
+    color_emoji_ = MakeFamily("ColorEmojiFont.ttf", "und-Zsye");
+    text_emoji_ = MakeFamily("TextEmojiFont.ttf");
+    japanese_ = MakeFamily("Ja.ttf");
+  }
+
+  std::shared_ptr<FontFamily> roboto_;
+  std::shared_ptr<FontFamily> regular_;
+  std::shared_ptr<FontFamily> color_emoji_;
+  std::shared_ptr<FontFamily> text_emoji_;
+  std::shared_ptr<FontFamily> japanese_;
+};
+
+const std::vector<std::vector<uint16_t>> kInsertions = {
+    {kHiraganaA},
+    {kHiraganaA, kHiraganaA, 'x'},
+    {kLatinCapitalAWithMacron},
+    {kCombiningAcute},
+    {kSoftHyphen},
+    {kRegistered},
+    {kRegistered, kEmojiStyleVS},
+    {kRegistered, kTextStyleVS},
+    {'a', kEmojiStyleVS},
+    // U+1F600 GRINNING FACE, which no family covers.
+    {0xD83D, 0xDE00},
+    // An unpaired surrogate.
+    {0xD83D},
+};
+
+}  // namespace
+
+TEST_F(FontCollectionLatin1Test, MatchesRegularPathForCoveringFirstFamily) {
+  std::lock_guard<std::recursive_mutex> lock(gMinikinLock);
+  FontCollection collection(std::vector<std::shared_ptr<FontFamily>>{
+      roboto_, color_emoji_, text_emoji_, japanese_, regular_});
+
+  ExpectSameRuns(collection, ToUTF16("a"));
+  ExpectSameRuns(collection, ToUTF16("The quick brown fox jumps over it."));
+  ExpectSameRunsWithInsertions(
+      collection, ToUTF16("abcdefgh\xe0\xe9\xee\xf5\xfc\xdf\xf1 ABCDEFGH"),
+      kInsertions);
+}
+
+TEST_F(FontCollectionLatin1Test, MatchesRegularPathForPartialFirstFamily) {
+  std::lock_guard<std::recursive_mutex> lock(gMinikinLock);
+  FontCollection collection(std::vector<std::shared_ptr<FontFamily>>{
+      regular_, roboto_, color_emoji_, text_emoji_, japanese_});
+
+  // Only some of these are covered by the first family, so runs change
+  // family within blocks.
+  ExpectSameRuns(collection, ToUTF16("abcde,-!abcde,-!abcde"));
+  ExpectSameRunsWithInsertions(collection, ToUTF16("abcdeabcdeabcdeabcde"),
+                               kInsertions);
+  ExpectSameRunsWithInsertions(collection, ToUTF16("abcdeabcdeabcdeabcde"),
+                               {{'f'}, {'f', 'g', 'h'}, {' '}});
+}
+
+}  // namespace minikin
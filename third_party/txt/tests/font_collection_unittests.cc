@@ -14,14 +14,241 @@
  * limitations under the License.
  */
 
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "lib/fxl/command_line.h"
+#include "lib/fxl/files/scoped_temp_dir.h"
 #include "lib/fxl/logging.h"
+#include "third_party/skia/include/core/SkTypeface.h"
+#include "txt/asset_font_manager.h"
 #include "txt/font_collection.h"
 #include "txt_test_utils.h"
 
 namespace txt {
 
+namespace {
+
+// U+3042 HIRAGANA LETTER A, which the Roboto test fonts have no glyph for.
+constexpr uint32_t kHiraganaA = 0x3042;
+
+// U+E000, a private use character none of the test fonts have a glyph for.
+constexpr uint32_t kPrivateUse = 0xE000;
+
+// Matches characters to the first family with a glyph for them, like the
+// platform font managers do.
+class CharacterMatchingFontManager : public AssetFontManager {
+ public:
+  CharacterMatchingFontManager(std::unique_ptr<FontAssetProvider> provider)
+      : AssetFontManager(std::move(provider)) {}
+
+  int character_match_count() const { return character_match_count_; }
+
+  int family_match_count() const { return family_match_count_; }
+
+ private:
+  mutable int character_match_count_ = 0;
+  mutable int family_match_count_ = 0;
+
+  // |SkFontMgr|
+  SkFontStyleSet* onMatchFamily(const char familyName[]) const override {
+    family_match_count_++;
+    return AssetFontManager::onMatchFamily(familyName);
+  }
+
+  // |SkFontMgr|
+  SkTypeface* onMatchFamilyStyleCharacter(const char familyName[],
+                                          const SkFontStyle& style,
+                                          const char* bcp47[],
+                                          int bcp47Count,
+                                          SkUnichar character) const override {
+    character_match_count_++;
+    for (int i = 0; i < countFamilies(); i++) {
+      SkString family_name;
+      getFamilyName(i, &family_name);
+      sk_sp<SkTypeface> typeface(
+          matchFamilyStyle(family_name.c_str(), SkFontStyle()));
+      uint16_t glyph = 0;
+      if (typeface &&
+          typeface->charsToGlyphs(&character, SkTypeface::kUTF32_Encoding,
+                                  &glyph, 1) == 1 &&
+          glyph != 0) {
+        return typeface.release();
+      }
+    }
+    return nullptr;
+  }
+};
+
+sk_sp<CharacterMatchingFontManager> MakeFontManager() {
+  auto font_provider = std::make_unique<TypefaceFontAssetProvider>();
+  RegisterFontsFromPath(*font_provider, GetFontDir());
+  return sk_make_sp<CharacterMatchingFontManager>(std::move(font_provider));
+}
+
+// Runs the tasks posted to it when asked to.
+class FileTaskQueue {
+ public:
+  FontCollection::FileTaskRunner GetTaskRunner() {
+    return [this](std::function<void()> task) {
+      tasks_.push_back(std::move(task));
+    };
+  }
+
+  size_t size() const { return tasks_.size(); }
+
+  void RunTasks() {
+    for (const auto& task : tasks_) {
+      task();
+    }
+    tasks_.clear();
+  }
+
+ private:
+  std::vector<std::function<void()>> tasks_;
+};
+
+std::vector<std::pair<std::string, std::string>> ReadFallbackFontCache(
+    const std::string& path) {
+  std::vector<std::pair<std::string, std::string>> entries;
+  std::ifstream file(path);
+  std::string line;
+  while (std::getline(file, line)) {
+    const size_t separator = line.find('\t');
+    EXPECT_NE(separator, std::string::npos);
+    if (separator != std::string::npos) {
+      entries.emplace_back(line.substr(0, separator),
+                           line.substr(separator + 1));
+    }
+  }
+  return entries;
+}
+
+// The number of runs |collection| splits |text| into.
+size_t CountRuns(const minikin::FontCollection& collection,
+                 const std::u16string& text) {
+  std::vector<minikin::FontCollection::Run> runs;
+  collection.itemize(reinterpret_cast<const uint16_t*>(text.data()),
+                     text.size(), minikin::FontStyle(), &runs);
+  return runs.size();
+}
+
+}  // namespace
+
+TEST(FontCollection, PersistsFallbackFontsOffTheLayoutThread) {
+  files::ScopedTempDir temp_dir;
+  const std::string path = temp_dir.path() + "/flutter_fallback_fonts";
+  FileTaskQueue file_tasks;
+
+  auto collection = std::make_shared<FontCollection>();
+  collection->SetAssetFontManager(MakeFontManager());
+  collection->SetFallbackFontCachePath(path, file_tasks.GetTaskRunner());
+  const auto& family = collection->MatchFallbackFont(kHiraganaA, "ja");
+  ASSERT_TRUE(family);
+  ASSERT_TRUE(family->getCoverage().get(kHiraganaA));
+
+  // The file is only written by the posted task.
+  ASSERT_EQ(file_tasks.size(), 1u);
+  ASSERT_TRUE(ReadFallbackFontCache(path).empty());
+  file_tasks.RunTasks();
+
+  auto entries = ReadFallbackFontCache(path);
+  ASSERT_EQ(entries.size(), 1u);
+  ASSERT_EQ(entries[0].first, "ja");
+  ASSERT_FALSE(entries[0].second.empty());
+
+  // Resolving the character again does not append to the file.
+  collection->MatchFallbackFont(kHiraganaA, "ja");
+  ASSERT_EQ(file_tasks.size(), 0u);
+}
+
+TEST(FontCollection, ReadsPersistedFallbackFonts) {
+  files::ScopedTempDir temp_dir;
+  const std::string path = temp_dir.path() + "/flutter_fallback_fonts";
+  {
+    auto collection = std::make_shared<FontCollection>();
+    collection->SetAssetFontManager(MakeFontManager());
+    collection->SetFallbackFontCachePath(path);
+    ASSERT_TRUE(collection->MatchFallbackFont(kHiraganaA, "ja"));
+  }
+  {
+    // Malformed and unknown entries are skipped.
+    std::ofstream file(path, std::ios::app);
+    file << "no separator\n";
+    file << "ja\tNot a real font!\n";
+  }
+
+  auto font_manager = MakeFontManager();
+  auto collection = std::make_shared<FontCollection>();
+  collection->SetAssetFontManager(font_manager);
+  collection->SetFallbackFontCachePath(path);
+  const auto& family = collection->MatchFallbackFont(kHiraganaA, "ja");
+  ASSERT_TRUE(family);
+  ASSERT_TRUE(family->getCoverage().get(kHiraganaA));
+  ASSERT_EQ(font_manager->character_match_count(), 0);
+
+  // Other locales do not use the persisted families.
+  ASSERT_TRUE(collection->MatchFallbackFont(kHiraganaA, "ko"));
+  ASSERT_EQ(font_manager->character_match_count(), 1);
+}
+
+TEST(FontCollection, CachesUnmatchedCharacters) {
+  auto font_manager = MakeFontManager();
+  auto collection = std::make_shared<FontCollection>();
+  collection->SetAssetFontManager(font_manager);
+
+  ASSERT_FALSE(collection->MatchFallbackFont(kPrivateUse, "ja"));
+  ASSERT_EQ(font_manager->character_match_count(), 1);
+  ASSERT_FALSE(collection->MatchFallbackFont(kPrivateUse, "ja"));
+  ASSERT_EQ(font_manager->character_match_count(), 1);
+
+  // The cache is per locale.
+  ASSERT_FALSE(collection->MatchFallbackFont(kPrivateUse, "ko"));
+  ASSERT_EQ(font_manager->character_match_count(), 2);
+
+  // Registering fonts may add a glyph for the character.
+  collection->SetTestFontManager(MakeFontManager());
+  ASSERT_FALSE(collection->MatchFallbackFont(kPrivateUse, "ja"));
+  ASSERT_EQ(font_manager->character_match_count(), 3);
+}
+
+TEST(FontCollection, RecreatesCachedCollectionsOfLocalesWithFallbackFonts) {
+  auto font_manager = MakeFontManager();
+  auto collection = std::make_shared<FontCollection>();
+  collection->SetAssetFontManager(font_manager);
+
+  auto before = collection->GetMinikinFontCollectionForFamily("Roboto", "ja");
+  ASSERT_TRUE(before);
+  ASSERT_EQ(collection->GetMinikinFontCollectionForFamily("Roboto", "ja"),
+            before);
+  auto other_locale =
+      collection->GetMinikinFontCollectionForFamily("Roboto", "ko");
+  ASSERT_TRUE(other_locale);
+
+  ASSERT_TRUE(collection->MatchFallbackFont(kHiraganaA, "ja"));
+  const int family_match_count = font_manager->family_match_count();
+  auto after = collection->GetMinikinFontCollectionForFamily("Roboto", "ja");
+  ASSERT_NE(after, before);
+  ASSERT_EQ(collection->GetMinikinFontCollectionForFamily("Roboto", "ja"),
+            after);
+  // The families of the recreated collection are not matched again.
+  ASSERT_EQ(font_manager->family_match_count(), family_match_count);
+
+  // Collections of locales that did not gain the family are kept.
+  ASSERT_EQ(collection->GetMinikinFontCollectionForFamily("Roboto", "ko"),
+            other_locale);
+
+  // Without the fallback font provider only the recreated collection has the
+  // fallback family.
+  collection.reset();
+  ASSERT_EQ(CountRuns(*before, u"a\u3042"), 1u);
+  ASSERT_EQ(CountRuns(*after, u"a\u3042"), 2u);
+  ASSERT_EQ(CountRuns(*other_locale, u"a\u3042"), 1u);
+}
+
 #if 0
 
 TEST(FontCollection, HasDefaultRegistrations) {
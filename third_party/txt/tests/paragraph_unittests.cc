@@ -21,6 +21,7 @@
 #include "txt/font_style.h"
 #include "txt/font_weight.h"
 #include "txt/paragraph.h"
+#include "txt/paragraph_batch.h"
 #include "txt/paragraph_builder.h"
 #include "txt_test_utils.h"
 
@@ -1569,4 +1570,54 @@ TEST_F(ParagraphTest, Ellipsize) {
   ASSERT_EQ(paragraph->records_.size(), 1ull);
 }
 
+TEST_F(ParagraphTest, BatchLayoutParagraph) {
+  const char* texts[] = {
+      "Short item",
+      "A longer item whose text wraps onto more than one line of the list.",
+      "An item with\na hard line break",
+      "Short item",
+  };
+
+  txt::ParagraphStyle paragraph_style;
+  txt::TextStyle text_style;
+  text_style.font_family = "Roboto";
+  text_style.font_size = 26;
+  text_style.color = SK_ColorBLACK;
+
+  auto build_paragraph = [&](const char* text) {
+    auto icu_text = icu::UnicodeString::fromUTF8(text);
+    std::u16string u16_text(icu_text.getBuffer(),
+                            icu_text.getBuffer() + icu_text.length());
+    txt::ParagraphBuilder builder(paragraph_style, GetTestFontCollection());
+    builder.PushStyle(text_style);
+    builder.AddText(u16_text);
+    builder.Pop();
+    return builder.Build();
+  };
+
+  std::vector<std::unique_ptr<Paragraph>> paragraphs;
+  std::vector<std::unique_ptr<Paragraph>> batched_paragraphs;
+  ParagraphBatch batch;
+  for (const char* text : texts) {
+    paragraphs.push_back(build_paragraph(text));
+    paragraphs.back()->Layout(300);
+    batched_paragraphs.push_back(build_paragraph(text));
+    batch.AddParagraph(batched_paragraphs.back().get(), 300);
+  }
+  ASSERT_EQ(batch.size(), batched_paragraphs.size());
+  batch.Layout();
+  ASSERT_EQ(batch.size(), 0ull);
+
+  for (size_t i = 0; i < paragraphs.size(); ++i) {
+    EXPECT_EQ(batched_paragraphs[i]->GetLineCount(),
+              paragraphs[i]->GetLineCount());
+    EXPECT_DOUBLE_EQ(batched_paragraphs[i]->GetHeight(),
+                     paragraphs[i]->GetHeight());
+    EXPECT_DOUBLE_EQ(batched_paragraphs[i]->GetMaxIntrinsicWidth(),
+                     paragraphs[i]->GetMaxIntrinsicWidth());
+    EXPECT_EQ(batched_paragraphs[i]->records_.size(),
+              paragraphs[i]->records_.size());
+  }
+}
+
 }  // namespace txt
@@ -18,6 +18,7 @@
 
 #include "lib/fxl/command_line.h"
 #include "txt/font_collection.h"
+#include "txt/typeface_font_asset_provider.h"
 
 namespace txt {
 
@@ -29,6 +30,9 @@ const fxl::CommandLine& GetCommandLineForProcess();
 
 void SetCommandLine(fxl::CommandLine cmd);
 
+void RegisterFontsFromPath(TypefaceFontAssetProvider& font_provider,
+                           std::string directory_path);
+
 std::shared_ptr<FontCollection> GetTestFontCollection();
 
 }  // namespace txt
@@ -13,18 +13,8 @@
 namespace vulkan {
 
 VulkanBackbuffer::VulkanBackbuffer(const VulkanProcTable& p_vk,
-                                   const VulkanHandle<VkDevice>& device,
-                                   const VulkanHandle<VkCommandPool>& pool)
-    : vk(p_vk),
-      device_(device),
-      usage_command_buffer_(p_vk, device, pool),
-      render_command_buffer_(p_vk, device, pool),
-      valid_(false) {
-  if (!usage_command_buffer_.IsValid() || !render_command_buffer_.IsValid()) {
-    FXL_DLOG(INFO) << "Command buffers were not valid.";
-    return;
-  }
-
+                                   const VulkanHandle<VkDevice>& device)
+    : vk(p_vk), device_(device), valid_(false) {
   if (!CreateSemaphores()) {
     FXL_DLOG(INFO) << "Could not create semaphores.";
     return;
@@ -136,12 +126,4 @@ const VulkanHandle<VkSemaphore>& VulkanBackbuffer::GetRenderSemaphore() const {
   return semaphores_[1];
 }
 
-VulkanCommandBuffer& VulkanBackbuffer::GetUsageCommandBuffer() {
-  return usage_command_buffer_;
-}
-
-VulkanCommandBuffer& VulkanBackbuffer::GetRenderCommandBuffer() {
-  return render_command_buffer_;
-}
-
 }  // namespace vulkan
@@ -7,20 +7,21 @@
 
 #include <array>
 
-#include "flutter/vulkan/vulkan_command_buffer.h"
 #include "flutter/vulkan/vulkan_handle.h"
 #include "lib/fxl/compiler_specific.h"
 #include "lib/fxl/macros.h"
-#include "third_party/skia/include/core/SkSize.h"
-#include "third_party/skia/include/core/SkSurface.h"
 
 namespace vulkan {
 
+class VulkanProcTable;
+
+// The synchronization primitives of one frame in flight. The swapchain cycles
+// through a ring of these so that the CPU can record a frame while the GPU is
+// still working on the previous ones.
 class VulkanBackbuffer {
  public:
   VulkanBackbuffer(const VulkanProcTable& vk,
-                   const VulkanHandle<VkDevice>& device,
-                   const VulkanHandle<VkCommandPool>& pool);
+                   const VulkanHandle<VkDevice>& device);
 
   ~VulkanBackbuffer();
 
@@ -40,17 +41,11 @@ class VulkanBackbuffer {
 
   const VulkanHandle<VkSemaphore>& GetRenderSemaphore() const;
 
-  VulkanCommandBuffer& GetUsageCommandBuffer();
-
-  VulkanCommandBuffer& GetRenderCommandBuffer();
-
  private:
   const VulkanProcTable& vk;
   const VulkanHandle<VkDevice>& device_;
   std::array<VulkanHandle<VkSemaphore>, 2> semaphores_;
   std::array<VulkanHandle<VkFence>, 2> use_fences_;
-  VulkanCommandBuffer usage_command_buffer_;
-  VulkanCommandBuffer render_command_buffer_;
   bool valid_;
 
   bool CreateSemaphores();
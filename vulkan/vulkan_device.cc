@@ -4,6 +4,7 @@
 
 #include "flutter/vulkan/vulkan_device.h"
 
+#include <algorithm>
 #include <limits>
 #include <map>
 #include <vector>
@@ -302,11 +303,38 @@ int VulkanDevice::ChooseSurfaceFormat(const VulkanSurface& surface,
 }
 
 bool VulkanDevice::ChoosePresentMode(const VulkanSurface& surface,
+                                     bool prefer_low_latency,
                                      VkPresentModeKHR* present_mode) const {
   if (!surface.IsValid() || present_mode == nullptr) {
     return false;
   }
 
+  *present_mode = VK_PRESENT_MODE_FIFO_KHR;
+  if (!prefer_low_latency) {
+    return true;
+  }
+
+  uint32_t mode_count = 0;
+  if (VK_CALL_LOG_ERROR(vk.GetPhysicalDeviceSurfacePresentModesKHR(
+          physical_device_, surface.Handle(), &mode_count, nullptr)) !=
+      VK_SUCCESS) {
+    return true;
+  }
+
+  std::vector<VkPresentModeKHR> modes(mode_count);
+  if (VK_CALL_LOG_ERROR(vk.GetPhysicalDeviceSurfacePresentModesKHR(
+          physical_device_, surface.Handle(), &mode_count, modes.data())) !=
+      VK_SUCCESS) {
+    return true;
+  }
+
+  *present_mode = ChoosePresentMode(modes, prefer_low_latency);
+  return true;
+}
+
+VkPresentModeKHR VulkanDevice::ChoosePresentMode(
+    const std::vector<VkPresentModeKHR>& supported_modes,
+    bool prefer_low_latency) {
   // https://github.com/LunarG/VulkanSamples/issues/98 indicates that
   // VK_PRESENT_MODE_FIFO_KHR is preferable on mobile platforms. The problems
   // mentioned in the ticket w.r.t the application being faster that the refresh
@@ -314,11 +342,22 @@ bool VulkanDevice::ChoosePresentMode(const VulkanSurface& surface,
   // powered by Vsync pulses instead of depending the the submit to block.
   // However, for platforms that don't have VSync providers setup, it is better
   // to fall back to FIFO. For platforms that do have VSync providers, there
-  // should be little difference. In case there is a need for a mode other than
-  // FIFO, availability checks must be performed here before returning the
-  // result. FIFO is always present.
-  *present_mode = VK_PRESENT_MODE_FIFO_KHR;
-  return true;
+  // should be little difference. FIFO is always present.
+  if (!prefer_low_latency) {
+    return VK_PRESENT_MODE_FIFO_KHR;
+  }
+
+  // Mailbox replaces the queued image instead of tearing, so it is preferred
+  // over immediate presentation.
+  for (VkPresentModeKHR preferred :
+       {VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_IMMEDIATE_KHR}) {
+    if (std::find(supported_modes.begin(), supported_modes.end(),
+                  preferred) != supported_modes.end()) {
+      return preferred;
+    }
+  }
+
+  return VK_PRESENT_MODE_FIFO_KHR;
 }
 
 bool VulkanDevice::QueueSubmit(
@@ -53,10 +53,18 @@ class VulkanDevice {
                           std::vector<VkFormat> desired_formats,
                           VkSurfaceFormatKHR* format) const;
 
+  // If |prefer_low_latency| is set, mailbox or immediate presentation is
+  // chosen when the surface supports it. FIFO is chosen otherwise.
   FXL_WARN_UNUSED_RESULT
   bool ChoosePresentMode(const VulkanSurface& surface,
+                         bool prefer_low_latency,
                          VkPresentModeKHR* present_mode) const;
 
+  // Picks the present mode among the |supported_modes| of a surface.
+  static VkPresentModeKHR ChoosePresentMode(
+      const std::vector<VkPresentModeKHR>& supported_modes,
+      bool prefer_low_latency);
+
   FXL_WARN_UNUSED_RESULT
   bool QueueSubmit(std::vector<VkPipelineStageFlags> wait_dest_pipeline_stages,
                    const std::vector<VkSemaphore>& wait_semaphores,
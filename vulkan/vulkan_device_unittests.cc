@@ -0,0 +1,54 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <vector>
+
+#include "flutter/vulkan/vulkan_device.h"
+#include "gtest/gtest.h"
+
+namespace vulkan {
+namespace {
+
+TEST(VulkanDevice, ChoosesFifoByDefault) {
+  const std::vector<VkPresentModeKHR> modes = {
+      VK_PRESENT_MODE_IMMEDIATE_KHR,
+      VK_PRESENT_MODE_MAILBOX_KHR,
+      VK_PRESENT_MODE_FIFO_KHR,
+  };
+  EXPECT_EQ(VulkanDevice::ChoosePresentMode(modes, false),
+            VK_PRESENT_MODE_FIFO_KHR);
+}
+
+TEST(VulkanDevice, PrefersMailboxForLowLatency) {
+  const std::vector<VkPresentModeKHR> modes = {
+      VK_PRESENT_MODE_IMMEDIATE_KHR,
+      VK_PRESENT_MODE_FIFO_KHR,
+      VK_PRESENT_MODE_MAILBOX_KHR,
+  };
+  EXPECT_EQ(VulkanDevice::ChoosePresentMode(modes, true),
+            VK_PRESENT_MODE_MAILBOX_KHR);
+}
+
+TEST(VulkanDevice, FallsBackToImmediateForLowLatency) {
+  const std::vector<VkPresentModeKHR> modes = {
+      VK_PRESENT_MODE_FIFO_KHR,
+      VK_PRESENT_MODE_IMMEDIATE_KHR,
+  };
+  EXPECT_EQ(VulkanDevice::ChoosePresentMode(modes, true),
+            VK_PRESENT_MODE_IMMEDIATE_KHR);
+}
+
+TEST(VulkanDevice, FallsBackToFifoWithoutLowLatencyModes) {
+  const std::vector<VkPresentModeKHR> modes = {
+      VK_PRESENT_MODE_FIFO_KHR,
+      VK_PRESENT_MODE_FIFO_RELAXED_KHR,
+  };
+  EXPECT_EQ(VulkanDevice::ChoosePresentMode(modes, true),
+            VK_PRESENT_MODE_FIFO_KHR);
+  EXPECT_EQ(VulkanDevice::ChoosePresentMode({}, true),
+            VK_PRESENT_MODE_FIFO_KHR);
+}
+
+}  // namespace
+}  // namespace vulkan
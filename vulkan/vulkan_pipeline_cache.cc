@@ -0,0 +1,299 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/vulkan/vulkan_pipeline_cache.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <utility>
+
+#include "flutter/fml/paths.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/vulkan/vulkan_device.h"
+#include "flutter/vulkan/vulkan_proc_table.h"
+#include "lib/fxl/files/file.h"
+#include "lib/fxl/logging.h"
+
+namespace vulkan {
+
+namespace {
+
+// The pipeline cache procs handed to Skia are plain function pointers. They
+// find the cache of their device here.
+struct Registry {
+  std::mutex mutex;
+  std::map<VkDevice, VulkanPipelineCache*> caches;
+  // Kept after the cache of the device is gone, so that pipeline caches Skia
+  // destroys later are still destroyed.
+  std::map<VkDevice, PFN_vkDestroyPipelineCache> destroy_procs;
+};
+
+Registry& GetRegistry() {
+  static Registry* registry = new Registry();
+  return *registry;
+}
+
+// The layout of the header of version one of the pipeline cache data. See
+// vkGetPipelineCacheData in the Vulkan specification.
+struct PipelineCacheHeader {
+  uint32_t header_length;
+  uint32_t header_version;
+  uint32_t vendor_id;
+  uint32_t device_id;
+  uint8_t pipeline_cache_uuid[VK_UUID_SIZE];
+};
+
+std::string ToHexString(uint32_t value) {
+  std::stringstream stream;
+  stream << std::hex << value;
+  return stream.str();
+}
+
+}  // namespace
+
+// Writes the cache data to disk. Writes may be issued from the IO thread and,
+// on shutdown, from the GPU thread. Data that is not larger than what has
+// already been written is dropped so that a late write never replaces newer
+// data.
+class VulkanPipelineCache::Writer {
+ public:
+  explicit Writer(std::string path) : path_(std::move(path)) {}
+
+  bool Write(const std::vector<uint8_t>& data) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (data.size() <= written_data_size_) {
+      return true;
+    }
+
+    TRACE_EVENT0("flutter", "VulkanPipelineCache::Write");
+
+    // Write to a temporary file first so that the next launch never sees
+    // partially written data.
+    const std::string temp_path = path_ + ".tmp";
+    if (!files::WriteFile(temp_path, reinterpret_cast<const char*>(data.data()),
+                          data.size())) {
+      FXL_DLOG(WARNING) << "Could not write the pipeline cache to "
+                        << temp_path;
+      return false;
+    }
+    if (::rename(temp_path.c_str(), path_.c_str()) != 0) {
+      ::remove(temp_path.c_str());
+      return false;
+    }
+
+    written_data_size_ = data.size();
+    return true;
+  }
+
+  const std::string& path() const { return path_; }
+
+ private:
+  const std::string path_;
+  std::mutex mutex_;
+  size_t written_data_size_ = 0;
+
+  FXL_DISALLOW_COPY_AND_ASSIGN(Writer);
+};
+
+VulkanPipelineCache::VulkanPipelineCache(
+    const VulkanProcTable& p_vk,
+    const VulkanDevice& device,
+    std::string directory,
+    fxl::RefPtr<fxl::TaskRunner> io_task_runner)
+    : vk(p_vk),
+      device_(device.GetHandle()),
+      io_task_runner_(std::move(io_task_runner)),
+      skia_pipeline_cache_(VK_NULL_HANDLE),
+      saved_data_size_(0) {
+  VkPhysicalDeviceProperties properties = {};
+  vk.GetPhysicalDeviceProperties(device.GetPhysicalDeviceHandle(),
+                                 &properties);
+
+  // Devices of the same model share a cache.
+  writer_ = std::make_shared<Writer>(fml::paths::JoinPaths(
+      {directory, "flutter_vk_pipeline_cache_" +
+                      ToHexString(properties.vendorID) + "_" +
+                      ToHexString(properties.deviceID)}));
+
+  std::string data;
+  if (files::ReadFileToString(writer_->path(), &data)) {
+    initial_data_.assign(data.begin(), data.end());
+    if (!IsDataCompatible(initial_data_, properties)) {
+      FXL_DLOG(INFO) << "Discarding the pipeline cache of another driver.";
+      initial_data_.clear();
+    }
+  }
+  saved_data_size_ = initial_data_.size();
+
+  Registry& registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.caches[device_] = this;
+  registry.destroy_procs[device_] = vk.DestroyPipelineCache;
+}
+
+VulkanPipelineCache::~VulkanPipelineCache() {
+  Registry& registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.caches.erase(device_);
+}
+
+bool VulkanPipelineCache::IsDataCompatible(
+    const std::vector<uint8_t>& data,
+    const VkPhysicalDeviceProperties& properties) {
+  PipelineCacheHeader header = {};
+  if (data.size() < sizeof(header)) {
+    return false;
+  }
+  memcpy(&header, data.data(), sizeof(header));
+
+  return header.header_length >= sizeof(header) &&
+         header.header_length <= data.size() &&
+         header.header_version == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+         header.vendor_id == properties.vendorID &&
+         header.device_id == properties.deviceID &&
+         memcmp(header.pipeline_cache_uuid, properties.pipelineCacheUUID,
+                VK_UUID_SIZE) == 0;
+}
+
+GrVkGetProc VulkanPipelineCache::WrapSkiaGetProc(GrVkGetProc get_proc) const {
+  return [get_proc](const char* proc_name, VkInstance instance,
+                    VkDevice device) -> PFN_vkVoidFunction {
+    if (strcmp(proc_name, "vkCreatePipelineCache") == 0) {
+      return reinterpret_cast<PFN_vkVoidFunction>(
+          &VulkanPipelineCache::CreatePipelineCache);
+    }
+    if (strcmp(proc_name, "vkDestroyPipelineCache") == 0) {
+      return reinterpret_cast<PFN_vkVoidFunction>(
+          &VulkanPipelineCache::DestroyPipelineCache);
+    }
+    return get_proc(proc_name, instance, device);
+  };
+}
+
+bool VulkanPipelineCache::CopyDataIfGrown(std::vector<uint8_t>* data) {
+  if (skia_pipeline_cache_ == VK_NULL_HANDLE) {
+    return false;
+  }
+
+  size_t data_size = 0;
+  if (VK_CALL_LOG_ERROR(vk.GetPipelineCacheData(
+          device_, skia_pipeline_cache_, &data_size, nullptr)) != VK_SUCCESS) {
+    return false;
+  }
+
+  // Pipeline caches only ever grow.
+  if (data_size <= saved_data_size_) {
+    return true;
+  }
+
+  TRACE_EVENT0("flutter", "VulkanPipelineCache::CopyData");
+
+  data->resize(data_size);
+  if (VK_CALL_LOG_ERROR(vk.GetPipelineCacheData(device_, skia_pipeline_cache_,
+                                                &data_size, data->data())) !=
+      VK_SUCCESS) {
+    data->clear();
+    return false;
+  }
+  data->resize(data_size);
+
+  saved_data_size_ = data_size;
+  return true;
+}
+
+bool VulkanPipelineCache::Save() {
+  auto data = std::make_shared<std::vector<uint8_t>>();
+  if (!CopyDataIfGrown(data.get())) {
+    return false;
+  }
+  if (data->empty()) {
+    return true;
+  }
+
+  if (!io_task_runner_) {
+    return writer_->Write(*data);
+  }
+
+  io_task_runner_->PostTask([writer = writer_, data]() {
+    FXL_ALLOW_UNUSED_LOCAL(writer->Write(*data));
+  });
+  return true;
+}
+
+VkResult VulkanPipelineCache::CreatePipelineCache(
+    VkDevice device,
+    const VkPipelineCacheCreateInfo* create_info,
+    const VkAllocationCallbacks* allocator,
+    VkPipelineCache* pipeline_cache) {
+  Registry& registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  auto found = registry.caches.find(device);
+  if (found == registry.caches.end()) {
+    return VK_ERROR_INITIALIZATION_FAILED;
+  }
+  VulkanPipelineCache* cache = found->second;
+
+  VkPipelineCacheCreateInfo seeded_create_info = *create_info;
+  if (seeded_create_info.initialDataSize == 0 &&
+      !cache->initial_data_.empty()) {
+    seeded_create_info.initialDataSize = cache->initial_data_.size();
+    seeded_create_info.pInitialData = cache->initial_data_.data();
+  }
+
+  VkResult result = cache->vk.CreatePipelineCache(device, &seeded_create_info,
+                                                  allocator, pipeline_cache);
+  if (result != VK_SUCCESS && seeded_create_info.initialDataSize !=
+                                  create_info->initialDataSize) {
+    // The driver rejected data that looked compatible. Start over.
+    cache->saved_data_size_ = 0;
+    result = cache->vk.CreatePipelineCache(device, create_info, allocator,
+                                           pipeline_cache);
+  }
+
+  if (result == VK_SUCCESS && cache->skia_pipeline_cache_ == VK_NULL_HANDLE) {
+    cache->skia_pipeline_cache_ = *pipeline_cache;
+  }
+
+  // The initial data is no longer needed.
+  cache->initial_data_.clear();
+  cache->initial_data_.shrink_to_fit();
+
+  return result;
+}
+
+void VulkanPipelineCache::DestroyPipelineCache(
+    VkDevice device,
+    VkPipelineCache pipeline_cache,
+    const VkAllocationCallbacks* allocator) {
+  Registry& registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  auto found = registry.caches.find(device);
+  if (found == registry.caches.end()) {
+    FXL_DLOG(ERROR) << "The pipeline cache was collected before the GrContext.";
+    auto destroy_proc = registry.destroy_procs.find(device);
+    if (destroy_proc != registry.destroy_procs.end()) {
+      destroy_proc->second(device, pipeline_cache, allocator);
+    }
+    return;
+  }
+  VulkanPipelineCache* cache = found->second;
+
+  if (pipeline_cache == cache->skia_pipeline_cache_) {
+    // The IO thread may be gone by the time the GrContext is collected on
+    // shutdown, so the final data is written right away.
+    std::vector<uint8_t> data;
+    if (cache->CopyDataIfGrown(&data) && !data.empty()) {
+      FXL_ALLOW_UNUSED_LOCAL(cache->writer_->Write(data));
+    }
+    cache->skia_pipeline_cache_ = VK_NULL_HANDLE;
+  }
+
+  cache->vk.DestroyPipelineCache(device, pipeline_cache, allocator);
+}
+
+}  // namespace vulkan
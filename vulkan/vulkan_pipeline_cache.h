@@ -0,0 +1,86 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_VULKAN_VULKAN_PIPELINE_CACHE_H_
+#define FLUTTER_VULKAN_VULKAN_PIPELINE_CACHE_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/vulkan/vulkan_handle.h"
+#include "lib/fxl/compiler_specific.h"
+#include "lib/fxl/macros.h"
+#include "lib/fxl/tasks/task_runner.h"
+#include "third_party/skia/include/gpu/vk/GrVkBackendContext.h"
+
+namespace vulkan {
+
+class VulkanProcTable;
+class VulkanDevice;
+
+// Persists the pipeline cache of a device across launches so that pipelines do
+// not have to be compiled again on the first use of each effect.
+//
+// Skia creates and owns the pipeline cache of its Vulkan backend. The procs
+// returned by the getter from |WrapSkiaGetProc| seed the cache Skia creates
+// with the data stored on disk and store its data when Skia destroys it. The
+// pipeline cache must outlive the GrContext it was wrapped for.
+class VulkanPipelineCache {
+ public:
+  // The cache is stored in |directory| which must exist. Files are written on
+  // |io_task_runner| if one is given and on the calling thread otherwise.
+  VulkanPipelineCache(const VulkanProcTable& vk,
+                      const VulkanDevice& device,
+                      std::string directory,
+                      fxl::RefPtr<fxl::TaskRunner> io_task_runner = nullptr);
+
+  ~VulkanPipelineCache();
+
+  GrVkGetProc WrapSkiaGetProc(GrVkGetProc get_proc) const;
+
+  // Stores the data of the pipeline cache of Skia if it has grown since it was
+  // last stored. The data is copied on the calling thread and written to disk
+  // on the IO task runner.
+  FXL_WARN_UNUSED_RESULT
+  bool Save();
+
+  // Checks the header of the cache data against the device the data is going
+  // to be used with. Data from other devices or drivers is rejected by drivers
+  // anyway but some drivers have been known to crash instead.
+  static bool IsDataCompatible(const std::vector<uint8_t>& data,
+                               const VkPhysicalDeviceProperties& properties);
+
+ private:
+  class Writer;
+
+  const VulkanProcTable& vk;
+  const VkDevice device_;
+  fxl::RefPtr<fxl::TaskRunner> io_task_runner_;
+  std::shared_ptr<Writer> writer_;
+  std::vector<uint8_t> initial_data_;
+  VkPipelineCache skia_pipeline_cache_;
+  size_t saved_data_size_;
+
+  // Copies the data of the pipeline cache of Skia into |data| if it has grown
+  // since it was last copied.
+  bool CopyDataIfGrown(std::vector<uint8_t>* data);
+
+  static VKAPI_ATTR VkResult VKAPI_CALL
+  CreatePipelineCache(VkDevice device,
+                      const VkPipelineCacheCreateInfo* create_info,
+                      const VkAllocationCallbacks* allocator,
+                      VkPipelineCache* pipeline_cache);
+
+  static VKAPI_ATTR void VKAPI_CALL
+  DestroyPipelineCache(VkDevice device,
+                       VkPipelineCache pipeline_cache,
+                       const VkAllocationCallbacks* allocator);
+
+  FXL_DISALLOW_COPY_AND_ASSIGN(VulkanPipelineCache);
+};
+
+}  // namespace vulkan
+
+#endif  // FLUTTER_VULKAN_VULKAN_PIPELINE_CACHE_H_
@@ -0,0 +1,118 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string.h>
+
+#include <vector>
+
+#include "flutter/vulkan/vulkan_pipeline_cache.h"
+#include "gtest/gtest.h"
+
+namespace vulkan {
+namespace {
+
+const uint32_t kVendorId = 0x13b5;
+const uint32_t kDeviceId = 0x7212;
+
+VkPhysicalDeviceProperties CreateProperties() {
+  VkPhysicalDeviceProperties properties = {};
+  properties.vendorID = kVendorId;
+  properties.deviceID = kDeviceId;
+  for (size_t i = 0; i < VK_UUID_SIZE; i++) {
+    properties.pipelineCacheUUID[i] = static_cast<uint8_t>(i + 1);
+  }
+  return properties;
+}
+
+// Lays out the header of version one of the pipeline cache data followed by
+// |payload_size| bytes of driver data.
+std::vector<uint8_t> CreateData(const VkPhysicalDeviceProperties& properties,
+                                size_t payload_size = 64) {
+  const uint32_t header[] = {
+      16 + VK_UUID_SIZE,
+      VK_PIPELINE_CACHE_HEADER_VERSION_ONE,
+      properties.vendorID,
+      properties.deviceID,
+  };
+  std::vector<uint8_t> data(sizeof(header) + VK_UUID_SIZE + payload_size, 0xab);
+  memcpy(data.data(), header, sizeof(header));
+  memcpy(data.data() + sizeof(header), properties.pipelineCacheUUID,
+         VK_UUID_SIZE);
+  return data;
+}
+
+void SetWord(std::vector<uint8_t>* data, size_t index, uint32_t value) {
+  memcpy(data->data() + index * sizeof(uint32_t), &value, sizeof(value));
+}
+
+TEST(VulkanPipelineCache, AcceptsDataOfTheSameDevice) {
+  const auto properties = CreateProperties();
+  EXPECT_TRUE(VulkanPipelineCache::IsDataCompatible(CreateData(properties),
+                                                    properties));
+  // A header without driver data is still well formed.
+  EXPECT_TRUE(VulkanPipelineCache::IsDataCompatible(CreateData(properties, 0),
+                                                    properties));
+}
+
+TEST(VulkanPipelineCache, RejectsTruncatedData) {
+  const auto properties = CreateProperties();
+  auto data = CreateData(properties, 0);
+
+  EXPECT_FALSE(VulkanPipelineCache::IsDataCompatible({}, properties));
+  data.pop_back();
+  EXPECT_FALSE(VulkanPipelineCache::IsDataCompatible(data, properties));
+}
+
+TEST(VulkanPipelineCache, RejectsMalformedHeaderLength) {
+  const auto properties = CreateProperties();
+  auto data = CreateData(properties);
+
+  // Shorter than the header itself.
+  SetWord(&data, 0, 8);
+  EXPECT_FALSE(VulkanPipelineCache::IsDataCompatible(data, properties));
+
+  // Longer than the data.
+  SetWord(&data, 0, data.size() + 1);
+  EXPECT_FALSE(VulkanPipelineCache::IsDataCompatible(data, properties));
+
+  // Longer headers of later revisions are fine as long as they fit.
+  SetWord(&data, 0, data.size());
+  EXPECT_TRUE(VulkanPipelineCache::IsDataCompatible(data, properties));
+}
+
+TEST(VulkanPipelineCache, RejectsUnknownHeaderVersion) {
+  const auto properties = CreateProperties();
+  auto data = CreateData(properties);
+
+  SetWord(&data, 1, VK_PIPELINE_CACHE_HEADER_VERSION_ONE + 1);
+  EXPECT_FALSE(VulkanPipelineCache::IsDataCompatible(data, properties));
+}
+
+TEST(VulkanPipelineCache, RejectsDataOfOtherDevices) {
+  const auto properties = CreateProperties();
+  const auto data = CreateData(properties);
+
+  auto other_vendor = properties;
+  other_vendor.vendorID++;
+  EXPECT_FALSE(VulkanPipelineCache::IsDataCompatible(data, other_vendor));
+
+  auto other_device = properties;
+  other_device.deviceID++;
+  EXPECT_FALSE(VulkanPipelineCache::IsDataCompatible(data, other_device));
+}
+
+TEST(VulkanPipelineCache, RejectsDataOfOtherDrivers) {
+  const auto properties = CreateProperties();
+  const auto data = CreateData(properties);
+
+  // Driver updates change the UUID but not the device.
+  for (size_t i = 0; i < VK_UUID_SIZE; i += VK_UUID_SIZE - 1) {
+    auto other_driver = properties;
+    other_driver.pipelineCacheUUID[i] ^= 0xff;
+    EXPECT_FALSE(VulkanPipelineCache::IsDataCompatible(data, other_driver));
+  }
+}
+
+}  // namespace
+}  // namespace vulkan
@@ -79,6 +79,7 @@ bool VulkanProcTable::SetupInstanceProcAddresses(
   ACQUIRE_PROC(EnumeratePhysicalDevices, handle);
   ACQUIRE_PROC(GetDeviceProcAddr, handle);
   ACQUIRE_PROC(GetPhysicalDeviceFeatures, handle);
+  ACQUIRE_PROC(GetPhysicalDeviceProperties, handle);
   ACQUIRE_PROC(GetPhysicalDeviceQueueFamilyProperties, handle);
   ACQUIRE_PROC(GetPhysicalDeviceSurfaceCapabilitiesKHR, handle);
   ACQUIRE_PROC(GetPhysicalDeviceSurfaceFormatsKHR, handle);
@@ -123,11 +124,13 @@ bool VulkanProcTable::SetupDeviceProcAddresses(
   ACQUIRE_PROC(CreateCommandPool, handle);
   ACQUIRE_PROC(CreateFence, handle);
   ACQUIRE_PROC(CreateImage, handle);
+  ACQUIRE_PROC(CreatePipelineCache, handle);
   ACQUIRE_PROC(CreateSemaphore, handle);
   ACQUIRE_PROC(CreateSwapchainKHR, handle);
   ACQUIRE_PROC(DestroyCommandPool, handle);
   ACQUIRE_PROC(DestroyFence, handle);
   ACQUIRE_PROC(DestroyImage, handle);
+  ACQUIRE_PROC(DestroyPipelineCache, handle);
   ACQUIRE_PROC(DestroySemaphore, handle);
   ACQUIRE_PROC(DestroySwapchainKHR, handle);
   ACQUIRE_PROC(DeviceWaitIdle, handle);
@@ -136,6 +139,7 @@ bool VulkanProcTable::SetupDeviceProcAddresses(
   ACQUIRE_PROC(FreeMemory, handle);
   ACQUIRE_PROC(GetDeviceQueue, handle);
   ACQUIRE_PROC(GetImageMemoryRequirements, handle);
+  ACQUIRE_PROC(GetPipelineCacheData, handle);
   ACQUIRE_PROC(GetSwapchainImagesKHR, handle);
   ACQUIRE_PROC(QueuePresentKHR, handle);
   ACQUIRE_PROC(QueueSubmit, handle);
@@ -75,6 +75,7 @@ class VulkanProcTable : public fxl::RefCountedThreadSafe<VulkanProcTable> {
   DEFINE_PROC(CreateFence);
   DEFINE_PROC(CreateImage);
   DEFINE_PROC(CreateInstance);
+  DEFINE_PROC(CreatePipelineCache);
   DEFINE_PROC(CreateSemaphore);
   DEFINE_PROC(CreateSwapchainKHR);
   DEFINE_PROC(DestroyCommandPool);
@@ -83,6 +84,7 @@ class VulkanProcTable : public fxl::RefCountedThreadSafe<VulkanProcTable> {
   DEFINE_PROC(DestroyFence);
   DEFINE_PROC(DestroyImage);
   DEFINE_PROC(DestroyInstance);
+  DEFINE_PROC(DestroyPipelineCache);
   DEFINE_PROC(DestroySemaphore);
   DEFINE_PROC(DestroySurfaceKHR);
   DEFINE_PROC(DestroySwapchainKHR);
@@ -99,11 +101,13 @@ class VulkanProcTable : public fxl::RefCountedThreadSafe<VulkanProcTable> {
   DEFINE_PROC(GetImageMemoryRequirements);
   DEFINE_PROC(GetInstanceProcAddr);
   DEFINE_PROC(GetPhysicalDeviceFeatures);
+  DEFINE_PROC(GetPhysicalDeviceProperties);
   DEFINE_PROC(GetPhysicalDeviceQueueFamilyProperties);
   DEFINE_PROC(GetPhysicalDeviceSurfaceCapabilitiesKHR);
   DEFINE_PROC(GetPhysicalDeviceSurfaceFormatsKHR);
   DEFINE_PROC(GetPhysicalDeviceSurfacePresentModesKHR);
   DEFINE_PROC(GetPhysicalDeviceSurfaceSupportKHR);
+  DEFINE_PROC(GetPipelineCacheData);
   DEFINE_PROC(GetSwapchainImagesKHR);
   DEFINE_PROC(QueuePresentKHR);
   DEFINE_PROC(QueueSubmit);
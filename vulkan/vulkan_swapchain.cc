@@ -4,11 +4,16 @@
 
 #include "flutter/vulkan/vulkan_swapchain.h"
 
+#include <algorithm>
+
+#include "flutter/fml/trace_event.h"
 #include "flutter/vulkan/vulkan_backbuffer.h"
+#include "flutter/vulkan/vulkan_command_buffer.h"
 #include "flutter/vulkan/vulkan_device.h"
 #include "flutter/vulkan/vulkan_image.h"
 #include "flutter/vulkan/vulkan_proc_table.h"
 #include "flutter/vulkan/vulkan_surface.h"
+#include "lib/fxl/time/time_point.h"
 #include "third_party/skia/include/gpu/GrBackendSurface.h"
 #include "third_party/skia/include/gpu/GrContext.h"
 #include "third_party/skia/include/gpu/vk/GrVkTypes.h"
@@ -41,12 +46,12 @@ VulkanSwapchain::VulkanSwapchain(const VulkanProcTable& p_vk,
                                  const VulkanSurface& surface,
                                  GrContext* skia_context,
                                  std::unique_ptr<VulkanSwapchain> old_swapchain,
-                                 uint32_t queue_family_index)
+                                 uint32_t queue_family_index,
+                                 const VulkanSwapchainOptions& options)
     : vk(p_vk),
       device_(device),
       capabilities_(),
       surface_format_(),
-      current_pipeline_stage_(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT),
       current_backbuffer_index_(0),
       current_image_index_(0),
       valid_(false) {
@@ -79,7 +84,9 @@ VulkanSwapchain::VulkanSwapchain(const VulkanProcTable& p_vk,
   }
 
   VkPresentModeKHR present_mode = VK_PRESENT_MODE_FIFO_KHR;
-  if (!device_.ChoosePresentMode(surface, &present_mode)) {
+  if (!device_.ChoosePresentMode(surface,
+                                 options.prefer_low_latency_present_mode,
+                                 &present_mode)) {
     FXL_DLOG(INFO) << "Could not choose present mode.";
     return;
   }
@@ -113,12 +120,22 @@ VulkanSwapchain::VulkanSwapchain(const VulkanProcTable& p_vk,
 
   VkSurfaceKHR surface_handle = surface.Handle();
 
+  // One more image than frames in flight lets the presentation engine hold on
+  // to an image without stalling the acquisition of the next one.
+  const size_t frames_in_flight = std::max<size_t>(options.frames_in_flight, 1);
+  uint32_t image_count = std::max(capabilities_.minImageCount,
+                                  static_cast<uint32_t>(frames_in_flight + 1));
+  if (capabilities_.maxImageCount > 0) {
+    // A maximum of zero means that there is no limit.
+    image_count = std::min(image_count, capabilities_.maxImageCount);
+  }
+
   const VkSwapchainCreateInfoKHR create_info = {
       .sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR,
       .pNext = nullptr,
       .flags = 0,
       .surface = surface_handle,
-      .minImageCount = capabilities_.minImageCount,
+      .minImageCount = image_count,
       .imageFormat = surface_format_.format,
       .imageColorSpace = surface_format_.colorSpace,
       .imageExtent = capabilities_.currentExtent,
@@ -156,10 +173,20 @@ VulkanSwapchain::VulkanSwapchain(const VulkanProcTable& p_vk,
     return;
   }
 
+  if (!CreateBackbuffers(frames_in_flight)) {
+    FXL_DLOG(INFO) << "Could not create backbuffers.";
+    return;
+  }
+
   valid_ = true;
 }
 
-VulkanSwapchain::~VulkanSwapchain() = default;
+VulkanSwapchain::~VulkanSwapchain() {
+  // The pre-recorded command buffers may still be in use by frames in flight.
+  for (const auto& backbuffer : backbuffers_) {
+    FXL_ALLOW_UNUSED_LOCAL(backbuffer->WaitFences());
+  }
+}
 
 bool VulkanSwapchain::IsValid() const {
   return valid_;
@@ -258,16 +285,6 @@ bool VulkanSwapchain::CreateSwapchainImages(GrContext* skia_context,
   const SkISize surface_size = GetSize();
 
   for (const VkImage& image : images) {
-    // Populate the backbuffer.
-    auto backbuffer = std::make_unique<VulkanBackbuffer>(
-        vk, device_.GetHandle(), device_.GetCommandPool());
-
-    if (!backbuffer->IsValid()) {
-      return false;
-    }
-
-    backbuffers_.emplace_back(std::move(backbuffer));
-
     // Populate the image.
     auto vulkan_image = std::make_unique<VulkanImage>(image);
 
@@ -275,6 +292,10 @@ bool VulkanSwapchain::CreateSwapchainImages(GrContext* skia_context,
       return false;
     }
 
+    if (!RecordLayoutTransitions(*vulkan_image)) {
+      return false;
+    }
+
     images_.emplace_back(std::move(vulkan_image));
 
     // Populate the surface.
@@ -288,12 +309,78 @@ bool VulkanSwapchain::CreateSwapchainImages(GrContext* skia_context,
     surfaces_.emplace_back(std::move(surface));
   }
 
-  FXL_DCHECK(backbuffers_.size() == images_.size());
   FXL_DCHECK(images_.size() == surfaces_.size());
+  FXL_DCHECK(images_.size() == acquire_command_buffers_.size());
+  FXL_DCHECK(images_.size() == present_command_buffers_.size());
 
   return true;
 }
 
+bool VulkanSwapchain::CreateBackbuffers(size_t frames_in_flight) {
+  // More frames in flight than images would only wait on image acquisition.
+  const size_t count = std::min(frames_in_flight, images_.size());
+
+  for (size_t i = 0; i < count; i++) {
+    auto backbuffer =
+        std::make_unique<VulkanBackbuffer>(vk, device_.GetHandle());
+
+    if (!backbuffer->IsValid()) {
+      return false;
+    }
+
+    backbuffers_.emplace_back(std::move(backbuffer));
+  }
+
+  image_backbuffers_.assign(images_.size(), nullptr);
+
+  return !backbuffers_.empty();
+}
+
+bool VulkanSwapchain::RecordLayoutTransitions(VulkanImage& image) {
+  auto acquire_command_buffer = std::make_unique<VulkanCommandBuffer>(
+      vk, device_.GetHandle(), device_.GetCommandPool());
+  auto present_command_buffer = std::make_unique<VulkanCommandBuffer>(
+      vk, device_.GetHandle(), device_.GetCommandPool());
+
+  if (!acquire_command_buffer->IsValid() ||
+      !present_command_buffer->IsValid()) {
+    return false;
+  }
+
+  // The image starts out in the undefined layout which is also a valid source
+  // layout for every later acquisition. The contents of the previous frame are
+  // discarded but every frame is rendered in full.
+  if (!acquire_command_buffer->Begin() ||
+      !image.InsertImageMemoryBarrier(
+          *acquire_command_buffer,                        // command buffer
+          VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,  // src_pipeline_bits
+          VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,  // dest_pipeline_bits
+          VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,           // dest_access_flags
+          VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL        // dest_layout
+          ) ||
+      !acquire_command_buffer->End()) {
+    FXL_DLOG(INFO) << "Could not record the acquire layout transition.";
+    return false;
+  }
+
+  if (!present_command_buffer->Begin() ||
+      !image.InsertImageMemoryBarrier(
+          *present_command_buffer,                        // command buffer
+          VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,  // src_pipeline_bits
+          VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,           // dest_pipeline_bits
+          VK_ACCESS_MEMORY_READ_BIT,                      // dest_access_flags
+          VK_IMAGE_LAYOUT_PRESENT_SRC_KHR                 // dest_layout
+          ) ||
+      !present_command_buffer->End()) {
+    FXL_DLOG(INFO) << "Could not record the present layout transition.";
+    return false;
+  }
+
+  acquire_command_buffers_.emplace_back(std::move(acquire_command_buffer));
+  present_command_buffers_.emplace_back(std::move(present_command_buffer));
+  return true;
+}
+
 VulkanBackbuffer* VulkanSwapchain::GetNextBackbuffer() {
   auto available_backbuffers = backbuffers_.size();
 
@@ -335,24 +422,24 @@ VulkanSwapchain::AcquireResult VulkanSwapchain::AcquireSurface() {
 
   // ---------------------------------------------------------------------------
   // Step 1:
-  // Wait for use readiness.
+  // Wait till the GPU is done with the frame that last used the backbuffer.
   // ---------------------------------------------------------------------------
+  const bool trace_waits = TRACE_EVENT_CATEGORY_ENABLED("flutter");
+  const fxl::TimePoint wait_start =
+      trace_waits ? fxl::TimePoint::Now() : fxl::TimePoint();
   if (!backbuffer->WaitFences()) {
     FXL_DLOG(INFO) << "Failed waiting on fences.";
     return error;
   }
-
-  // ---------------------------------------------------------------------------
-  // Step 2:
-  // Put semaphores in unsignaled state.
-  // ---------------------------------------------------------------------------
-  if (!backbuffer->ResetFences()) {
-    FXL_DLOG(INFO) << "Could not reset fences.";
-    return error;
+  const fxl::TimePoint acquire_start =
+      trace_waits ? fxl::TimePoint::Now() : fxl::TimePoint();
+  if (trace_waits) {
+    TRACE_COUNTER1("flutter", "VulkanSwapchain FenceWait", "micros",
+                   (acquire_start - wait_start).ToMicroseconds());
   }
 
   // ---------------------------------------------------------------------------
-  // Step 3:
+  // Step 2:
   // Acquire the next image index.
   // ---------------------------------------------------------------------------
   uint32_t next_image_index = 0;
@@ -378,66 +465,52 @@ VulkanSwapchain::AcquireResult VulkanSwapchain::AcquireSurface() {
       return {AcquireStatus::ErrorSurfaceLost, nullptr};
   }
 
+  if (trace_waits) {
+    TRACE_COUNTER1("flutter", "VulkanSwapchain AcquireWait", "micros",
+                   (fxl::TimePoint::Now() - acquire_start).ToMicroseconds());
+  }
+
   // Simple sanity checking of image index.
   if (next_image_index >= images_.size()) {
     FXL_DLOG(INFO) << "Image index returned was out-of-bounds.";
     return error;
   }
 
-  auto& image = images_[next_image_index];
-  if (!image->IsValid()) {
-    FXL_DLOG(INFO) << "Image at index was invalid.";
+  // The command buffers of the image must not be pending when resubmitted.
+  // They usually are not since the image was released by the presentation
+  // engine.
+  VulkanBackbuffer* previous_backbuffer = image_backbuffers_[next_image_index];
+  if (previous_backbuffer != nullptr && previous_backbuffer != backbuffer &&
+      !previous_backbuffer->WaitFences()) {
+    FXL_DLOG(INFO) << "Failed waiting on the fences of the previous frame.";
     return error;
   }
+  image_backbuffers_[next_image_index] = backbuffer;
 
   // ---------------------------------------------------------------------------
-  // Step 4:
-  // Start recording to the command buffer.
+  // Step 3:
+  // Put fences in unsignaled state. This is done after the acquisition so that
+  // the fences stay signaled if the swapchain has to be recreated.
   // ---------------------------------------------------------------------------
-  if (!backbuffer->GetUsageCommandBuffer().Begin()) {
-    FXL_DLOG(INFO) << "Could not begin recording to the command buffer.";
+  if (!backbuffer->ResetFences()) {
+    FXL_DLOG(INFO) << "Could not reset fences.";
     return error;
   }
 
   // ---------------------------------------------------------------------------
-  // Step 5:
-  // Set image layout to color attachment mode.
+  // Step 4:
+  // Submit the pre-recorded transition of the image to the color attachment
+  // layout. It waits for the presentation engine to release the image.
   // ---------------------------------------------------------------------------
-  VkPipelineStageFlagBits destination_pipeline_stage =
+  const VkPipelineStageFlagBits destination_pipeline_stage =
       VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-  VkImageLayout destination_image_layout =
+  const VkImageLayout destination_image_layout =
       VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
 
-  if (!image->InsertImageMemoryBarrier(
-          backbuffer->GetUsageCommandBuffer(),   // command buffer
-          current_pipeline_stage_,               // src_pipeline_bits
-          destination_pipeline_stage,            // dest_pipeline_bits
-          VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,  // dest_access_flags
-          destination_image_layout               // dest_layout
-          )) {
-    FXL_DLOG(INFO) << "Could not insert image memory barrier.";
-    return error;
-  } else {
-    current_pipeline_stage_ = destination_pipeline_stage;
-  }
-
-  // ---------------------------------------------------------------------------
-  // Step 6:
-  // End recording to the command buffer.
-  // ---------------------------------------------------------------------------
-  if (!backbuffer->GetUsageCommandBuffer().End()) {
-    FXL_DLOG(INFO) << "Could not end recording to the command buffer.";
-    return error;
-  }
-
-  // ---------------------------------------------------------------------------
-  // Step 7:
-  // Submit the command buffer to the device queue.
-  // ---------------------------------------------------------------------------
   std::vector<VkSemaphore> wait_semaphores = {backbuffer->GetUsageSemaphore()};
   std::vector<VkSemaphore> signal_semaphores = {};
   std::vector<VkCommandBuffer> command_buffers = {
-      backbuffer->GetUsageCommandBuffer().Handle()};
+      acquire_command_buffers_[next_image_index]->Handle()};
 
   if (!device_.QueueSubmit(
           {destination_pipeline_stage},  // wait_dest_pipeline_stages
@@ -451,7 +524,7 @@ VulkanSwapchain::AcquireResult VulkanSwapchain::AcquireSurface() {
   }
 
   // ---------------------------------------------------------------------------
-  // Step 8:
+  // Step 5:
   // Tell Skia about the updated image layout.
   // ---------------------------------------------------------------------------
   sk_sp<SkSurface> surface = surfaces_[next_image_index];
@@ -481,64 +554,27 @@ bool VulkanSwapchain::Submit() {
   }
 
   sk_sp<SkSurface> surface = surfaces_[current_image_index_];
-  const std::unique_ptr<VulkanImage>& image = images_[current_image_index_];
   auto backbuffer = backbuffers_[current_backbuffer_index_].get();
 
   // ---------------------------------------------------------------------------
   // Step 0:
   // Make sure Skia has flushed all work for the surface to the gpu.
   // ---------------------------------------------------------------------------
+  const bool trace_waits = TRACE_EVENT_CATEGORY_ENABLED("flutter");
+  const fxl::TimePoint submit_start =
+      trace_waits ? fxl::TimePoint::Now() : fxl::TimePoint();
   surface->flush();
 
   // ---------------------------------------------------------------------------
   // Step 1:
-  // Start recording to the command buffer.
-  // ---------------------------------------------------------------------------
-  if (!backbuffer->GetRenderCommandBuffer().Begin()) {
-    FXL_DLOG(INFO) << "Could not start recording to the command buffer.";
-    return false;
-  }
-
-  // ---------------------------------------------------------------------------
-  // Step 2:
-  // Set image layout to present mode.
-  // ---------------------------------------------------------------------------
-  VkPipelineStageFlagBits destination_pipeline_stage =
-      VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-  VkImageLayout destination_image_layout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-
-  if (!image->InsertImageMemoryBarrier(
-          backbuffer->GetRenderCommandBuffer(),  // command buffer
-          current_pipeline_stage_,               // src_pipeline_bits
-          destination_pipeline_stage,            // dest_pipeline_bits
-          VK_ACCESS_MEMORY_READ_BIT,             // dest_access_flags
-          destination_image_layout               // dest_layout
-          )) {
-    FXL_DLOG(INFO) << "Could not insert memory barrier.";
-    return false;
-  } else {
-    current_pipeline_stage_ = destination_pipeline_stage;
-  }
-
-  // ---------------------------------------------------------------------------
-  // Step 3:
-  // End recording to the command buffer.
-  // ---------------------------------------------------------------------------
-  if (!backbuffer->GetRenderCommandBuffer().End()) {
-    FXL_DLOG(INFO) << "Could not end recording to the command buffer.";
-    return false;
-  }
-
-  // ---------------------------------------------------------------------------
-  // Step 4:
-  // Submit the command buffer to the device queue. Tell it to signal the render
-  // semaphore.
+  // Submit the pre-recorded transition of the image to the present layout.
+  // Tell it to signal the render semaphore.
   // ---------------------------------------------------------------------------
   std::vector<VkSemaphore> wait_semaphores = {};
   std::vector<VkSemaphore> queue_signal_semaphores = {
       backbuffer->GetRenderSemaphore()};
   std::vector<VkCommandBuffer> command_buffers = {
-      backbuffer->GetRenderCommandBuffer().Handle()};
+      present_command_buffers_[current_image_index_]->Handle()};
 
   if (!device_.QueueSubmit(
           {/* Empty. No wait semaphores. */},  // wait_dest_pipeline_stages
@@ -551,8 +587,15 @@ bool VulkanSwapchain::Submit() {
     return false;
   }
 
+  const fxl::TimePoint present_start =
+      trace_waits ? fxl::TimePoint::Now() : fxl::TimePoint();
+  if (trace_waits) {
+    TRACE_COUNTER1("flutter", "VulkanSwapchain SubmitWait", "micros",
+                   (present_start - submit_start).ToMicroseconds());
+  }
+
   // ---------------------------------------------------------------------------
-  // Step 5:
+  // Step 2:
   // Submit the present operation and wait on the render semaphore.
   // ---------------------------------------------------------------------------
   VkSwapchainKHR swapchain = swapchain_;
@@ -575,6 +618,11 @@ bool VulkanSwapchain::Submit() {
     return false;
   }
 
+  if (trace_waits) {
+    TRACE_COUNTER1("flutter", "VulkanSwapchain PresentWait", "micros",
+                   (fxl::TimePoint::Now() - present_start).ToMicroseconds());
+  }
+
   return true;
 }
 
@@ -21,8 +21,18 @@ class VulkanProcTable;
 class VulkanDevice;
 class VulkanSurface;
 class VulkanBackbuffer;
+class VulkanCommandBuffer;
 class VulkanImage;
 
+struct VulkanSwapchainOptions {
+  /// The number of frames the CPU may record ahead of the GPU. Each frame in
+  /// flight has its own semaphores and fences.
+  size_t frames_in_flight = 2;
+  /// Use mailbox or immediate presentation instead of FIFO if the surface
+  /// supports it. Only useful if frames are not paced by vsync.
+  bool prefer_low_latency_present_mode = false;
+};
+
 class VulkanSwapchain {
  public:
   VulkanSwapchain(const VulkanProcTable& vk,
@@ -30,7 +40,8 @@ class VulkanSwapchain {
                   const VulkanSurface& surface,
                   GrContext* skia_context,
                   std::unique_ptr<VulkanSwapchain> old_swapchain,
-                  uint32_t queue_family_index);
+                  uint32_t queue_family_index,
+                  const VulkanSwapchainOptions& options);
 
   ~VulkanSwapchain();
 
@@ -67,10 +78,18 @@ class VulkanSwapchain {
   VkSurfaceCapabilitiesKHR capabilities_;
   VkSurfaceFormatKHR surface_format_;
   VulkanHandle<VkSwapchainKHR> swapchain_;
+  // One for each frame in flight.
   std::vector<std::unique_ptr<VulkanBackbuffer>> backbuffers_;
+  // One for each swapchain image.
   std::vector<std::unique_ptr<VulkanImage>> images_;
   std::vector<sk_sp<SkSurface>> surfaces_;
-  VkPipelineStageFlagBits current_pipeline_stage_;
+  // The layout transitions of each image are recorded once and resubmitted
+  // every time the image is acquired and presented.
+  std::vector<std::unique_ptr<VulkanCommandBuffer>> acquire_command_buffers_;
+  std::vector<std::unique_ptr<VulkanCommandBuffer>> present_command_buffers_;
+  // The backbuffer of the frame that last used each image. Its fences guard
+  // the reuse of the pre-recorded command buffers of the image.
+  std::vector<VulkanBackbuffer*> image_backbuffers_;
   size_t current_backbuffer_index_;
   size_t current_image_index_;
   bool valid_;
@@ -81,6 +100,10 @@ class VulkanSwapchain {
                              SkColorType color_type,
                              sk_sp<SkColorSpace> color_space);
 
+  bool CreateBackbuffers(size_t frames_in_flight);
+
+  bool RecordLayoutTransitions(VulkanImage& image);
+
   sk_sp<SkSurface> CreateSkiaSurface(GrContext* skia_context,
                                      VkImage image,
                                      const SkISize& size,
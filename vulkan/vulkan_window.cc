@@ -10,15 +10,25 @@
 #include "flutter/vulkan/vulkan_application.h"
 #include "flutter/vulkan/vulkan_device.h"
 #include "flutter/vulkan/vulkan_native_surface.h"
+#include "flutter/vulkan/vulkan_pipeline_cache.h"
 #include "flutter/vulkan/vulkan_surface.h"
 #include "flutter/vulkan/vulkan_swapchain.h"
 #include "third_party/skia/include/gpu/GrContext.h"
 
 namespace vulkan {
 
+// About ten seconds of continuous animation.
+static const size_t kPipelineCacheSaveInterval = 600;
+
 VulkanWindow::VulkanWindow(fxl::RefPtr<VulkanProcTable> proc_table,
-                           std::unique_ptr<VulkanNativeSurface> native_surface)
-    : valid_(false), vk(std::move(proc_table)) {
+                           std::unique_ptr<VulkanNativeSurface> native_surface,
+                           VulkanSwapchainOptions swapchain_options,
+                           std::string pipeline_cache_directory,
+                           fxl::RefPtr<fxl::TaskRunner> io_task_runner)
+    : valid_(false),
+      vk(std::move(proc_table)),
+      swapchain_options_(std::move(swapchain_options)),
+      frame_count_(0) {
   if (!vk || !vk->HasAcquiredMandatoryProcAddresses()) {
     FXL_DLOG(INFO) << "Proc table has not acquired mandatory proc addresses.";
     return;
@@ -68,6 +78,15 @@ VulkanWindow::VulkanWindow(fxl::RefPtr<VulkanProcTable> proc_table,
     return;
   }
 
+  // Create the pipeline cache. Skia must be told about it when its context is
+  // created.
+
+  if (!pipeline_cache_directory.empty()) {
+    pipeline_cache_ = std::make_unique<VulkanPipelineCache>(
+        *vk, *logical_device_, std::move(pipeline_cache_directory),
+        std::move(io_task_runner));
+  }
+
   // Create the Skia GrContext.
 
   if (!CreateSkiaGrContext()) {
@@ -137,7 +156,9 @@ bool VulkanWindow::CreateSkiaBackendContext(GrVkBackendContext* context) {
                          kKHR_swapchain_GrVkExtensionFlag |
                          surface_->GetNativeSurface().GetSkiaExtensionName();
   context->fFeatures = skia_features;
-  context->fGetProc = std::move(getProc);
+  context->fGetProc = pipeline_cache_
+                          ? pipeline_cache_->WrapSkiaGetProc(std::move(getProc))
+                          : std::move(getProc);
   context->fOwnsInstanceAndDevice = false;
   return true;
 }
@@ -213,7 +234,17 @@ bool VulkanWindow::SwapBuffers() {
     return false;
   }
 
-  return swapchain_->Submit();
+  if (!swapchain_->Submit()) {
+    return false;
+  }
+
+  // Store the pipelines compiled so far every once in a while in case the
+  // process is killed before the GrContext is collected.
+  if (pipeline_cache_ && ++frame_count_ % kPipelineCacheSaveInterval == 0) {
+    FXL_ALLOW_UNUSED_LOCAL(pipeline_cache_->Save());
+  }
+
+  return true;
 }
 
 bool VulkanWindow::RecreateSwapchain() {
@@ -239,7 +270,8 @@ bool VulkanWindow::RecreateSwapchain() {
 
   auto swapchain = std::make_unique<VulkanSwapchain>(
       *vk, *logical_device_, *surface_, skia_gr_context_.get(),
-      std::move(old_swapchain), logical_device_->GetGraphicsQueueIndex());
+      std::move(old_swapchain), logical_device_->GetGraphicsQueueIndex(),
+      swapchain_options_);
 
   if (!swapchain->IsValid()) {
     return false;
@@ -6,13 +6,16 @@
 #define FLUTTER_VULKAN_VULKAN_WINDOW_H_
 
 #include <memory>
+#include <string>
 #include <tuple>
 #include <utility>
 #include <vector>
 
 #include "flutter/vulkan/vulkan_proc_table.h"
+#include "flutter/vulkan/vulkan_swapchain.h"
 #include "lib/fxl/compiler_specific.h"
 #include "lib/fxl/macros.h"
+#include "lib/fxl/tasks/task_runner.h"
 #include "third_party/skia/include/core/SkRefCnt.h"
 #include "third_party/skia/include/core/SkSize.h"
 #include "third_party/skia/include/core/SkSurface.h"
@@ -24,15 +27,20 @@ namespace vulkan {
 class VulkanNativeSurface;
 class VulkanDevice;
 class VulkanSurface;
-class VulkanSwapchain;
 class VulkanImage;
 class VulkanApplication;
 class VulkanBackbuffer;
+class VulkanPipelineCache;
 
 class VulkanWindow {
  public:
+  // The pipeline cache is not persisted if |pipeline_cache_directory| is
+  // empty. Its files are written on |io_task_runner| if one is given.
   VulkanWindow(fxl::RefPtr<VulkanProcTable> proc_table,
-               std::unique_ptr<VulkanNativeSurface> native_surface);
+               std::unique_ptr<VulkanNativeSurface> native_surface,
+               VulkanSwapchainOptions swapchain_options,
+               std::string pipeline_cache_directory,
+               fxl::RefPtr<fxl::TaskRunner> io_task_runner = nullptr);
 
   ~VulkanWindow();
 
@@ -47,11 +55,15 @@ class VulkanWindow {
  private:
   bool valid_;
   fxl::RefPtr<VulkanProcTable> vk;
+  const VulkanSwapchainOptions swapchain_options_;
   std::unique_ptr<VulkanApplication> application_;
   std::unique_ptr<VulkanDevice> logical_device_;
   std::unique_ptr<VulkanSurface> surface_;
   std::unique_ptr<VulkanSwapchain> swapchain_;
+  // Must outlive the GrContext.
+  std::unique_ptr<VulkanPipelineCache> pipeline_cache_;
   sk_sp<GrContext> skia_gr_context_;
+  size_t frame_count_;
 
   bool CreateSkiaGrContext();
 